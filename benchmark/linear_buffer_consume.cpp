@@ -0,0 +1,125 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares parsing a buffer message by message with
+// asioext::dynamic_linear_buffer against a dynamic buffer that erases
+// consumed bytes from the front of its storage (Asio's dynamic_vector_buffer,
+// and what dynamic_linear_buffer used to do).
+//
+// Usage: linear_buffer_consume [max buffer size in KiB] [message size]
+//
+// Buffer sizes start at 64 KiB and are doubled up to the given maximum
+// (default 1024 KiB). Each run fills the buffer with newline-terminated
+// messages, then finds and consumes them one by one.
+
+#include <asioext/linear_buffer.hpp>
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/buffer.hpp>
+#else
+# include <asio/buffer.hpp>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+namespace asio = boost::asio;
+#endif
+
+template <typename DynamicBuffer>
+std::size_t parse_all(DynamicBuffer buf, const std::string& input)
+{
+  const std::size_t size = buf.size();
+  buf.grow(input.size());
+  std::memcpy(buf.data(size, input.size()).data(), input.data(),
+              input.size());
+
+  std::size_t messages = 0;
+  while (buf.size() != 0) {
+    const auto data = buf.data(0, buf.size());
+    const char* first = static_cast<const char*>(data.data());
+    const char* eol = static_cast<const char*>(
+        std::memchr(first, '\n', data.size()));
+    if (!eol)
+      break;
+    buf.consume(eol - first + 1);
+    ++messages;
+  }
+  return messages;
+}
+
+double best_of(int runs, std::size_t expected,
+               const std::function<std::size_t()>& f)
+{
+  double best = 1e100;
+  for (int i = 0; i != runs; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t n = f();
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (n != expected) {
+      std::cerr << "error: parsed " << n << " messages, expected "
+                << expected << std::endl;
+      std::exit(1);
+    }
+    best = (std::min)(best, elapsed.count());
+  }
+  return best;
+}
+
+void report(const char* name, double ms, std::size_t bytes, double baseline)
+{
+  std::cout << "  " << name << ": " << ms << " ms ("
+            << static_cast<uint64_t>(bytes / ms * 1000.0 / (1024 * 1024))
+            << " MiB/s, " << baseline / ms << "x)" << std::endl;
+}
+
+int main(int argc, const char* argv[])
+{
+  std::size_t max_kib = 1024;
+  std::size_t message_size = 64;
+  if (argc > 1) max_kib = std::strtoul(argv[1], nullptr, 10);
+  if (argc > 2) message_size = std::strtoul(argv[2], nullptr, 10);
+  if (message_size < 2) {
+    std::cerr << "usage: " << argv[0]
+              << " [max buffer size in KiB] [message size >= 2]"
+              << std::endl;
+    return 1;
+  }
+
+  const int runs = 3;
+
+  for (std::size_t kib = 64; kib <= max_kib; kib *= 2) {
+    const std::size_t messages = kib * 1024 / message_size;
+    std::string input;
+    input.reserve(messages * message_size);
+    for (std::size_t i = 0; i != messages; ++i) {
+      input.append(message_size - 1, static_cast<char>('a' + i % 26));
+      input += '\n';
+    }
+
+    std::cout << kib << " KiB, " << messages << " messages:" << std::endl;
+
+    const double baseline = best_of(runs, messages, [&] {
+      std::vector<uint8_t> v;
+      return parse_all(asio::dynamic_buffer(v), input);
+    });
+    report("erase from the front (asio::dynamic_vector_buffer)", baseline,
+           input.size(), baseline);
+    report("asioext::dynamic_linear_buffer",
+           best_of(runs, messages, [&] {
+             asioext::linear_buffer b;
+             return parse_all(asioext::dynamic_buffer(b), input);
+           }),
+           input.size(), baseline);
+  }
+  return 0;
+}
@@ -0,0 +1,166 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares asioext::parallel_walk() against std::filesystem's recursive
+// directory iteration on a generated tree.
+//
+// Usage: parallel_walk <scratch dir> [depth] [fanout] [files per dir]
+//
+// The tree is created below <scratch dir> (and removed afterwards). Its
+// creation also warms the page cache, so this measures the CPU and system
+// call overhead of the walkers rather than the underlying storage.
+
+#include <asioext/parallel_walk.hpp>
+#include <asioext/open.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+struct tree_params
+{
+  int depth = 4;
+  int fanout = 8;
+  int files_per_dir = 32;
+};
+
+// Returns the number of created entries.
+uint64_t create_tree(const fs::path& path, const tree_params& params,
+                     int depth)
+{
+  const asioext::directory_handle dir =
+      asioext::open_directory(path.string().c_str());
+
+  uint64_t n = 0;
+  for (int i = 0; i != params.files_per_dir; ++i) {
+    asioext::open(dir, ("f" + std::to_string(i)).c_str(),
+                  asioext::open_flags::access_write |
+                  asioext::open_flags::create_always);
+    ++n;
+  }
+
+  if (depth == params.depth)
+    return n;
+
+  for (int i = 0; i != params.fanout; ++i) {
+    const fs::path sub = path / ("d" + std::to_string(i));
+    fs::create_directory(sub);
+    n += 1 + create_tree(sub, params, depth + 1);
+  }
+  return n;
+}
+
+double best_of(int runs, uint64_t expected, const std::function<uint64_t()>& f)
+{
+  double best = 1e100;
+  for (int i = 0; i != runs; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t n = f();
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (n != expected) {
+      std::cerr << "error: visited " << n << " entries, expected "
+                << expected << std::endl;
+      std::exit(1);
+    }
+    best = (std::min)(best, elapsed.count());
+  }
+  return best;
+}
+
+void report(const char* name, double ms, uint64_t entries, double baseline)
+{
+  std::cout << "  " << name << ": " << ms << " ms ("
+            << static_cast<uint64_t>(entries / ms * 1000.0)
+            << " entries/s, " << baseline / ms << "x)" << std::endl;
+}
+
+int main(int argc, const char* argv[])
+{
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0]
+              << " <scratch dir> [depth] [fanout] [files per dir]"
+              << std::endl;
+    return 1;
+  }
+
+  tree_params params;
+  if (argc > 2) params.depth = std::atoi(argv[2]);
+  if (argc > 3) params.fanout = std::atoi(argv[3]);
+  if (argc > 4) params.files_per_dir = std::atoi(argv[4]);
+
+  const fs::path root = fs::path(argv[1]) / "asioext_walk_bench";
+  const std::string root_str = root.string();
+  const unsigned threads = (std::max)(1u, std::thread::hardware_concurrency());
+  const int runs = 3;
+
+  try {
+    fs::remove_all(root);
+    fs::create_directories(root);
+    std::cout << "Creating tree (depth " << params.depth << ", fanout "
+              << params.fanout << ", " << params.files_per_dir
+              << " files per directory)..." << std::endl;
+    const uint64_t entries = create_tree(root, params, 0);
+    std::cout << entries << " entries" << std::endl;
+
+    const auto fs_walk = [&root] (bool stat) {
+      uint64_t n = 0;
+      for (const fs::directory_entry& e :
+           fs::recursive_directory_iterator(root)) {
+        if (stat)
+          e.symlink_status();
+        ++n;
+      }
+      return n;
+    };
+
+    const auto asioext_walk = [&root_str] (std::size_t threads, bool stat) {
+      asioext::walk_options options;
+      options.threads = threads;
+      options.stat_entries = stat;
+      return asioext::parallel_walk(root_str.c_str(),
+          [] (const asioext::walk_entry&) {
+            return asioext::walk_action::proceed;
+          }, options);
+    };
+
+    for (bool stat : {false, true}) {
+      std::cout << (stat ? "With" : "Without")
+                << " per-entry metadata:" << std::endl;
+
+      const double baseline = best_of(runs, entries,
+                                      [&] { return fs_walk(stat); });
+      report("std::filesystem::recursive_directory_iterator", baseline,
+             entries, baseline);
+      report("asioext::parallel_walk, 1 thread",
+             best_of(runs, entries, [&] { return asioext_walk(1, stat); }),
+             entries, baseline);
+
+      if (threads > 1) {
+        const std::string name = "asioext::parallel_walk, " +
+                                 std::to_string(threads) + " threads";
+        report(name.c_str(),
+               best_of(runs, entries,
+                       [&] { return asioext_walk(threads, stat); }),
+               entries, baseline);
+      }
+    }
+
+    fs::remove_all(root);
+  } catch (std::exception& e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,166 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares scanning a file with one async_read_some_at() at a time against
+// asioext::prefetching_file_reader.
+//
+// Usage: prefetching_file_reader <file> [chunk size in KiB] [work per chunk in us]
+//
+// The consumer spends the given time (default 100 us) busy on each chunk
+// (default 256 KiB), simulating parsing or hashing. On POSIX systems the
+// file is dropped from the page cache before each variant, so that both read
+// from the device. Elsewhere, the second variant might read cached data.
+
+#include <asioext/prefetching_file_reader.hpp>
+#include <asioext/file.hpp>
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/io_context.hpp>
+#else
+# include <asio/io_context.hpp>
+#endif
+
+#if !defined(ASIOEXT_WINDOWS)
+# include <fcntl.h>
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+namespace asio = boost::asio;
+#endif
+
+static std::chrono::microseconds work_per_chunk;
+
+void work(asio::const_buffer chunk, uint64_t& sum)
+{
+  const auto until = std::chrono::steady_clock::now() + work_per_chunk;
+  const uint8_t* data = static_cast<const uint8_t*>(chunk.data());
+  for (std::size_t i = 0; i < chunk.size(); i += 4096)
+    sum += data[i];
+  while (std::chrono::steady_clock::now() < until) {}
+}
+
+void evict(asioext::file& f)
+{
+#if !defined(ASIOEXT_WINDOWS) && defined(POSIX_FADV_DONTNEED)
+  ::posix_fadvise(f.native_handle(), 0, 0, POSIX_FADV_DONTNEED);
+#else
+  (void)f;
+#endif
+}
+
+uint64_t read_sequentially(asio::io_context& ctx, const char* filename,
+                           std::size_t chunk_size)
+{
+  asioext::file f(ctx, filename,
+                  asioext::open_flags::access_read |
+                  asioext::open_flags::open_existing);
+  evict(f);
+
+  std::vector<uint8_t> buffer(chunk_size);
+  uint64_t offset = 0;
+  uint64_t sum = 0;
+  std::function<void (asioext::error_code, std::size_t)> on_read =
+      [&] (asioext::error_code ec, std::size_t n) {
+    if (ec)
+      return;
+    work(asio::buffer(buffer.data(), n), sum);
+    offset += n;
+    f.async_read_some_at(offset, asio::buffer(buffer), on_read);
+  };
+  f.async_read_some_at(offset, asio::buffer(buffer), on_read);
+  ctx.restart();
+  ctx.run();
+  return offset;
+}
+
+uint64_t read_prefetching(asio::io_context& ctx, const char* filename,
+                          std::size_t chunk_size, std::size_t& depth)
+{
+  asioext::file f(ctx, filename,
+                  asioext::open_flags::access_read |
+                  asioext::open_flags::open_existing);
+  evict(f);
+
+  asioext::prefetch_options options;
+  options.chunk_size = chunk_size;
+  asioext::prefetching_file_reader<asioext::file> reader(f, options);
+
+  uint64_t size = 0;
+  uint64_t sum = 0;
+  std::function<void (asioext::error_code, asio::const_buffer)> on_chunk =
+      [&] (asioext::error_code ec, asio::const_buffer chunk) {
+    if (ec)
+      return;
+    work(chunk, sum);
+    size += chunk.size();
+    reader.async_next(on_chunk);
+  };
+  reader.async_next(on_chunk);
+  ctx.restart();
+  ctx.run();
+  depth = reader.depth();
+  return size;
+}
+
+void report(const char* name, double ms, uint64_t bytes, double baseline)
+{
+  std::cout << "  " << name << ": " << ms << " ms ("
+            << static_cast<uint64_t>(bytes / ms * 1000.0 / (1024 * 1024))
+            << " MiB/s, " << baseline / ms << "x)" << std::endl;
+}
+
+int main(int argc, const char* argv[])
+{
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0]
+              << " <file> [chunk size in KiB] [work per chunk in us]"
+              << std::endl;
+    return 1;
+  }
+
+  std::size_t chunk_kib = 256;
+  work_per_chunk = std::chrono::microseconds(100);
+  if (argc > 2) chunk_kib = std::strtoul(argv[2], nullptr, 10);
+  if (argc > 3)
+    work_per_chunk = std::chrono::microseconds(
+        std::strtoul(argv[3], nullptr, 10));
+  if (chunk_kib == 0) {
+    std::cerr << "chunk size must not be 0" << std::endl;
+    return 1;
+  }
+
+  asio::io_context ctx;
+  asio::add_service(ctx, new asioext::thread_pool_file_service(ctx, 8));
+
+  auto start = std::chrono::steady_clock::now();
+  const uint64_t size = read_sequentially(ctx, argv[1], chunk_kib * 1024);
+  const std::chrono::duration<double, std::milli> baseline =
+      std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  std::size_t depth = 0;
+  const uint64_t prefetched = read_prefetching(ctx, argv[1],
+                                               chunk_kib * 1024, depth);
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  if (prefetched != size) {
+    std::cerr << "error: read " << prefetched << " bytes, expected " << size
+              << std::endl;
+    return 1;
+  }
+
+  std::cout << size / 1024 << " KiB in " << chunk_kib << " KiB chunks, "
+            << work_per_chunk.count() << " us per chunk:" << std::endl;
+  report("one read at a time", baseline.count(), size, baseline.count());
+  report("asioext::prefetching_file_reader", elapsed.count(), size,
+         baseline.count());
+  std::cout << "  final depth: " << depth << std::endl;
+  return 0;
+}
@@ -0,0 +1,185 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares splitting a stream into delimited messages with asio::read_until
+// (on a std::string) against buffered_stream::read_until.
+//
+// Usage: read_until [input size in MiB] [chunk size]
+//
+// The input (default 64 MiB) is read from an in-memory stream that returns
+// at most |chunk size| bytes (default 16384) per read_some() call, similar
+// to a socket. Each benchmark is run with short and long messages, and with
+// a single-byte ('\n') and a multi-byte ("\r\n\r\n") delimiter.
+
+#include <asioext/buffered_stream.hpp>
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/buffer.hpp>
+# include <boost/asio/io_context.hpp>
+# include <boost/asio/read_until.hpp>
+#else
+# include <asio/buffer.hpp>
+# include <asio/io_context.hpp>
+# include <asio/read_until.hpp>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+namespace asio = boost::asio;
+#endif
+
+// A SyncReadStream serving a string in chunks.
+class memory_stream
+{
+public:
+  typedef memory_stream lowest_layer_type;
+  typedef asio::io_context::executor_type executor_type;
+
+  memory_stream(asio::io_context& ctx, const std::string& data,
+                std::size_t chunk_size)
+    : executor_(ctx.get_executor())
+    , data_(data)
+    , pos_(0)
+    , chunk_size_(chunk_size)
+  {}
+
+  lowest_layer_type& lowest_layer() { return *this; }
+  executor_type get_executor() { return executor_; }
+
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+                        asioext::error_code& ec)
+  {
+    if (pos_ == data_.size()) {
+      ec = asio::error::eof;
+      return 0;
+    }
+
+    ec = asioext::error_code();
+    const std::size_t n = asio::buffer_copy(
+        buffers, asio::buffer(data_.data() + pos_,
+                              (std::min)(chunk_size_, data_.size() - pos_)));
+    pos_ += n;
+    return n;
+  }
+
+private:
+  executor_type executor_;
+  const std::string& data_;
+  std::size_t pos_;
+  std::size_t chunk_size_;
+};
+
+std::size_t asio_read_until(memory_stream& stream, const std::string& delim)
+{
+  std::string buffer;
+  std::size_t messages = 0;
+  asioext::error_code ec;
+  for (;;) {
+    const std::size_t n = asio::read_until(stream, asio::dynamic_buffer(buffer),
+                                           delim, ec);
+    if (ec)
+      break;
+    buffer.erase(0, n);
+    ++messages;
+  }
+  return messages;
+}
+
+std::size_t buffered_read_until(memory_stream& stream,
+                                const std::string& delim)
+{
+  asioext::buffered_stream<memory_stream&> buffered(stream);
+  std::size_t messages = 0;
+  asioext::error_code ec;
+  for (;;) {
+    const std::size_t n = buffered.read_until(delim, ec);
+    if (ec)
+      break;
+    buffered.read_buffer().erase(std::size_t(0), n);
+    ++messages;
+  }
+  return messages;
+}
+
+double best_of(int runs, std::size_t expected,
+               const std::function<std::size_t()>& f)
+{
+  double best = 1e100;
+  for (int i = 0; i != runs; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t n = f();
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (n != expected) {
+      std::cerr << "error: read " << n << " messages, expected "
+                << expected << std::endl;
+      std::exit(1);
+    }
+    best = (std::min)(best, elapsed.count());
+  }
+  return best;
+}
+
+void report(const char* name, double ms, std::size_t bytes, double baseline)
+{
+  std::cout << "  " << name << ": " << ms << " ms ("
+            << static_cast<uint64_t>(bytes / ms * 1000.0 / (1024 * 1024))
+            << " MiB/s, " << baseline / ms << "x)" << std::endl;
+}
+
+int main(int argc, const char* argv[])
+{
+  std::size_t mib = 64;
+  std::size_t chunk_size = 16384;
+  if (argc > 1) mib = std::strtoul(argv[1], nullptr, 10);
+  if (argc > 2) chunk_size = std::strtoul(argv[2], nullptr, 10);
+  if (mib == 0 || chunk_size == 0) {
+    std::cerr << "usage: " << argv[0]
+              << " [input size in MiB] [chunk size]" << std::endl;
+    return 1;
+  }
+
+  const int runs = 3;
+  const std::string delims[] = {"\n", "\r\n\r\n"};
+  const std::size_t message_sizes[] = {64, 4096};
+
+  asio::io_context ctx;
+  for (const std::string& delim : delims) {
+    for (const std::size_t message_size : message_sizes) {
+      const std::size_t messages = mib * 1024 * 1024 / message_size;
+      std::string input;
+      input.reserve(messages * message_size);
+      for (std::size_t i = 0; i != messages; ++i) {
+        // Plenty of partial matches for the multi-byte delimiter.
+        for (std::size_t j = 0; j < message_size - delim.size(); ++j)
+          input += (j % 40 == 39) ? '\r' : static_cast<char>('a' + i % 26);
+        input += delim;
+      }
+
+      std::cout << (delim.size() == 1 ? "'\\n'" : "\"\\r\\n\\r\\n\"") << ", "
+                << messages << " messages of " << message_size << " bytes:"
+                << std::endl;
+
+      const double baseline = best_of(runs, messages, [&] {
+        memory_stream stream(ctx, input, chunk_size);
+        return asio_read_until(stream, delim);
+      });
+      report("asio::read_until", baseline, input.size(), baseline);
+      report("asioext::buffered_stream::read_until",
+             best_of(runs, messages, [&] {
+               memory_stream stream(ctx, input, chunk_size);
+               return buffered_read_until(stream, delim);
+             }),
+             input.size(), baseline);
+    }
+  }
+  return 0;
+}
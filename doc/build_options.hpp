@@ -74,6 +74,44 @@
 /// to query or modify file attributes fail.
 #define ASIOEXT_DISABLE_FILE_FLAGS
 
+/// @brief Disable the use of Linux' @c openat2() system call.
+///
+/// This macro disables the use of @c openat2(), regardless of
+/// platform support. Opening files relative to a
+/// @ref asioext::directory_handle with non-empty @ref asioext::resolve_flags
+/// then fails with @c asio::error::operation_not_supported.
+#define ASIOEXT_DISABLE_OPENAT2
+
+/// @brief Disable the use of Linux' @c getdents64() system call.
+///
+/// This macro makes @ref asioext::directory_reader use @c readdir()
+/// instead of @c getdents64(), regardless of platform support.
+#define ASIOEXT_DISABLE_GETDENTS64
+
+/// @brief Disable the use of Linux' @c statx() system call.
+///
+/// This macro makes the @c query() functions (and
+/// @ref asioext::directory_handle::stat) use @c stat() instead of
+/// @c statx(), regardless of platform support. File creation times
+/// are then unavailable on Linux.
+#define ASIOEXT_DISABLE_STATX
+
+/// @brief Disable the use of Linux' open file description locks.
+///
+/// This macro makes the file locking functions (e.g.
+/// @ref asioext::file_handle::lock) use classic POSIX record locks
+/// (@c F_SETLK) instead of @c F_OFD_SETLK, regardless of platform support.
+/// Record locks are owned by the process, so different file handles
+/// in the same process don't conflict, and closing any handle to a file
+/// releases all of the process' locks on it.
+#define ASIOEXT_DISABLE_OFD_LOCKS
+
+/// @brief Disable the splice()-based transfer functions.
+///
+/// This macro disables @ref splice on Linux, e.g. for kernels or
+/// sandboxes that don't permit @c splice(), @c tee() and @c vmsplice().
+#define ASIOEXT_DISABLE_SPLICE
+
 /// @brief Disable <code>\#pragma once</code> support.
 ///
 /// This macro disables the use of <code>\#pragma once</code>, regardless of
@@ -3,41 +3,15 @@
 /// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <asioext/unique_file_handle.hpp>
+#include <asioext/copy_file.hpp>
+#include <asioext/checksum.hpp>
 #include <asioext/open.hpp>
 #include <asioext/standard_streams.hpp>
 
-#include <asio/write.hpp>
-#include <asio/read.hpp>
-
-#include <array>
+#include <iomanip>
 #include <iostream>
 #include <cstdio>
 
-// General-purpose stream copying from |src| to |dst|.
-// This doesn't use src.size() deliberately, so we can support special
-// files that don't report their size correctly.
-void copy_file_aux(asioext::file_handle src, asioext::file_handle dst)
-{
-  static const std::size_t kBufferSize = 16 * 1024;
-
-  std::array<char, kBufferSize> buffer;
-  while (true) {
-    std::error_code ec;
-    const std::size_t actual = asio::read(src, asio::buffer(buffer), ec);
-
-    // Handle the expected errors here. (We could also use the throwing version
-    // and catch & re-throw here, but this'd be overkill.)
-    if (ec) {
-      if (ec == asio::error::eof)
-        break;
-      else
-        throw std::system_error(ec);
-    }
-
-    asio::write(dst, asio::buffer(buffer.data(), actual));
-  }
-}
-
 bool copy_file(const std::string& src_path, const std::string& dst_path)
 {
   asioext::file_handle src, dst;
@@ -60,7 +34,7 @@ bool copy_file(const std::string& src_path, const std::string& dst_path)
 
   try {
     if (dst_path != "-") {
-      dst_file = asioext::open(src_path.c_str(),
+      dst_file = asioext::open(dst_path.c_str(),
                                asioext::open_flags::access_write |
                                asioext::open_flags::create_always);
       dst = dst_file.get();
@@ -73,13 +47,20 @@ bool copy_file(const std::string& src_path, const std::string& dst_path)
     return false;
   }
 
+  // asioext::copy_file() reads until EOF instead of relying on src's size,
+  // so we can support special files that don't report their size correctly.
+  // The checksum is computed while the data is copied.
+  asioext::crc32c_hasher hasher;
   try {
-    copy_file_aux(src, dst);
+    asioext::copy_file(src, dst, hasher);
   } catch (std::exception& e) {
     std::cerr << "error: Copying data failed with " << e.what() << '\n';
     return false;
   }
 
+  std::cerr << "crc32c: " << std::hex << std::setw(8) << std::setfill('0')
+      << hasher.value() << '\n';
+
   return true;
 }
 
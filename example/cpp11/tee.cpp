@@ -7,6 +7,7 @@
 #include <asioext/file_handle.hpp>
 #include <asioext/open.hpp>
 #include <asioext/standard_streams.hpp>
+#include <asioext/splice.hpp>
 
 #include <asio/write.hpp>
 
@@ -39,6 +40,43 @@ bool tee_file(asioext::file_handle source, file_handles& destinations)
   return true;
 }
 
+#if defined(ASIOEXT_HAS_SPLICE)
+// splice() doesn't work with all kinds of files (e.g. terminals), and
+// we can't fall back once the first chunk has been taken from the source.
+bool can_splice(asioext::file_handle handle)
+{
+  std::error_code ec;
+  const asioext::file_info info =
+      handle.query(asioext::file_info_mask::type, ec);
+  return !ec && (info.type == asioext::file_type::regular ||
+                 info.type == asioext::file_type::fifo ||
+                 info.type == asioext::file_type::socket);
+}
+
+// Lets the kernel duplicate the data, without copying it to user space.
+// Returns false if splicing isn't supported by one of the files.
+bool splice_file(asioext::file_handle source, file_handles& destinations)
+{
+  if (!can_splice(source))
+    return false;
+  for (std::size_t i = 0, n = destinations.size(); i != n; ++i) {
+    if (!can_splice(destinations[i].get()))
+      return false;
+  }
+
+  std::error_code ec;
+  const uint64_t transferred = asioext::splice_fanout(source, destinations,
+                                                      ec);
+  // Nothing has been read yet, so the fallback doesn't lose any data.
+  if (ec == asio::error::invalid_argument && transferred == 0)
+    return false;
+
+  if (ec && ec != asio::error::broken_pipe)
+    throw std::system_error(ec);
+  return true;
+}
+#endif
+
 int main(int argc, const char* argv[])
 {
   if (argc < 2) {
@@ -60,6 +98,10 @@ int main(int argc, const char* argv[])
   }
 
   try {
+#if defined(ASIOEXT_HAS_SPLICE)
+    if (splice_file(asioext::get_stdin(), files))
+      return 0;
+#endif
     return tee_file(asioext::get_stdin(), files) ? 0 : 1;
   } catch (std::exception& e) {
     std::cerr << "fatal: copying data failed with " << e.what() << '\n';
@@ -6,7 +6,7 @@
 #include <asioext/file.hpp>
 #include <asioext/thread_pool_file_service.hpp>
 #include <asioext/open_flags.hpp>
-#include <asioext/standard_streams.hpp>
+#include <asioext/standard_stream.hpp>
 
 #include <asio/write.hpp>
 #include <asio/io_service.hpp>
@@ -19,7 +19,7 @@ using file_handles = std::vector<asioext::file>;
 class tee_file
 {
 public:
-  tee_file(asioext::file& source, file_handles& destinations)
+  tee_file(asioext::standard_stream& source, file_handles& destinations)
     : source_(source)
     , destinations_(destinations)
     , completed_(0)
@@ -30,7 +30,7 @@ public:
   void run();
 
 private:
-  asioext::file& source_;
+  asioext::standard_stream& source_;
   file_handles& destinations_;
   char buffer_[16 * 1024];
   std::size_t completed_;
@@ -98,7 +98,9 @@ int main(int argc, const char* argv[])
   }
 
   try {
-    asioext::file source(io_service, asioext::get_stdin());
+    // Pipes and terminals are read through the reactor,
+    // redirected files through the thread-pool.
+    asioext::standard_stream source(io_service, asioext::get_stdin());
 
     tee_file op(source, files);
     op.run();
@@ -58,9 +58,27 @@
 ///   * File permissions
 ///   * File attributes
 ///   * File time info (ctime, mtime, ...)
+///   * Consistent snapshots of all of the above, retrieved with a single
+///     system call (@ref asioext::file_handle::query, @ref query)
+/// * Byte-range file locks (@ref asioext::file_handle::lock,
+///   @ref asioext::basic_file::async_lock, @ref asioext::file_lock_guard),
+///   using open file description locks on Linux
+/// * Zero-copy transfers between files, pipes and sockets
+///   (@ref asioext::splice_transfer, @ref asioext::splice_fanout,
+///   @ref asioext::async_splice_read, ...), built on Linux' @c splice()
+/// * Directory handles (@ref asioext::directory_handle) to open, query,
+///   rename and remove files relative to a directory (POSIX only)
+/// * Fast directory enumeration (@ref asioext::directory_reader,
+///   @ref asioext::async_read_directory, POSIX only)
+/// * Parallel recursive directory traversal (@ref asioext::parallel_walk,
+///   POSIX only)
 /// * Utilities for reading/writing files:
 ///   * @ref asioext::read_file
+///   * @ref asioext::read_files
 ///   * @ref asioext::write_file
+///   * @ref asioext::copy_file
+///   * Checksums (@ref asioext::crc32c_hasher, @ref asioext::xxhash64_hasher)
+///     computed while reading/writing/copying
 
 /// @ingroup files
 /// @defgroup files_handle File handles
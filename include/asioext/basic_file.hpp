@@ -511,6 +511,37 @@ public:
   }
 #endif
 
+  /// @brief Assign an existing native handle to the file.
+  ///
+  /// This function takes ownership of the given wrapped native handle.
+  /// The file must not be open.
+  ///
+  /// @param handle The native handle object, wrapped in a file_handle,
+  /// which shall be assigned to this basic_file object.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  void assign(const file_handle& handle)
+  {
+    error_code ec;
+    holder_.get_service().assign(holder_.get_implementation(), handle.native_handle(), ec);
+    detail::throw_error(ec, "assign");
+  }
+
+  /// @brief Assign an existing native handle to the file.
+  ///
+  /// This function takes ownership of the given wrapped native handle.
+  /// The file must not be open.
+  ///
+  /// @param handle The native handle object, wrapped in a file_handle,
+  /// which shall be assigned to this basic_file object.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  void assign(const file_handle& handle, error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    holder_.get_service().assign(holder_.get_implementation(), handle.native_handle(), ec);
+  }
+
   /// Determine whether the handle is open.
   bool is_open() const ASIOEXT_NOEXCEPT
   {
@@ -540,6 +571,102 @@ public:
     holder_.get_service().close(holder_.get_implementation(), ec);
   }
 
+  /// @brief Start an asynchronous operation to open a file.
+  ///
+  /// This function is used to asynchronously open a handle to the
+  /// specified file, without blocking the calling thread.
+  /// The function call always returns immediately.
+  ///
+  /// For details, see @ref open(const char*,const open_args&)
+  ///
+  /// @param filename The path of the file to open. A copy is made,
+  /// so it doesn't need to outlive this call.
+  /// See @ref filenames for details.
+  ///
+  /// @param args Additional options used to open the file.
+  ///
+  /// @param handler The handler to be called when the open operation
+  /// completes. Copies will be made of the handler as required.
+  /// The function signature of the handler must be:
+  /// @code void handler(
+  ///   const error_code& error // Result of operation.
+  /// ); @endcode
+  /// Regardless of whether the asynchronous operation completes immediately or
+  /// not, the handler will not be invoked from within this function. Invocation
+  /// of the handler will be performed in a manner equivalent to using
+  /// asio::io_context::post().
+  ///
+  /// @note The file must not be moved while the operation is pending.
+  /// If the file is closed or destroyed, the operation completes with
+  /// @c asio::error::operation_aborted.
+  ///
+  /// @see open_flags
+  template <typename OpenHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(OpenHandler, void (error_code))
+  async_open(const char* filename, const open_args& args,
+             OpenHandler&& handler)
+  {
+    return holder_.get_service().async_open(holder_.get_implementation(),
+        filename, args, std::forward<OpenHandler>(handler));
+  }
+
+#if defined(ASIOEXT_WINDOWS) || defined(ASIOEXT_IS_DOCUMENTATION)
+  /// @copydoc async_open(const char*,const open_args&,OpenHandler&&)
+  ///
+  /// @note Only available on Windows.
+  template <typename OpenHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(OpenHandler, void (error_code))
+  async_open(const wchar_t* filename, const open_args& args,
+             OpenHandler&& handler)
+  {
+    return holder_.get_service().async_open(holder_.get_implementation(),
+        filename, args, std::forward<OpenHandler>(handler));
+  }
+#endif
+
+#if defined(ASIOEXT_HAS_BOOST_FILESYSTEM) || defined(ASIOEXT_IS_DOCUMENTATION)
+  /// @copydoc async_open(const char*,const open_args&,OpenHandler&&)
+  ///
+  /// @note Only available if using Boost.Filesystem
+  /// (i.e. if @c ASIOEXT_HAS_BOOST_FILESYSTEM is defined)
+  template <typename OpenHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(OpenHandler, void (error_code))
+  async_open(const boost::filesystem::path& filename, const open_args& args,
+             OpenHandler&& handler)
+  {
+    return holder_.get_service().async_open(holder_.get_implementation(),
+        filename, args, std::forward<OpenHandler>(handler));
+  }
+#endif
+
+  /// @brief Start an asynchronous operation to close the handle.
+  ///
+  /// This function is used to asynchronously close the handle, without
+  /// blocking the calling thread (closing a file can e.g. flush data to
+  /// a network file system). The function call always returns immediately.
+  ///
+  /// The handle is detached from this object right away, so is_open()
+  /// returns @c false and the object can be re-opened before the handler
+  /// has been called.
+  ///
+  /// @param handler The handler to be called when the close operation
+  /// completes. Copies will be made of the handler as required.
+  /// The function signature of the handler must be:
+  /// @code void handler(
+  ///   const error_code& error // Result of operation.
+  /// ); @endcode
+  /// Regardless of whether the asynchronous operation completes immediately or
+  /// not, the handler will not be invoked from within this function. Invocation
+  /// of the handler will be performed in a manner equivalent to using
+  /// asio::io_context::post().
+  template <typename CloseHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(CloseHandler, void (error_code))
+  async_close(CloseHandler&& handler)
+  {
+    return holder_.get_service().async_close(holder_.get_implementation(),
+        std::forward<CloseHandler>(handler));
+  }
+
   /// @}
 
   /// @name File pointer functions
@@ -771,6 +898,317 @@ public:
     holder_.get_service().times(holder_.get_implementation(), new_times, ec);
   }
 
+  /// @copydoc file_handle::query(file_info_mask)
+  file_info query(file_info_mask mask = file_info_mask::all)
+  {
+    error_code ec;
+    file_info info = holder_.get_service().query(
+        holder_.get_implementation(), mask, ec);
+    detail::throw_error(ec, "query");
+    return info;
+  }
+
+  /// @copydoc file_handle::query(file_info_mask,error_code&)
+  file_info query(file_info_mask mask, error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    return holder_.get_service().query(holder_.get_implementation(),
+                                       mask, ec);
+  }
+
+  /// @}
+
+  /// @name Locking functions
+  /// @{
+
+  /// @copydoc file_handle::lock(const file_range&,lock_type)
+  void lock(const file_range& range, lock_type type)
+  {
+    error_code ec;
+    holder_.get_service().lock(holder_.get_implementation(), range, type, ec);
+    detail::throw_error(ec, "lock");
+  }
+
+  /// @copydoc file_handle::lock(const file_range&,lock_type,error_code&)
+  void lock(const file_range& range, lock_type type,
+            error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    holder_.get_service().lock(holder_.get_implementation(), range, type, ec);
+  }
+
+  /// @copydoc file_handle::try_lock(const file_range&,lock_type)
+  bool try_lock(const file_range& range, lock_type type)
+  {
+    error_code ec;
+    const bool locked = holder_.get_service().try_lock(
+        holder_.get_implementation(), range, type, ec);
+    detail::throw_error(ec, "try_lock");
+    return locked;
+  }
+
+  /// @copydoc file_handle::try_lock(const file_range&,lock_type,error_code&)
+  bool try_lock(const file_range& range, lock_type type,
+                error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    return holder_.get_service().try_lock(holder_.get_implementation(),
+                                          range, type, ec);
+  }
+
+  /// @copydoc file_handle::unlock(const file_range&)
+  void unlock(const file_range& range)
+  {
+    error_code ec;
+    holder_.get_service().unlock(holder_.get_implementation(), range, ec);
+    detail::throw_error(ec, "unlock");
+  }
+
+  /// @copydoc file_handle::unlock(const file_range&,error_code&)
+  void unlock(const file_range& range, error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    holder_.get_service().unlock(holder_.get_implementation(), range, ec);
+  }
+
+  /// @brief Start an asynchronous operation to lock a range of the file.
+  ///
+  /// This function is used to asynchronously acquire a lock on @c range.
+  /// The wait happens on a thread of the service's pool, so the calling
+  /// thread and the io_context aren't blocked. Note however that the pool
+  /// thread is occupied until the lock has been acquired.
+  ///
+  /// Since a pending lock request can't be interrupted, cancel() only
+  /// affects operations that haven't started waiting yet.
+  ///
+  /// The lock can be released using unlock() (or managed by a
+  /// @ref file_lock_guard constructed with @c std::adopt_lock).
+  ///
+  /// @param range The range to lock.
+  ///
+  /// @param type The kind of lock to acquire.
+  ///
+  /// @param handler The handler to be called when the operation completes.
+  /// Copies will be made of the handler as required. The function signature of
+  /// the handler must be:
+  /// @code void handler(
+  ///   const error_code& error // Result of operation.
+  /// ); @endcode
+  ///
+  /// @see lock(const file_range&,lock_type)
+  template <typename LockHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(LockHandler, void (error_code))
+  async_lock(const file_range& range, lock_type type, LockHandler&& handler)
+  {
+    return holder_.get_service().async_lock(holder_.get_implementation(),
+        range, type, std::forward<LockHandler>(handler));
+  }
+
+  /// @}
+
+  /// @name Asynchronous metadata functions
+  ///
+  /// These functions perform the same operations as their synchronous
+  /// counterparts, but without blocking the calling thread. This matters
+  /// on e.g. network file systems, where a metadata request can easily
+  /// take hundreds of milliseconds.
+  ///
+  /// Regardless of whether the asynchronous operation completes immediately
+  /// or not, the handler will not be invoked from within these functions.
+  /// Invocation of the handler will be performed in a manner equivalent to
+  /// using asio::io_context::post().
+  /// @{
+
+  /// @brief Start an asynchronous operation to get the size of the file.
+  ///
+  /// @param handler The handler to be called when the operation completes.
+  /// Copies will be made of the handler as required. The function signature of
+  /// the handler must be:
+  /// @code void handler(
+  ///   const error_code& error, // Result of operation.
+  ///   uint64_t size // The total number of bytes in this file.
+  /// ); @endcode
+  ///
+  /// @see size()
+  template <typename SizeHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(SizeHandler, void (error_code, uint64_t))
+  async_size(SizeHandler&& handler)
+  {
+    return holder_.get_service().async_size(holder_.get_implementation(),
+        std::forward<SizeHandler>(handler));
+  }
+
+  /// @brief Start an asynchronous operation to truncate or extend the file.
+  ///
+  /// @param new_size The new size of the file, in bytes.
+  ///
+  /// @param handler The handler to be called when the operation completes.
+  /// Copies will be made of the handler as required. The function signature of
+  /// the handler must be:
+  /// @code void handler(
+  ///   const error_code& error // Result of operation.
+  /// ); @endcode
+  ///
+  /// @see truncate()
+  template <typename TruncateHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(TruncateHandler, void (error_code))
+  async_truncate(uint64_t new_size, TruncateHandler&& handler)
+  {
+    return holder_.get_service().async_truncate(holder_.get_implementation(),
+        new_size, std::forward<TruncateHandler>(handler));
+  }
+
+  /// @brief Start an asynchronous operation to get the file's permissions.
+  ///
+  /// @param handler The handler to be called when the operation completes.
+  /// Copies will be made of the handler as required. The function signature of
+  /// the handler must be:
+  /// @code void handler(
+  ///   const error_code& error, // Result of operation.
+  ///   file_perms perms // The file's access permissions.
+  /// ); @endcode
+  ///
+  /// @see permissions()
+  template <typename PermissionsHandler>
+  ASIOEXT_WINDOWS_NO_HANDLEINFO_WARNING
+  ASIOEXT_INITFN_RESULT_TYPE(PermissionsHandler, void (error_code, file_perms))
+  async_permissions(PermissionsHandler&& handler)
+  {
+    return holder_.get_service().async_permissions(
+        holder_.get_implementation(),
+        std::forward<PermissionsHandler>(handler));
+  }
+
+  /// @brief Start an asynchronous operation to change the file's permissions.
+  ///
+  /// @param perms The permissions to add, remove or replace.
+  ///
+  /// @param opts Options controlling whether @c perms are added, removed
+  /// or replace the current permissions.
+  ///
+  /// @param handler The handler to be called when the operation completes.
+  /// Copies will be made of the handler as required. The function signature of
+  /// the handler must be:
+  /// @code void handler(
+  ///   const error_code& error // Result of operation.
+  /// ); @endcode
+  ///
+  /// @see permissions(file_perms,file_perm_options)
+  template <typename PermissionsHandler>
+  ASIOEXT_WINDOWS_NO_HANDLEINFO_WARNING
+  ASIOEXT_INITFN_RESULT_TYPE(PermissionsHandler, void (error_code))
+  async_permissions(file_perms perms, file_perm_options opts,
+                    PermissionsHandler&& handler)
+  {
+    return holder_.get_service().async_permissions(
+        holder_.get_implementation(), perms, opts,
+        std::forward<PermissionsHandler>(handler));
+  }
+
+  /// @brief Start an asynchronous operation to get the file's attributes.
+  ///
+  /// @param handler The handler to be called when the operation completes.
+  /// Copies will be made of the handler as required. The function signature of
+  /// the handler must be:
+  /// @code void handler(
+  ///   const error_code& error, // Result of operation.
+  ///   file_attrs attrs // The file's attributes.
+  /// ); @endcode
+  ///
+  /// @see attributes()
+  template <typename AttributesHandler>
+  ASIOEXT_WINDOWS_NO_HANDLEINFO_WARNING
+  ASIOEXT_INITFN_RESULT_TYPE(AttributesHandler, void (error_code, file_attrs))
+  async_attributes(AttributesHandler&& handler)
+  {
+    return holder_.get_service().async_attributes(
+        holder_.get_implementation(),
+        std::forward<AttributesHandler>(handler));
+  }
+
+  /// @brief Start an asynchronous operation to change the file's attributes.
+  ///
+  /// @param attrs The attributes to add, remove or replace.
+  ///
+  /// @param opts Options controlling whether @c attrs are added, removed
+  /// or replace the current attributes.
+  ///
+  /// @param handler The handler to be called when the operation completes.
+  /// Copies will be made of the handler as required. The function signature of
+  /// the handler must be:
+  /// @code void handler(
+  ///   const error_code& error // Result of operation.
+  /// ); @endcode
+  ///
+  /// @see attributes(file_attrs,file_attr_options)
+  template <typename AttributesHandler>
+  ASIOEXT_WINDOWS_NO_HANDLEINFO_WARNING
+  ASIOEXT_INITFN_RESULT_TYPE(AttributesHandler, void (error_code))
+  async_attributes(file_attrs attrs, file_attr_options opts,
+                   AttributesHandler&& handler)
+  {
+    return holder_.get_service().async_attributes(
+        holder_.get_implementation(), attrs, opts,
+        std::forward<AttributesHandler>(handler));
+  }
+
+  /// @brief Start an asynchronous operation to get the file's time data.
+  ///
+  /// @param handler The handler to be called when the operation completes.
+  /// Copies will be made of the handler as required. The function signature of
+  /// the handler must be:
+  /// @code void handler(
+  ///   const error_code& error, // Result of operation.
+  ///   file_times times // The file's time data.
+  /// ); @endcode
+  ///
+  /// @see times()
+  template <typename TimesHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(TimesHandler, void (error_code, file_times))
+  async_times(TimesHandler&& handler)
+  {
+    return holder_.get_service().async_times(holder_.get_implementation(),
+        std::forward<TimesHandler>(handler));
+  }
+
+  /// @brief Start an asynchronous operation to change the file's time data.
+  ///
+  /// @param new_times The new file times. Zero values are ignored.
+  ///
+  /// @param handler The handler to be called when the operation completes.
+  /// Copies will be made of the handler as required. The function signature of
+  /// the handler must be:
+  /// @code void handler(
+  ///   const error_code& error // Result of operation.
+  /// ); @endcode
+  ///
+  /// @see times(const file_times&)
+  template <typename TimesHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(TimesHandler, void (error_code))
+  async_times(const file_times& new_times, TimesHandler&& handler)
+  {
+    return holder_.get_service().async_times(holder_.get_implementation(),
+        new_times, std::forward<TimesHandler>(handler));
+  }
+
+  /// @brief Start an asynchronous operation to get a snapshot of the
+  /// file's metadata.
+  ///
+  /// @param mask The members of @c file_info to retrieve.
+  ///
+  /// @param handler The handler to be called when the operation completes.
+  /// Copies will be made of the handler as required. The function signature of
+  /// the handler must be:
+  /// @code void handler(
+  ///   const error_code& error, // Result of operation.
+  ///   file_info info // The file's metadata.
+  /// ); @endcode
+  ///
+  /// @see query()
+  template <typename QueryHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(QueryHandler, void (error_code, file_info))
+  async_query(file_info_mask mask, QueryHandler&& handler)
+  {
+    return holder_.get_service().async_query(holder_.get_implementation(),
+        mask, std::forward<QueryHandler>(handler));
+  }
+
   /// @}
 
   /// @name SyncReadStream functions
@@ -0,0 +1,289 @@
+/// @file
+/// Defines the buffer_pool class and the buffer_pool_allocator class template.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_BUFFERPOOL_HPP
+#define ASIOEXT_BUFFERPOOL_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/detail/cstdint.hpp"
+#include "asioext/detail/service_base.hpp"
+#include "asioext/detail/throw_exception.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/io_context.hpp>
+#else
+# include <asio/io_context.hpp>
+#endif
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup core
+/// @brief Counters describing the state of a @c buffer_pool.
+struct buffer_pool_statistics
+{
+  /// Number of allocations.
+  uint64_t allocations;
+
+  /// Number of allocations that were served from the pool.
+  uint64_t hits;
+
+  /// Number of blocks that were returned to the heap (instead of being kept
+  /// in the pool), because they were too large or the pool was full.
+  uint64_t releases;
+
+  /// Number of blocks currently kept in the pool.
+  std::size_t cached_blocks;
+
+  /// Total size of all blocks currently kept in the pool, in bytes.
+  std::size_t cached_bytes;
+};
+
+/// @ingroup core
+/// @brief Keeps freed memory blocks around for reuse.
+///
+/// Blocks are grouped into size classes (powers of two from
+/// @c min_block_size to @c max_block_size bytes). Freed blocks are put on
+/// their class' free list, so that the next allocation of that class doesn't
+/// have to go to the heap. Larger blocks aren't pooled at all.
+///
+/// The pool holds on to at most @c max_cached_bytes bytes. Blocks freed beyond
+/// that limit are returned to the heap.
+///
+/// @note buffer_pool objects aren't thread-safe. Use one pool per thread
+/// (see @ref thread_local_pool) or per single-threaded io_context
+/// (see @ref buffer_pool_service).
+class buffer_pool
+{
+public:
+  /// The smallest block size handed out by the pool.
+  static const std::size_t min_block_size = 64;
+
+  /// The largest block size that is kept in the pool.
+  static const std::size_t max_block_size = 1024 * 1024;
+
+  /// The default maximum number of bytes the pool keeps.
+  static const std::size_t default_max_cached_bytes = 4 * 1024 * 1024;
+
+  /// @brief Construct an empty buffer_pool.
+  ///
+  /// @param max_cached_bytes The maximum number of bytes the pool may keep.
+  ASIOEXT_DECL explicit buffer_pool(
+      std::size_t max_cached_bytes = default_max_cached_bytes) ASIOEXT_NOEXCEPT;
+
+  /// @brief Destroy the buffer_pool.
+  ///
+  /// Returns all cached blocks to the heap.
+  ///
+  /// @warning All blocks allocated from the pool must have been deallocated
+  /// before, as deallocating a block returns it to the pool. This includes
+  /// blocks held by containers using a @ref buffer_pool_allocator bound to
+  /// the pool. Debug builds check this with an assertion. The
+  /// @ref thread_local_pool is exempt, as blocks always go to the
+  /// pool of the thread they're deallocated on.
+  ASIOEXT_DECL ~buffer_pool();
+
+  /// @brief Allocate a block of at least @c n bytes.
+  ///
+  /// @throws std::bad_alloc Thrown if no memory is available.
+  ASIOEXT_DECL void* allocate(std::size_t n);
+
+  /// @brief Deallocate a block obtained by @ref allocate.
+  ///
+  /// @param p The block to deallocate.
+  /// @param n The size that was passed to @ref allocate.
+  ASIOEXT_DECL void deallocate(void* p, std::size_t n) ASIOEXT_NOEXCEPT;
+
+  /// @brief Return all cached blocks to the heap.
+  ASIOEXT_DECL void trim() ASIOEXT_NOEXCEPT;
+
+  /// @brief Get the maximum number of bytes the pool keeps.
+  std::size_t max_cached_bytes() const ASIOEXT_NOEXCEPT
+  {
+    return max_cached_bytes_;
+  }
+
+  /// @brief Get the pool's counters.
+  buffer_pool_statistics statistics() const ASIOEXT_NOEXCEPT
+  {
+    return stats_;
+  }
+
+  /// @brief Get the calling thread's pool.
+  ///
+  /// The pool is created on first use and destroyed when the thread exits.
+  ASIOEXT_DECL static buffer_pool& thread_local_pool();
+
+private:
+  buffer_pool(const buffer_pool&) ASIOEXT_DELETED;
+  buffer_pool& operator=(const buffer_pool&) ASIOEXT_DELETED;
+
+  ASIOEXT_DECL buffer_pool(std::size_t max_cached_bytes,
+                           bool check_outstanding) ASIOEXT_NOEXCEPT;
+
+  struct free_block
+  {
+    free_block* next;
+  };
+
+  // 64, 128, ..., 1 MiB
+  static const std::size_t num_classes = 15;
+
+  free_block* free_lists_[num_classes];
+  std::size_t max_cached_bytes_;
+  buffer_pool_statistics stats_;
+  // Blocks that have been allocated, but not deallocated yet.
+  std::size_t outstanding_;
+  bool check_outstanding_;
+};
+
+/// @ingroup core
+/// @brief Associates a @c buffer_pool with an io_context.
+///
+/// If an io_context is only ever run by a single thread, all buffers
+/// allocated through its pool stay on that thread.
+///
+/// The pool is destroyed along with the io_context, so all of its blocks
+/// have to be deallocated before (see @ref buffer_pool::~buffer_pool).
+///
+/// @code
+/// asioext::buffer_pool& pool =
+///     asio::use_service<asioext::buffer_pool_service>(io_context).pool();
+/// @endcode
+class buffer_pool_service
+#if !defined(ASIOEXT_IS_DOCUMENTATION)
+  : public asioext::detail::io_context_service_base<buffer_pool_service>
+#else
+  : public asio::io_context::service
+#endif
+{
+public:
+#if defined(ASIOEXT_IS_DOCUMENTATION)
+  /// The unique service identifier.
+  static asio::io_context::id id;
+#endif
+
+  /// Construct a new buffer pool service for the specified io_context.
+  ASIOEXT_DECL explicit buffer_pool_service(asio::io_context& owner);
+
+  /// Return all cached blocks to the heap.
+  ASIOEXT_DECL void shutdown_service();
+
+  /// Get the io_context's pool.
+  buffer_pool& pool() ASIOEXT_NOEXCEPT
+  {
+    return pool_;
+  }
+
+private:
+  buffer_pool pool_;
+};
+
+/// @ingroup core
+/// @brief Allocator that gets its memory from a @c buffer_pool.
+///
+/// Suitable as the @c Allocator of @c basic_linear_buffer,
+/// @c basic_chained_buffer and @c buffered_stream.
+///
+/// A default-constructed allocator uses the pool of the thread it is
+/// used on (see @ref buffer_pool::thread_local_pool). Blocks freed on
+/// a different thread than they were allocated on end up in that thread's
+/// pool.
+template <typename T>
+class buffer_pool_allocator
+{
+public:
+  typedef T value_type;
+
+  template <typename U>
+  struct rebind { typedef buffer_pool_allocator<U> other; };
+
+  /// @brief Construct an allocator using the calling thread's pool.
+  buffer_pool_allocator() ASIOEXT_NOEXCEPT
+    : pool_(nullptr)
+  {}
+
+  /// @brief Construct an allocator using the given pool.
+  explicit buffer_pool_allocator(buffer_pool& pool) ASIOEXT_NOEXCEPT
+    : pool_(&pool)
+  {}
+
+  /// @brief Construct an allocator using the pool of an io_context.
+  ///
+  /// @see buffer_pool_service
+  explicit buffer_pool_allocator(asio::io_context& io_context)
+    : pool_(&asio::use_service<buffer_pool_service>(io_context).pool())
+  {}
+
+  template <typename U>
+  buffer_pool_allocator(const buffer_pool_allocator<U>& other) ASIOEXT_NOEXCEPT
+    : pool_(other.pool_)
+  {}
+
+  /// @brief Get the pool memory comes from, or @c nullptr if the calling
+  /// thread's pool is used.
+  buffer_pool* pool() const ASIOEXT_NOEXCEPT
+  {
+    return pool_;
+  }
+
+  T* allocate(std::size_t n)
+  {
+    if (n > (std::numeric_limits<std::size_t>::max)() / sizeof(T)) {
+      std::bad_alloc ex;
+      detail::throw_exception(ex);
+    }
+    return static_cast<T*>(get_pool().allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    get_pool().deallocate(p, n * sizeof(T));
+  }
+
+private:
+  template <typename U>
+  friend class buffer_pool_allocator;
+
+  buffer_pool& get_pool() const ASIOEXT_NOEXCEPT
+  {
+    return pool_ ? *pool_ : buffer_pool::thread_local_pool();
+  }
+
+  buffer_pool* pool_;
+};
+
+template <typename T, typename U>
+inline bool operator==(const buffer_pool_allocator<T>& a,
+                       const buffer_pool_allocator<U>& b) ASIOEXT_NOEXCEPT
+{
+  return a.pool() == b.pool();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const buffer_pool_allocator<T>& a,
+                       const buffer_pool_allocator<U>& b) ASIOEXT_NOEXCEPT
+{
+  return a.pool() != b.pool();
+}
+
+ASIOEXT_NS_END
+
+#if defined(ASIOEXT_HEADER_ONLY)
+# include "asioext/impl/buffer_pool.cpp"
+#endif
+
+#endif
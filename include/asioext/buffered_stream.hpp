@@ -0,0 +1,1439 @@
+/// @file
+/// Defines the buffered_stream class
+///
+/// @copyright Copyright (c) 2019 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_BUFFEREDSTREAM_HPP
+#define ASIOEXT_BUFFEREDSTREAM_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/linear_buffer.hpp"
+#include "asioext/error_code.hpp"
+#include "asioext/is_raw_byte_container.hpp"
+#include "asioext/async_result.hpp"
+#include "asioext/compose.hpp"
+#include "asioext/bind_handler.hpp"
+
+#include "asioext/detail/find_delimiter.hpp"
+#include "asioext/detail/throw_error.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/associated_executor.hpp>
+# include <boost/asio/buffers_iterator.hpp>
+# include <boost/asio/read.hpp>
+# include <boost/asio/write.hpp>
+# include <boost/asio/post.hpp>
+# include <boost/asio/steady_timer.hpp>
+#else
+# include <asio/associated_executor.hpp>
+# include <asio/buffers_iterator.hpp>
+# include <asio/read.hpp>
+# include <asio/write.hpp>
+# include <asio/post.hpp>
+# include <asio/steady_timer.hpp>
+#endif
+
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup net
+/// @brief Controls when a @c buffered_stream flushes on its own.
+///
+/// Automatic flushes are triggered by @ref buffered_stream::write,
+/// @ref buffered_stream::async_write_some and @ref buffered_stream::enqueue.
+/// By default, there are none, except for the flush before a read.
+struct auto_flush_options
+{
+  /// @brief Flush as soon as this many bytes are pending.
+  std::size_t high_water_mark = (std::numeric_limits<std::size_t>::max)();
+
+  /// @brief Flush pending data at the latest this long after it was written.
+  ///
+  /// Writes within this window are coalesced into a single flush, similar to
+  /// Nagle's algorithm. Zero disables the timer.
+  std::chrono::steady_clock::duration max_delay =
+      std::chrono::steady_clock::duration::zero();
+};
+
+/// @ingroup net
+/// @brief Adds read and write buffers to a stream.
+///
+/// Besides writing into @ref write_buffer, payloads that already exist
+/// somewhere else (file chunks, shared blobs, ...) can be queued with
+/// @ref enqueue. They are written in place, together with the buffered data,
+/// using as few (vectored) write operations as possible. Payloads smaller
+/// than @ref coalesce_limit are copied into the write buffer instead, since
+/// copying them is cheaper than an additional I/O vector entry.
+///
+/// Data can be flushed explicitly, or automatically as configured by
+/// @ref set_auto_flush. Automatic flushes are asynchronous, so they need
+/// the stream's executor to be run, and the stream has to outlive them.
+/// Their errors are reported by the next @ref write.
+///
+/// Unless the stream is @ref corked, pending data is also flushed whenever
+/// a read has to wait for the next layer, since the peer might only answer
+/// once it has seen that data. Synchronous reads flush synchronously,
+/// asynchronous ones start an automatic flush.
+///
+/// @ref read_some, @ref write_some and their asynchronous counterparts make
+/// the stream a SyncReadStream, SyncWriteStream, AsyncReadStream and
+/// AsyncWriteStream, so it can be used with @c asio::read, @c asio::write
+/// and friends, or below other layers such as @c asio::ssl::stream.
+/// Requests of at least @ref read_bypass_limit bytes are read directly into
+/// the caller's buffers once the read buffer is empty, instead of going
+/// through the read buffer. Writes are always copied into the write buffer.
+/// They're sent before the next read, once the @c high_water_mark of the
+/// @ref auto_flush_options is reached, or when the stream is flushed, so
+/// the stream has to be flushed if the upper layers are done writing but
+/// don't read:
+///
+/// @code
+/// asioext::buffered_stream<asio::ip::tcp::socket> buffered(ctx);
+/// asio::ssl::stream<asioext::buffered_stream<asio::ip::tcp::socket>&>
+///     tls(buffered, ssl_ctx);
+///
+/// // The handshake's messages are flushed before waiting for the answers.
+/// tls.handshake(asio::ssl::stream_base::client);
+///
+/// // Many small records, written in one go.
+/// for (const std::string& line : lines)
+///   asio::write(tls, asio::buffer(line));
+/// buffered.flush();
+/// @endcode
+///
+/// @tparam Buffer The type of the buffers, which must be constructible
+/// like @c basic_linear_buffer and usable with @c dynamic_buffer().
+/// For large payloads, @c basic_chained_buffer avoids the copies
+/// a contiguous buffer needs when growing.
+template <typename Stream, typename Allocator = std::allocator<uint8_t>,
+          typename Buffer = basic_linear_buffer<Allocator>>
+class buffered_stream
+{
+public:
+  /// The type of the next layer.
+  typedef typename std::remove_reference<Stream>::type next_layer_type;
+
+  /// The type of the lowest layer.
+  typedef typename next_layer_type::lowest_layer_type lowest_layer_type;
+
+  /// The type of the executor associated with the object.
+  typedef typename lowest_layer_type::executor_type executor_type;
+
+  typedef Buffer buffer_type;
+
+  /// Construct, passing the specified argument to initialise the next layer.
+  template <typename Arg>
+  explicit buffered_stream(
+      Arg&& a, std::size_t max_write_size = (std::numeric_limits<std::size_t>::max)(),
+      std::size_t max_read_size = (std::numeric_limits<std::size_t>::max)())
+    : stream_(std::forward<Arg>(a))
+    , write_buffer_(0, max_write_size)
+    , write_buffer_locked_(0, max_write_size)
+    , read_buffer_(0, max_read_size)
+    , coalesce_limit_(default_coalesce_limit)
+    , read_bypass_limit_(default_read_bypass_limit)
+    , timer_(stream_.lowest_layer().get_executor())
+    , flush_wait_(stream_.lowest_layer().get_executor(),
+                  asio::steady_timer::time_point::max())
+  {}
+
+  /// Construct, passing the specified argument to initialise the next layer.
+  template <typename Arg>
+  buffered_stream(
+      Arg&& a, const Allocator& allocator,
+      std::size_t max_write_size = (std::numeric_limits<std::size_t>::max)(),
+      std::size_t max_read_size = (std::numeric_limits<std::size_t>::max)())
+    : stream_(std::forward<Arg>(a))
+    , write_buffer_(allocator, 0, max_write_size)
+    , write_buffer_locked_(allocator, 0, max_write_size)
+    , read_buffer_(allocator, 0, max_read_size)
+    , write_queue_(allocator)
+    , write_queue_locked_(allocator)
+    , coalesce_limit_(default_coalesce_limit)
+    , read_bypass_limit_(default_read_bypass_limit)
+    , timer_(stream_.lowest_layer().get_executor())
+    , flush_wait_(stream_.lowest_layer().get_executor(),
+                  asio::steady_timer::time_point::max())
+  {}
+
+  /// Get a reference to the next layer.
+  next_layer_type& next_layer() ASIOEXT_NOEXCEPT
+  {
+    return stream_;
+  }
+
+  /// Get a reference to the lowest layer.
+  lowest_layer_type& lowest_layer() ASIOEXT_NOEXCEPT
+  {
+    return stream_.lowest_layer();
+  }
+
+  /// Get a const reference to the lowest layer.
+  const lowest_layer_type& lowest_layer() const ASIOEXT_NOEXCEPT
+  {
+    return stream_.lowest_layer();
+  }
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() ASIOEXT_NOEXCEPT
+  {
+    return stream_.lowest_layer().get_executor();
+  }
+
+  /// Close the stream.
+  ///
+  /// Pending automatic flushes are cancelled, and a pending
+  /// @ref async_write_some completes with @c asio::error::operation_aborted.
+  void close()
+  {
+    clear_buffers();
+    stream_.close();
+  }
+
+  /// Close the stream.
+  void close(error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    clear_buffers();
+    stream_.close(ec);
+  }
+
+  buffer_type& write_buffer() ASIOEXT_NOEXCEPT
+  {
+    return write_buffer_;
+  }
+
+  const buffer_type& write_buffer() const ASIOEXT_NOEXCEPT
+  {
+    return write_buffer_;
+  }
+
+  /// @brief Queue a buffer to be written without copying it.
+  ///
+  /// The data is written after everything that was written to
+  /// @ref write_buffer (or enqueued) before. @c owner keeps the memory
+  /// @c data refers to alive until it has been written.
+  ///
+  /// @note The memory must not be modified until it has been written.
+  ///
+  /// @throws asio::system_error Thrown on failure. If there isn't enough
+  /// space in the write buffer (see @ref pending_write_size), the error is
+  /// @c asio::error::no_buffer_space and nothing is enqueued.
+  void enqueue(asio::const_buffer data, std::shared_ptr<const void> owner)
+  {
+    error_code ec;
+    enqueue(data, std::move(owner), ec);
+    detail::throw_error(ec, "enqueue");
+  }
+
+  /// @brief Queue a buffer to be written without copying it.
+  ///
+  /// The data is written after everything that was written to
+  /// @ref write_buffer (or enqueued) before. @c owner keeps the memory
+  /// @c data refers to alive until it has been written.
+  ///
+  /// @note The memory must not be modified until it has been written.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset. If there isn't enough space in the write buffer
+  /// (see @ref pending_write_size), this is @c asio::error::no_buffer_space
+  /// and nothing is enqueued. The error of a failed automatic flush is
+  /// reported here as well.
+  void enqueue(asio::const_buffer data, std::shared_ptr<const void> owner,
+               error_code& ec);
+
+  /// @brief Queue a container to be written without copying it.
+  ///
+  /// The container is moved into the stream, which keeps it until
+  /// its contents have been written. Lvalues are rejected, since they
+  /// would have to be copied; use @ref write for those.
+  ///
+  /// @tparam RawByteContainer A type satisfying the
+  /// @ref concept-RawByteContainer requirements.
+  ///
+  /// @throws asio::system_error Thrown on failure. If there isn't enough
+  /// space in the write buffer (see @ref pending_write_size), the error is
+  /// @c asio::error::no_buffer_space and the container is left untouched.
+  template <typename RawByteContainer>
+  typename std::enable_if<is_raw_byte_container<
+      typename std::decay<RawByteContainer>::type>::value>::type
+  enqueue(RawByteContainer&& data)
+  {
+    static_assert(!std::is_lvalue_reference<RawByteContainer>::value,
+                  "enqueue() needs an rvalue, use write() to copy");
+    error_code ec;
+    enqueue(std::forward<RawByteContainer>(data), ec);
+    detail::throw_error(ec, "enqueue");
+  }
+
+  /// @brief Queue a container to be written without copying it.
+  ///
+  /// The container is moved into the stream, which keeps it until
+  /// its contents have been written. Lvalues are rejected, since they
+  /// would have to be copied; use @ref write for those.
+  ///
+  /// @tparam RawByteContainer A type satisfying the
+  /// @ref concept-RawByteContainer requirements.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset. If there isn't enough space in the write buffer
+  /// (see @ref pending_write_size), this is @c asio::error::no_buffer_space
+  /// and the container is left untouched. The error of a failed automatic
+  /// flush is reported here as well.
+  template <typename RawByteContainer>
+  typename std::enable_if<is_raw_byte_container<
+      typename std::decay<RawByteContainer>::type>::value>::type
+  enqueue(RawByteContainer&& data, error_code& ec);
+
+  /// @brief Get the size below which enqueued data is copied.
+  std::size_t coalesce_limit() const ASIOEXT_NOEXCEPT
+  {
+    return coalesce_limit_;
+  }
+
+  /// @brief Set the size below which enqueued data is copied.
+  ///
+  /// Enqueued buffers smaller than this are copied into the write buffer,
+  /// rather than written in place. Defaults to 512 bytes.
+  void set_coalesce_limit(std::size_t limit) ASIOEXT_NOEXCEPT
+  {
+    coalesce_limit_ = limit;
+  }
+
+  /// @brief Write data to the write buffer.
+  ///
+  /// This function copies all of the given data to the write buffer,
+  /// which might trigger an automatic flush.
+  ///
+  /// @returns The number of bytes written.
+  ///
+  /// @throws asio::system_error Thrown on failure. If there isn't enough
+  /// space in the write buffer (see @ref pending_write_size), the error is
+  /// @c asio::error::no_buffer_space and nothing is written.
+  template <typename ConstBufferSequence>
+  std::size_t write(const ConstBufferSequence& buffers)
+  {
+    error_code ec;
+    const std::size_t s = write(buffers, ec);
+    detail::throw_error(ec, "write");
+    return s;
+  }
+
+  /// @brief Write data to the write buffer.
+  ///
+  /// This function copies all of the given data to the write buffer,
+  /// which might trigger an automatic flush.
+  ///
+  /// @returns The number of bytes written.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset. If there isn't enough space in the write buffer
+  /// (see @ref pending_write_size), this is @c asio::error::no_buffer_space
+  /// and nothing is written. The error of a failed automatic flush is
+  /// reported here as well.
+  template <typename ConstBufferSequence>
+  std::size_t write(const ConstBufferSequence& buffers, error_code& ec);
+
+  /// @brief Write some data to the stream.
+  ///
+  /// This function copies as much of the given data as fits into
+  /// the write buffer. If the pending data has reached the
+  /// @c high_water_mark of the @ref auto_flush_options (unless
+  /// @ref corked), or the write buffer is full, it is flushed first.
+  /// The function call will block until that flush completes.
+  ///
+  /// If an automatic flush is in progress, the data is only copied, as
+  /// this function can't wait for it. If none of it fits, the error is
+  /// @c asio::error::would_block.
+  ///
+  /// @returns The number of bytes written.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers)
+  {
+    error_code ec;
+    const std::size_t s = write_some(buffers, ec);
+    detail::throw_error(ec, "write_some");
+    return s;
+  }
+
+  /// @brief Write some data to the stream.
+  ///
+  /// This function copies as much of the given data as fits into
+  /// the write buffer. If the pending data has reached the
+  /// @c high_water_mark of the @ref auto_flush_options (unless
+  /// @ref corked), or the write buffer is full, it is flushed first.
+  /// The function call will block until that flush completes.
+  ///
+  /// If an automatic flush is in progress, the data is only copied, as
+  /// this function can't wait for it. If none of it fits, the error is
+  /// @c asio::error::would_block.
+  ///
+  /// @returns The number of bytes written, or 0 if an error occurred.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers,
+                         error_code& ec);
+
+  /// @brief Asynchronously write some data to the stream.
+  ///
+  /// This function copies as much of the given data as fits into
+  /// the write buffer, which might trigger an automatic flush.
+  /// If the pending data has reached the @c high_water_mark of the
+  /// @ref auto_flush_options (unless @ref corked), or the write buffer is
+  /// full, the operation waits for that data to be flushed first. This
+  /// throttles writers that are faster than the next layer.
+  ///
+  /// @param buffers The data to write. Ownership is retained by the
+  /// caller, which must guarantee that it remains valid until the handler
+  /// is called.
+  ///
+  /// @param handler The handler to be called when the write operation
+  /// completes. The function signature of the handler must be:
+  /// @code void handler(
+  ///   const error_code& error, // Result of operation.
+  ///   std::size_t bytes_transferred // Number of bytes written.
+  /// ); @endcode
+  /// Regardless of whether the asynchronous operation completes immediately or
+  /// not, the handler will not be invoked from within this function. Invocation
+  /// of the handler will be performed in a manner equivalent to using
+  /// asio::io_context::post().
+  ///
+  /// @warning Starting multiple asynchronous writes is not allowed.
+  template <typename ConstBufferSequence, typename WriteHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(WriteHandler, void (error_code, std::size_t))
+  async_write_some(const ConstBufferSequence& buffers,
+                   WriteHandler&& handler);
+
+  /// @brief Get the number of bytes that wait for the next flush.
+  ///
+  /// This includes enqueued buffers, but not the data of a flush that's
+  /// still in progress. @ref write and @ref enqueue fail if this would
+  /// exceed the write buffer's maximum size.
+  std::size_t pending_write_size() const ASIOEXT_NOEXCEPT
+  {
+    return write_buffer_.size() + write_queue_size_;
+  }
+
+  /// @brief Set the options for automatic flushes.
+  ///
+  /// @note Automatic flushes start asynchronous flushes, so
+  /// @ref async_flush may fail with @c asio::error::already_started if
+  /// they're enabled, or while an asynchronous read is pending.
+  void set_auto_flush(const auto_flush_options& options)
+  {
+    auto_flush_ = options;
+    check_auto_flush();
+  }
+
+  /// @brief Get the options for automatic flushes.
+  const auto_flush_options& auto_flush() const ASIOEXT_NOEXCEPT
+  {
+    return auto_flush_;
+  }
+
+  /// @brief Suppress automatic flushes until @ref uncork is called.
+  ///
+  /// Explicit flushes are still possible.
+  void cork() ASIOEXT_NOEXCEPT
+  {
+    corked_ = true;
+  }
+
+  /// @brief Allow automatic flushes again and flush all pending data.
+  void uncork()
+  {
+    corked_ = false;
+    if (pending_write_size() != 0)
+      start_auto_flush();
+  }
+
+  /// @brief Check whether automatic flushes are suppressed.
+  bool corked() const ASIOEXT_NOEXCEPT
+  {
+    return corked_;
+  }
+
+  bool can_flush() const ASIOEXT_NOEXCEPT
+  {
+    return !flush_pending_ &&
+           (!write_buffer_.empty() || !write_queue_.empty());
+  }
+
+  bool flush_pending() const ASIOEXT_NOEXCEPT { return flush_pending_; }
+
+  /// @brief Flush all data from the buffer to the next layer.
+  ///
+  /// This function tries to write all buffered data to the next layer.
+  /// The function call will block until one or more bytes of data has been
+  /// written successfully, or until an error occurs.
+  ///
+  /// @return the number of bytes written to the next layer on the last write
+  /// operation.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ///
+  /// @note The flush operation may not write all of the internal buffer.
+  std::size_t flush()
+  {
+    error_code ec;
+    const std::size_t s = flush(ec);
+    detail::throw_error(ec, "flush");
+    return s;
+  }
+
+  /// @brief Flush all data from the buffer to the next layer.
+  ///
+  /// This function tries to write all buffered data to the next layer.
+  /// The function call will block until one or more bytes of data has been
+  /// written successfully, or until an error occurs.
+  ///
+  /// @return the number of bytes written to the next layer on the last write
+  /// operation.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ///
+  /// @note The flush operation may not write all of the internal buffer.
+  std::size_t flush(error_code& ec);
+
+  /// @brief Asynchronously flush all data from the buffer to the next layer.
+  ///
+  /// This function is used to asynchronously write all buffered data to the
+  /// next layer.
+  ///
+  /// @param handler The handler to be called when the flush operation completes.
+  /// The function signature of the handler must be:
+  /// @code void handler(
+  ///   const error_code& error, // Result of operation.
+  ///   std::size_t bytes_transferred // Number of bytes written.
+  /// ); @endcode
+  /// Regardless of whether the asynchronous operation completes immediately or
+  /// not, the handler will not be invoked from within this function. Invocation
+  /// of the handler will be performed in a manner equivalent to using
+  /// asio::io_context::post().
+  ///
+  /// @note The flush operation may not write all of the internal buffer.
+  ///
+  /// @warning Starting multiple asynchronous flushes is not allowed.
+  template <typename WriteHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(WriteHandler, void (error_code, std::size_t))
+  async_flush(WriteHandler&& handler);
+
+  buffer_type& read_buffer() ASIOEXT_NOEXCEPT
+  {
+    return read_buffer_;
+  }
+
+  const buffer_type& read_buffer() const ASIOEXT_NOEXCEPT
+  {
+    return read_buffer_;
+  }
+
+  /// @brief Fill the buffer with some data.
+  ///
+  /// This function tries to read data from the next layer, after flushing
+  /// pending data (unless @ref corked).
+  /// The function call will block until one or more bytes of data has been
+  /// read successfully, or until an error occurs.
+  ///
+  /// @return the number of bytes placed in the buffer as a result of
+  /// the operation.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  std::size_t fill()
+  {
+    error_code ec;
+    const std::size_t s = fill(ec);
+    detail::throw_error(ec, "fill");
+    return s;
+  }
+
+  /// @brief Fill the buffer with some data.
+  ///
+  /// This function tries to read data from the next layer, after flushing
+  /// pending data (unless @ref corked).
+  /// The function call will block until one or more bytes of data has been
+  /// read successfully, or until an error occurs.
+  ///
+  /// @return the number of bytes placed in the buffer as a result of
+  /// the operation.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  std::size_t fill(error_code& ec);
+
+  /// @brief Asynchronously fill the buffer with some data.
+  ///
+  /// This function tries to asynchronously read data from the next layer.
+  /// Pending data is flushed automatically (unless @ref corked).
+  ///
+  /// @param handler The handler to be called when the fill operation completes.
+  /// The function signature of the handler must be:
+  /// @code void handler(
+  ///   const error_code& error, // Result of operation.
+  ///   std::size_t bytes_transferred // Number of bytes read.
+  /// ); @endcode
+  /// Regardless of whether the asynchronous operation completes immediately or
+  /// not, the handler will not be invoked from within this function. Invocation
+  /// of the handler will be performed in a manner equivalent to using
+  /// asio::io_context::post().
+  ///
+  /// @warning Starting multiple asynchronous fills is not allowed.
+  template <typename ReadHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(ReadHandler, void (error_code, std::size_t))
+  async_fill(ReadHandler&& handler);
+
+  /// @brief Get the size from which on reads bypass the read buffer.
+  std::size_t read_bypass_limit() const ASIOEXT_NOEXCEPT
+  {
+    return read_bypass_limit_;
+  }
+
+  /// @brief Set the size from which on reads bypass the read buffer.
+  ///
+  /// If the read buffer is empty, @ref read_some and @ref async_read_some
+  /// requests of at least this many bytes are read directly into the
+  /// caller's buffers, saving a copy. Smaller requests fill the read buffer,
+  /// so that subsequent small reads don't need to hit the next layer.
+  /// Defaults to 8192 bytes.
+  void set_read_bypass_limit(std::size_t limit) ASIOEXT_NOEXCEPT
+  {
+    read_bypass_limit_ = limit;
+  }
+
+  /// @brief Read some data from the stream.
+  ///
+  /// If the read buffer isn't empty, data is taken from it only. Otherwise
+  /// pending data is flushed (unless @ref corked), and the function call
+  /// will block until one or more bytes of data has been read from the next
+  /// layer, or until an error occurs.
+  ///
+  /// @returns The number of bytes read.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers)
+  {
+    error_code ec;
+    const std::size_t s = read_some(buffers, ec);
+    detail::throw_error(ec, "read_some");
+    return s;
+  }
+
+  /// @brief Read some data from the stream.
+  ///
+  /// If the read buffer isn't empty, data is taken from it only. Otherwise
+  /// pending data is flushed (unless @ref corked), and the function call
+  /// will block until one or more bytes of data has been read from the next
+  /// layer, or until an error occurs.
+  ///
+  /// @returns The number of bytes read, or 0 if an error occurred.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+                        error_code& ec);
+
+  /// @brief Asynchronously read some data from the stream.
+  ///
+  /// If the read buffer isn't empty, the operation completes with data
+  /// taken from it only. Otherwise pending data is flushed automatically
+  /// (unless @ref corked) before reading from the next layer.
+  ///
+  /// @param buffers The buffers to read into. Ownership is retained by the
+  /// caller, which must guarantee that they remain valid until the handler
+  /// is called.
+  ///
+  /// @param handler The handler to be called when the read operation
+  /// completes. The function signature of the handler must be:
+  /// @code void handler(
+  ///   const error_code& error, // Result of operation.
+  ///   std::size_t bytes_transferred // Number of bytes read.
+  /// ); @endcode
+  /// Regardless of whether the asynchronous operation completes immediately or
+  /// not, the handler will not be invoked from within this function. Invocation
+  /// of the handler will be performed in a manner equivalent to using
+  /// asio::io_context::post().
+  ///
+  /// @warning Starting multiple asynchronous reads is not allowed.
+  template <typename MutableBufferSequence, typename ReadHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(ReadHandler, void (error_code, std::size_t))
+  async_read_some(const MutableBufferSequence& buffers,
+                  ReadHandler&& handler);
+
+  /// @brief Fill the buffer until it contains the given delimiter.
+  ///
+  /// This function reads data from the next layer until the read buffer
+  /// contains @c delim. Unlike @c asio::read_until, already searched data
+  /// isn't searched again after reading more, and the search compares
+  /// multiple bytes at once.
+  ///
+  /// @returns The number of bytes in the read buffer up to and including
+  /// the delimiter.
+  ///
+  /// @throws asio::system_error Thrown on failure. If the buffer reaches its
+  /// maximum size without containing the delimiter, the error is
+  /// @c asio::error::not_found.
+  std::size_t read_until(char delim)
+  {
+    return read_until(std::string_view(&delim, 1));
+  }
+
+  /// @copydoc read_until(char)
+  std::size_t read_until(std::string_view delim)
+  {
+    error_code ec;
+    const std::size_t s = read_until(delim, ec);
+    detail::throw_error(ec, "read_until");
+    return s;
+  }
+
+  /// @brief Fill the buffer until it contains the given delimiter.
+  ///
+  /// This function reads data from the next layer until the read buffer
+  /// contains @c delim.
+  ///
+  /// @returns The number of bytes in the read buffer up to and including
+  /// the delimiter, or 0 if an error occurred.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset. If the buffer reaches its maximum size without
+  /// containing the delimiter, this is @c asio::error::not_found.
+  std::size_t read_until(char delim, error_code& ec)
+  {
+    return read_until(std::string_view(&delim, 1), ec);
+  }
+
+  /// @copydoc read_until(char,error_code&)
+  std::size_t read_until(std::string_view delim, error_code& ec);
+
+  /// @brief Asynchronously fill the buffer until it contains the given
+  /// delimiter.
+  ///
+  /// @param delim The delimiter to search for. A copy is made.
+  ///
+  /// @param handler The handler to be called when the operation completes.
+  /// The function signature of the handler must be:
+  /// @code void handler(
+  ///   const error_code& error, // Result of operation.
+  ///   std::size_t bytes_transferred // Number of bytes up to and including
+  ///                                 // the delimiter.
+  /// ); @endcode
+  /// Regardless of whether the asynchronous operation completes immediately or
+  /// not, the handler will not be invoked from within this function. Invocation
+  /// of the handler will be performed in a manner equivalent to using
+  /// asio::io_context::post().
+  ///
+  /// @warning Starting multiple asynchronous fills is not allowed.
+  template <typename ReadHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(ReadHandler, void (error_code, std::size_t))
+  async_read_until(std::string_view delim, ReadHandler&& handler);
+
+  /// @copydoc async_read_until(std::string_view,ReadHandler&&)
+  template <typename ReadHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(ReadHandler, void (error_code, std::size_t))
+  async_read_until(char delim, ReadHandler&& handler)
+  {
+    return async_read_until(std::string_view(&delim, 1),
+                            std::forward<ReadHandler>(handler));
+  }
+
+private:
+  static const std::size_t default_coalesce_limit = 512;
+  static const std::size_t default_read_bypass_limit = 8192;
+
+  // An enqueued buffer, which goes after the first |buffer_pos| bytes of
+  // the associated write buffer.
+  struct queued_buffer
+  {
+    std::size_t buffer_pos;
+    asio::const_buffer data;
+    std::shared_ptr<const void> owner;
+  };
+
+  typedef std::vector<queued_buffer, typename std::allocator_traits<
+      Allocator>::template rebind_alloc<queued_buffer>> queue_type;
+
+  void clear_buffers() ASIOEXT_NOEXCEPT
+  {
+    write_buffer_.clear();
+    write_buffer_locked_.clear();
+    read_buffer_.clear();
+    write_queue_.clear();
+    write_queue_locked_.clear();
+    write_queue_size_ = 0;
+
+    timer_.cancel();
+    flush_wait_.cancel();
+    timer_armed_ = false;
+    flush_requested_ = false;
+    auto_flush_error_ = error_code();
+    ++close_count_;
+  }
+
+  // Checks whether |n| more bytes may be written (or enqueued).
+  bool check_write_space(std::size_t n, error_code& ec) const ASIOEXT_NOEXCEPT
+  {
+    if (auto_flush_error_) {
+      ec = auto_flush_error_;
+      return false;
+    }
+
+    const std::size_t pending = pending_write_size();
+    if (pending > write_buffer_.max_size() ||
+        write_buffer_.max_size() - pending < n) {
+      ec = asio::error::no_buffer_space;
+      return false;
+    }
+    return true;
+  }
+
+  // Starts a flush (or the timer) if the auto_flush_options say so.
+  void check_auto_flush();
+  void start_auto_flush();
+  void resume_auto_flush();
+
+  // Locks the write buffers and returns the buffer sequence to write.
+  const std::vector<asio::const_buffer>& lock_write_buffers(error_code& ec);
+  void unlock_write_buffers(std::size_t bytes_written);
+
+  template <typename ConstBufferSequence>
+  void add_gather_buffers(const ConstBufferSequence& buffers);
+
+  // Checks whether write_some() has to flush before it can continue.
+  bool write_needs_flush() const ASIOEXT_NOEXCEPT
+  {
+    const std::size_t pending = pending_write_size();
+    return pending >= write_buffer_.max_size() ||
+           (!corked_ && pending != 0 &&
+            pending >= auto_flush_.high_water_mark);
+  }
+
+  // The peer might wait for the pending data before it sends anything,
+  // so reads from the next layer have to flush it first.
+  bool flush_before_read(error_code& ec)
+  {
+    if (corked_ || flush_pending_ || pending_write_size() == 0)
+      return true;
+    flush(ec);
+    return !ec;
+  }
+
+  void start_flush_before_read()
+  {
+    if (!corked_ && pending_write_size() != 0)
+      start_auto_flush();
+  }
+
+  // Copies as much of |buffers| into the write buffer as fits.
+  template <typename ConstBufferSequence>
+  std::size_t copy_to_write_buffer(const ConstBufferSequence& buffers);
+
+  // Searches the read buffer for |delim|, starting at |pos|. Returns the
+  // number of bytes up to and including the delimiter, or 0. In the latter
+  // case, |pos| is advanced past the data that can't start a match.
+  std::size_t find_delimiter(std::string_view delim, std::size_t& pos);
+
+  // Moves as much buffered data as fits into |buffers|.
+  template <typename MutableBufferSequence>
+  std::size_t take_buffered(const MutableBufferSequence& buffers);
+
+  Stream stream_;
+
+  bool flush_pending_ = false;
+  buffer_type write_buffer_;
+  buffer_type write_buffer_locked_;
+  buffer_type read_buffer_;
+
+  queue_type write_queue_;
+  queue_type write_queue_locked_;
+  // The sequence that's currently being written. Only a member so its
+  // memory can be reused.
+  std::vector<asio::const_buffer> gather_buffers_;
+  std::size_t write_queue_size_ = 0;
+  std::size_t coalesce_limit_;
+  std::size_t read_bypass_limit_;
+
+  auto_flush_options auto_flush_;
+  asio::steady_timer timer_;
+  bool corked_ = false;
+  bool timer_armed_ = false;
+  // Set if an automatic flush was due while another flush was running.
+  bool flush_requested_ = false;
+  error_code auto_flush_error_;
+  // Never expires. async_write_some() waits on this for a pending flush,
+  // which cancels it when done.
+  asio::steady_timer flush_wait_;
+  // Incremented by close(), so waiting operations know they're aborted.
+  std::size_t close_count_ = 0;
+};
+
+template <typename Stream, typename Allocator, typename Buffer>
+template <typename ConstBufferSequence>
+std::size_t buffered_stream<Stream, Allocator, Buffer>::write(
+    const ConstBufferSequence& buffers, error_code& ec)
+{
+  const std::size_t n = asio::buffer_size(buffers);
+  if (!check_write_space(n, ec))
+    return 0;
+
+  auto buf = dynamic_buffer(write_buffer_);
+  const std::size_t pos = buf.size();
+  buf.grow(n);
+  asio::buffer_copy(buf.data(pos, n), buffers);
+
+  ec = error_code();
+  check_auto_flush();
+  return n;
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+template <typename ConstBufferSequence>
+std::size_t buffered_stream<Stream, Allocator, Buffer>::write_some(
+    const ConstBufferSequence& buffers, error_code& ec)
+{
+  if (auto_flush_error_) {
+    ec = auto_flush_error_;
+    return 0;
+  }
+
+  const std::size_t size = asio::buffer_size(buffers);
+  if (size != 0 && write_needs_flush() && !flush_pending_) {
+    flush(ec);
+    if (ec)
+      return 0;
+  }
+
+  // Only an automatic flush can leave the buffer full.
+  const std::size_t n = copy_to_write_buffer(buffers);
+  ec = n == 0 && size != 0 ? asio::error::would_block : error_code();
+  return n;
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+template <typename ConstBufferSequence, typename WriteHandler>
+ASIOEXT_INITFN_RESULT_TYPE(WriteHandler, void(error_code, std::size_t))
+buffered_stream<Stream, Allocator, Buffer>::async_write_some(
+    const ConstBufferSequence& buffers, WriteHandler&& handler)
+{
+  auto init = [this, &buffers] (auto&& handler) {
+    if (auto_flush_error_ || asio::buffer_size(buffers) == 0 ||
+        !write_needs_flush()) {
+      const error_code ec = auto_flush_error_;
+      const std::size_t n = ec ? 0 : copy_to_write_buffer(buffers);
+      if (!ec)
+        check_auto_flush();
+      auto ex = asio::get_associated_executor(handler, get_executor());
+      asio::post(ex, asioext::bind_handler(std::move(handler), ec, n));
+      return;
+    }
+
+    // Called with (error, size) after our own flush, and with (error) after
+    // waiting for someone else's, which always ends with a cancellation.
+    auto op = [this, buffers, close_count = close_count_] (
+        auto& self, error_code ec, auto... flushed) {
+      if (close_count != close_count_)
+        ec = asio::error::operation_aborted;
+      else if (sizeof...(flushed) == 0)
+        ec = auto_flush_error_;
+      if (ec) {
+        self.complete(ec, 0);
+        return;
+      }
+
+      if (write_needs_flush()) {
+        if (flush_pending_)
+          flush_wait_.async_wait(std::move(self));
+        else
+          async_flush(std::move(self));
+        return;
+      }
+
+      const std::size_t n = copy_to_write_buffer(buffers);
+      check_auto_flush();
+      self.complete(ec, n);
+    };
+    auto self = asioext::make_composed_operation(std::move(op),
+                                                 std::move(handler));
+    if (flush_pending_)
+      flush_wait_.async_wait(std::move(self));
+    else
+      async_flush(std::move(self));
+  };
+  return asioext::async_initiate<WriteHandler, void (error_code, std::size_t)>(
+    init, handler);
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+template <typename ConstBufferSequence>
+std::size_t buffered_stream<Stream, Allocator, Buffer>::copy_to_write_buffer(
+    const ConstBufferSequence& buffers)
+{
+  const std::size_t pending = pending_write_size();
+  if (pending >= write_buffer_.max_size())
+    return 0;
+
+  const std::size_t n = (std::min)(asio::buffer_size(buffers),
+                                   write_buffer_.max_size() - pending);
+  auto buf = dynamic_buffer(write_buffer_);
+  const std::size_t pos = buf.size();
+  buf.grow(n);
+  return asio::buffer_copy(buf.data(pos, n), buffers);
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+void buffered_stream<Stream, Allocator, Buffer>::check_auto_flush()
+{
+  const std::size_t pending = pending_write_size();
+  if (corked_ || pending == 0)
+    return;
+
+  if (pending >= auto_flush_.high_water_mark) {
+    start_auto_flush();
+    return;
+  }
+
+  if (auto_flush_.max_delay == std::chrono::steady_clock::duration::zero() ||
+      timer_armed_)
+    return;
+
+  timer_armed_ = true;
+  timer_.expires_after(auto_flush_.max_delay);
+  timer_.async_wait([this] (error_code ec) {
+    // Cancelled by close() (or our destructor), don't touch us.
+    if (ec)
+      return;
+
+    timer_armed_ = false;
+    if (!corked_ && pending_write_size() != 0)
+      start_auto_flush();
+  });
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+void buffered_stream<Stream, Allocator, Buffer>::start_auto_flush()
+{
+  if (flush_pending_) {
+    flush_requested_ = true;
+    return;
+  }
+
+  async_flush([this] (error_code ec, std::size_t) {
+    if (ec && ec != asio::error::operation_aborted)
+      auto_flush_error_ = ec;
+  });
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+void buffered_stream<Stream, Allocator, Buffer>::resume_auto_flush()
+{
+  // Whatever was written during the last flush is due now, or later.
+  if (flush_requested_) {
+    flush_requested_ = false;
+    if (!corked_ && pending_write_size() != 0)
+      start_auto_flush();
+  } else {
+    check_auto_flush();
+  }
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+void buffered_stream<Stream, Allocator, Buffer>::enqueue(
+    asio::const_buffer data, std::shared_ptr<const void> owner,
+    error_code& ec)
+{
+  if (!check_write_space(data.size(), ec))
+    return;
+
+  ec = error_code();
+  if (data.size() == 0)
+    return;
+
+  if (data.size() < coalesce_limit_) {
+    auto buf = dynamic_buffer(write_buffer_);
+    const std::size_t pos = buf.size();
+    buf.grow(data.size());
+    asio::buffer_copy(buf.data(pos, data.size()), data);
+    check_auto_flush();
+    return;
+  }
+
+  queued_buffer q;
+  q.buffer_pos = write_buffer_.size();
+  q.data = data;
+  q.owner = std::move(owner);
+  write_queue_.push_back(std::move(q));
+  write_queue_size_ += data.size();
+  check_auto_flush();
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+template <typename RawByteContainer>
+typename std::enable_if<is_raw_byte_container<
+    typename std::decay<RawByteContainer>::type>::value>::type
+buffered_stream<Stream, Allocator, Buffer>::enqueue(RawByteContainer&& data,
+                                                    error_code& ec)
+{
+  static_assert(!std::is_lvalue_reference<RawByteContainer>::value,
+                "enqueue() needs an rvalue, use write() to copy");
+  typedef typename std::decay<RawByteContainer>::type container_type;
+
+  // Don't bother moving the container if we copy it (or fail) anyway.
+  if (data.size() < coalesce_limit_ ||
+      !check_write_space(data.size(), ec)) {
+    enqueue(asio::buffer(data.data(), data.size()), nullptr, ec);
+    return;
+  }
+
+  auto owner = std::make_shared<container_type>(
+      std::forward<RawByteContainer>(data));
+  const asio::const_buffer buffer(owner->data(), owner->size());
+  enqueue(buffer, std::move(owner), ec);
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+std::size_t buffered_stream<Stream, Allocator, Buffer>::flush(error_code& ec)
+{
+  const auto& buffers = lock_write_buffers(ec);
+  if (ec) return 0;
+
+  const std::size_t r = asio::write(stream_, buffers, ec);
+  unlock_write_buffers(r);
+  return r;
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+template <typename WriteHandler>
+ASIOEXT_INITFN_RESULT_TYPE(WriteHandler, void(error_code, std::size_t))
+buffered_stream<Stream, Allocator, Buffer>::async_flush(WriteHandler&& handler)
+{
+  auto init = [this] (auto&& handler) {
+    error_code ec;
+    const auto& buffers = lock_write_buffers(ec);
+    if (ec) {
+      auto ex = asio::get_associated_executor(handler, get_executor());
+      asio::post(ex, asioext::bind_handler(std::move(handler), ec, 0));
+      return;
+    }
+
+    auto op = [this] (auto& self, error_code ec, std::size_t size) {
+      unlock_write_buffers(size);
+      flush_wait_.cancel();
+      if (!ec)
+        resume_auto_flush();
+      self.complete(ec, size);
+    };
+    asio::async_write(stream_, buffers,
+                      asioext::make_composed_operation(std::move(op),
+                                                       std::move(handler)));
+  };
+  return asioext::async_initiate<WriteHandler, void (error_code, std::size_t)>(
+    init, handler);
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+std::size_t buffered_stream<Stream, Allocator, Buffer>::fill(error_code& ec)
+{
+  if (!flush_before_read(ec))
+    return 0;
+  return asio::read(stream_, dynamic_buffer(read_buffer_),
+                    asio::transfer_at_least(1), ec);
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+template <typename ReadHandler>
+ASIOEXT_INITFN_RESULT_TYPE(ReadHandler, void(error_code, std::size_t))
+buffered_stream<Stream, Allocator, Buffer>::async_fill(ReadHandler&& handler)
+{
+  start_flush_before_read();
+  return asio::async_read(stream_, dynamic_buffer(read_buffer_),
+                          asio::transfer_at_least(1),
+                          std::forward<ReadHandler>(handler));
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+template <typename MutableBufferSequence>
+std::size_t buffered_stream<Stream, Allocator, Buffer>::read_some(
+    const MutableBufferSequence& buffers, error_code& ec)
+{
+  if (read_buffer_.size() == 0) {
+    const std::size_t n = asio::buffer_size(buffers);
+    if (n == 0) {
+      ec = error_code();
+      return 0;
+    }
+
+    if (n >= read_bypass_limit_) {
+      if (!flush_before_read(ec))
+        return 0;
+      return stream_.read_some(buffers, ec);
+    }
+
+    fill(ec);
+    if (ec)
+      return 0;
+  }
+
+  ec = error_code();
+  return take_buffered(buffers);
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+template <typename MutableBufferSequence, typename ReadHandler>
+ASIOEXT_INITFN_RESULT_TYPE(ReadHandler, void(error_code, std::size_t))
+buffered_stream<Stream, Allocator, Buffer>::async_read_some(
+    const MutableBufferSequence& buffers, ReadHandler&& handler)
+{
+  auto init = [this, &buffers] (auto&& handler) {
+    const std::size_t n = asio::buffer_size(buffers);
+    if (read_buffer_.size() != 0 || n == 0) {
+      const std::size_t r = take_buffered(buffers);
+      auto ex = asio::get_associated_executor(handler, get_executor());
+      asio::post(ex, asioext::bind_handler(std::move(handler),
+                                           error_code(), r));
+      return;
+    }
+
+    if (n >= read_bypass_limit_) {
+      start_flush_before_read();
+      stream_.async_read_some(buffers, std::move(handler));
+      return;
+    }
+
+    auto op = [this, buffers] (auto& self, error_code ec, std::size_t) {
+      self.complete(ec, ec ? 0 : take_buffered(buffers));
+    };
+    async_fill(asioext::make_composed_operation(std::move(op),
+                                                std::move(handler)));
+  };
+  return asioext::async_initiate<ReadHandler, void (error_code, std::size_t)>(
+    init, handler);
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+template <typename MutableBufferSequence>
+std::size_t buffered_stream<Stream, Allocator, Buffer>::take_buffered(
+    const MutableBufferSequence& buffers)
+{
+  auto buf = dynamic_buffer(read_buffer_);
+  const std::size_t n = asio::buffer_copy(buffers, buf.data(0, buf.size()));
+  buf.consume(n);
+  return n;
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+std::size_t buffered_stream<Stream, Allocator, Buffer>::read_until(
+    std::string_view delim, error_code& ec)
+{
+  if (delim.empty()) {
+    ec = asio::error::invalid_argument;
+    return 0;
+  }
+
+  std::size_t pos = 0;
+  for (;;) {
+    const std::size_t n = find_delimiter(delim, pos);
+    if (n != 0) {
+      ec = error_code();
+      return n;
+    }
+
+    if (read_buffer_.size() >= read_buffer_.max_size()) {
+      ec = asio::error::not_found;
+      return 0;
+    }
+
+    fill(ec);
+    if (ec)
+      return 0;
+  }
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+template <typename ReadHandler>
+ASIOEXT_INITFN_RESULT_TYPE(ReadHandler, void(error_code, std::size_t))
+buffered_stream<Stream, Allocator, Buffer>::async_read_until(
+    std::string_view delim, ReadHandler&& handler)
+{
+  auto init = [this] (auto&& handler, std::string delim) {
+    error_code ec;
+    std::size_t pos = 0;
+    std::size_t n = 0;
+    if (delim.empty())
+      ec = asio::error::invalid_argument;
+    else
+      n = find_delimiter(delim, pos);
+
+    if (ec || n != 0) {
+      auto ex = asio::get_associated_executor(handler, get_executor());
+      asio::post(ex, asioext::bind_handler(std::move(handler), ec, n));
+      return;
+    }
+
+    auto op = [this, delim = std::move(delim), pos] (
+        auto& self, error_code ec, std::size_t) mutable {
+      if (!ec) {
+        const std::size_t n = find_delimiter(delim, pos);
+        if (n != 0) {
+          self.complete(ec, n);
+          return;
+        }
+
+        if (read_buffer_.size() < read_buffer_.max_size()) {
+          async_fill(std::move(self));
+          return;
+        }
+        ec = asio::error::not_found;
+      }
+      self.complete(ec, 0);
+    };
+    async_fill(asioext::make_composed_operation(std::move(op),
+                                                std::move(handler)));
+  };
+  return asioext::async_initiate<ReadHandler, void (error_code, std::size_t)>(
+    init, handler, std::string(delim));
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+std::size_t buffered_stream<Stream, Allocator, Buffer>::find_delimiter(
+    std::string_view delim, std::size_t& pos)
+{
+  auto buf = dynamic_buffer(read_buffer_);
+  const std::size_t size = buf.size();
+  const auto data = buf.data(pos, size - pos);
+  const uint8_t* needle = reinterpret_cast<const uint8_t*>(delim.data());
+  const std::size_t n = delim.size();
+
+  auto it = asio::buffer_sequence_begin(data);
+  const auto end = asio::buffer_sequence_end(data);
+  if (n == 1 || it == end || std::next(it) == end) {
+    // Delimiters can't straddle buffers here.
+    std::size_t offset = pos;
+    for (; it != end; ++it) {
+      const asio::const_buffer b(*it);
+      const uint8_t* first = static_cast<const uint8_t*>(b.data());
+      const uint8_t* last = first + b.size();
+      const uint8_t* p = detail::find_bytes(first, last, needle, n);
+      if (p != last)
+        return offset + (p - first) + n;
+      offset += b.size();
+    }
+  } else {
+    const auto first = asio::buffers_begin(data);
+    const auto last = asio::buffers_end(data);
+    const auto p = std::search(first, last, delim.begin(), delim.end());
+    if (p != last)
+      return pos + (p - first) + n;
+  }
+
+  // The last n - 1 bytes might be the beginning of a delimiter.
+  if (size - pos >= n)
+    pos = size - (n - 1);
+  return 0;
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+const std::vector<asio::const_buffer>&
+buffered_stream<Stream, Allocator, Buffer>::lock_write_buffers(error_code& ec)
+{
+  if (flush_pending_) {
+    ec = asio::error::already_started;
+    return gather_buffers_;
+  }
+
+  if (write_buffer_locked_.size() == 0 && write_queue_locked_.empty()) {
+    // Don't swap if there's nothing in either buffer (we'll do a zero-sized
+    // write in this case, which doesn't hurt us and simplifies the call-site).
+    if (write_buffer_.size() != 0 || !write_queue_.empty()) {
+      // Swap send buffers so clients can continue to enqueue data while
+      // this buffer is being flushed.
+      std::swap(write_buffer_, write_buffer_locked_);
+      write_queue_.swap(write_queue_locked_);
+      write_queue_size_ = 0;
+    }
+  }
+
+  // Interleave the buffered data with the queued buffers.
+  gather_buffers_.clear();
+  auto buf = dynamic_buffer(write_buffer_locked_);
+  std::size_t pos = 0;
+  for (const queued_buffer& q : write_queue_locked_) {
+    add_gather_buffers(buf.data(pos, q.buffer_pos - pos));
+    gather_buffers_.push_back(q.data);
+    pos = q.buffer_pos;
+  }
+  add_gather_buffers(buf.data(pos, buf.size() - pos));
+
+  flush_pending_ = true;
+  return gather_buffers_;
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+void buffered_stream<Stream, Allocator, Buffer>::unlock_write_buffers(std::size_t bytes_written)
+{
+  flush_pending_ = false;
+  gather_buffers_.clear();
+
+  // Normally everything was written, but an error might have interrupted us.
+  auto buf = dynamic_buffer(write_buffer_locked_);
+  std::size_t buffer_consumed = 0;
+  auto it = write_queue_locked_.begin();
+  for (; it != write_queue_locked_.end() && bytes_written != 0; ++it) {
+    const std::size_t n = (std::min)(bytes_written,
+                                     it->buffer_pos - buffer_consumed);
+    buffer_consumed += n;
+    bytes_written -= n;
+    if (it->buffer_pos != buffer_consumed)
+      break;
+
+    const std::size_t m = (std::min)(bytes_written, it->data.size());
+    it->data += m;
+    bytes_written -= m;
+    if (it->data.size() != 0)
+      break;
+  }
+  buffer_consumed += bytes_written;
+  write_queue_locked_.erase(write_queue_locked_.begin(), it);
+  for (queued_buffer& q : write_queue_locked_)
+    q.buffer_pos -= buffer_consumed;
+  buf.consume(buffer_consumed);
+}
+
+template <typename Stream, typename Allocator, typename Buffer>
+template <typename ConstBufferSequence>
+void buffered_stream<Stream, Allocator, Buffer>::add_gather_buffers(
+    const ConstBufferSequence& buffers)
+{
+  for (auto it = asio::buffer_sequence_begin(buffers),
+       end = asio::buffer_sequence_end(buffers); it != end; ++it) {
+    const asio::const_buffer b(*it);
+    if (b.size() != 0)
+      gather_buffers_.push_back(b);
+  }
+}
+
+ASIOEXT_NS_END
+
+#endif
@@ -0,0 +1,705 @@
+/// @file
+/// Defines the basic_chained_buffer class template.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_CHAINEDBUFFER_HPP
+#define ASIOEXT_CHAINEDBUFFER_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/linear_buffer.hpp"
+#include "asioext/error_code.hpp"
+
+#include "asioext/detail/chained_buffer_sequence.hpp"
+#include "asioext/detail/buffer.hpp"
+#include "asioext/detail/cstdint.hpp"
+#include "asioext/detail/error.hpp"
+#include "asioext/detail/throw_exception.hpp"
+
+#include <deque>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup core
+/// @brief Byte buffer made up of a chain of fixed-size segments.
+///
+/// Unlike @c basic_linear_buffer, this class never moves its contents.
+/// Growing the buffer appends segments to the chain, and consuming data from
+/// the front recycles fully consumed segments, which are kept around for
+/// later use. This makes it the better choice for large payloads, whose
+/// size isn't known up-front.
+///
+/// The price is that the data isn't contiguous. The input and output
+/// sequences are represented by sequences of buffers (one per segment),
+/// which are suitable for scatter/gather I/O. If the data has to be
+/// contiguous, use @ref linearize.
+template <typename Allocator = std::allocator<uint8_t>>
+class basic_chained_buffer
+{
+  typedef std::allocator_traits<Allocator> allocator_traits_type;
+  typedef typename allocator_traits_type::template rebind_alloc<uint8_t*>
+      segment_allocator_type;
+  typedef std::deque<uint8_t*, segment_allocator_type> segment_list;
+
+public:
+  typedef Allocator allocator_type;
+
+  typedef uint8_t value_type;
+  typedef std::size_t size_type;
+
+  /// The type used to represent a const object as a list of buffers.
+  typedef detail::chained_buffer_sequence<
+    ASIOEXT_CONST_BUFFER, typename segment_list::const_iterator
+  > const_buffers_type;
+
+  /// The type used to represent a non-const object as a list of buffers.
+  typedef detail::chained_buffer_sequence<
+    ASIOEXT_MUTABLE_BUFFER, typename segment_list::const_iterator
+  > mutable_buffers_type;
+
+  /// The segment size used unless specified otherwise.
+  static const std::size_t default_segment_size = 64 * 1024;
+
+  static_assert(std::is_same<typename allocator_type::value_type,
+                             uint8_t>::value,
+                "Allocator::value_type must be uint8_t");
+
+  /// @brief Default-construct a basic_chained_buffer.
+  ///
+  /// The constructed basic_chained_buffer is empty and doesn't have
+  /// any segments.
+  ///
+  /// @note Not @c noexcept, as @c std::deque may allocate even when empty.
+  basic_chained_buffer()
+    : allocator_()
+    , segments_()
+    , segment_size_(default_segment_size)
+    , offset_(0)
+    , size_(0)
+    , max_size_((std::numeric_limits<std::size_t>::max)())
+  {
+  }
+
+  /// @brief Construct a basic_chained_buffer.
+  ///
+  /// The constructed basic_chained_buffer is empty.
+  ///
+  /// @param initial_capacity The minimum capacity that the buffer starts with.
+  /// @param maximum_size Specifies a maximum size for the buffer, in bytes.
+  /// @param segment_size The size of each segment, in bytes.
+  ///
+  /// @throws std::invalid_argument If @c segment_size is 0.
+  explicit basic_chained_buffer(
+      std::size_t initial_capacity,
+      std::size_t maximum_size = (std::numeric_limits<std::size_t>::max)(),
+      std::size_t segment_size = default_segment_size)
+    : allocator_()
+    , segments_()
+    , segment_size_(checked_segment_size(segment_size))
+    , offset_(0)
+    , size_(0)
+    , max_size_(maximum_size)
+  {
+    reserve(initial_capacity);
+  }
+
+  /// @brief Construct a basic_chained_buffer.
+  ///
+  /// The constructed basic_chained_buffer is empty.
+  ///
+  /// @param a Allocator used to allocate the segments.
+  /// @param initial_capacity The minimum capacity that the buffer starts with.
+  /// @param maximum_size Specifies a maximum size for the buffer, in bytes.
+  /// @param segment_size The size of each segment, in bytes.
+  ///
+  /// @throws std::invalid_argument If @c segment_size is 0.
+  basic_chained_buffer(
+      const Allocator& a, std::size_t initial_capacity,
+      std::size_t maximum_size = (std::numeric_limits<std::size_t>::max)(),
+      std::size_t segment_size = default_segment_size)
+    : allocator_(a)
+    , segments_(segment_allocator_type(a))
+    , segment_size_(checked_segment_size(segment_size))
+    , offset_(0)
+    , size_(0)
+    , max_size_(maximum_size)
+  {
+    reserve(initial_capacity);
+  }
+
+  /// @brief Move-construct a basic_chained_buffer.
+  ///
+  /// After the move, @c other is an empty buffer with no allocated memory
+  /// (as-if just default-constructed).
+  ///
+  /// @note Not @c noexcept, as @c std::deque may allocate for @c other.
+  basic_chained_buffer(basic_chained_buffer&& other)
+    : allocator_(std::move(other.allocator_))
+    , segments_(std::move(other.segments_))
+    , segment_size_(other.segment_size_)
+    , offset_(other.offset_)
+    , size_(other.size_)
+    , max_size_(other.max_size_)
+  {
+    other.segments_.clear();
+    other.offset_ = other.size_ = 0;
+  }
+
+  /// @brief Destroy the basic_chained_buffer.
+  ///
+  /// Deallocates all segments.
+  ~basic_chained_buffer()
+  {
+    deallocate_segments(0);
+  }
+
+  /// @brief Move-assign a basic_chained_buffer.
+  ///
+  /// After the move, @c other is an empty buffer with no allocated memory
+  /// (as-if just default-constructed).
+  basic_chained_buffer& operator=(basic_chained_buffer&& other)
+  {
+    if (this != &other) {
+      deallocate_segments(0);
+      // The segments have to be returned to the allocator they came from.
+      allocator_ = std::move(other.allocator_);
+      segments_ = std::move(other.segments_);
+      segment_size_ = other.segment_size_;
+      offset_ = other.offset_;
+      size_ = other.size_;
+      max_size_ = other.max_size_;
+
+      other.segments_.clear();
+      other.offset_ = other.size_ = 0;
+    }
+    return *this;
+  }
+
+  /// @brief Get the allocator used by the buffer.
+  allocator_type get_allocator() const ASIOEXT_NOEXCEPT
+  {
+    return allocator_;
+  }
+
+  /// @brief Get the size of the input sequence.
+  std::size_t size() const ASIOEXT_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// @brief Get the maximum size of the buffer.
+  std::size_t max_size() const ASIOEXT_NOEXCEPT
+  {
+    return max_size_;
+  }
+
+  /// @brief Get the current capacity of the buffer.
+  ///
+  /// @returns The number of bytes the input and output sequences can hold
+  /// without allocating more segments.
+  std::size_t capacity() const ASIOEXT_NOEXCEPT
+  {
+    return segments_.size() * segment_size_ - offset_;
+  }
+
+  /// @brief Get the size of the segments.
+  std::size_t segment_size() const ASIOEXT_NOEXCEPT
+  {
+    return segment_size_;
+  }
+
+  /// @brief Determine if this buffer is empty.
+  bool empty() const ASIOEXT_NOEXCEPT
+  {
+    return 0 == size_;
+  }
+
+  /// @brief Determine whether the input sequence is stored contiguously.
+  ///
+  /// @returns @c true if the input sequence doesn't cross a segment
+  /// boundary, i.e. @ref data consists of at most one buffer.
+  bool is_contiguous() const ASIOEXT_NOEXCEPT
+  {
+    return offset_ + size_ <= segment_size_;
+  }
+
+  /// Get a list of buffers that represents the input sequence.
+  ///
+  /// @note The returned object is invalidated by any @c basic_chained_buffer
+  /// member function that modifies the buffer.
+  mutable_buffers_type data() ASIOEXT_NOEXCEPT
+  {
+    return mutable_buffers_type(segments_.begin(), segment_size_,
+                                offset_, size_);
+  }
+
+  /// Get a list of buffers that represents the input sequence.
+  ///
+  /// @note The returned object is invalidated by any @c basic_chained_buffer
+  /// member function that modifies the buffer.
+  const_buffers_type data() const ASIOEXT_NOEXCEPT
+  {
+    return const_buffers_type(segments_.begin(), segment_size_,
+                              offset_, size_);
+  }
+
+  /// @brief Get a list of buffers that represents part of the input sequence.
+  ///
+  /// @param pos Position of the first byte to represent.
+  /// @param n The number of bytes to represent. If the input sequence is
+  /// shorter, the buffer sequence represents as many bytes as are available.
+  mutable_buffers_type data(std::size_t pos, std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    clamp(pos, n);
+    return mutable_buffers_type(segments_.begin(), segment_size_,
+                                offset_ + pos, n);
+  }
+
+  /// @brief Get a list of buffers that represents part of the input sequence.
+  ///
+  /// @param pos Position of the first byte to represent.
+  /// @param n The number of bytes to represent. If the input sequence is
+  /// shorter, the buffer sequence represents as many bytes as are available.
+  const_buffers_type data(std::size_t pos,
+                          std::size_t n) const ASIOEXT_NOEXCEPT
+  {
+    clamp(pos, n);
+    return const_buffers_type(segments_.begin(), segment_size_,
+                              offset_ + pos, n);
+  }
+
+  /// @brief Copy part of the input sequence to contiguous memory.
+  ///
+  /// @param dest The memory to copy the data to.
+  /// @param n The number of bytes to copy.
+  /// @param pos Position of the first byte to copy.
+  ///
+  /// @returns The number of bytes copied, which is less than @c n if
+  /// the input sequence is too short.
+  std::size_t copy(void* dest, std::size_t n,
+                   std::size_t pos = 0) const ASIOEXT_NOEXCEPT
+  {
+    return asio::buffer_copy(asio::buffer(dest, n), data(pos, n));
+  }
+
+  /// @brief Get a contiguous copy of the input sequence.
+  ///
+  /// The segments of a chained buffer are never merged, so making the data
+  /// contiguous always requires copying it. Only do this if it's really
+  /// necessary, e.g. for APIs that insist on a single pointer. The buffer
+  /// itself is left unchanged.
+  ///
+  /// If the input sequence is already contiguous (see @ref is_contiguous),
+  /// its first buffer can be used directly instead.
+  basic_linear_buffer<Allocator> linearize() const
+  {
+    basic_linear_buffer<Allocator> result(allocator_, size_);
+    result.resize(size_);
+    copy(result.data(), size_);
+    return result;
+  }
+
+  /// @brief Append the given data to the buffer.
+  ///
+  /// This function appends the given raw data to the buffer,
+  /// allocating segments as necessary.
+  ///
+  /// @param data The raw bytes to append.
+  /// @param n Number of raw bytes to append.
+  ///
+  /// @throws std::length_error If <tt>size() + n > max_size()</tt>.
+  void append(const void* data, std::size_t n)
+  {
+    size_ += asio::buffer_copy(prepare(n), asio::buffer(data, n));
+  }
+
+  /// @brief Get a list of buffers that represents the output sequence, with
+  /// the given size.
+  ///
+  /// Ensures that the output sequence can accommodate @c n bytes, allocating
+  /// segments as necessary.
+  ///
+  /// @param n Total number of bytes the output sequence has to accomodate.
+  ///
+  /// @returns An object of type @c mutable_buffers_type representing memory
+  /// directly behind the input sequence, of size @c n.
+  ///
+  /// @throws std::length_error If <tt>size() + n > max_size()</tt>.
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    if (size_ > max_size_ || max_size_ - size_ < n) {
+      std::length_error ex("basic_chained_buffer too long");
+      detail::throw_exception(ex);
+    }
+
+    reserve(size_ + n);
+    return mutable_buffers_type(segments_.begin(), segment_size_,
+                                offset_ + size_, n);
+  }
+
+  /// @brief Move bytes from the output sequence to the input sequence.
+  ///
+  /// @param n The number of bytes to append from the start of the output
+  /// sequence to the end of the input sequence.
+  ///
+  /// @note If @c n is greater than the size of the output sequence, the entire
+  /// output sequence is moved to the input sequence and no error is issued.
+  void commit(std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    size_ += (std::min)(n, capacity() - size_);
+  }
+
+  /// @brief Remove bytes from the input sequence.
+  ///
+  /// Removes @c n bytes from the beginning of the input sequence.
+  /// This doesn't move any data. Segments that become unused are moved to
+  /// the end of the chain, to be reused by the output sequence.
+  ///
+  /// @note If @c n is greater than the size of the input sequence, the entire
+  /// input sequence is consumed and no error is issued.
+  void consume(std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    n = (std::min)(n, size_);
+    offset_ += n;
+    size_ -= n;
+
+    while (offset_ >= segment_size_) {
+      uint8_t* segment = segments_.front();
+      segments_.pop_front();
+      segments_.push_back(segment);
+      offset_ -= segment_size_;
+    }
+  }
+
+  /// @brief Ensure the buffer has at least the given capacity.
+  ///
+  /// Existing data is never moved, so this doesn't invalidate any pointers
+  /// into the buffer.
+  ///
+  /// @throws std::length_error If <tt>min_cap > max_size()</tt>.
+  void reserve(std::size_t min_cap);
+
+  /// @brief Resize the input sequence.
+  ///
+  /// When growing the buffer, new bytes are not zero-initialized.
+  ///
+  /// @throws std::length_error If <tt>new_size > max_size()</tt>.
+  void resize(std::size_t new_size)
+  {
+    if (new_size > max_size_) {
+      std::length_error ex("basic_chained_buffer too long");
+      detail::throw_exception(ex);
+    }
+
+    reserve(new_size);
+    size_ = new_size;
+  }
+
+  /// @brief Deallocate all segments that aren't in use.
+  void shrink_to_fit() ASIOEXT_NOEXCEPT
+  {
+    if (size_ == 0)
+      offset_ = 0;
+    deallocate_segments((offset_ + size_ + segment_size_ - 1) /
+                        segment_size_);
+  }
+
+  /// @brief Clear the buffer.
+  ///
+  /// Resets the buffer to a size of zero without deallocating
+  /// any segments.
+  void clear() ASIOEXT_NOEXCEPT
+  {
+    offset_ = 0;
+    size_ = 0;
+  }
+
+private:
+  basic_chained_buffer(const basic_chained_buffer&) ASIOEXT_DELETED;
+  basic_chained_buffer& operator=(const basic_chained_buffer&) ASIOEXT_DELETED;
+
+  static std::size_t checked_segment_size(std::size_t segment_size)
+  {
+    if (segment_size == 0) {
+      std::invalid_argument ex("basic_chained_buffer segment size is 0");
+      detail::throw_exception(ex);
+    }
+    return segment_size;
+  }
+
+  void clamp(std::size_t& pos, std::size_t& n) const ASIOEXT_NOEXCEPT
+  {
+    if (pos > size_)
+      pos = size_;
+    if (n > size_ - pos)
+      n = size_ - pos;
+  }
+
+  // Owns a freshly allocated segment until it is released.
+  struct segment_holder
+  {
+    segment_holder(allocator_type& a, std::size_t n)
+      : allocator(a)
+      , data(allocator_traits_type::allocate(a, n))
+      , size(n)
+    {}
+
+    ~segment_holder()
+    {
+      if (data)
+        allocator_traits_type::deallocate(allocator, data, size);
+    }
+
+    allocator_type& allocator;
+    uint8_t* data;
+    std::size_t size;
+  };
+
+  // Deallocates all segments after the first |keep| segments.
+  void deallocate_segments(std::size_t keep) ASIOEXT_NOEXCEPT
+  {
+    while (segments_.size() > keep) {
+      allocator_traits_type::deallocate(allocator_, segments_.back(),
+                                        segment_size_);
+      segments_.pop_back();
+    }
+  }
+
+  allocator_type allocator_;
+  segment_list segments_;
+  std::size_t segment_size_;
+  // Start of the input sequence in the first segment, always < segment_size_.
+  std::size_t offset_;
+  std::size_t size_;
+  std::size_t max_size_;
+};
+
+/// @ingroup core
+/// @brief Typedef for the typical usage of @c basic_chained_buffer.
+typedef basic_chained_buffer<> chained_buffer;
+
+/// @ingroup core
+/// @brief Adapt a @c basic_chained_buffer to the DynamicBuffer requirements.
+///
+/// The interface is identical to @c dynamic_linear_buffer, but the buffer
+/// sequences returned by this class consist of one buffer per segment.
+/// Growing the buffer never copies any data.
+template <typename Allocator>
+class dynamic_chained_buffer
+{
+public:
+  /// The type used to represent the input sequence as a list of buffers.
+  typedef typename basic_chained_buffer<Allocator>::const_buffers_type
+      const_buffers_type;
+
+  /// The type used to represent the output sequence as a list of buffers.
+  typedef typename basic_chained_buffer<Allocator>::mutable_buffers_type
+      mutable_buffers_type;
+
+  /// @brief Construct a dynamic buffer from a @c basic_chained_buffer.
+  ///
+  /// @param b The basic_chained_buffer to be used as backing storage for
+  /// the dynamic buffer.
+  /// Any existing data in the buffer is treated as the dynamic buffer's input
+  /// sequence. The object stores a reference to the buffer and the user is
+  /// responsible for ensuring that the buffer object remains valid until the
+  /// dynamic_chained_buffer object is destroyed.
+  ///
+  /// @param maximum_size Specifies a maximum size for the buffer, in bytes.
+  explicit dynamic_chained_buffer(basic_chained_buffer<Allocator>& b,
+      std::size_t maximum_size =
+        (std::numeric_limits<std::size_t>::max)()) ASIOEXT_NOEXCEPT
+    : data_(b)
+    , max_size_((std::min)(b.max_size(), maximum_size))
+  {
+  }
+
+  /// @brief Move-construct a dynamic buffer.
+  dynamic_chained_buffer(dynamic_chained_buffer&& other) ASIOEXT_NOEXCEPT
+    : data_(other.data_)
+    , max_size_(other.max_size_)
+  {
+  }
+
+  /// @brief Get the size of the input sequence.
+  std::size_t size() const ASIOEXT_NOEXCEPT
+  {
+    return (std::min)(data_.size(), max_size_);
+  }
+
+  /// @brief Get the maximum size of the dynamic buffer.
+  std::size_t max_size() const ASIOEXT_NOEXCEPT
+  {
+    return max_size_;
+  }
+
+  /// @brief Get the current capacity of the dynamic buffer.
+  std::size_t capacity() const ASIOEXT_NOEXCEPT
+  {
+    return (std::min)(data_.capacity(), max_size_);
+  }
+
+#if !defined(ASIOEXT_NO_DYNAMIC_BUFFER_V1)
+  /// Get a list of buffers that represents the input sequence.
+  mutable_buffers_type data() ASIOEXT_NOEXCEPT
+  {
+    return data_.data(0, size());
+  }
+
+  /// Get a list of buffers that represents the input sequence.
+  const_buffers_type data() const ASIOEXT_NOEXCEPT
+  {
+    return const_cast<const basic_chained_buffer<Allocator>&>(data_).data(
+        0, size());
+  }
+#endif
+
+  /// @brief Get a sequence of buffers that represents the underlying memory.
+  ///
+  /// @param pos Position of the first byte to represent in the buffer sequence
+  ///
+  /// @param n The number of bytes to return in the buffer sequence. If the
+  /// underlying memory is shorter, the buffer sequence represents as many bytes
+  /// as are available.
+  mutable_buffers_type data(std::size_t pos, std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    return data_.data(pos, n);
+  }
+
+  /// @brief Get a sequence of buffers that represents the underlying memory.
+  ///
+  /// @param pos Position of the first byte to represent in the buffer sequence
+  ///
+  /// @param n The number of bytes to return in the buffer sequence. If the
+  /// underlying memory is shorter, the buffer sequence represents as many bytes
+  /// as are available.
+  const_buffers_type data(std::size_t pos,
+                          std::size_t n) const ASIOEXT_NOEXCEPT
+  {
+    return const_cast<const basic_chained_buffer<Allocator>&>(data_).data(
+        pos, n);
+  }
+
+#if !defined(ASIOEXT_NO_DYNAMIC_BUFFER_V1)
+  /// @brief Get a list of buffers that represents the output sequence, with
+  /// the given size.
+  ///
+  /// @throws std::length_error If <tt>size() + n > max_size()</tt>.
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    check_grow(n);
+    return data_.prepare(n);
+  }
+
+  /// @brief Get a list of buffers that represents the output sequence, with
+  /// the given size.
+  ///
+  /// @param n Total number of bytes the output sequence has to accomodate.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ///
+  /// @note This function is not part of the DynamicBuffer requirements.
+  mutable_buffers_type prepare(std::size_t n, error_code& ec)
+  {
+    const std::size_t siz = data_.size();
+    if (siz > max_size_ || max_size_ - siz < n) {
+      ec = asio::error::no_memory;
+      return mutable_buffers_type();
+    }
+    ec = error_code();
+    return data_.prepare(n);
+  }
+
+  /// Move bytes from the output sequence to the input sequence.
+  void commit(std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    data_.commit(n);
+  }
+#endif
+
+  /// @brief Grow the underlying memory by the specified number of bytes.
+  ///
+  /// @throws std::length_error If <tt>size() + n > max_size()</tt>.
+  void grow(std::size_t n)
+  {
+    check_grow(n);
+    data_.resize(data_.size() + n);
+  }
+
+  /// @brief Shrink the underlying memory by the specified number of bytes.
+  ///
+  /// Erases @c n bytes from the end of the input sequence. If @c n is greater
+  /// than the current size, the buffer is emptied.
+  void shrink(std::size_t n)
+  {
+    const std::size_t siz = data_.size();
+    data_.resize(siz - (std::min)(siz, n));
+  }
+
+  /// @brief Remove characters from the input sequence.
+  ///
+  /// Removes @c n characters from the beginning of the input sequence.
+  /// This doesn't move any data.
+  void consume(std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    data_.consume(n);
+  }
+
+private:
+  void check_grow(std::size_t n) const
+  {
+    const std::size_t siz = data_.size();
+    if (siz > max_size_ || max_size_ - siz < n) {
+      std::length_error ex("dynamic_chained_buffer too long");
+      detail::throw_exception(ex);
+    }
+  }
+
+  basic_chained_buffer<Allocator>& data_;
+  std::size_t max_size_;
+};
+
+/// @ingroup core
+/// @brief Create a new dynamic buffer that represents the
+/// given @c basic_chained_buffer.
+///
+/// @returns <tt>dynamic_chained_buffer<Allocator>(data)</tt>.
+template <typename Allocator>
+inline dynamic_chained_buffer<Allocator> dynamic_buffer(
+    basic_chained_buffer<Allocator>& data) ASIOEXT_NOEXCEPT
+{
+  return dynamic_chained_buffer<Allocator>(data);
+}
+
+ASIOEXT_NS_END
+
+#if !defined(ASIOEXT_IS_DOCUMENTATION)
+# if defined(ASIOEXT_USE_BOOST_ASIO)
+namespace boost {
+# endif
+namespace asio {
+
+using asioext::dynamic_buffer;
+
+}
+# if defined(ASIOEXT_USE_BOOST_ASIO)
+}
+# endif
+#endif
+
+#include "asioext/impl/chained_buffer.hpp"
+
+#endif
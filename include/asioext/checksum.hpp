@@ -0,0 +1,109 @@
+/// @file
+/// Defines the asioext::crc32c_hasher and asioext::xxhash64_hasher classes.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_CHECKSUM_HPP
+#define ASIOEXT_CHECKSUM_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/detail/cstdint.hpp"
+
+#include <cstddef>
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup files
+/// @brief Computes the CRC-32C (Castagnoli) checksum of a byte stream.
+///
+/// If the CPU supports it, the dedicated CRC32 instructions
+/// (SSE 4.2 on x86-64, the CRC32 extension on ARMv8) are used.
+/// Otherwise a table-driven (slicing-by-8) implementation is used.
+///
+/// This class satisfies the @ref concept-Hasher requirements.
+class crc32c_hasher
+{
+public:
+  /// The type of the computed checksum.
+  typedef uint32_t value_type;
+
+  /// Construct a hasher that hasn't seen any data yet.
+  crc32c_hasher() ASIOEXT_NOEXCEPT
+    : crc_(0xffffffff)
+  {
+    // ctor
+  }
+
+  /// Append the given bytes to the checksummed data.
+  ASIOEXT_DECL void update(const void* data,
+                           std::size_t size) ASIOEXT_NOEXCEPT;
+
+  /// Get the checksum of all data seen so far.
+  value_type value() const ASIOEXT_NOEXCEPT
+  {
+    return ~crc_;
+  }
+
+  /// Forget all data seen so far.
+  void reset() ASIOEXT_NOEXCEPT
+  {
+    crc_ = 0xffffffff;
+  }
+
+private:
+  uint32_t crc_;
+};
+
+/// @ingroup files
+/// @brief Computes the 64-bit xxHash (XXH64) of a byte stream.
+///
+/// This class satisfies the @ref concept-Hasher requirements.
+class xxhash64_hasher
+{
+public:
+  /// The type of the computed hash.
+  typedef uint64_t value_type;
+
+  /// Construct a hasher that hasn't seen any data yet.
+  ///
+  /// @param seed The seed value to use.
+  explicit xxhash64_hasher(uint64_t seed = 0) ASIOEXT_NOEXCEPT
+  {
+    reset(seed);
+  }
+
+  /// Append the given bytes to the hashed data.
+  ASIOEXT_DECL void update(const void* data,
+                           std::size_t size) ASIOEXT_NOEXCEPT;
+
+  /// Get the hash of all data seen so far.
+  ASIOEXT_DECL value_type value() const ASIOEXT_NOEXCEPT;
+
+  /// Forget all data seen so far.
+  ///
+  /// @param seed The seed value to use.
+  ASIOEXT_DECL void reset(uint64_t seed = 0) ASIOEXT_NOEXCEPT;
+
+private:
+  uint64_t seed_;
+  uint64_t total_size_;
+  uint64_t acc_[4];
+  unsigned char pending_[32];
+  std::size_t pending_size_;
+};
+
+ASIOEXT_NS_END
+
+#if defined(ASIOEXT_HEADER_ONLY)
+# include "asioext/impl/checksum.cpp"
+#endif
+
+#endif
@@ -97,9 +97,9 @@ composed_operation<
     typename std::decay<Handler>::type,
     typename std::decay<Impl>::type,
     typename std::decay<Work>::type
-  >(std::move(handler),
-    std::move(impl),
-    std::move(work));
+  >(std::forward<Handler>(handler),
+    std::forward<Impl>(impl),
+    std::forward<Work>(work));
 }
 
 template <typename IoObject, typename = typename std::enable_if<
@@ -0,0 +1,129 @@
+/// @file
+/// Declares the various asioext::copy_file overloads.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_COPYFILE_HPP
+#define ASIOEXT_COPYFILE_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/file_handle.hpp"
+#include "asioext/is_hasher.hpp"
+#include "asioext/error_code.hpp"
+
+#include "asioext/detail/cstdint.hpp"
+
+#include <type_traits>
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup files
+/// @defgroup copy_file asioext::copy_file()
+/// Copies the contents of one file to another.
+///
+/// Data is read from the source until it reports EOF, so special files
+/// (pipes, character devices, ...) which don't report their size correctly
+/// are supported as well.
+///
+///@{
+
+/// Copy the remaining contents of @c src to @c dst.
+///
+/// @param src The file_handle object to read from. Reading starts at the
+/// current file pointer.
+///
+/// @param dst The file_handle object to write to. Writing starts at the
+/// current file pointer.
+///
+/// @returns The number of bytes copied.
+///
+/// @throws asio::system_error Thrown on failure.
+ASIOEXT_DECL uint64_t copy_file(file_handle src, file_handle dst);
+
+/// Copy the remaining contents of @c src to @c dst.
+///
+/// @param src The file_handle object to read from. Reading starts at the
+/// current file pointer.
+///
+/// @param dst The file_handle object to write to. Writing starts at the
+/// current file pointer.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+///
+/// @returns The number of bytes copied.
+ASIOEXT_DECL uint64_t copy_file(file_handle src, file_handle dst,
+                                error_code& ec) ASIOEXT_NOEXCEPT;
+
+#if !defined(ASIOEXT_IS_DOCUMENTATION)
+# define ASIOEXT_DETAIL_COPYFILE_HASH_RET(H) \
+    typename std::enable_if<is_hasher<H>::value, uint64_t>::type
+#else
+# define ASIOEXT_DETAIL_COPYFILE_HASH_RET(H) uint64_t
+#endif
+
+/// Copy the remaining contents of @c src to @c dst and compute their
+/// checksum.
+///
+/// Every chunk is passed to @c hasher right after it has been read, while
+/// it is still in the CPU cache. This saves a second pass over the data.
+///
+/// @param src The file_handle object to read from. Reading starts at the
+/// current file pointer.
+///
+/// @param dst The file_handle object to write to. Writing starts at the
+/// current file pointer.
+///
+/// @param hasher The hasher that is updated with the copied data.
+/// The type must satisfy the @ref concept-Hasher requirements.
+///
+/// @returns The number of bytes copied.
+///
+/// @throws asio::system_error Thrown on failure.
+template <class Hasher>
+ASIOEXT_DETAIL_COPYFILE_HASH_RET(Hasher)
+    copy_file(file_handle src, file_handle dst, Hasher& hasher);
+
+/// Copy the remaining contents of @c src to @c dst and compute their
+/// checksum.
+///
+/// Every chunk is passed to @c hasher right after it has been read, while
+/// it is still in the CPU cache. This saves a second pass over the data.
+///
+/// @param src The file_handle object to read from. Reading starts at the
+/// current file pointer.
+///
+/// @param dst The file_handle object to write to. Writing starts at the
+/// current file pointer.
+///
+/// @param hasher The hasher that is updated with the copied data.
+/// The type must satisfy the @ref concept-Hasher requirements.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+///
+/// @returns The number of bytes copied.
+template <class Hasher>
+ASIOEXT_DETAIL_COPYFILE_HASH_RET(Hasher)
+    copy_file(file_handle src, file_handle dst, Hasher& hasher,
+              error_code& ec);
+
+/// @}
+
+ASIOEXT_NS_END
+
+#include "asioext/impl/copy_file.hpp"
+
+#if defined(ASIOEXT_HEADER_ONLY)
+# include "asioext/impl/copy_file.cpp"
+#endif
+
+#endif
@@ -0,0 +1,83 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_DETAIL_ALLOCATORREALLOC_HPP
+#define ASIOEXT_DETAIL_ALLOCATORREALLOC_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+template <typename Allocator, typename = void>
+struct has_try_realloc : std::false_type
+{};
+
+template <typename Allocator>
+struct has_try_realloc<Allocator, void_t<
+  decltype(std::declval<Allocator&>().try_realloc(
+      std::declval<typename Allocator::value_type*>(),
+      std::size_t(), std::size_t()))
+>> : std::true_type
+{};
+
+template <typename Allocator, typename = void>
+struct has_expand : std::false_type
+{};
+
+template <typename Allocator>
+struct has_expand<Allocator, void_t<
+  decltype(std::declval<Allocator&>().expand(
+      std::declval<typename Allocator::value_type*>(),
+      std::size_t(), std::size_t()))
+>> : std::true_type
+{};
+
+// Resizes the block |p| of |n| elements to |new_n| elements without
+// going through allocate()/copy/deallocate(), if |Allocator| knows how.
+// Returns the (possibly moved) block on success, nullptr otherwise.
+// |p| stays valid if nullptr is returned.
+template <typename Allocator, typename T, typename HasExpand>
+T* try_realloc_impl(Allocator& a, T* p, std::size_t n, std::size_t new_n,
+                    std::true_type /*has_try_realloc*/, HasExpand)
+{
+  return a.try_realloc(p, n, new_n);
+}
+
+template <typename Allocator, typename T>
+T* try_realloc_impl(Allocator& a, T* p, std::size_t n, std::size_t new_n,
+                    std::false_type, std::true_type /*has_expand*/)
+{
+  return a.expand(p, n, new_n) ? p : nullptr;
+}
+
+template <typename Allocator, typename T>
+T* try_realloc_impl(Allocator&, T*, std::size_t, std::size_t,
+                    std::false_type, std::false_type)
+{
+  return nullptr;
+}
+
+template <typename Allocator, typename T>
+T* try_realloc(Allocator& a, T* p, std::size_t n, std::size_t new_n)
+{
+  return try_realloc_impl(a, p, n, new_n, has_try_realloc<Allocator>(),
+                          has_expand<Allocator>());
+}
+
+}
+
+ASIOEXT_NS_END
+
+#endif
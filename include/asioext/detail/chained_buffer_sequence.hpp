@@ -0,0 +1,183 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_DETAIL_CHAINEDBUFFERSEQUENCE_HPP
+#define ASIOEXT_DETAIL_CHAINEDBUFFERSEQUENCE_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/detail/cstdint.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+// A buffer sequence describing |size| bytes, starting |offset| bytes into
+// a list of equally sized segments.
+//
+// |SegmentIterator| is a random access iterator over uint8_t pointers.
+template <typename Buffer, typename SegmentIterator>
+class chained_buffer_sequence
+{
+public:
+  typedef Buffer value_type;
+
+  class const_iterator;
+
+  typedef const_iterator iterator;
+
+  chained_buffer_sequence() ASIOEXT_NOEXCEPT
+    : first_()
+    , segment_size_(1)
+    , offset_(0)
+    , size_(0)
+  {}
+
+  chained_buffer_sequence(SegmentIterator first, std::size_t segment_size,
+                          std::size_t offset, std::size_t size) ASIOEXT_NOEXCEPT
+    : first_(first + offset / segment_size)
+    , segment_size_(segment_size)
+    , offset_(offset % segment_size)
+    , size_(size)
+  {}
+
+  // Allows mutable sequences to be used as const ones.
+  template <typename OtherBuffer>
+  chained_buffer_sequence(const chained_buffer_sequence<
+                            OtherBuffer, SegmentIterator>& other) ASIOEXT_NOEXCEPT
+    : first_(other.first_)
+    , segment_size_(other.segment_size_)
+    , offset_(other.offset_)
+    , size_(other.size_)
+  {}
+
+  const_iterator begin() const ASIOEXT_NOEXCEPT
+  {
+    return const_iterator(*this, 0);
+  }
+
+  const_iterator end() const ASIOEXT_NOEXCEPT
+  {
+    return const_iterator(*this, count());
+  }
+
+  // Number of buffers in the sequence.
+  std::size_t count() const ASIOEXT_NOEXCEPT
+  {
+    if (size_ == 0)
+      return 0;
+    return (offset_ + size_ + segment_size_ - 1) / segment_size_;
+  }
+
+  // Total number of bytes.
+  std::size_t size() const ASIOEXT_NOEXCEPT
+  {
+    return size_;
+  }
+
+private:
+  template <typename OtherBuffer, typename OtherIterator>
+  friend class chained_buffer_sequence;
+
+  Buffer at(std::size_t index) const ASIOEXT_NOEXCEPT
+  {
+    const std::size_t segment_begin = index * segment_size_;
+    const std::size_t first = (std::max)(offset_, segment_begin);
+    const std::size_t last = (std::min)(offset_ + size_,
+                                        segment_begin + segment_size_);
+    return Buffer(first_[index] + (first - segment_begin), last - first);
+  }
+
+  SegmentIterator first_;
+  std::size_t segment_size_;
+  std::size_t offset_;
+  std::size_t size_;
+};
+
+template <typename Buffer, typename SegmentIterator>
+class chained_buffer_sequence<Buffer, SegmentIterator>::const_iterator
+{
+public:
+  typedef std::bidirectional_iterator_tag iterator_category;
+  typedef Buffer value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const Buffer* pointer;
+  // Buffers are computed on the fly, we have nothing to refer to.
+  typedef Buffer reference;
+
+  const_iterator() ASIOEXT_NOEXCEPT
+    : index_(0)
+  {}
+
+  reference operator*() const ASIOEXT_NOEXCEPT
+  {
+    return seq_.at(index_);
+  }
+
+  const_iterator& operator++() ASIOEXT_NOEXCEPT
+  {
+    ++index_;
+    return *this;
+  }
+
+  const_iterator operator++(int) ASIOEXT_NOEXCEPT
+  {
+    const_iterator tmp(*this);
+    ++index_;
+    return tmp;
+  }
+
+  const_iterator& operator--() ASIOEXT_NOEXCEPT
+  {
+    --index_;
+    return *this;
+  }
+
+  const_iterator operator--(int) ASIOEXT_NOEXCEPT
+  {
+    const_iterator tmp(*this);
+    --index_;
+    return tmp;
+  }
+
+  friend bool operator==(const const_iterator& a,
+                         const const_iterator& b) ASIOEXT_NOEXCEPT
+  {
+    return a.index_ == b.index_;
+  }
+
+  friend bool operator!=(const const_iterator& a,
+                         const const_iterator& b) ASIOEXT_NOEXCEPT
+  {
+    return a.index_ != b.index_;
+  }
+
+private:
+  friend class chained_buffer_sequence;
+
+  const_iterator(const chained_buffer_sequence& seq,
+                 std::size_t index) ASIOEXT_NOEXCEPT
+    : seq_(seq)
+    , index_(index)
+  {}
+
+  // A copy, so iterators stay valid if the sequence object goes away.
+  chained_buffer_sequence seq_;
+  std::size_t index_;
+};
+
+}
+
+ASIOEXT_NS_END
+
+#endif
@@ -0,0 +1,45 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_DETAIL_FINDDELIMITER_HPP
+#define ASIOEXT_DETAIL_FINDDELIMITER_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/detail/cstdint.hpp"
+
+#include <cstddef>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+// Returns the first occurrence of |c| in [first, last), or |last|.
+// Compares 16 (SSE2) or 32 (AVX2) bytes at a time if available.
+ASIOEXT_DECL const uint8_t* find_byte(const uint8_t* first,
+                                      const uint8_t* last,
+                                      uint8_t c) ASIOEXT_NOEXCEPT;
+
+// Returns the first occurrence of the |n| bytes at |needle| in
+// [first, last), or |last|. Candidates are found by comparing the first and
+// last byte of the needle against 16 (32) positions at a time.
+ASIOEXT_DECL const uint8_t* find_bytes(const uint8_t* first,
+                                       const uint8_t* last,
+                                       const uint8_t* needle,
+                                       std::size_t n) ASIOEXT_NOEXCEPT;
+
+}
+
+ASIOEXT_NS_END
+
+#if defined(ASIOEXT_HEADER_ONLY)
+# include "asioext/detail/impl/find_delimiter.cpp"
+#endif
+
+#endif
@@ -0,0 +1,37 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_DETAIL_HASHING_HPP
+#define ASIOEXT_DETAIL_HASHING_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+// Transfers that feed a Hasher are split into chunks of this size, so that
+// each chunk is still cache-hot when it's hashed (or written) right after
+// being read (or hashed).
+static constexpr std::size_t hashing_chunk_size = 64 * 1024;
+
+// A Hasher that does nothing, for code paths shared with
+// the non-hashing variants.
+struct null_hasher
+{
+  void update(const void*, std::size_t) ASIOEXT_NOEXCEPT {}
+};
+
+}
+
+ASIOEXT_NS_END
+
+#endif
@@ -0,0 +1,139 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/detail/find_delimiter.hpp"
+
+#include <cstring>
+
+#if defined(__AVX2__)
+# include <immintrin.h>
+# define ASIOEXT_FIND_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define ASIOEXT_FIND_SSE2 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+# include <intrin.h>
+#endif
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+#if defined(ASIOEXT_FIND_AVX2) || defined(ASIOEXT_FIND_SSE2)
+// |mask| must not be 0.
+static inline unsigned int lowest_bit(uint32_t mask) ASIOEXT_NOEXCEPT
+{
+# if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return index;
+# else
+  return __builtin_ctz(mask);
+# endif
+}
+#endif
+
+#if defined(ASIOEXT_FIND_AVX2)
+typedef __m256i simd_type;
+static const std::size_t simd_width = 32;
+
+static inline simd_type simd_splat(uint8_t c) ASIOEXT_NOEXCEPT
+{
+  return _mm256_set1_epi8(static_cast<char>(c));
+}
+
+// Returns a bit for each byte at |p| that equals the respective byte
+// of |pattern|.
+static inline uint32_t simd_match(const uint8_t* p,
+                                  simd_type pattern) ASIOEXT_NOEXCEPT
+{
+  const simd_type block =
+      _mm256_loadu_si256(reinterpret_cast<const simd_type*>(p));
+  return static_cast<uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+}
+#elif defined(ASIOEXT_FIND_SSE2)
+typedef __m128i simd_type;
+static const std::size_t simd_width = 16;
+
+static inline simd_type simd_splat(uint8_t c) ASIOEXT_NOEXCEPT
+{
+  return _mm_set1_epi8(static_cast<char>(c));
+}
+
+static inline uint32_t simd_match(const uint8_t* p,
+                                  simd_type pattern) ASIOEXT_NOEXCEPT
+{
+  const simd_type block =
+      _mm_loadu_si128(reinterpret_cast<const simd_type*>(p));
+  return static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+}
+#endif
+
+const uint8_t* find_byte(const uint8_t* first, const uint8_t* last,
+                         uint8_t c) ASIOEXT_NOEXCEPT
+{
+#if defined(ASIOEXT_FIND_AVX2) || defined(ASIOEXT_FIND_SSE2)
+  const simd_type pattern = simd_splat(c);
+  for (; static_cast<std::size_t>(last - first) >= simd_width;
+       first += simd_width) {
+    const uint32_t mask = simd_match(first, pattern);
+    if (mask != 0)
+      return first + lowest_bit(mask);
+  }
+#endif
+
+  if (first == last)
+    return last;
+  const void* p = std::memchr(first, c, last - first);
+  return p ? static_cast<const uint8_t*>(p) : last;
+}
+
+const uint8_t* find_bytes(const uint8_t* first, const uint8_t* last,
+                          const uint8_t* needle,
+                          std::size_t n) ASIOEXT_NOEXCEPT
+{
+  if (n == 1)
+    return find_byte(first, last, needle[0]);
+  if (n == 0 || static_cast<std::size_t>(last - first) < n)
+    return last;
+
+#if defined(ASIOEXT_FIND_AVX2) || defined(ASIOEXT_FIND_SSE2)
+  // Only positions where both the first and the last byte match are
+  // compared in full.
+  const simd_type head = simd_splat(needle[0]);
+  const simd_type tail = simd_splat(needle[n - 1]);
+  for (; static_cast<std::size_t>(last - first) >= simd_width + n - 1;
+       first += simd_width) {
+    uint32_t mask = simd_match(first, head) &
+                    simd_match(first + n - 1, tail);
+    while (mask != 0) {
+      const uint8_t* candidate = first + lowest_bit(mask);
+      if (std::memcmp(candidate + 1, needle + 1, n - 2) == 0)
+        return candidate;
+      mask &= mask - 1;
+    }
+  }
+#endif
+
+  while (static_cast<std::size_t>(last - first) >= n) {
+    const void* p = std::memchr(first, needle[0], (last - first) - n + 1);
+    if (!p)
+      break;
+    const uint8_t* candidate = static_cast<const uint8_t*>(p);
+    if (std::memcmp(candidate, needle, n) == 0)
+      return candidate;
+    first = candidate + 1;
+  }
+  return last;
+}
+
+}
+
+ASIOEXT_NS_END
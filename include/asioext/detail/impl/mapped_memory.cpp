@@ -0,0 +1,164 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/detail/mapped_memory.hpp"
+
+#include <cstdio>
+#include <limits>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+namespace mapped_memory {
+
+namespace {
+
+// Returns 0 if |size| can't be rounded up.
+std::size_t round_up(std::size_t size, std::size_t page_size) ASIOEXT_NOEXCEPT
+{
+  if (size == 0)
+    return page_size;
+  if (size > (std::numeric_limits<std::size_t>::max)() - (page_size - 1))
+    return 0;
+  return (size + page_size - 1) & ~(page_size - 1);
+}
+
+std::size_t round_up(std::size_t size) ASIOEXT_NOEXCEPT
+{
+  return round_up(size, granularity());
+}
+
+std::size_t read_huge_page_size() ASIOEXT_NOEXCEPT
+{
+  std::size_t size = 2 * 1024 * 1024;
+
+  std::FILE* f = std::fopen("/proc/meminfo", "r");
+  if (!f)
+    return size;
+
+  char line[128];
+  unsigned long kib;
+  while (std::fgets(line, sizeof(line), f)) {
+    if (std::sscanf(line, "Hugepagesize: %lu kB", &kib) == 1) {
+      if (kib != 0 && (kib & (kib - 1)) == 0)
+        size = static_cast<std::size_t>(kib) * 1024;
+      break;
+    }
+  }
+  std::fclose(f);
+  return size;
+}
+
+}
+
+std::size_t granularity() ASIOEXT_NOEXCEPT
+{
+  static const std::size_t page_size =
+      static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+void* map(std::size_t size) ASIOEXT_NOEXCEPT
+{
+  size = round_up(size);
+  if (size == 0)
+    return nullptr;
+
+  void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  return data != MAP_FAILED ? data : nullptr;
+}
+
+void unmap(void* data, std::size_t size) ASIOEXT_NOEXCEPT
+{
+  ::munmap(data, round_up(size));
+}
+
+void* remap(void* data, std::size_t size,
+            std::size_t new_size) ASIOEXT_NOEXCEPT
+{
+  size = round_up(size);
+  new_size = round_up(new_size);
+  if (new_size == 0)
+    return nullptr;
+
+  // Still fits into the pages we have.
+  if (size == new_size)
+    return data;
+
+  // The kernel moves page table entries around, it doesn't copy.
+  void* new_data = ::mremap(data, size, new_size, MREMAP_MAYMOVE);
+  return new_data != MAP_FAILED ? new_data : nullptr;
+}
+
+std::size_t huge_page_size() ASIOEXT_NOEXCEPT
+{
+  static const std::size_t page_size = read_huge_page_size();
+  return page_size;
+}
+
+void* map_huge(std::size_t size, bool prefault) ASIOEXT_NOEXCEPT
+{
+  const std::size_t page_size = huge_page_size();
+  size = round_up(size, page_size);
+  if (size == 0)
+    return nullptr;
+
+#if defined(MAP_HUGETLB)
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+  if (prefault)
+    flags |= MAP_POPULATE;
+
+  void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (data != MAP_FAILED)
+    return data;
+#endif
+
+  // No reserved huge pages. Transparent huge pages only back huge page
+  // aligned ranges, so we map a bit more and cut off the excess.
+  if (size > (std::numeric_limits<std::size_t>::max)() - page_size)
+    return nullptr;
+
+  const std::size_t map_size = size + page_size - granularity();
+  void* raw = ::mmap(nullptr, map_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED)
+    return nullptr;
+
+  char* first = static_cast<char*>(raw);
+  char* aligned = reinterpret_cast<char*>(
+      (reinterpret_cast<std::size_t>(first) + page_size - 1) &
+      ~(page_size - 1));
+  char* last = first + map_size;
+  if (aligned != first)
+    ::munmap(first, aligned - first);
+  if (aligned + size != last)
+    ::munmap(aligned + size, last - (aligned + size));
+
+#if defined(MADV_HUGEPAGE)
+  ::madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+
+  if (prefault) {
+    // A write fault per huge page (or per page, if THP are disabled).
+    const std::size_t step = granularity();
+    for (std::size_t i = 0; i < size; i += step)
+      static_cast<volatile char*>(static_cast<void*>(aligned))[i] = 0;
+  }
+  return aligned;
+}
+
+void unmap_huge(void* data, std::size_t size) ASIOEXT_NOEXCEPT
+{
+  ::munmap(data, round_up(size, huge_page_size()));
+}
+
+}
+}
+
+ASIOEXT_NS_END
@@ -0,0 +1,82 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/detail/mirrored_mapping.hpp"
+#include "asioext/detail/posix_file_ops.hpp"
+#include "asioext/detail/error.hpp"
+
+#include <cerrno>
+#include <limits>
+
+#include <sys/mman.h>
+#include <sys/types.h> // for off_t
+#include <unistd.h>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+namespace mirrored_mapping {
+
+std::size_t granularity() ASIOEXT_NOEXCEPT
+{
+  static const std::size_t page_size =
+      static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+uint8_t* map(std::size_t size, error_code& ec) ASIOEXT_NOEXCEPT
+{
+  if (size == 0 || size % granularity() != 0 ||
+      size > (std::numeric_limits<std::size_t>::max)() / 2 ||
+      size > static_cast<uint64_t>((std::numeric_limits<off_t>::max)())) {
+    ec = asio::error::invalid_argument;
+    return nullptr;
+  }
+
+  const int fd = ::memfd_create("asioext_ring", MFD_CLOEXEC);
+  if (fd == -1) {
+    posix_file_ops::set_error(ec, errno);
+    return nullptr;
+  }
+
+  uint8_t* result = nullptr;
+  if (::ftruncate(fd, static_cast<off_t>(size)) == 0) {
+    // Reserve a contiguous range first, then replace both halves
+    // with views of the same memory.
+    void* base = ::mmap(nullptr, size * 2, PROT_NONE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base != MAP_FAILED) {
+      uint8_t* p = static_cast<uint8_t*>(base);
+      if (::mmap(p, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+                 fd, 0) != MAP_FAILED &&
+          ::mmap(p + size, size, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED) {
+        result = p;
+        ec = error_code();
+      } else {
+        posix_file_ops::set_error(ec, errno);
+        ::munmap(base, size * 2);
+      }
+    } else {
+      posix_file_ops::set_error(ec, errno);
+    }
+  } else {
+    posix_file_ops::set_error(ec, errno);
+  }
+
+  // The mappings keep the memory alive.
+  ::close(fd);
+  return result;
+}
+
+void unmap(uint8_t* data, std::size_t size) ASIOEXT_NOEXCEPT
+{
+  ::munmap(data, size * 2);
+}
+
+}
+}
+
+ASIOEXT_NS_END
@@ -0,0 +1,368 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/parallel_walk.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+// A directory that still needs to be read.
+struct walk_directory
+{
+  std::shared_ptr<const directory_handle> parent;
+  // Relative to |parent|.
+  std::string name;
+  // Relative to the root.
+  std::string path;
+  std::size_t depth;
+};
+
+// Every worker owns one of these. The owner pushes and pops at the back
+// (depth-first, so the parent's handle and inodes are still hot), while
+// thieves take from the front.
+class walk_queue
+{
+public:
+  void push(walk_directory&& dir)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dirs_.push_back(std::move(dir));
+  }
+
+  bool pop(walk_directory& dir)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dirs_.empty())
+      return false;
+    dir = std::move(dirs_.back());
+    dirs_.pop_back();
+    return true;
+  }
+
+  bool steal(walk_directory& dir)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dirs_.empty())
+      return false;
+    dir = std::move(dirs_.front());
+    dirs_.pop_front();
+    return true;
+  }
+
+private:
+  std::mutex mutex_;
+  std::deque<walk_directory> dirs_;
+};
+
+class walk_state
+{
+public:
+  walk_state(std::size_t num_workers, const walk_options& options,
+             walk_visit_function visit, void* visitor)
+    : options_(options)
+    , visit_(visit)
+    , visitor_(visitor)
+    , queues_(new walk_queue[num_workers])
+    , num_workers_(num_workers)
+    , pending_(0)
+    , queued_(0)
+    , sleepers_(0)
+    , stopped_(false)
+    , visited_(0)
+  {
+    // ctor
+  }
+
+  void push(std::size_t worker, walk_directory&& dir)
+  {
+    // Counters first, so |pending_| can't drop to 0 while |dir| is queued
+    // and |queued_| can't underflow.
+    pending_.fetch_add(1);
+    queued_.fetch_add(1);
+    queues_[worker].push(std::move(dir));
+
+    if (sleepers_.load() != 0) {
+      std::lock_guard<std::mutex> lock(idle_mutex_);
+      idle_cv_.notify_one();
+    }
+  }
+
+  bool get(std::size_t worker, walk_directory& dir)
+  {
+    while (!stopped_.load(std::memory_order_relaxed)) {
+      if (try_get(worker, dir)) {
+        queued_.fetch_sub(1);
+        return true;
+      }
+
+      std::unique_lock<std::mutex> lock(idle_mutex_);
+      sleepers_.fetch_add(1);
+      while (queued_.load() == 0 && pending_.load() != 0 &&
+             !stopped_.load())
+        idle_cv_.wait(lock);
+      sleepers_.fetch_sub(1);
+
+      if (pending_.load() == 0)
+        return false;
+    }
+    return false;
+  }
+
+  void done()
+  {
+    if (pending_.fetch_sub(1) == 1) {
+      std::lock_guard<std::mutex> lock(idle_mutex_);
+      idle_cv_.notify_all();
+    }
+  }
+
+  void stop()
+  {
+    stopped_.store(true);
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    idle_cv_.notify_all();
+  }
+
+  bool stopped() const
+  {
+    return stopped_.load(std::memory_order_relaxed);
+  }
+
+  void set_error(const error_code& ec)
+  {
+    if (options_.skip_errors)
+      return;
+
+    {
+      std::lock_guard<std::mutex> lock(error_mutex_);
+      if (!error_)
+        error_ = ec;
+    }
+    stop();
+  }
+
+  void set_exception(std::exception_ptr e)
+  {
+    {
+      std::lock_guard<std::mutex> lock(error_mutex_);
+      if (!exception_)
+        exception_ = std::move(e);
+    }
+    stop();
+  }
+
+  walk_action visit(const walk_entry& entry)
+  {
+    visited_.fetch_add(1, std::memory_order_relaxed);
+    return visit_(visitor_, entry);
+  }
+
+  const walk_options& options() const { return options_; }
+  uint64_t visited() const { return visited_.load(); }
+  const error_code& error() const { return error_; }
+  const std::exception_ptr& exception() const { return exception_; }
+
+private:
+  bool try_get(std::size_t worker, walk_directory& dir)
+  {
+    if (queues_[worker].pop(dir))
+      return true;
+
+    for (std::size_t i = 1; i != num_workers_; ++i) {
+      if (queues_[(worker + i) % num_workers_].steal(dir))
+        return true;
+    }
+    return false;
+  }
+
+  const walk_options& options_;
+  walk_visit_function visit_;
+  void* visitor_;
+
+  std::unique_ptr<walk_queue[]> queues_;
+  std::size_t num_workers_;
+
+  // Directories that are either queued or being processed.
+  std::atomic<std::size_t> pending_;
+  std::atomic<std::size_t> queued_;
+  std::atomic<std::size_t> sleepers_;
+  std::atomic<bool> stopped_;
+  std::atomic<uint64_t> visited_;
+
+  std::mutex idle_mutex_;
+  std::condition_variable idle_cv_;
+
+  std::mutex error_mutex_;
+  error_code error_;
+  std::exception_ptr exception_;
+};
+
+class walk_worker
+{
+public:
+  walk_worker(walk_state& state, std::size_t index)
+    : state_(state)
+    , index_(index)
+    , reader_(directory_handle(), state.options().buffer_size)
+  {
+    // ctor
+  }
+
+  void operator()()
+  {
+    try {
+      walk_directory dir;
+      while (state_.get(index_, dir)) {
+        process(dir);
+        state_.done();
+      }
+    } catch (...) {
+      state_.set_exception(std::current_exception());
+    }
+  }
+
+private:
+  void process(walk_directory& dir)
+  {
+    const walk_options& options = state_.options();
+
+    error_code ec;
+    directory_handle handle = open_directory(*dir.parent, dir.name.c_str(),
+                                             ec);
+    if (ec) {
+      state_.set_error(ec);
+      return;
+    }
+
+    reader_.assign(std::move(handle));
+    subdirs_.clear();
+
+    const std::size_t depth = dir.depth + 1;
+    while (!state_.stopped()) {
+      entries_.clear();
+      if (reader_.read(entries_, ec) == 0) {
+        if (ec)
+          state_.set_error(ec);
+        break;
+      }
+
+      for (directory_entry& entry : entries_) {
+        file_info info;
+        if (options.stat_entries || entry.type == file_type::unknown) {
+          info = reader_.stat(entry, ec);
+          if (ec) {
+            // Probably removed since we read the directory.
+            state_.set_error(ec);
+            continue;
+          }
+          entry.type = info.type;
+        }
+
+        const walk_entry e = {
+          reader_.directory(), dir.path, entry, depth,
+          options.stat_entries ? &info : nullptr
+        };
+
+        const walk_action action = state_.visit(e);
+        if (action == walk_action::stop) {
+          state_.stop();
+          return;
+        }
+
+        if (action == walk_action::proceed &&
+            entry.type == file_type::directory &&
+            depth < options.max_depth)
+          subdirs_.push_back(std::move(entry.name));
+      }
+    }
+
+    if (subdirs_.empty() || state_.stopped())
+      return;
+
+    std::shared_ptr<const directory_handle> parent =
+        std::make_shared<directory_handle>(reader_.release());
+    for (std::string& name : subdirs_) {
+      walk_directory subdir;
+      subdir.parent = parent;
+      subdir.path = dir.path.empty() ? name : dir.path + '/' + name;
+      subdir.name = std::move(name);
+      subdir.depth = depth;
+      state_.push(index_, std::move(subdir));
+    }
+  }
+
+  walk_state& state_;
+  std::size_t index_;
+
+  // Reused for all directories this worker reads.
+  directory_reader reader_;
+  std::vector<directory_entry> entries_;
+  std::vector<std::string> subdirs_;
+};
+
+uint64_t parallel_walk(const char* root, walk_visit_function visit,
+                       void* visitor, const walk_options& options,
+                       error_code& ec)
+{
+  std::size_t num_workers = options.threads;
+  if (num_workers == 0)
+    num_workers = std::thread::hardware_concurrency();
+  if (num_workers == 0)
+    num_workers = 1;
+
+  // Errors opening the root are reported even if |options.skip_errors|
+  // is set. Workers then re-open it like any other directory.
+  walk_directory dir;
+  dir.parent = std::make_shared<directory_handle>(open_directory(root, ec));
+  if (ec)
+    return 0;
+
+  if (options.max_depth == 0)
+    return 0;
+
+  dir.name = ".";
+  dir.depth = 0;
+
+  walk_state state(num_workers, options, visit, visitor);
+  state.push(0, std::move(dir));
+
+  std::vector<walk_worker> workers;
+  workers.reserve(num_workers);
+  for (std::size_t i = 0; i != num_workers; ++i)
+    workers.emplace_back(state, i);
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_workers - 1);
+  try {
+    for (std::size_t i = 1; i != num_workers; ++i)
+      threads.emplace_back(std::ref(workers[i]));
+  } catch (...) {
+    // Just run with the threads we got.
+  }
+
+  workers[0]();
+  for (std::thread& t : threads)
+    t.join();
+
+  if (state.exception())
+    std::rethrow_exception(state.exception());
+
+  ec = state.error();
+  return state.visited();
+}
+
+}
+
+ASIOEXT_NS_END
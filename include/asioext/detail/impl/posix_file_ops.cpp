@@ -3,6 +3,7 @@
 /// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include "asioext/open_args.hpp"
+#include "asioext/file_info.hpp"
 
 #include "asioext/detail/posix_file_ops.hpp"
 #include "asioext/detail/chrono.hpp"
@@ -13,13 +14,35 @@
 #endif
 
 #include <cerrno>
+#include <cstring> // for memset
+#include <limits>
 
 #include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 #include <sys/stat.h>
 #include <sys/types.h> // for off_t etc.
 #include <sys/time.h> // for utimes
 
+#if defined(ASIOEXT_HAS_GETDENTS64)
+# include <sys/syscall.h>
+#endif
+
+#if defined(__linux__) && !defined(ASIOEXT_DISABLE_STATX)
+# if defined(STATX_BASIC_STATS)
+#  include <sys/sysmacros.h> // for makedev
+#  define ASIOEXT_HAS_STATX 1
+# endif
+#endif
+
+#if defined(__linux__) && !defined(ASIOEXT_DISABLE_OPENAT2)
+# include <sys/syscall.h>
+# if defined(SYS_openat2) && __has_include(<linux/openat2.h>)
+#  include <linux/openat2.h>
+#  define ASIOEXT_HAS_OPENAT2 1
+# endif
+#endif
+
 #if !defined(ASIOEXT_USE_FUTIMENS) && !defined(ASIOEXT_DISABLE_FUTIMENS)
 # if defined(__linux__)
 // __USE_XOPEN2K8 should be enough
@@ -269,6 +292,343 @@ handle_type open(const char* path, const open_args& args,
   }
 }
 
+// An empty (-1) |dir| means "relative to the current working directory".
+static int to_native_dir(handle_type dir) ASIOEXT_NOEXCEPT
+{
+  return dir != -1 ? dir : AT_FDCWD;
+}
+
+#if defined(ASIOEXT_HAS_OPENAT2)
+static uint64_t resolve_flags_to_native(resolve_flags flags) ASIOEXT_NOEXCEPT
+{
+  uint64_t native = 0;
+  if ((flags & resolve_flags::beneath) != resolve_flags::none)
+    native |= RESOLVE_BENEATH;
+  if ((flags & resolve_flags::in_root) != resolve_flags::none)
+    native |= RESOLVE_IN_ROOT;
+  if ((flags & resolve_flags::no_symlinks) != resolve_flags::none)
+    native |= RESOLVE_NO_SYMLINKS;
+  if ((flags & resolve_flags::no_magic_links) != resolve_flags::none)
+    native |= RESOLVE_NO_MAGICLINKS;
+  if ((flags & resolve_flags::no_cross_device) != resolve_flags::none)
+    native |= RESOLVE_NO_XDEV;
+  return native;
+}
+#endif
+
+// Common part of openat() and open_directory(), |flags| must already
+// include O_CLOEXEC.
+static handle_type openat_aux(handle_type dir, const char* path, int flags,
+                              mode_t mode, resolve_flags resolve,
+                              error_code& ec) ASIOEXT_NOEXCEPT
+{
+  if (resolve != resolve_flags::none) {
+#if defined(ASIOEXT_HAS_OPENAT2)
+    struct open_how how = {};
+    how.flags = static_cast<uint64_t>(flags);
+    // openat2() is strict about this and fails with EINVAL otherwise.
+    if ((flags & O_CREAT) != 0)
+      how.mode = mode;
+    how.resolve = resolve_flags_to_native(resolve);
+
+    while (true) {
+      const long fd = ::syscall(SYS_openat2, to_native_dir(dir), path,
+                                &how, sizeof(how));
+      if (fd != -1) {
+        ec = error_code();
+        return static_cast<handle_type>(fd);
+      }
+
+      const int e = errno;
+      if (e == EINTR || e == EAGAIN)
+        continue;
+
+      if (e == ENOSYS)
+        ec = asio::error::operation_not_supported;
+      else
+        set_error(ec, e);
+      return -1;
+    }
+#else
+    ec = asio::error::operation_not_supported;
+    return -1;
+#endif
+  }
+
+  while (true) {
+    const handle_type fd = ::openat(to_native_dir(dir), path, flags, mode);
+    if (fd != -1) {
+      ec = error_code();
+      return fd;
+    }
+
+    const int e = errno;
+    if (e == EINTR)
+      continue;
+
+    set_error(ec, e);
+    return -1;
+  }
+}
+
+handle_type openat(handle_type dir, const char* path, const open_args& args,
+                   resolve_flags resolve, error_code& ec) ASIOEXT_NOEXCEPT
+{
+  const handle_type fd = openat_aux(dir, path,
+                                    O_CLOEXEC | args.native_flags(),
+                                    static_cast<mode_t>(args.mode()),
+                                    resolve, ec);
+#if ASIOEXT_HAS_FILE_FLAGS
+  if (fd != -1 && args.attrs() != 0 && ::fchflags(fd, args.attrs()) != 0) {
+    set_error(ec, errno);
+    ::close(fd);
+    return -1;
+  }
+#endif
+  return fd;
+}
+
+handle_type open_directory(handle_type dir, const char* path,
+                           resolve_flags resolve,
+                           error_code& ec) ASIOEXT_NOEXCEPT
+{
+  // Not O_PATH: We want to be able to read the directory's entries.
+  return openat_aux(dir, path, O_CLOEXEC | O_RDONLY | O_DIRECTORY, 0,
+                    resolve, ec);
+}
+
+static file_type mode_to_file_type(mode_t mode) ASIOEXT_NOEXCEPT
+{
+  if (S_ISREG(mode))
+    return file_type::regular;
+  if (S_ISDIR(mode))
+    return file_type::directory;
+  if (S_ISLNK(mode))
+    return file_type::symlink;
+  if (S_ISBLK(mode))
+    return file_type::block;
+  if (S_ISCHR(mode))
+    return file_type::character;
+  if (S_ISFIFO(mode))
+    return file_type::fifo;
+  if (S_ISSOCK(mode))
+    return file_type::socket;
+  return file_type::unknown;
+}
+
+// Deliberately unlisted in the header so we don't have to #include <sys/stat.h>
+inline bool stat_to_file_info(const struct stat& st, file_info_mask mask,
+                              file_info& info) ASIOEXT_NOEXCEPT
+{
+  if ((mask & file_info_mask::type) != file_info_mask::none)
+    info.type = mode_to_file_type(st.st_mode);
+  if ((mask & file_info_mask::perms) != file_info_mask::none)
+    info.perms = static_cast<file_perms>(st.st_mode) & file_perms::mask;
+#if ASIOEXT_HAS_FILE_FLAGS
+  if ((mask & file_info_mask::attrs) != file_info_mask::none)
+    info.attrs = native_to_file_attrs(st.st_flags);
+#endif
+  if ((mask & file_info_mask::size) != file_info_mask::none)
+    info.size = static_cast<uint64_t>(st.st_size);
+  if ((mask & file_info_mask::inode) != file_info_mask::none)
+    info.inode = static_cast<uint64_t>(st.st_ino);
+  if ((mask & file_info_mask::device) != file_info_mask::none)
+    info.device = static_cast<uint64_t>(st.st_dev);
+  if ((mask & file_info_mask::hard_links) != file_info_mask::none)
+    info.hard_links = static_cast<uint64_t>(st.st_nlink);
+  if ((mask & file_info_mask::block_size) != file_info_mask::none)
+    info.block_size = static_cast<uint32_t>(st.st_blksize);
+  if ((mask & file_info_mask::times) == file_info_mask::none)
+    return true;
+
+  file_times times;
+  if (!stat_to_times(st, times.ctime, times.atime, times.mtime))
+    return false;
+  if ((mask & file_info_mask::ctime) != file_info_mask::none)
+    info.times.ctime = times.ctime;
+  if ((mask & file_info_mask::atime) != file_info_mask::none)
+    info.times.atime = times.atime;
+  if ((mask & file_info_mask::mtime) != file_info_mask::none)
+    info.times.mtime = times.mtime;
+  return true;
+}
+
+#if defined(ASIOEXT_HAS_STATX)
+static unsigned int file_info_mask_to_statx(file_info_mask mask) ASIOEXT_NOEXCEPT
+{
+  // st_dev and st_blksize are always returned.
+  unsigned int native = 0;
+  if ((mask & file_info_mask::type) != file_info_mask::none)
+    native |= STATX_TYPE;
+  if ((mask & file_info_mask::perms) != file_info_mask::none)
+    native |= STATX_MODE;
+  if ((mask & file_info_mask::size) != file_info_mask::none)
+    native |= STATX_SIZE;
+  if ((mask & file_info_mask::inode) != file_info_mask::none)
+    native |= STATX_INO;
+  if ((mask & file_info_mask::hard_links) != file_info_mask::none)
+    native |= STATX_NLINK;
+  if ((mask & file_info_mask::ctime) != file_info_mask::none)
+    native |= STATX_BTIME;
+  if ((mask & file_info_mask::atime) != file_info_mask::none)
+    native |= STATX_ATIME;
+  if ((mask & file_info_mask::mtime) != file_info_mask::none)
+    native |= STATX_MTIME;
+  return native;
+}
+
+static bool statx_to_time(const struct statx_timestamp& ts,
+                          file_time_type& t) ASIOEXT_NOEXCEPT
+{
+  file_time_type::duration d;
+  if (!compose_time(chrono::seconds(ts.tv_sec),
+                    chrono::nanoseconds(ts.tv_nsec), d))
+    return false;
+  t = file_time_type(d);
+  return true;
+}
+
+// Members the file system couldn't provide (i.e. missing from stx_mask)
+// are left alone.
+static bool statx_to_file_info(const struct statx& stx, file_info_mask mask,
+                               file_info& info) ASIOEXT_NOEXCEPT
+{
+  const unsigned int valid = stx.stx_mask;
+  if ((mask & file_info_mask::type) != file_info_mask::none &&
+      (valid & STATX_TYPE))
+    info.type = mode_to_file_type(stx.stx_mode);
+  if ((mask & file_info_mask::perms) != file_info_mask::none &&
+      (valid & STATX_MODE))
+    info.perms = static_cast<file_perms>(stx.stx_mode) & file_perms::mask;
+  if ((mask & file_info_mask::size) != file_info_mask::none &&
+      (valid & STATX_SIZE))
+    info.size = stx.stx_size;
+  if ((mask & file_info_mask::inode) != file_info_mask::none &&
+      (valid & STATX_INO))
+    info.inode = stx.stx_ino;
+  if ((mask & file_info_mask::device) != file_info_mask::none)
+    info.device = static_cast<uint64_t>(makedev(stx.stx_dev_major,
+                                                stx.stx_dev_minor));
+  if ((mask & file_info_mask::hard_links) != file_info_mask::none &&
+      (valid & STATX_NLINK))
+    info.hard_links = stx.stx_nlink;
+  if ((mask & file_info_mask::block_size) != file_info_mask::none)
+    info.block_size = stx.stx_blksize;
+  if ((mask & file_info_mask::ctime) != file_info_mask::none &&
+      (valid & STATX_BTIME) && !statx_to_time(stx.stx_btime, info.times.ctime))
+    return false;
+  if ((mask & file_info_mask::atime) != file_info_mask::none &&
+      (valid & STATX_ATIME) && !statx_to_time(stx.stx_atime, info.times.atime))
+    return false;
+  if ((mask & file_info_mask::mtime) != file_info_mask::none &&
+      (valid & STATX_MTIME) && !statx_to_time(stx.stx_mtime, info.times.mtime))
+    return false;
+  return true;
+}
+
+// Returns false if statx() isn't supported by the kernel, in which case
+// the caller should fall back to stat().
+static bool statx_aux(int dir, const char* path, int flags,
+                      file_info_mask mask, file_info& info,
+                      error_code& ec) ASIOEXT_NOEXCEPT
+{
+  struct statx stx;
+  if (::statx(dir, path, flags, file_info_mask_to_statx(mask), &stx) == 0) {
+    if (statx_to_file_info(stx, mask, info))
+      ec = error_code();
+    else
+      ec = make_error_code(errc::value_too_large);
+    return true;
+  }
+  if (errno == ENOSYS)
+    return false;
+  set_error(ec, errno);
+  return true;
+}
+#endif
+
+void query(handle_type fd, file_info_mask mask, file_info& info,
+           error_code& ec) ASIOEXT_NOEXCEPT
+{
+#if defined(ASIOEXT_HAS_STATX)
+  if (statx_aux(fd, "", AT_EMPTY_PATH, mask, info, ec))
+    return;
+#endif
+
+  struct stat st;
+  if (::fstat(fd, &st) == 0) {
+    if (stat_to_file_info(st, mask, info))
+      ec = error_code();
+    else
+      ec = make_error_code(errc::value_too_large);
+    return;
+  }
+  set_error(ec, errno);
+}
+
+void query_at(handle_type dir, const char* path, bool follow_symlinks,
+              file_info_mask mask, file_info& info,
+              error_code& ec) ASIOEXT_NOEXCEPT
+{
+  const int flags = follow_symlinks ? 0 : AT_SYMLINK_NOFOLLOW;
+#if defined(ASIOEXT_HAS_STATX)
+  if (statx_aux(to_native_dir(dir), path, flags, mask, info, ec))
+    return;
+#endif
+
+  struct stat st;
+  if (::fstatat(to_native_dir(dir), path, &st, flags) == 0) {
+    if (stat_to_file_info(st, mask, info))
+      ec = error_code();
+    else
+      ec = make_error_code(errc::value_too_large);
+    return;
+  }
+  set_error(ec, errno);
+}
+
+void unlink_at(handle_type dir, const char* path, bool directory,
+               error_code& ec) ASIOEXT_NOEXCEPT
+{
+  if (::unlinkat(to_native_dir(dir), path, directory ? AT_REMOVEDIR : 0) == 0)
+    ec = error_code();
+  else
+    set_error(ec, errno);
+}
+
+void rename_at(handle_type old_dir, const char* old_path,
+               handle_type new_dir, const char* new_path,
+               error_code& ec) ASIOEXT_NOEXCEPT
+{
+  if (::renameat(to_native_dir(old_dir), old_path,
+                 to_native_dir(new_dir), new_path) == 0)
+    ec = error_code();
+  else
+    set_error(ec, errno);
+}
+
+#if defined(ASIOEXT_HAS_GETDENTS64)
+std::size_t read_directory(handle_type dir, void* buffer, std::size_t size,
+                           error_code& ec) ASIOEXT_NOEXCEPT
+{
+  while (true) {
+    // Not every libc has a getdents64() wrapper.
+    const long r = ::syscall(SYS_getdents64, dir, buffer, size);
+    if (r >= 0) {
+      ec = error_code();
+      return static_cast<std::size_t>(r);
+    }
+
+    const int e = errno;
+    if (e == EINTR)
+      continue;
+
+    set_error(ec, e);
+    return 0;
+  }
+}
+#endif
+
 void close(handle_type fd, error_code& ec) ASIOEXT_NOEXCEPT
 {
   // By the time close() returns, the fd is already gone
@@ -285,6 +645,128 @@ void close(handle_type fd, error_code& ec) ASIOEXT_NOEXCEPT
     set_error(ec, errno);
 }
 
+bool poll(handle_type fd, bool write, int timeout_ms,
+          error_code& ec) ASIOEXT_NOEXCEPT
+{
+  struct pollfd pfd;
+  pfd.fd = fd;
+  pfd.events = write ? POLLOUT : POLLIN;
+  pfd.revents = 0;
+
+  while (true) {
+    const int r = ::poll(&pfd, 1, timeout_ms);
+    if (r != -1) {
+      ec = error_code();
+      return r != 0;
+    }
+
+    const int e = errno;
+    if (e == EINTR)
+      continue;
+
+    set_error(ec, e);
+    return false;
+  }
+}
+
+#if defined(ASIOEXT_HAS_SPLICE)
+void pipe(handle_type fds[2], error_code& ec) ASIOEXT_NOEXCEPT
+{
+  if (::pipe2(fds, O_CLOEXEC) == 0)
+    ec = error_code();
+  else
+    set_error(ec, errno);
+}
+
+std::size_t set_pipe_size(handle_type fd, std::size_t size,
+                          error_code& ec) ASIOEXT_NOEXCEPT
+{
+  // Unprivileged processes can't exceed /proc/sys/fs/pipe-max-size,
+  // in which case we just keep the current size.
+  int r = ::fcntl(fd, F_SETPIPE_SZ, static_cast<int>(size));
+  if (r == -1)
+    r = ::fcntl(fd, F_GETPIPE_SZ);
+
+  if (r == -1) {
+    set_error(ec, errno);
+    return 0;
+  }
+
+  ec = error_code();
+  return static_cast<std::size_t>(r);
+}
+
+std::size_t splice(handle_type in, handle_type out, std::size_t size,
+                   bool nonblocking, error_code& ec) ASIOEXT_NOEXCEPT
+{
+  const unsigned int flags = SPLICE_F_MOVE |
+      (nonblocking ? SPLICE_F_NONBLOCK : 0);
+
+  while (true) {
+    const ssize_t r = ::splice(in, nullptr, out, nullptr, size, flags);
+    if (r != -1) {
+      if (r == 0 && size != 0)
+        ec = asio::error::eof;
+      else
+        ec = error_code();
+      return static_cast<std::size_t>(r);
+    }
+
+    const int e = errno;
+    if (e == EINTR)
+      continue;
+
+    set_error(ec, e);
+    return 0;
+  }
+}
+
+std::size_t tee(handle_type in, handle_type out, std::size_t size,
+                bool nonblocking, error_code& ec) ASIOEXT_NOEXCEPT
+{
+  const unsigned int flags = nonblocking ? SPLICE_F_NONBLOCK : 0;
+
+  while (true) {
+    const ssize_t r = ::tee(in, out, size, flags);
+    if (r != -1) {
+      if (r == 0 && size != 0)
+        ec = asio::error::eof;
+      else
+        ec = error_code();
+      return static_cast<std::size_t>(r);
+    }
+
+    const int e = errno;
+    if (e == EINTR)
+      continue;
+
+    set_error(ec, e);
+    return 0;
+  }
+}
+
+std::size_t vmsplice(handle_type pipe, const iovec* bufs, int count,
+                     bool nonblocking, error_code& ec) ASIOEXT_NOEXCEPT
+{
+  const unsigned int flags = nonblocking ? SPLICE_F_NONBLOCK : 0;
+
+  while (true) {
+    const ssize_t r = ::vmsplice(pipe, bufs, count, flags);
+    if (r != -1) {
+      ec = error_code();
+      return static_cast<std::size_t>(r);
+    }
+
+    const int e = errno;
+    if (e == EINTR)
+      continue;
+
+    set_error(ec, e);
+    return 0;
+  }
+}
+#endif
+
 handle_type duplicate(handle_type fd, error_code& ec) ASIOEXT_NOEXCEPT
 {
   const int new_fd = ::dup(fd);
@@ -435,15 +917,14 @@ void attributes(handle_type fd, file_attrs attrs, file_attr_options opts,
 void get_times(handle_type fd, file_time_type& ctime, file_time_type& atime,
                file_time_type& mtime, error_code& ec) ASIOEXT_NOEXCEPT
 {
-  struct stat st;
-  if (::fstat(fd, &st) == 0) {
-    if (stat_to_times(st, ctime, atime, mtime))
-      ec = error_code();
-    else
-      ec = make_error_code(errc::value_too_large);
-    return;
+  // query() can obtain the creation time through statx().
+  file_info info;
+  query(fd, file_info_mask::times, info, ec);
+  if (!ec) {
+    ctime = info.times.ctime;
+    atime = info.times.atime;
+    mtime = info.times.mtime;
   }
-  set_error(ec, errno);
 }
 
 void set_times(handle_type fd, file_time_type ctime, file_time_type atime,
@@ -518,6 +999,84 @@ void set_times(handle_type fd, file_time_type ctime, file_time_type atime,
 #endif
 }
 
+// On Linux we prefer open file description locks: Unlike classic POSIX
+// record locks, they're owned by the open file description (and thus not
+// silently dropped once *any* descriptor for the file is closed) and
+// conflict between descriptors of the same process.
+#if defined(ASIOEXT_HAS_OFD_LOCKS)
+# define ASIOEXT_F_SETLK F_OFD_SETLK
+# define ASIOEXT_F_SETLKW F_OFD_SETLKW
+#else
+# define ASIOEXT_F_SETLK F_SETLK
+# define ASIOEXT_F_SETLKW F_SETLKW
+#endif
+
+static bool fill_flock(struct flock& fl, short type, uint64_t offset,
+                       uint64_t length) ASIOEXT_NOEXCEPT
+{
+  // off_t is signed. Also, the range's end must be representable.
+  const uint64_t max = static_cast<uint64_t>(
+      std::numeric_limits<off_t>::max());
+  if (offset > max || length > max - offset)
+    return false;
+
+  // OFD locks require l_pid to be 0.
+  std::memset(&fl, 0, sizeof(fl));
+  fl.l_type = type;
+  fl.l_whence = SEEK_SET;
+  fl.l_start = static_cast<off_t>(offset);
+  fl.l_len = static_cast<off_t>(length);
+  return true;
+}
+
+bool lock(handle_type fd, uint64_t offset, uint64_t length, bool exclusive,
+          bool wait, error_code& ec) ASIOEXT_NOEXCEPT
+{
+  struct flock fl;
+  if (!fill_flock(fl, exclusive ? F_WRLCK : F_RDLCK, offset, length)) {
+    ec = make_error_code(errc::value_too_large);
+    return false;
+  }
+
+  while (::fcntl(fd, wait ? ASIOEXT_F_SETLKW : ASIOEXT_F_SETLK, &fl) != 0) {
+    const int e = errno;
+    if (e == EINTR)
+      continue;
+
+    if (!wait && (e == EAGAIN || e == EACCES)) {
+      ec = error_code();
+      return false;
+    }
+
+    set_error(ec, e);
+    return false;
+  }
+
+  ec = error_code();
+  return true;
+}
+
+void unlock(handle_type fd, uint64_t offset, uint64_t length,
+            error_code& ec) ASIOEXT_NOEXCEPT
+{
+  struct flock fl;
+  if (!fill_flock(fl, F_UNLCK, offset, length)) {
+    ec = make_error_code(errc::value_too_large);
+    return;
+  }
+
+  while (::fcntl(fd, ASIOEXT_F_SETLK, &fl) != 0) {
+    const int e = errno;
+    if (e == EINTR)
+      continue;
+
+    set_error(ec, e);
+    return;
+  }
+
+  ec = error_code();
+}
+
 std::size_t readv(handle_type fd, iovec* bufs, int count,
                   error_code& ec) ASIOEXT_NOEXCEPT
 {
@@ -0,0 +1,274 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/detail/splice.hpp"
+#include "asioext/file_info.hpp"
+
+#include <algorithm>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+// Larger pipes mean fewer system calls per byte. Unprivileged processes
+// might not be allowed to go this high, in which case we take what we get.
+static const std::size_t splice_pipe_size = 1024 * 1024;
+
+static bool is_pipe(posix_file_ops::handle_type fd) ASIOEXT_NOEXCEPT
+{
+  error_code ec;
+  file_info info;
+  posix_file_ops::query(fd, file_info_mask::type, info, ec);
+  return !ec && info.type == file_type::fifo;
+}
+
+static void make_splice_pipe(unique_file_handle& read_end,
+                             unique_file_handle& write_end,
+                             std::size_t& size,
+                             error_code& ec) ASIOEXT_NOEXCEPT
+{
+  posix_file_ops::handle_type fds[2];
+  posix_file_ops::pipe(fds, ec);
+  if (ec)
+    return;
+
+  // Both are empty, so there's nothing to close here.
+  read_end.reset(file_handle(fds[0]), ec);
+  write_end.reset(file_handle(fds[1]), ec);
+
+  const std::size_t actual =
+      posix_file_ops::set_pipe_size(fds[1], splice_pipe_size, ec);
+  if (!ec)
+    size = (std::min)(size, actual);
+}
+
+splice_transfer_state::splice_transfer_state(
+    handle_type in, handle_type out, uint64_t max_size,
+    bool nonblocking_in, bool nonblocking_out) ASIOEXT_NOEXCEPT
+  : in_(in)
+  , out_(out)
+  , remaining_(max_size)
+  , total_(0)
+  , chunk_size_(splice_pipe_size)
+  , pending_(0)
+  , nonblocking_in_(nonblocking_in)
+  , nonblocking_out_(nonblocking_out)
+  , initialized_(false)
+  , waiting_for_read_(false)
+{
+  // ctor
+}
+
+void splice_transfer_state::init(error_code& ec) ASIOEXT_NOEXCEPT
+{
+  initialized_ = true;
+
+  // splice() needs a pipe on one side. If we already have one, data can
+  // be moved directly. If we need to know which side would block,
+  // we always go through our own pipe though.
+  if (!nonblocking_in_ && !nonblocking_out_ &&
+      (is_pipe(in_) || is_pipe(out_))) {
+    ec = error_code();
+    return;
+  }
+
+  make_splice_pipe(pipe_read_, pipe_write_, chunk_size_, ec);
+}
+
+bool splice_transfer_state::drain(error_code& ec) ASIOEXT_NOEXCEPT
+{
+  while (pending_ != 0) {
+    const std::size_t n = posix_file_ops::splice(
+        pipe_read_.get().native_handle(), out_, pending_,
+        nonblocking_out_, ec);
+    if (ec) {
+      waiting_for_read_ = false;
+      return false;
+    }
+
+    pending_ -= n;
+    total_ += n;
+  }
+  return true;
+}
+
+void splice_transfer_state::run(error_code& ec) ASIOEXT_NOEXCEPT
+{
+  if (!initialized_) {
+    init(ec);
+    if (ec)
+      return;
+  }
+
+  const bool direct = !pipe_write_.is_open();
+  while (true) {
+    if (pending_ != 0 && !drain(ec))
+      return;
+
+    if (remaining_ == 0) {
+      ec = error_code();
+      return;
+    }
+
+    const std::size_t size = static_cast<std::size_t>(
+        (std::min<uint64_t>)(remaining_, chunk_size_));
+
+    std::size_t n;
+    if (direct) {
+      n = posix_file_ops::splice(in_, out_, size, false, ec);
+    } else {
+      n = posix_file_ops::splice(in_, pipe_write_.get().native_handle(),
+                                 size, nonblocking_in_, ec);
+    }
+
+    if (ec) {
+      if (ec == asio::error::eof) {
+        remaining_ = 0;
+        ec = error_code();
+      } else if (ec == asio::error::would_block) {
+        if (direct) {
+          // Either side might be the culprit.
+          error_code poll_ec;
+          waiting_for_read_ = !posix_file_ops::poll(in_, false, 0, poll_ec);
+        } else {
+          waiting_for_read_ = true;
+        }
+      }
+      return;
+    }
+
+    remaining_ -= n;
+    if (direct)
+      total_ += n;
+    else
+      pending_ = n;
+  }
+}
+
+splice_fanout_state::splice_fanout_state(
+    handle_type source, std::vector<handle_type> destinations,
+    bool nonblocking_source) ASIOEXT_NOEXCEPT
+  : source_(source)
+  , destinations_(std::move(destinations))
+  , total_(0)
+  , chunk_size_(splice_pipe_size)
+  , source_is_pipe_(false)
+  , nonblocking_source_(nonblocking_source)
+  , initialized_(false)
+{
+  // ctor
+}
+
+void splice_fanout_state::init(error_code& ec) ASIOEXT_NOEXCEPT
+{
+  initialized_ = true;
+
+  if (destinations_.empty()) {
+    ec = asio::error::invalid_argument;
+    return;
+  }
+
+  source_is_pipe_ = is_pipe(source_);
+
+  try {
+    pipes_.resize(destinations_.size() * 2);
+  } catch (std::bad_alloc&) {
+    ec = asio::error::no_memory;
+    return;
+  }
+
+  // All pipes get the same size, so tee() can always duplicate
+  // the same amount of data into each of them.
+  for (std::size_t i = 0, n = destinations_.size(); i != n; ++i) {
+    make_splice_pipe(pipes_[2 * i], pipes_[2 * i + 1], chunk_size_, ec);
+    if (ec)
+      return;
+  }
+}
+
+// Moves the next chunk from |source_| into all of our (empty) pipes.
+std::size_t splice_fanout_state::fill(error_code& ec) ASIOEXT_NOEXCEPT
+{
+  const std::size_t last = destinations_.size() - 1;
+  const handle_type last_read = pipes_[2 * last].get().native_handle();
+  const handle_type last_write = pipes_[2 * last + 1].get().native_handle();
+
+  // If the source is a pipe, tee() duplicates its data without consuming
+  // it. The last destination's pipe then gets the original. Otherwise we
+  // need to splice() it into a pipe first and duplicate from there.
+  // |total_| counts what's been taken from |source_|, whether or not it
+  // made it to the destinations.
+  handle_type tee_source;
+  std::size_t size;
+  if (source_is_pipe_ && last != 0) {
+    tee_source = source_;
+    size = posix_file_ops::tee(source_, pipes_[1].get().native_handle(),
+                               chunk_size_, nonblocking_source_, ec);
+  } else {
+    tee_source = last_read;
+    size = posix_file_ops::splice(source_, last_write, chunk_size_,
+                                  nonblocking_source_, ec);
+    total_ += size;
+  }
+
+  if (ec || last == 0)
+    return size;
+
+  for (std::size_t i = source_is_pipe_ ? 1 : 0; i != last; ++i) {
+    const std::size_t n = posix_file_ops::tee(
+        tee_source, pipes_[2 * i + 1].get().native_handle(), size, false,
+        ec);
+    if (!ec && n != size)
+      ec = asio::error::no_buffer_space;
+    if (ec)
+      return 0;
+  }
+
+  if (source_is_pipe_) {
+    for (std::size_t moved = 0; moved != size; ) {
+      const std::size_t n = posix_file_ops::splice(source_, last_write,
+                                                   size - moved, false, ec);
+      total_ += n;
+      moved += n;
+      if (ec)
+        return 0;
+    }
+  }
+  return size;
+}
+
+void splice_fanout_state::run(error_code& ec) ASIOEXT_NOEXCEPT
+{
+  if (!initialized_) {
+    init(ec);
+    if (ec)
+      return;
+  }
+
+  while (true) {
+    const std::size_t size = fill(ec);
+    if (ec) {
+      if (ec == asio::error::eof)
+        ec = error_code();
+      return;
+    }
+
+    for (std::size_t i = 0, n = destinations_.size(); i != n; ++i) {
+      const handle_type pipe = pipes_[2 * i].get().native_handle();
+      for (std::size_t left = size; left != 0; ) {
+        left -= posix_file_ops::splice(pipe, destinations_[i], left, false,
+                                       ec);
+        if (ec == asio::error::would_block)
+          posix_file_ops::poll(destinations_[i], true, -1, ec);
+        if (ec)
+          return;
+      }
+    }
+  }
+}
+
+}
+
+ASIOEXT_NS_END
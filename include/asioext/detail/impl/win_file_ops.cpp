@@ -475,6 +475,90 @@ void set_times(handle_type fd, file_time_type ctime, file_time_type atime,
   set_error(ec);
 }
 
+void query(handle_type fd, file_info_mask mask, file_info& info,
+           error_code& ec) ASIOEXT_NOEXCEPT
+{
+  // A single call gives us everything but the block size.
+  BY_HANDLE_FILE_INFORMATION bhfi;
+  if (!::GetFileInformationByHandle(fd, &bhfi)) {
+    set_error(ec);
+    return;
+  }
+
+  ASIOEXT_CONSTEXPR file_perms write_perms = file_perms::owner_write |
+                                             file_perms::group_write |
+                                             file_perms::others_write;
+
+  if ((mask & file_info_mask::type) != file_info_mask::none) {
+    info.type = bhfi.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ?
+        file_type::directory : file_type::regular;
+  }
+  if ((mask & file_info_mask::perms) != file_info_mask::none) {
+    info.perms = bhfi.dwFileAttributes & FILE_ATTRIBUTE_READONLY ?
+        file_perms::all & ~write_perms : file_perms::all;
+  }
+  if ((mask & file_info_mask::attrs) != file_info_mask::none)
+    info.attrs = native_to_file_attrs(bhfi.dwFileAttributes);
+  if ((mask & file_info_mask::size) != file_info_mask::none) {
+    info.size = (static_cast<uint64_t>(bhfi.nFileSizeHigh) << 32) |
+                bhfi.nFileSizeLow;
+  }
+  if ((mask & file_info_mask::inode) != file_info_mask::none) {
+    info.inode = (static_cast<uint64_t>(bhfi.nFileIndexHigh) << 32) |
+                 bhfi.nFileIndexLow;
+  }
+  if ((mask & file_info_mask::device) != file_info_mask::none)
+    info.device = bhfi.dwVolumeSerialNumber;
+  if ((mask & file_info_mask::hard_links) != file_info_mask::none)
+    info.hard_links = bhfi.nNumberOfLinks;
+  if ((mask & file_info_mask::ctime) != file_info_mask::none)
+    info.times.ctime = filetime_to_chrono(bhfi.ftCreationTime);
+  if ((mask & file_info_mask::atime) != file_info_mask::none)
+    info.times.atime = filetime_to_chrono(bhfi.ftLastAccessTime);
+  if ((mask & file_info_mask::mtime) != file_info_mask::none)
+    info.times.mtime = filetime_to_chrono(bhfi.ftLastWriteTime);
+  ec = error_code();
+}
+
+// FILE_READ_ATTRIBUTES doesn't conflict with any sharing mode, and
+// FILE_FLAG_BACKUP_SEMANTICS allows us to open directories as well.
+static void query_args(open_args& args) ASIOEXT_NOEXCEPT
+{
+  args.creation_disposition(OPEN_EXISTING);
+  args.desired_access(FILE_READ_ATTRIBUTES);
+  args.share_mode(FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE);
+  args.attrs(0);
+  args.flags(FILE_FLAG_BACKUP_SEMANTICS);
+}
+
+void query(const char* path, file_info_mask mask, file_info& info,
+           error_code& ec) ASIOEXT_NOEXCEPT
+{
+  open_args args;
+  query_args(args);
+
+  const handle_type fd = open(path, args, ec);
+  if (ec)
+    return;
+
+  query(fd, mask, info, ec);
+  ::CloseHandle(fd);
+}
+
+void query(const wchar_t* path, file_info_mask mask, file_info& info,
+           error_code& ec) ASIOEXT_NOEXCEPT
+{
+  open_args args;
+  query_args(args);
+
+  const handle_type fd = open(path, args, ec);
+  if (ec)
+    return;
+
+  query(fd, mask, info, ec);
+  ::CloseHandle(fd);
+}
+
 uint32_t read(handle_type fd, void* buffer, uint32_t size,
               error_code& ec) ASIOEXT_NOEXCEPT
 {
@@ -502,6 +586,80 @@ uint32_t write(handle_type fd, const void* buffer, uint32_t size,
   return bytesWritten;
 }
 
+static void range_to_overlapped(uint64_t offset, uint64_t length,
+                                OVERLAPPED& overlapped, DWORD& low,
+                                DWORD& high) ASIOEXT_NOEXCEPT
+{
+  LARGE_INTEGER offset2;
+  offset2.QuadPart = offset;
+  overlapped.Offset = offset2.LowPart;
+  overlapped.OffsetHigh = offset2.HighPart;
+
+  if (length != 0) {
+    LARGE_INTEGER length2;
+    length2.QuadPart = length;
+    low = length2.LowPart;
+    high = length2.HighPart;
+  } else {
+    low = MAXDWORD;
+    high = MAXDWORD;
+  }
+}
+
+bool lock(handle_type fd, uint64_t offset, uint64_t length, bool exclusive,
+          bool wait, error_code& ec) ASIOEXT_NOEXCEPT
+{
+  OVERLAPPED overlapped = {0};
+  DWORD low, high;
+  range_to_overlapped(offset, length, overlapped, low, high);
+
+  DWORD flags = 0;
+  if (exclusive)
+    flags |= LOCKFILE_EXCLUSIVE_LOCK;
+  if (!wait)
+    flags |= LOCKFILE_FAIL_IMMEDIATELY;
+
+  if (!::LockFileEx(fd, flags, 0, low, high, &overlapped)) {
+    DWORD e = ::GetLastError();
+
+    // Handles opened for asynchronous I/O complete the request later.
+    if (e == ERROR_IO_PENDING) {
+      DWORD dummy;
+      if (::GetOverlappedResult(fd, &overlapped, &dummy, TRUE)) {
+        ec = error_code();
+        return true;
+      }
+      e = ::GetLastError();
+    }
+
+    if (!wait && e == ERROR_LOCK_VIOLATION) {
+      ec = error_code();
+      return false;
+    }
+
+    ec = error_code(e, asio::error::get_system_category());
+    return false;
+  }
+
+  ec = error_code();
+  return true;
+}
+
+void unlock(handle_type fd, uint64_t offset, uint64_t length,
+            error_code& ec) ASIOEXT_NOEXCEPT
+{
+  OVERLAPPED overlapped = {0};
+  DWORD low, high;
+  range_to_overlapped(offset, length, overlapped, low, high);
+
+  if (!::UnlockFileEx(fd, 0, low, high, &overlapped)) {
+    set_error(ec);
+    return;
+  }
+
+  ec = error_code();
+}
+
 uint32_t pread(handle_type fd, void* buffer, uint32_t size, uint64_t offset,
                error_code& ec) ASIOEXT_NOEXCEPT
 {
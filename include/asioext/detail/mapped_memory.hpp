@@ -0,0 +1,70 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_DETAIL_MAPPEDMEMORY_HPP
+#define ASIOEXT_DETAIL_MAPPEDMEMORY_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <cstddef>
+
+// Growing a mapping without copying needs mremap().
+// Huge pages come from MAP_HUGETLB or transparent huge pages.
+#if defined(__linux__)
+# define ASIOEXT_HAS_MREMAP 1
+# define ASIOEXT_HAS_HUGE_PAGES 1
+#endif
+
+#if defined(ASIOEXT_HAS_MREMAP)
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+namespace mapped_memory {
+
+// Sizes are rounded up to a multiple of this (and to at least one page).
+ASIOEXT_DECL std::size_t granularity() ASIOEXT_NOEXCEPT;
+
+// Maps |size| bytes of fresh, zeroed anonymous memory.
+// Returns nullptr on failure.
+ASIOEXT_DECL void* map(std::size_t size) ASIOEXT_NOEXCEPT;
+
+ASIOEXT_DECL void unmap(void* data, std::size_t size) ASIOEXT_NOEXCEPT;
+
+// Grows or shrinks the mapping |data| of |size| bytes to |new_size| bytes.
+// The contents are preserved, but the kernel may move them to a different
+// address. Returns nullptr (and leaves |data| alone) on failure.
+ASIOEXT_DECL void* remap(void* data, std::size_t size,
+                         std::size_t new_size) ASIOEXT_NOEXCEPT;
+
+// Size of a (default) huge page. Sizes passed to map_huge() and
+// unmap_huge() are rounded up to a multiple of this.
+ASIOEXT_DECL std::size_t huge_page_size() ASIOEXT_NOEXCEPT;
+
+// Maps |size| bytes of zeroed anonymous memory backed by huge pages.
+// Reserved huge pages (MAP_HUGETLB) are tried first. If there are none,
+// a huge page aligned mapping is requested to be backed by transparent
+// huge pages instead. If |prefault| is true, all pages are faulted in
+// before returning. Returns nullptr on failure.
+ASIOEXT_DECL void* map_huge(std::size_t size, bool prefault) ASIOEXT_NOEXCEPT;
+
+ASIOEXT_DECL void unmap_huge(void* data, std::size_t size) ASIOEXT_NOEXCEPT;
+
+}
+}
+
+ASIOEXT_NS_END
+
+# if defined(ASIOEXT_HEADER_ONLY)
+#  include "asioext/detail/impl/mapped_memory.cpp"
+# endif
+
+#endif
+
+#endif
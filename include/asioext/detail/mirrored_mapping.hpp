@@ -0,0 +1,54 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_DETAIL_MIRROREDMAPPING_HPP
+#define ASIOEXT_DETAIL_MIRROREDMAPPING_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/error_code.hpp"
+
+#include "asioext/detail/cstdint.hpp"
+
+#include <cstddef>
+
+// Double mappings need anonymous shared memory, which we get from
+// memfd_create().
+#if defined(__linux__)
+# define ASIOEXT_HAS_MIRRORED_MAPPING 1
+#endif
+
+#if defined(ASIOEXT_HAS_MIRRORED_MAPPING)
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+namespace mirrored_mapping {
+
+// Sizes passed to map() need to be a multiple of this.
+ASIOEXT_DECL std::size_t granularity() ASIOEXT_NOEXCEPT;
+
+// Maps |size| bytes of fresh memory twice, back-to-back, so that
+// |result[i]| and |result[i + size]| refer to the same byte.
+ASIOEXT_DECL uint8_t* map(std::size_t size, error_code& ec) ASIOEXT_NOEXCEPT;
+
+ASIOEXT_DECL void unmap(uint8_t* data, std::size_t size) ASIOEXT_NOEXCEPT;
+
+}
+}
+
+ASIOEXT_NS_END
+
+# if defined(ASIOEXT_HEADER_ONLY)
+#  include "asioext/detail/impl/mirrored_mapping.cpp"
+# endif
+
+#endif
+
+#endif
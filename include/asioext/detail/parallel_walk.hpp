@@ -0,0 +1,46 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_DETAIL_PARALLELWALK_HPP
+#define ASIOEXT_DETAIL_PARALLELWALK_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/error_code.hpp"
+
+#include "asioext/detail/cstdint.hpp"
+
+ASIOEXT_NS_BEGIN
+
+enum class walk_action;
+struct walk_options;
+struct walk_entry;
+
+namespace detail {
+
+// Type-erased visitor, so the walker itself doesn't need to be a template.
+typedef walk_action (*walk_visit_function)(void* visitor,
+                                           const walk_entry& entry);
+
+// Exceptions thrown by |visit| are rethrown, after all workers
+// have finished.
+ASIOEXT_DECL uint64_t parallel_walk(const char* root,
+                                    walk_visit_function visit, void* visitor,
+                                    const walk_options& options,
+                                    error_code& ec);
+
+}
+
+ASIOEXT_NS_END
+
+#if defined(ASIOEXT_HEADER_ONLY)
+# include "asioext/detail/impl/parallel_walk.cpp"
+#endif
+
+#endif
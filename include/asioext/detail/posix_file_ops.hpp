@@ -12,9 +12,11 @@
 #endif
 
 #include "asioext/open_flags.hpp"
+#include "asioext/resolve_flags.hpp"
 #include "asioext/seek_origin.hpp"
 #include "asioext/file_perms.hpp"
 #include "asioext/file_attrs.hpp"
+#include "asioext/file_info.hpp"
 #include "asioext/error_code.hpp"
 #include "asioext/chrono.hpp"
 
@@ -27,6 +29,21 @@
 
 #undef _FILE_OFFSET_BITS
 
+#if defined(__linux__) && !defined(ASIOEXT_DISABLE_GETDENTS64)
+# define ASIOEXT_HAS_GETDENTS64 1
+#endif
+
+#if defined(__linux__) && !defined(ASIOEXT_DISABLE_SPLICE)
+# define ASIOEXT_HAS_SPLICE 1
+#endif
+
+#if defined(__linux__) && !defined(ASIOEXT_DISABLE_OFD_LOCKS)
+# include <fcntl.h> // for F_OFD_SETLK
+# if defined(F_OFD_SETLK)
+#  define ASIOEXT_HAS_OFD_LOCKS 1
+# endif
+#endif
+
 ASIOEXT_NS_BEGIN
 
 class open_args;
@@ -46,8 +63,67 @@ ASIOEXT_DECL int parse_open_flags(open_flags flags) ASIOEXT_NOEXCEPT;
 ASIOEXT_DECL handle_type open(const char* path, const open_args& args,
                               error_code& ec) ASIOEXT_NOEXCEPT;
 
+ASIOEXT_DECL handle_type openat(handle_type dir, const char* path,
+                                const open_args& args, resolve_flags resolve,
+                                error_code& ec) ASIOEXT_NOEXCEPT;
+
+// |dir| may be -1, in which case |path| is resolved the way open() would.
+ASIOEXT_DECL handle_type open_directory(handle_type dir, const char* path,
+                                        resolve_flags resolve,
+                                        error_code& ec) ASIOEXT_NOEXCEPT;
+
+// Only the members selected by |mask| are written to |info|.
+ASIOEXT_DECL void query(handle_type fd, file_info_mask mask, file_info& info,
+                        error_code& ec) ASIOEXT_NOEXCEPT;
+
+// |dir| may be -1, in which case |path| is resolved the way open() would.
+ASIOEXT_DECL void query_at(handle_type dir, const char* path,
+                           bool follow_symlinks, file_info_mask mask,
+                           file_info& info, error_code& ec) ASIOEXT_NOEXCEPT;
+
+ASIOEXT_DECL void unlink_at(handle_type dir, const char* path,
+                            bool directory, error_code& ec) ASIOEXT_NOEXCEPT;
+
+ASIOEXT_DECL void rename_at(handle_type old_dir, const char* old_path,
+                            handle_type new_dir, const char* new_path,
+                            error_code& ec) ASIOEXT_NOEXCEPT;
+
+#if defined(ASIOEXT_HAS_GETDENTS64)
+// Fills |buffer| with as many (raw) linux_dirent64 records as fit.
+// Returns the number of bytes used, 0 at the end of the directory.
+ASIOEXT_DECL std::size_t read_directory(handle_type dir, void* buffer,
+                                        std::size_t size,
+                                        error_code& ec) ASIOEXT_NOEXCEPT;
+#endif
+
 ASIOEXT_DECL void close(handle_type fd, error_code& ec) ASIOEXT_NOEXCEPT;
 
+// Waits until |fd| is readable (or writable if |write| is set).
+// A negative |timeout_ms| waits indefinitely. Returns false on timeout.
+ASIOEXT_DECL bool poll(handle_type fd, bool write, int timeout_ms,
+                       error_code& ec) ASIOEXT_NOEXCEPT;
+
+#if defined(ASIOEXT_HAS_SPLICE)
+ASIOEXT_DECL void pipe(handle_type fds[2], error_code& ec) ASIOEXT_NOEXCEPT;
+
+// Tries to resize the pipe's buffer to |size| bytes.
+// Returns the actual size.
+ASIOEXT_DECL std::size_t set_pipe_size(handle_type fd, std::size_t size,
+                                       error_code& ec) ASIOEXT_NOEXCEPT;
+
+// Returns 0 and sets |ec| to asio::error::eof if there's no more data.
+// If |nonblocking| is set, pipes are never waited on.
+ASIOEXT_DECL std::size_t splice(handle_type in, handle_type out,
+                                std::size_t size, bool nonblocking,
+                                error_code& ec) ASIOEXT_NOEXCEPT;
+ASIOEXT_DECL std::size_t tee(handle_type in, handle_type out,
+                             std::size_t size, bool nonblocking,
+                             error_code& ec) ASIOEXT_NOEXCEPT;
+ASIOEXT_DECL std::size_t vmsplice(handle_type pipe, const iovec* bufs,
+                                  int count, bool nonblocking,
+                                  error_code& ec) ASIOEXT_NOEXCEPT;
+#endif
+
 ASIOEXT_DECL handle_type duplicate(handle_type fd,
                                    error_code& ec) ASIOEXT_NOEXCEPT;
 
@@ -83,6 +159,14 @@ ASIOEXT_DECL void set_times(handle_type fd, file_time_type ctime,
                             file_time_type atime, file_time_type mtime,
                             error_code& ec) ASIOEXT_NOEXCEPT;
 
+// A |length| of 0 extends the range to the end of the file (and beyond).
+// If |wait| is false, returns false if the lock is held by someone else.
+ASIOEXT_DECL bool lock(handle_type fd, uint64_t offset, uint64_t length,
+                       bool exclusive, bool wait,
+                       error_code& ec) ASIOEXT_NOEXCEPT;
+ASIOEXT_DECL void unlock(handle_type fd, uint64_t offset, uint64_t length,
+                         error_code& ec) ASIOEXT_NOEXCEPT;
+
 ASIOEXT_DECL std::size_t readv(handle_type fd,
                                iovec* bufs,
                                int count,
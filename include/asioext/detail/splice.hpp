@@ -0,0 +1,132 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_DETAIL_SPLICE_HPP
+#define ASIOEXT_DETAIL_SPLICE_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/unique_file_handle.hpp"
+#include "asioext/error_code.hpp"
+
+#include "asioext/detail/posix_file_ops.hpp"
+#include "asioext/detail/cstdint.hpp"
+
+#include <vector>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+// Both state machines below do as much work as possible per run() call.
+// If a non-blocking descriptor isn't ready, run() fails with
+// asio::error::would_block and waiting_for_read() tells the caller which
+// readiness to wait for, before calling run() again.
+// Once done, run() returns with a cleared |ec| (EOF isn't an error here).
+
+// Moves data from |in| to |out|, through an intermediate pipe unless
+// one of them already is a pipe.
+class splice_transfer_state
+{
+public:
+  typedef posix_file_ops::handle_type handle_type;
+
+  // If |nonblocking_in| is set, only reads from |in| may fail with
+  // would_block (and an intermediate pipe is always used). Otherwise
+  // descriptors block, unless they have O_NONBLOCK set.
+  ASIOEXT_DECL splice_transfer_state(handle_type in, handle_type out,
+                                     uint64_t max_size,
+                                     bool nonblocking_in,
+                                     bool nonblocking_out) ASIOEXT_NOEXCEPT;
+
+  ASIOEXT_DECL void run(error_code& ec) ASIOEXT_NOEXCEPT;
+
+  bool waiting_for_read() const ASIOEXT_NOEXCEPT { return waiting_for_read_; }
+  uint64_t total() const ASIOEXT_NOEXCEPT { return total_; }
+
+private:
+  ASIOEXT_DECL void init(error_code& ec) ASIOEXT_NOEXCEPT;
+  ASIOEXT_DECL bool drain(error_code& ec) ASIOEXT_NOEXCEPT;
+
+  handle_type in_;
+  handle_type out_;
+  unique_file_handle pipe_read_;
+  unique_file_handle pipe_write_;
+  uint64_t remaining_;
+  uint64_t total_;
+  std::size_t chunk_size_;
+  // Bytes waiting in our pipe.
+  std::size_t pending_;
+  bool nonblocking_in_;
+  bool nonblocking_out_;
+  bool initialized_;
+  bool waiting_for_read_;
+};
+
+// Duplicates everything read from |source| to all destinations.
+class splice_fanout_state
+{
+public:
+  typedef posix_file_ops::handle_type handle_type;
+
+  // If |nonblocking_source| is set, reads from |source| may fail
+  // with would_block. Writes to the destinations always block.
+  ASIOEXT_DECL splice_fanout_state(handle_type source,
+                                   std::vector<handle_type> destinations,
+                                   bool nonblocking_source) ASIOEXT_NOEXCEPT;
+
+  ASIOEXT_DECL void run(error_code& ec) ASIOEXT_NOEXCEPT;
+
+  bool waiting_for_read() const ASIOEXT_NOEXCEPT { return true; }
+  uint64_t total() const ASIOEXT_NOEXCEPT { return total_; }
+
+private:
+  ASIOEXT_DECL void init(error_code& ec) ASIOEXT_NOEXCEPT;
+  ASIOEXT_DECL std::size_t fill(error_code& ec) ASIOEXT_NOEXCEPT;
+
+  handle_type source_;
+  std::vector<handle_type> destinations_;
+  // One pipe per destination.
+  std::vector<unique_file_handle> pipes_;
+  uint64_t total_;
+  std::size_t chunk_size_;
+  bool source_is_pipe_;
+  bool nonblocking_source_;
+  bool initialized_;
+};
+
+// Blocks until |state| is done.
+template <typename State>
+void run_blocking(State& state, posix_file_ops::handle_type in,
+                  posix_file_ops::handle_type out,
+                  error_code& ec) ASIOEXT_NOEXCEPT
+{
+  while (true) {
+    state.run(ec);
+    if (ec != asio::error::would_block)
+      return;
+
+    if (state.waiting_for_read())
+      posix_file_ops::poll(in, false, -1, ec);
+    else
+      posix_file_ops::poll(out, true, -1, ec);
+    if (ec)
+      return;
+  }
+}
+
+}
+
+ASIOEXT_NS_END
+
+#if defined(ASIOEXT_HEADER_ONLY)
+# include "asioext/detail/impl/splice.cpp"
+#endif
+
+#endif
@@ -15,6 +15,7 @@
 #include "asioext/seek_origin.hpp"
 #include "asioext/file_perms.hpp"
 #include "asioext/file_attrs.hpp"
+#include "asioext/file_info.hpp"
 #include "asioext/error_code.hpp"
 #include "asioext/chrono.hpp"
 
@@ -85,6 +86,24 @@ ASIOEXT_DECL void set_times(handle_type fd, file_time_type ctime,
                             file_time_type atime, file_time_type mtime,
                             error_code& ec) ASIOEXT_NOEXCEPT;
 
+// Only the members selected by |mask| are written to |info|.
+ASIOEXT_DECL void query(handle_type fd, file_info_mask mask, file_info& info,
+                        error_code& ec) ASIOEXT_NOEXCEPT;
+
+ASIOEXT_DECL void query(const char* path, file_info_mask mask,
+                        file_info& info, error_code& ec) ASIOEXT_NOEXCEPT;
+
+ASIOEXT_DECL void query(const wchar_t* path, file_info_mask mask,
+                        file_info& info, error_code& ec) ASIOEXT_NOEXCEPT;
+
+// A |length| of 0 extends the range to the end of the file (and beyond).
+// If |wait| is false, returns false if the lock is held by someone else.
+ASIOEXT_DECL bool lock(handle_type fd, uint64_t offset, uint64_t length,
+                       bool exclusive, bool wait,
+                       error_code& ec) ASIOEXT_NOEXCEPT;
+ASIOEXT_DECL void unlock(handle_type fd, uint64_t offset, uint64_t length,
+                         error_code& ec) ASIOEXT_NOEXCEPT;
+
 ASIOEXT_DECL uint32_t read(handle_type fd,
                            void* buffer,
                            uint32_t size,
@@ -0,0 +1,314 @@
+/// @file
+/// Defines the directory_handle class and the open_directory() functions.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_DIRECTORYHANDLE_HPP
+#define ASIOEXT_DIRECTORYHANDLE_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#if !defined(ASIOEXT_WINDOWS) || defined(ASIOEXT_IS_DOCUMENTATION)
+
+#include "asioext/file_info.hpp"
+#include "asioext/resolve_flags.hpp"
+#include "asioext/error_code.hpp"
+
+#include "asioext/detail/posix_file_ops.hpp"
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup files_handle
+/// @brief An owning handle to an open directory.
+///
+/// A directory_handle is used as the starting point for resolving
+/// relative paths (see @ref open(const directory_handle&,const char*,const open_args&)
+/// and @ref open_directory(const directory_handle&,const char*,resolve_flags)).
+/// Opening many files in the same (deep) directory this way only resolves
+/// the directory's path once, instead of once per file. Since the handle
+/// refers to the directory itself, renaming or replacing the directory's
+/// parents doesn't affect later operations either.
+///
+/// The directory is closed when the directory_handle is destroyed.
+///
+/// @par Thread Safety:
+/// @e Distinct @e objects: Safe.@n
+/// @e Shared @e objects: Safe for all <tt>const</tt> member functions.
+///
+/// @note Only available on POSIX systems.
+class directory_handle
+{
+public:
+  /// The operating system's native directory handle type.
+  typedef detail::posix_file_ops::handle_type native_handle_type;
+
+  /// @brief Construct an empty directory_handle.
+  directory_handle() ASIOEXT_NOEXCEPT
+    : handle_(-1)
+  {
+    // ctor
+  }
+
+  /// @brief Construct a directory_handle using a native handle.
+  ///
+  /// The directory_handle takes ownership of the given handle.
+  explicit directory_handle(native_handle_type handle) ASIOEXT_NOEXCEPT
+    : handle_(handle)
+  {
+    // ctor
+  }
+
+  /// @brief Close the contained directory handle (if any).
+  ASIOEXT_DECL ~directory_handle();
+
+  /// @brief Move-construct a directory_handle from another.
+  ///
+  /// @param other The other directory_handle object from which the move will
+  /// occur. Following the move, @c other will be empty.
+  directory_handle(directory_handle&& other) ASIOEXT_NOEXCEPT
+    : handle_(other.handle_)
+  {
+    other.handle_ = -1;
+  }
+
+  /// @brief Move-assign a directory_handle from another.
+  ///
+  /// Closes the currently contained handle (if any), before
+  /// taking ownership of @c other's handle.
+  ASIOEXT_DECL directory_handle& operator=(directory_handle&& other);
+
+  /// @brief Get the native directory handle.
+  native_handle_type native_handle() const ASIOEXT_NOEXCEPT
+  {
+    return handle_;
+  }
+
+  /// @brief Determine whether the handle is open.
+  bool is_open() const ASIOEXT_NOEXCEPT
+  {
+    return handle_ != -1;
+  }
+
+  /// @brief Close the directory handle.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ASIOEXT_DECL void close();
+
+  /// @brief Close the directory handle.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ASIOEXT_DECL void close(error_code& ec) ASIOEXT_NOEXCEPT;
+
+  /// @brief Give up ownership of the contained native handle.
+  ///
+  /// @return The native handle. The directory_handle is empty afterwards.
+  native_handle_type release() ASIOEXT_NOEXCEPT
+  {
+    const native_handle_type handle = handle_;
+    handle_ = -1;
+    return handle;
+  }
+
+  /// @name Operations on directory entries
+  ///
+  /// The @c name arguments of these functions are resolved relative to
+  /// this directory. Absolute paths are used as-is.
+  ///
+  /// @{
+
+  /// @brief Get the metadata of a directory entry.
+  ///
+  /// Symbolic links are followed.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ASIOEXT_DECL file_info stat(const char* name) const;
+
+  /// @brief Get the metadata of a directory entry.
+  ///
+  /// Symbolic links are followed.
+  ///
+  /// @param name The entry's path, relative to this directory.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ASIOEXT_DECL file_info stat(const char* name,
+                              error_code& ec) const ASIOEXT_NOEXCEPT;
+
+  /// @brief Get the metadata of a directory entry.
+  ///
+  /// If the entry is a symbolic link, the link itself is queried.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ASIOEXT_DECL file_info symlink_stat(const char* name) const;
+
+  /// @brief Get the metadata of a directory entry.
+  ///
+  /// If the entry is a symbolic link, the link itself is queried.
+  ///
+  /// @param name The entry's path, relative to this directory.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ASIOEXT_DECL file_info symlink_stat(const char* name,
+                                      error_code& ec) const ASIOEXT_NOEXCEPT;
+
+  /// @brief Remove a (non-directory) directory entry.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ASIOEXT_DECL void remove(const char* name) const;
+
+  /// @brief Remove a (non-directory) directory entry.
+  ///
+  /// @param name The entry's path, relative to this directory.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ASIOEXT_DECL void remove(const char* name,
+                           error_code& ec) const ASIOEXT_NOEXCEPT;
+
+  /// @brief Remove an empty sub-directory.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ASIOEXT_DECL void remove_directory(const char* name) const;
+
+  /// @brief Remove an empty sub-directory.
+  ///
+  /// @param name The sub-directory's path, relative to this directory.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ASIOEXT_DECL void remove_directory(const char* name,
+                                     error_code& ec) const ASIOEXT_NOEXCEPT;
+
+  /// @brief Rename a directory entry.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ASIOEXT_DECL void rename(const char* old_name, const char* new_name) const;
+
+  /// @brief Rename a directory entry.
+  ///
+  /// @param old_name The entry's current path, relative to this directory.
+  ///
+  /// @param new_name The entry's new path, relative to this directory.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ASIOEXT_DECL void rename(const char* old_name, const char* new_name,
+                           error_code& ec) const ASIOEXT_NOEXCEPT;
+
+  /// @brief Move a directory entry to another directory.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ASIOEXT_DECL void rename(const char* old_name,
+                           const directory_handle& new_dir,
+                           const char* new_name) const;
+
+  /// @brief Move a directory entry to another directory.
+  ///
+  /// @param old_name The entry's current path, relative to this directory.
+  ///
+  /// @param new_dir The directory @c new_name is relative to.
+  ///
+  /// @param new_name The entry's new path, relative to @c new_dir.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ASIOEXT_DECL void rename(const char* old_name,
+                           const directory_handle& new_dir,
+                           const char* new_name,
+                           error_code& ec) const ASIOEXT_NOEXCEPT;
+
+  /// @}
+
+private:
+  native_handle_type handle_;
+};
+
+/// @ingroup files_handle
+/// @defgroup open_directory asioext::open_directory()
+/// @brief Open a directory.
+///
+/// The returned directory_handle can be used to open files with
+/// @ref open(const directory_handle&,const char*,const open_args&) and
+/// to operate on directory entries without resolving the full path
+/// each time.
+///
+/// @note Only available on POSIX systems.
+///
+/// @{
+
+/// @brief Open the directory at the given path.
+///
+/// @param path The directory's path.
+///
+/// @throws asio::system_error Thrown on failure.
+ASIOEXT_DECL directory_handle open_directory(const char* path);
+
+/// @brief Open the directory at the given path.
+///
+/// @param path The directory's path.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+ASIOEXT_DECL directory_handle open_directory(const char* path,
+                                             error_code& ec) ASIOEXT_NOEXCEPT;
+
+/// @brief Open a sub-directory of an already open directory.
+///
+/// @param dir The directory @c path is relative to.
+///
+/// @param path The sub-directory's path, relative to @c dir.
+///
+/// @param resolve Restrictions for resolving @c path.
+/// See @ref resolve_flags.
+///
+/// @throws asio::system_error Thrown on failure.
+ASIOEXT_DECL directory_handle open_directory(
+    const directory_handle& dir, const char* path,
+    resolve_flags resolve = resolve_flags::none);
+
+/// @brief Open a sub-directory of an already open directory.
+///
+/// @param dir The directory @c path is relative to.
+///
+/// @param path The sub-directory's path, relative to @c dir.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+ASIOEXT_DECL directory_handle open_directory(
+    const directory_handle& dir, const char* path,
+    error_code& ec) ASIOEXT_NOEXCEPT;
+
+/// @brief Open a sub-directory of an already open directory.
+///
+/// @param dir The directory @c path is relative to.
+///
+/// @param path The sub-directory's path, relative to @c dir.
+///
+/// @param resolve Restrictions for resolving @c path.
+/// See @ref resolve_flags.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+ASIOEXT_DECL directory_handle open_directory(
+    const directory_handle& dir, const char* path,
+    resolve_flags resolve, error_code& ec) ASIOEXT_NOEXCEPT;
+
+/// @}
+
+ASIOEXT_NS_END
+
+#if defined(ASIOEXT_HEADER_ONLY)
+# include "asioext/impl/directory_handle.cpp"
+#endif
+
+#endif
+
+#endif
@@ -0,0 +1,228 @@
+/// @file
+/// Defines the directory_reader class and async_read_directory().
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_DIRECTORYREADER_HPP
+#define ASIOEXT_DIRECTORYREADER_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#if !defined(ASIOEXT_WINDOWS) || defined(ASIOEXT_IS_DOCUMENTATION)
+
+#include "asioext/directory_handle.hpp"
+#include "asioext/file_info.hpp"
+#include "asioext/thread_pool_file_service.hpp"
+#include "asioext/async_result.hpp"
+#include "asioext/error_code.hpp"
+
+#include "asioext/detail/cstdint.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/io_context.hpp>
+#else
+# include <asio/io_context.hpp>
+#endif
+
+#include <memory>
+#include <string>
+#include <vector>
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup files_meta
+/// @brief A single entry of a directory, as returned by directory_reader.
+struct directory_entry
+{
+  /// @brief The entry's name (without the directory's path).
+  std::string name;
+
+  /// @brief The entry's type.
+  ///
+  /// Symbolic links aren't followed. If the file system doesn't report
+  /// types while listing directories, this is file_type::unknown and
+  /// directory_reader::stat() needs to be used.
+  file_type type = file_type::unknown;
+
+  /// @brief The entry's serial (inode) number.
+  uint64_t inode = 0;
+};
+
+/// @ingroup files_handle
+/// @brief Reads the entries of a directory in large batches.
+///
+/// Unlike directory iterators that stat() every entry, a directory_reader
+/// only returns what the OS reports while listing the directory itself
+/// (name, type and inode number). Further metadata can be fetched on
+/// demand using stat(), which only needs to resolve the entry's name
+/// relative to the already open directory.
+///
+/// On Linux, entries are read using @c getdents64(), filling a (by default
+/// 64 KiB) buffer per system call. Other platforms use @c readdir().
+///
+/// The special entries <tt>.</tt> and <tt>..</tt> are skipped.
+///
+/// @par Thread Safety:
+/// @e Distinct @e objects: Safe.@n
+/// @e Shared @e objects: Unsafe.
+///
+/// @note Only available on POSIX systems.
+class directory_reader
+{
+public:
+  /// The default size of the buffer used to read entries.
+  static constexpr std::size_t default_buffer_size = 64 * 1024;
+
+  /// @brief Construct an empty directory_reader.
+  ASIOEXT_DECL directory_reader() ASIOEXT_NOEXCEPT;
+
+  /// @brief Construct a directory_reader for the given directory.
+  ///
+  /// @param dir The directory to read. The directory_reader takes
+  /// ownership of the handle.
+  ///
+  /// @param buffer_size The size of the buffer used to read entries.
+  /// Larger buffers need fewer system calls for large directories.
+  ASIOEXT_DECL explicit directory_reader(
+      directory_handle dir, std::size_t buffer_size = default_buffer_size);
+
+  /// @brief Close the directory (if open).
+  ASIOEXT_DECL ~directory_reader();
+
+  /// @brief Move-construct a directory_reader from another.
+  ASIOEXT_DECL directory_reader(directory_reader&& other) ASIOEXT_NOEXCEPT;
+
+  /// @brief Move-assign a directory_reader from another.
+  ASIOEXT_DECL directory_reader& operator=(
+      directory_reader&& other) ASIOEXT_NOEXCEPT;
+
+  /// @brief Determine whether the directory_reader has an open directory.
+  bool is_open() const ASIOEXT_NOEXCEPT
+  {
+    return dir_.is_open();
+  }
+
+  /// @brief Start reading another directory.
+  ///
+  /// The currently read directory (if any) is closed. The read buffer is
+  /// kept, which makes this cheaper than creating a new directory_reader
+  /// for every directory.
+  ///
+  /// @param dir The directory to read. The directory_reader takes
+  /// ownership of the handle.
+  ASIOEXT_DECL void assign(directory_handle dir);
+
+  /// @brief Give up ownership of the read directory.
+  ///
+  /// @return The handle of the directory that was read. The
+  /// directory_reader no longer has an open directory afterwards.
+  ASIOEXT_DECL directory_handle release() ASIOEXT_NOEXCEPT;
+
+  /// @brief Get the directory that is read.
+  const directory_handle& directory() const ASIOEXT_NOEXCEPT
+  {
+    return dir_;
+  }
+
+  /// @brief Read the next batch of entries.
+  ///
+  /// This function appends the next batch of entries to @c entries.
+  ///
+  /// @param entries The vector the read entries are appended to.
+  ///
+  /// @return The number of appended entries. 0 once all entries
+  /// have been read.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ASIOEXT_DECL std::size_t read(std::vector<directory_entry>& entries);
+
+  /// @brief Read the next batch of entries.
+  ///
+  /// This function appends the next batch of entries to @c entries.
+  ///
+  /// @param entries The vector the read entries are appended to.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ///
+  /// @return The number of appended entries. 0 once all entries
+  /// have been read or if an error occurred.
+  ASIOEXT_DECL std::size_t read(std::vector<directory_entry>& entries,
+                                error_code& ec) ASIOEXT_NOEXCEPT;
+
+  /// @brief Get the metadata of an entry.
+  ///
+  /// Symbolic links aren't followed, so the result is consistent with
+  /// directory_entry::type.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ASIOEXT_DECL file_info stat(const directory_entry& entry) const;
+
+  /// @brief Get the metadata of an entry.
+  ///
+  /// Symbolic links aren't followed, so the result is consistent with
+  /// directory_entry::type.
+  ///
+  /// @param entry An entry previously returned by read().
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ASIOEXT_DECL file_info stat(const directory_entry& entry,
+                              error_code& ec) const ASIOEXT_NOEXCEPT;
+
+private:
+  directory_handle dir_;
+  std::unique_ptr<unsigned char[]> buffer_;
+  std::size_t buffer_size_;
+#if !defined(ASIOEXT_HAS_GETDENTS64)
+  // The DIR* used by readdir().
+  void* stream_;
+#endif
+};
+
+/// @ingroup files_handle
+/// @brief Asynchronously read the next batch of directory entries.
+///
+/// The entries are read on the thread pool of the io_context's
+/// @ref thread_pool_file_service, so the calling thread (and the
+/// io_context) isn't blocked by slow directory reads. Call this function
+/// again from the handler to stream the remaining batches.
+///
+/// @param context The io_context whose thread_pool_file_service is used.
+///
+/// @param reader The directory_reader to read from. Ownership is retained
+/// by the caller, which must guarantee that it remains valid (and is not
+/// otherwise used) until the handler is called.
+///
+/// @param entries The vector the read entries are appended to.
+/// Ownership is retained by the caller, which must guarantee that it
+/// remains valid until the handler is called.
+///
+/// @param token The completion token. The completion signature is
+/// <code>void(error_code ec, std::size_t num_entries)</code>.
+/// @c num_entries is 0 once all entries have been read.
+///
+/// @note Only available on POSIX systems.
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+async_read_directory(asio::io_context& context, directory_reader& reader,
+                     std::vector<directory_entry>& entries,
+                     CompletionToken&& token);
+
+ASIOEXT_NS_END
+
+#include "asioext/impl/directory_reader.hpp"
+
+#if defined(ASIOEXT_HEADER_ONLY)
+# include "asioext/impl/directory_reader.cpp"
+#endif
+
+#endif
+
+#endif
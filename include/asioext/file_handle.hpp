@@ -16,6 +16,9 @@
 
 #include "asioext/seek_origin.hpp"
 #include "asioext/error_code.hpp"
+#include "asioext/file_times.hpp"
+#include "asioext/file_info.hpp"
+#include "asioext/file_lock.hpp"
 #include "asioext/chrono.hpp"
 
 #if defined(ASIOEXT_WINDOWS)
@@ -26,28 +29,6 @@
 
 ASIOEXT_NS_BEGIN
 
-/// @ingroup files_time
-/// @brief Container for various time points associated with a file.
-///
-/// This struct contains several time points commonly associated
-/// with a file.
-/// The availability of the individual time points is platform-dependent.
-struct file_times
-{
-  /// @brief The file's creation time.
-  file_time_type ctime;
-  /// @brief The file's last access time.
-  file_time_type atime;
-  /// @brief The file's last modification time.
-  file_time_type mtime;
-};
-
-inline bool operator==(const file_times& a, const file_times& b)
-{ return a.ctime == b.ctime && a.atime == b.atime && a.mtime == b.mtime; }
-
-inline bool operator!=(const file_times& a, const file_times& b)
-{ return !(a == b); }
-
 /// @ingroup files_handle
 /// @brief A thin and lightweight wrapper around a native file handle.
 ///
@@ -474,6 +455,128 @@ public:
   ASIOEXT_DECL void times(const file_times& new_times,
                           error_code& ec) ASIOEXT_NOEXCEPT;
 
+  /// @brief Get a snapshot of the file's metadata.
+  ///
+  /// This function retrieves the metadata selected by @c mask using
+  /// a single system call (`statx()` on Linux,
+  /// `GetFileInformationByHandle()` on Windows), which is cheaper than
+  /// calling size(), permissions(), attributes() and times() separately
+  /// and guarantees that the values are consistent with each other.
+  ///
+  /// @param mask The members of @c file_info to retrieve.
+  /// Defaults to @ref file_info_mask::all.
+  ///
+  /// @return The file's metadata. Members that weren't requested or aren't
+  /// available for this file keep their default values.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ASIOEXT_DECL file_info query(file_info_mask mask = file_info_mask::all);
+
+  /// @brief Get a snapshot of the file's metadata.
+  ///
+  /// This function retrieves the metadata selected by @c mask using
+  /// a single system call (`statx()` on Linux,
+  /// `GetFileInformationByHandle()` on Windows), which is cheaper than
+  /// calling size(), permissions(), attributes() and times() separately
+  /// and guarantees that the values are consistent with each other.
+  ///
+  /// @param mask The members of @c file_info to retrieve.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ///
+  /// @return The file's metadata. Members that weren't requested or aren't
+  /// available for this file keep their default values.
+  ASIOEXT_DECL file_info query(file_info_mask mask,
+                               error_code& ec) ASIOEXT_NOEXCEPT;
+
+  /// @}
+
+  /// @name Locking functions
+  /// @{
+
+  /// @brief Lock a range of the file.
+  ///
+  /// This function blocks until the lock on @c range has been acquired.
+  ///
+  /// On Linux, open file description locks are used, which are owned by
+  /// the file_handle (and its duplicates) instead of the process. Two
+  /// file_handle objects that opened the same file separately therefore
+  /// contend for locks even if they belong to the same process.
+  /// On other POSIX systems, classic record locks (owned by the process)
+  /// are used. On Windows, `LockFileEx()` is used.
+  ///
+  /// @param range The range to lock.
+  ///
+  /// @param type The kind of lock to acquire.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ASIOEXT_DECL void lock(const file_range& range, lock_type type);
+
+  /// @brief Lock a range of the file.
+  ///
+  /// This function blocks until the lock on @c range has been acquired.
+  /// See lock(const file_range&, lock_type) for details.
+  ///
+  /// @param range The range to lock.
+  ///
+  /// @param type The kind of lock to acquire.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ASIOEXT_DECL void lock(const file_range& range, lock_type type,
+                         error_code& ec) ASIOEXT_NOEXCEPT;
+
+  /// @brief Try to lock a range of the file.
+  ///
+  /// This function attempts to acquire a lock on @c range without
+  /// blocking.
+  ///
+  /// @param range The range to lock.
+  ///
+  /// @param type The kind of lock to acquire.
+  ///
+  /// @return @c true if the lock was acquired, @c false if a conflicting
+  /// lock is held by someone else.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ASIOEXT_DECL bool try_lock(const file_range& range, lock_type type);
+
+  /// @brief Try to lock a range of the file.
+  ///
+  /// This function attempts to acquire a lock on @c range without
+  /// blocking.
+  ///
+  /// @param range The range to lock.
+  ///
+  /// @param type The kind of lock to acquire.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ///
+  /// @return @c true if the lock was acquired, @c false if a conflicting
+  /// lock is held by someone else or an error occurred.
+  ASIOEXT_DECL bool try_lock(const file_range& range, lock_type type,
+                             error_code& ec) ASIOEXT_NOEXCEPT;
+
+  /// @brief Unlock a range of the file.
+  ///
+  /// @param range The range to unlock. On Windows, this needs to match
+  /// a previously locked range exactly.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  ASIOEXT_DECL void unlock(const file_range& range);
+
+  /// @brief Unlock a range of the file.
+  ///
+  /// @param range The range to unlock. On Windows, this needs to match
+  /// a previously locked range exactly.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ASIOEXT_DECL void unlock(const file_range& range,
+                           error_code& ec) ASIOEXT_NOEXCEPT;
+
   /// @}
 
   /// @name SyncReadStream functions
@@ -0,0 +1,139 @@
+/// @file
+/// Defines the file_info struct and the file_type and file_info_mask enums.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_FILEINFO_HPP
+#define ASIOEXT_FILEINFO_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include "asioext/file_times.hpp"
+#include "asioext/file_perms.hpp"
+#include "asioext/file_attrs.hpp"
+
+#include "asioext/detail/cstdint.hpp"
+#include "asioext/detail/enum.hpp"
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup files_meta
+/// @brief The type of a file.
+enum class file_type
+{
+  /// The type couldn't be determined.
+  unknown = 0,
+
+  /// A regular file.
+  regular,
+
+  /// A directory.
+  directory,
+
+  /// A symbolic link.
+  symlink,
+
+  /// A block device.
+  block,
+
+  /// A character device.
+  character,
+
+  /// A FIFO (named pipe).
+  fifo,
+
+  /// A socket.
+  socket,
+};
+
+/// @ingroup files_meta
+/// @brief Selects the members of a @ref file_info that should be retrieved.
+///
+/// Requesting only what's actually needed allows the OS to skip work
+/// (e.g. `statx()` doesn't need to synchronize a network file system's
+/// attributes just to report an inode number).
+enum class file_info_mask
+{
+  /// Retrieve nothing.
+  none = 0,
+
+  /// Retrieve @ref file_info::type.
+  type = 1 << 0,
+
+  /// Retrieve @ref file_info::perms.
+  perms = 1 << 1,
+
+  /// Retrieve @ref file_info::attrs.
+  attrs = 1 << 2,
+
+  /// Retrieve @ref file_info::size.
+  size = 1 << 3,
+
+  /// Retrieve @ref file_info::inode.
+  inode = 1 << 4,
+
+  /// Retrieve @ref file_info::device.
+  device = 1 << 5,
+
+  /// Retrieve @ref file_info::hard_links.
+  hard_links = 1 << 6,
+
+  /// Retrieve @ref file_info::block_size.
+  block_size = 1 << 7,
+
+  /// Retrieve @ref file_times::ctime.
+  ctime = 1 << 8,
+
+  /// Retrieve @ref file_times::atime.
+  atime = 1 << 9,
+
+  /// Retrieve @ref file_times::mtime.
+  mtime = 1 << 10,
+
+  /// Retrieve all of @ref file_info::times.
+  times = ctime | atime | mtime,
+
+  /// Retrieve everything.
+  all = type | perms | attrs | size | inode | device | hard_links |
+        block_size | times,
+};
+
+ASIOEXT_ENUM_CLASS_BITMASK_OPS(file_info_mask)
+
+/// @ingroup files_meta
+/// @brief A snapshot of a file's metadata.
+///
+/// All members are obtained at the same time, so they are consistent
+/// with each other. Members that weren't requested (see @ref file_info_mask)
+/// or that aren't available for the file keep their default values.
+struct file_info
+{
+  /// @brief The file's type.
+  file_type type = file_type::unknown;
+  /// @brief The file's permissions.
+  file_perms perms = file_perms::none;
+  /// @brief The file's attributes.
+  file_attrs attrs = file_attrs::none;
+  /// @brief The file's size in bytes.
+  uint64_t size = 0;
+  /// @brief The file's serial (inode) number.
+  uint64_t inode = 0;
+  /// @brief The ID of the device containing the file.
+  uint64_t device = 0;
+  /// @brief The number of hard links to the file.
+  uint64_t hard_links = 0;
+  /// @brief The preferred block size for I/O on this file.
+  uint32_t block_size = 0;
+  /// @brief The file's time points.
+  file_times times;
+};
+
+ASIOEXT_NS_END
+
+#endif
@@ -0,0 +1,163 @@
+/// @file
+/// Defines the lock_type enum, the file_range struct and the
+/// file_lock_guard class template.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_FILELOCK_HPP
+#define ASIOEXT_FILELOCK_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include "asioext/error_code.hpp"
+
+#include "asioext/detail/cstdint.hpp"
+
+#include <mutex> // for std::adopt_lock_t
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup files_handle
+/// @brief The kind of lock to acquire on a file_range.
+enum class lock_type
+{
+  /// Any number of shared locks may overlap, as long as there's no
+  /// exclusive lock on the range.
+  shared,
+
+  /// No other lock may overlap an exclusive lock.
+  exclusive,
+};
+
+/// @ingroup files_handle
+/// @brief A range of bytes inside a file.
+///
+/// A range may extend past the current end of the file.
+struct file_range
+{
+  /// @brief The offset of the first byte in the range.
+  uint64_t offset = 0;
+
+  /// @brief The number of bytes in the range.
+  ///
+  /// Zero means "up to the end of the file", however far the file grows.
+  uint64_t length = 0;
+};
+
+/// @ingroup files_handle
+/// @brief Scoped ownership of a lock on a file_range.
+///
+/// This class owns a lock on a range of a @c Lockable file object
+/// (e.g. @ref file_handle or @ref basic_file) and releases it
+/// when destroyed.
+///
+/// @par Example
+/// @code
+/// {
+///   asioext::file_lock_guard<asioext::file_handle> guard(
+///       fh, asioext::file_range{0, 4096}, asioext::lock_type::exclusive);
+///   // ... modify the first 4096 bytes ...
+/// } // Lock released here.
+/// @endcode
+template <typename Lockable>
+class file_lock_guard
+{
+public:
+  /// @brief Acquire a lock on the given range.
+  ///
+  /// This constructor blocks until the lock has been acquired.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  file_lock_guard(Lockable& lockable, const file_range& range,
+                  lock_type type)
+    : lockable_(&lockable)
+    , range_(range)
+  {
+    lockable.lock(range, type);
+  }
+
+  /// @brief Take ownership of an already acquired lock.
+  ///
+  /// This is useful to manage a lock that has been acquired
+  /// asynchronously (e.g. using @ref basic_file::async_lock).
+  file_lock_guard(Lockable& lockable, const file_range& range,
+                  std::adopt_lock_t) ASIOEXT_NOEXCEPT
+    : lockable_(&lockable)
+    , range_(range)
+  {
+    // ctor
+  }
+
+  /// @brief Move-construct a file_lock_guard.
+  ///
+  /// Following the move, @c other doesn't own a lock anymore.
+  file_lock_guard(file_lock_guard&& other) ASIOEXT_NOEXCEPT
+    : lockable_(other.lockable_)
+    , range_(other.range_)
+  {
+    other.lockable_ = nullptr;
+  }
+
+  file_lock_guard(const file_lock_guard&) ASIOEXT_DELETED;
+  file_lock_guard& operator=(const file_lock_guard&) ASIOEXT_DELETED;
+
+  /// @brief Release the lock (if still owned).
+  ///
+  /// Errors are ignored.
+  ~file_lock_guard()
+  {
+    if (lockable_) {
+      error_code ec;
+      lockable_->unlock(range_, ec);
+    }
+  }
+
+  /// @brief Determine whether this object still owns a lock.
+  bool owns_lock() const ASIOEXT_NOEXCEPT
+  {
+    return lockable_ != nullptr;
+  }
+
+  /// @brief Get the locked range.
+  const file_range& range() const ASIOEXT_NOEXCEPT
+  {
+    return range_;
+  }
+
+  /// @brief Release the lock.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  /// The lock isn't owned by this object anymore in either case.
+  void unlock()
+  {
+    Lockable* lockable = lockable_;
+    lockable_ = nullptr;
+    if (lockable)
+      lockable->unlock(range_);
+  }
+
+  /// @brief Give up ownership of the lock without releasing it.
+  ///
+  /// @return The file object that is still locked, or @c nullptr if no lock
+  /// was owned.
+  Lockable* release() ASIOEXT_NOEXCEPT
+  {
+    Lockable* lockable = lockable_;
+    lockable_ = nullptr;
+    return lockable;
+  }
+
+private:
+  Lockable* lockable_;
+  file_range range_;
+};
+
+ASIOEXT_NS_END
+
+#endif
@@ -0,0 +1,45 @@
+/// @file
+/// Defines the file_times struct.
+///
+/// @copyright Copyright (c) 2015 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_FILETIMES_HPP
+#define ASIOEXT_FILETIMES_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/chrono.hpp"
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup files_time
+/// @brief Container for various time points associated with a file.
+///
+/// This struct contains several time points commonly associated
+/// with a file.
+/// The availability of the individual time points is platform-dependent.
+struct file_times
+{
+  /// @brief The file's creation time.
+  file_time_type ctime;
+  /// @brief The file's last access time.
+  file_time_type atime;
+  /// @brief The file's last modification time.
+  file_time_type mtime;
+};
+
+inline bool operator==(const file_times& a, const file_times& b)
+{ return a.ctime == b.ctime && a.atime == b.atime && a.mtime == b.mtime; }
+
+inline bool operator!=(const file_times& a, const file_times& b)
+{ return !(a == b); }
+
+ASIOEXT_NS_END
+
+#endif
@@ -0,0 +1,200 @@
+/// @file
+/// Defines growth policies for basic_linear_buffer.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_GROWTHPOLICY_HPP
+#define ASIOEXT_GROWTHPOLICY_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup core
+/// @defgroup growth_policy Buffer growth policies
+/// @brief Strategies for growing and shrinking a @c basic_linear_buffer.
+///
+/// A GrowthPolicy is a class with the following static member functions:
+///
+/// @code
+/// // Returns the new capacity for a buffer of |capacity| bytes that needs to
+/// // hold at least |required| bytes. The result must be in
+/// // [required, max_size]. |required| is never larger than |max_size|.
+/// static std::size_t grow(std::size_t capacity, std::size_t required,
+///                         std::size_t max_size);
+///
+/// // Returns the capacity a buffer of |capacity| bytes should shrink to,
+/// // now that it only holds |size| bytes. Returning |capacity| (or
+/// // anything smaller than |size|) keeps the memory.
+/// static std::size_t shrink(std::size_t capacity, std::size_t size);
+/// @endcode
+///
+/// Except for @ref hysteresis_shrink, the policies below never shrink
+/// a buffer on their own. @ref basic_linear_buffer::shrink_to_fit can
+/// always be used to give memory back explicitly.
+///
+/// @{
+
+/// @brief Grow the capacity by a constant factor of @c Num / @c Den.
+///
+/// This is the default policy, doubling the capacity whenever the
+/// buffer runs out of space. Smaller factors (e.g. 3/2) waste less memory
+/// at the cost of more frequent reallocations.
+template <std::size_t Num = 2, std::size_t Den = 1>
+struct geometric_growth
+{
+  static_assert(Den != 0 && Num > Den, "factor must be > 1");
+
+  static std::size_t grow(std::size_t capacity, std::size_t required,
+                          std::size_t max_size) ASIOEXT_NOEXCEPT
+  {
+    if (capacity >= max_size / Num * Den)
+      return max_size;
+    return (std::max)(required, capacity / Den * Num +
+                                capacity % Den * Num / Den);
+  }
+
+  static std::size_t shrink(std::size_t capacity,
+                            std::size_t /*size*/) ASIOEXT_NOEXCEPT
+  {
+    return capacity;
+  }
+};
+
+/// @brief Grow the capacity in fixed steps of @c Step bytes.
+///
+/// This keeps the unused capacity below @c Step bytes, which suits large
+/// buffers that grow slowly.
+template <std::size_t Step>
+struct fixed_step_growth
+{
+  static_assert(Step != 0, "Step must not be 0");
+
+  static std::size_t grow(std::size_t /*capacity*/, std::size_t required,
+                          std::size_t max_size) ASIOEXT_NOEXCEPT
+  {
+    const std::size_t rem = required % Step;
+    if (rem == 0)
+      return required;
+    if (max_size - required < Step - rem)
+      return max_size;
+    return required + (Step - rem);
+  }
+
+  static std::size_t shrink(std::size_t capacity,
+                            std::size_t /*size*/) ASIOEXT_NOEXCEPT
+  {
+    return capacity;
+  }
+};
+
+/// @brief Round another policy's capacities up to multiples of
+/// @c PageSize bytes.
+///
+/// Allocations of whole pages don't leave partially used pages behind,
+/// which is what most allocators do for large blocks anyway.
+template <typename Policy = geometric_growth<>, std::size_t PageSize = 4096>
+struct page_rounded_growth
+{
+  static_assert(PageSize != 0 && (PageSize & (PageSize - 1)) == 0,
+                "PageSize must be a power of two");
+
+  static std::size_t grow(std::size_t capacity, std::size_t required,
+                          std::size_t max_size) ASIOEXT_NOEXCEPT
+  {
+    const std::size_t cap = Policy::grow(capacity, required, max_size);
+    if (max_size - cap < PageSize - 1)
+      return max_size;
+    return (std::min)(max_size, (cap + PageSize - 1) & ~(PageSize - 1));
+  }
+
+  static std::size_t shrink(std::size_t capacity,
+                            std::size_t size) ASIOEXT_NOEXCEPT
+  {
+    const std::size_t cap = Policy::shrink(capacity, size);
+    if (cap >= capacity || cap < size)
+      return capacity;
+    return (std::min)(capacity, (cap + PageSize - 1) & ~(PageSize - 1));
+  }
+};
+
+/// @brief Grow to the next of a set of size classes.
+///
+/// The classes are the powers of two, with four evenly spaced classes
+/// in between each (16, 20, 24, 28, 32, 40, 48, 56, 64, ...), similar to
+/// the size classes of common malloc implementations. Requesting exactly
+/// a class size avoids memory the allocator would otherwise waste
+/// internally, and limits the overhead to 25%.
+struct size_class_growth
+{
+  static std::size_t grow(std::size_t /*capacity*/, std::size_t required,
+                          std::size_t max_size) ASIOEXT_NOEXCEPT
+  {
+    if (required <= 16)
+      return (std::min)(std::size_t(16), max_size);
+
+    // Find the power of two <= required, then the step between classes.
+    std::size_t base = 16;
+    while (base <= required / 2)
+      base *= 2;
+    const std::size_t step = base / 4;
+
+    const std::size_t rem = required % step;
+    if (rem == 0)
+      return required;
+    if (max_size - required < step - rem)
+      return max_size;
+    return required + (step - rem);
+  }
+
+  static std::size_t shrink(std::size_t capacity,
+                            std::size_t /*size*/) ASIOEXT_NOEXCEPT
+  {
+    return capacity;
+  }
+};
+
+/// @brief Give memory back after usage spikes.
+///
+/// Grows like @c Policy. Once the buffer's size drops to
+/// 1/@c Divisor of its capacity (or below), the buffer is shrunk to twice
+/// its size, but never below @c MinCapacity bytes. The gap between
+/// the grow and shrink thresholds keeps a buffer whose size oscillates
+/// from being reallocated over and over again.
+template <typename Policy = geometric_growth<>, std::size_t Divisor = 4,
+          std::size_t MinCapacity = 4096>
+struct hysteresis_shrink
+{
+  static_assert(Divisor > 2, "Divisor must be > 2");
+
+  static std::size_t grow(std::size_t capacity, std::size_t required,
+                          std::size_t max_size) ASIOEXT_NOEXCEPT
+  {
+    return Policy::grow(capacity, required, max_size);
+  }
+
+  static std::size_t shrink(std::size_t capacity,
+                            std::size_t size) ASIOEXT_NOEXCEPT
+  {
+    if (capacity <= MinCapacity || size > capacity / Divisor)
+      return capacity;
+    return (std::max)(MinCapacity, size * 2);
+  }
+};
+
+/// @}
+
+ASIOEXT_NS_END
+
+#endif
@@ -0,0 +1,155 @@
+/// @file
+/// Defines the huge_page_allocator class template.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_HUGEPAGEALLOCATOR_HPP
+#define ASIOEXT_HUGEPAGEALLOCATOR_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/detail/mapped_memory.hpp"
+#include "asioext/detail/throw_exception.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined(ASIOEXT_HAS_HUGE_PAGES) || defined(ASIOEXT_IS_DOCUMENTATION)
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup core
+/// @brief Allocator that backs large blocks with huge pages.
+///
+/// Blocks of at least @ref threshold bytes are mapped directly, using
+/// reserved huge pages (@c MAP_HUGETLB) if the system has any, and
+/// transparent huge pages (@c MADV_HUGEPAGE) otherwise. A single huge
+/// page replaces hundreds of regular pages, which greatly reduces
+/// TLB misses and page faults when streaming through multi-gigabyte
+/// buffers. If @ref prefault is set, all pages are faulted in up front,
+/// so that the first pass over the buffer doesn't pay for them.
+///
+/// Smaller blocks are allocated with <tt>::operator new</tt>, as rounding
+/// them up to a whole huge page would waste a lot of memory.
+///
+/// @code
+/// asioext::basic_linear_buffer<asioext::huge_page_allocator<uint8_t>> buf;
+/// asioext::read_file("big.bin", buf);
+/// @endcode
+///
+/// @note Only available on Linux.
+template <typename T>
+class huge_page_allocator
+{
+public:
+  typedef T value_type;
+  typedef std::false_type is_always_equal;
+  typedef std::true_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  template <typename U>
+  struct rebind { typedef huge_page_allocator<U> other; };
+
+  /// @brief Construct an allocator using the default threshold.
+  ///
+  /// The default threshold is the size of a huge page.
+  huge_page_allocator() ASIOEXT_NOEXCEPT
+    : threshold_(detail::mapped_memory::huge_page_size())
+    , prefault_(false)
+  {}
+
+  /// @brief Construct an allocator with the given options.
+  ///
+  /// @param threshold Blocks of at least this many bytes are backed by
+  /// huge pages.
+  ///
+  /// @param prefault Fault in all pages of huge page backed blocks when
+  /// they are allocated.
+  explicit huge_page_allocator(std::size_t threshold,
+                               bool prefault = false) ASIOEXT_NOEXCEPT
+    : threshold_(threshold)
+    , prefault_(prefault)
+  {}
+
+  template <typename U>
+  huge_page_allocator(const huge_page_allocator<U>& other) ASIOEXT_NOEXCEPT
+    : threshold_(other.threshold())
+    , prefault_(other.prefault())
+  {}
+
+  /// @brief Get the size (in bytes) from which on blocks are backed by
+  /// huge pages.
+  std::size_t threshold() const ASIOEXT_NOEXCEPT
+  {
+    return threshold_;
+  }
+
+  /// @brief Check whether huge page backed blocks are faulted in up front.
+  bool prefault() const ASIOEXT_NOEXCEPT
+  {
+    return prefault_;
+  }
+
+  /// @brief Allocate memory for @c n objects of type @c T.
+  ///
+  /// @throws std::bad_alloc Thrown if the memory couldn't be allocated.
+  T* allocate(std::size_t n)
+  {
+    void* data = nullptr;
+    if (n <= (std::numeric_limits<std::size_t>::max)() / sizeof(T)) {
+      if (n * sizeof(T) < threshold_)
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+      data = detail::mapped_memory::map_huge(n * sizeof(T), prefault_);
+    }
+
+    if (!data) {
+      std::bad_alloc ex;
+      detail::throw_exception(ex);
+    }
+    return static_cast<T*>(data);
+  }
+
+  /// @brief Free memory obtained from @ref allocate.
+  void deallocate(T* p, std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    if (n * sizeof(T) < threshold_)
+      ::operator delete(p);
+    else
+      detail::mapped_memory::unmap_huge(p, n * sizeof(T));
+  }
+
+private:
+  std::size_t threshold_;
+  bool prefault_;
+};
+
+// deallocate() has to pick the same path as allocate() did.
+template <typename T, typename U>
+inline bool operator==(const huge_page_allocator<T>& a,
+                       const huge_page_allocator<U>& b) ASIOEXT_NOEXCEPT
+{
+  return a.threshold() == b.threshold();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const huge_page_allocator<T>& a,
+                       const huge_page_allocator<U>& b) ASIOEXT_NOEXCEPT
+{
+  return a.threshold() != b.threshold();
+}
+
+ASIOEXT_NS_END
+
+#endif
+
+#endif
@@ -0,0 +1,122 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/buffer_pool.hpp"
+
+#include <cassert>
+
+ASIOEXT_NS_BEGIN
+
+// Returns the index of the smallest size class that fits |n| bytes.
+static std::size_t size_class(std::size_t n) ASIOEXT_NOEXCEPT
+{
+  std::size_t index = 0;
+  for (std::size_t size = buffer_pool::min_block_size; size < n; size *= 2)
+    ++index;
+  return index;
+}
+
+buffer_pool::buffer_pool(std::size_t max_cached_bytes) ASIOEXT_NOEXCEPT
+  : buffer_pool(max_cached_bytes, true)
+{
+}
+
+buffer_pool::buffer_pool(std::size_t max_cached_bytes,
+                         bool check_outstanding) ASIOEXT_NOEXCEPT
+  : max_cached_bytes_(max_cached_bytes)
+  , stats_()
+  , outstanding_(0)
+  , check_outstanding_(check_outstanding)
+{
+  for (std::size_t i = 0; i != num_classes; ++i)
+    free_lists_[i] = nullptr;
+}
+
+buffer_pool::~buffer_pool()
+{
+  // Blocks deallocated later would be put into a destroyed pool.
+  assert((!check_outstanding_ || outstanding_ == 0) &&
+         "buffer_pool destroyed while blocks are still in use");
+  trim();
+}
+
+void* buffer_pool::allocate(std::size_t n)
+{
+  ++stats_.allocations;
+  if (n > max_block_size) {
+    void* p = ::operator new(n);
+    ++outstanding_;
+    return p;
+  }
+
+  const std::size_t index = size_class(n);
+  if (free_block* block = free_lists_[index]) {
+    free_lists_[index] = block->next;
+    ++stats_.hits;
+    --stats_.cached_blocks;
+    stats_.cached_bytes -= min_block_size << index;
+    ++outstanding_;
+    return block;
+  }
+  void* p = ::operator new(min_block_size << index);
+  ++outstanding_;
+  return p;
+}
+
+void buffer_pool::deallocate(void* p, std::size_t n) ASIOEXT_NOEXCEPT
+{
+  // Unbalanced for the thread-local pools, if blocks change threads.
+  --outstanding_;
+
+  if (n > max_block_size) {
+    ++stats_.releases;
+    ::operator delete(p);
+    return;
+  }
+
+  const std::size_t index = size_class(n);
+  const std::size_t size = min_block_size << index;
+  if (size > max_cached_bytes_ - stats_.cached_bytes) {
+    ++stats_.releases;
+    ::operator delete(p);
+    return;
+  }
+
+  free_block* block = static_cast<free_block*>(p);
+  block->next = free_lists_[index];
+  free_lists_[index] = block;
+  ++stats_.cached_blocks;
+  stats_.cached_bytes += size;
+}
+
+void buffer_pool::trim() ASIOEXT_NOEXCEPT
+{
+  for (std::size_t i = 0; i != num_classes; ++i) {
+    while (free_block* block = free_lists_[i]) {
+      free_lists_[i] = block->next;
+      ::operator delete(block);
+    }
+  }
+  stats_.cached_blocks = 0;
+  stats_.cached_bytes = 0;
+}
+
+buffer_pool& buffer_pool::thread_local_pool()
+{
+  static thread_local buffer_pool pool(default_max_cached_bytes, false);
+  return pool;
+}
+
+buffer_pool_service::buffer_pool_service(asio::io_context& owner)
+  : io_context_service_base(owner)
+{
+}
+
+void buffer_pool_service::shutdown_service()
+{
+  pool_.trim();
+}
+
+ASIOEXT_NS_END
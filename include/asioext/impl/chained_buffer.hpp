@@ -0,0 +1,36 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_IMPL_CHAINEDBUFFER_HPP
+#define ASIOEXT_IMPL_CHAINEDBUFFER_HPP
+
+#include "asioext/detail/throw_exception.hpp"
+
+#include <stdexcept>
+
+ASIOEXT_NS_BEGIN
+
+template <typename Allocator>
+const std::size_t basic_chained_buffer<Allocator>::default_segment_size;
+
+template <typename Allocator>
+void basic_chained_buffer<Allocator>::reserve(std::size_t min_cap)
+{
+  if (min_cap > max_size_) {
+    std::length_error ex("basic_chained_buffer too long");
+    detail::throw_exception(ex);
+  }
+
+  while (capacity() < min_cap) {
+    // Don't leak the segment if the list can't grow.
+    segment_holder segment(allocator_, segment_size_);
+    segments_.push_back(segment.data);
+    segment.data = nullptr;
+  }
+}
+
+ASIOEXT_NS_END
+
+#endif
@@ -0,0 +1,269 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/checksum.hpp"
+
+#include <cstring>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+# define ASIOEXT_DETAIL_CRC32C_SSE42 1
+# include <nmmintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+# define ASIOEXT_DETAIL_CRC32C_SSE42 1
+# include <nmmintrin.h>
+# include <intrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+# define ASIOEXT_DETAIL_CRC32C_ARM 1
+# include <arm_acle.h>
+#endif
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+static inline uint32_t load_le32(const unsigned char* p)
+{
+  return static_cast<uint32_t>(p[0]) |
+         static_cast<uint32_t>(p[1]) << 8 |
+         static_cast<uint32_t>(p[2]) << 16 |
+         static_cast<uint32_t>(p[3]) << 24;
+}
+
+static inline uint64_t load_le64(const unsigned char* p)
+{
+  return static_cast<uint64_t>(load_le32(p)) |
+         static_cast<uint64_t>(load_le32(p + 4)) << 32;
+}
+
+// Slicing-by-8 tables for the (reflected) Castagnoli polynomial.
+static const uint32_t (&crc32c_tables())[8][256]
+{
+  struct tables
+  {
+    tables()
+    {
+      for (uint32_t i = 0; i != 256; ++i) {
+        uint32_t crc = i;
+        for (int j = 0; j != 8; ++j)
+          crc = (crc >> 1) ^ (0x82f63b78 & (0 - (crc & 1)));
+        t[0][i] = crc;
+      }
+      for (uint32_t i = 0; i != 256; ++i) {
+        for (int k = 1; k != 8; ++k)
+          t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xff];
+      }
+    }
+
+    uint32_t t[8][256];
+  };
+
+  static const tables instance;
+  return instance.t;
+}
+
+static uint32_t crc32c_portable(uint32_t crc, const unsigned char* p,
+                                std::size_t size)
+{
+  const uint32_t (&t)[8][256] = crc32c_tables();
+
+  for (; size >= 8; p += 8, size -= 8) {
+    const uint32_t lo = crc ^ load_le32(p);
+    const uint32_t hi = load_le32(p + 4);
+    crc = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^
+          t[5][(lo >> 16) & 0xff] ^ t[4][lo >> 24] ^
+          t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^
+          t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+  }
+
+  for (; size != 0; ++p, --size)
+    crc = t[0][(crc ^ *p) & 0xff] ^ (crc >> 8);
+  return crc;
+}
+
+#if defined(ASIOEXT_DETAIL_CRC32C_SSE42)
+# if defined(__GNUC__)
+__attribute__((target("sse4.2")))
+# endif
+static uint32_t crc32c_sse42(uint32_t crc, const unsigned char* p,
+                             std::size_t size)
+{
+  for (; size != 0 && (reinterpret_cast<std::size_t>(p) & 7); ++p, --size)
+    crc = _mm_crc32_u8(crc, *p);
+
+  uint64_t crc64 = crc;
+  for (; size >= 8; p += 8, size -= 8) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    crc64 = _mm_crc32_u64(crc64, v);
+  }
+  crc = static_cast<uint32_t>(crc64);
+
+  for (; size != 0; ++p, --size)
+    crc = _mm_crc32_u8(crc, *p);
+  return crc;
+}
+
+static bool has_sse42()
+{
+# if defined(__GNUC__)
+  static const bool supported = (__builtin_cpu_init(),
+                                 __builtin_cpu_supports("sse4.2") != 0);
+# else
+  static const bool supported = [] {
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+  }();
+# endif
+  return supported;
+}
+#elif defined(ASIOEXT_DETAIL_CRC32C_ARM)
+static uint32_t crc32c_arm(uint32_t crc, const unsigned char* p,
+                           std::size_t size)
+{
+  for (; size >= 8; p += 8, size -= 8) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    crc = __crc32cd(crc, v);
+  }
+
+  for (; size != 0; ++p, --size)
+    crc = __crc32cb(crc, *p);
+  return crc;
+}
+#endif
+
+static const uint64_t xxh64_prime1 = 11400714785074694791ull;
+static const uint64_t xxh64_prime2 = 14029467366897019727ull;
+static const uint64_t xxh64_prime3 = 1609587929392839161ull;
+static const uint64_t xxh64_prime4 = 9650029242287828579ull;
+static const uint64_t xxh64_prime5 = 2870177450012600261ull;
+
+static inline uint64_t xxh64_rotl(uint64_t x, int r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t xxh64_round(uint64_t acc, uint64_t input)
+{
+  acc += input * xxh64_prime2;
+  acc = xxh64_rotl(acc, 31);
+  return acc * xxh64_prime1;
+}
+
+static inline uint64_t xxh64_merge_round(uint64_t acc, uint64_t val)
+{
+  acc ^= xxh64_round(0, val);
+  return acc * xxh64_prime1 + xxh64_prime4;
+}
+
+}
+
+void crc32c_hasher::update(const void* data, std::size_t size) ASIOEXT_NOEXCEPT
+{
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+#if defined(ASIOEXT_DETAIL_CRC32C_SSE42)
+  if (detail::has_sse42()) {
+    crc_ = detail::crc32c_sse42(crc_, p, size);
+    return;
+  }
+#elif defined(ASIOEXT_DETAIL_CRC32C_ARM)
+  crc_ = detail::crc32c_arm(crc_, p, size);
+  return;
+#endif
+  crc_ = detail::crc32c_portable(crc_, p, size);
+}
+
+void xxhash64_hasher::update(const void* data,
+                             std::size_t size) ASIOEXT_NOEXCEPT
+{
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  const unsigned char* const end = p + size;
+
+  total_size_ += size;
+
+  if (pending_size_ + size < 32) {
+    if (size != 0)
+      std::memcpy(pending_ + pending_size_, p, size);
+    pending_size_ += size;
+    return;
+  }
+
+  if (pending_size_ != 0) {
+    const std::size_t fill = 32 - pending_size_;
+    std::memcpy(pending_ + pending_size_, p, fill);
+    p += fill;
+    for (int i = 0; i != 4; ++i)
+      acc_[i] = detail::xxh64_round(acc_[i],
+                                    detail::load_le64(pending_ + i * 8));
+    pending_size_ = 0;
+  }
+
+  uint64_t v1 = acc_[0], v2 = acc_[1], v3 = acc_[2], v4 = acc_[3];
+  for (; end - p >= 32; p += 32) {
+    v1 = detail::xxh64_round(v1, detail::load_le64(p));
+    v2 = detail::xxh64_round(v2, detail::load_le64(p + 8));
+    v3 = detail::xxh64_round(v3, detail::load_le64(p + 16));
+    v4 = detail::xxh64_round(v4, detail::load_le64(p + 24));
+  }
+  acc_[0] = v1; acc_[1] = v2; acc_[2] = v3; acc_[3] = v4;
+
+  if (p != end) {
+    pending_size_ = static_cast<std::size_t>(end - p);
+    std::memcpy(pending_, p, pending_size_);
+  }
+}
+
+uint64_t xxhash64_hasher::value() const ASIOEXT_NOEXCEPT
+{
+  uint64_t h;
+  if (total_size_ >= 32) {
+    h = detail::xxh64_rotl(acc_[0], 1) + detail::xxh64_rotl(acc_[1], 7) +
+        detail::xxh64_rotl(acc_[2], 12) + detail::xxh64_rotl(acc_[3], 18);
+    for (int i = 0; i != 4; ++i)
+      h = detail::xxh64_merge_round(h, acc_[i]);
+  } else {
+    h = seed_ + detail::xxh64_prime5;
+  }
+
+  h += total_size_;
+
+  const unsigned char* p = pending_;
+  const unsigned char* const end = pending_ + pending_size_;
+  for (; end - p >= 8; p += 8) {
+    h ^= detail::xxh64_round(0, detail::load_le64(p));
+    h = detail::xxh64_rotl(h, 27) * detail::xxh64_prime1 +
+        detail::xxh64_prime4;
+  }
+  if (end - p >= 4) {
+    h ^= static_cast<uint64_t>(detail::load_le32(p)) * detail::xxh64_prime1;
+    h = detail::xxh64_rotl(h, 23) * detail::xxh64_prime2 +
+        detail::xxh64_prime3;
+    p += 4;
+  }
+  for (; p != end; ++p) {
+    h ^= *p * detail::xxh64_prime5;
+    h = detail::xxh64_rotl(h, 11) * detail::xxh64_prime1;
+  }
+
+  h ^= h >> 33;
+  h *= detail::xxh64_prime2;
+  h ^= h >> 29;
+  h *= detail::xxh64_prime3;
+  h ^= h >> 32;
+  return h;
+}
+
+void xxhash64_hasher::reset(uint64_t seed) ASIOEXT_NOEXCEPT
+{
+  seed_ = seed;
+  total_size_ = 0;
+  acc_[0] = seed + detail::xxh64_prime1 + detail::xxh64_prime2;
+  acc_[1] = seed + detail::xxh64_prime2;
+  acc_[2] = seed;
+  acc_[3] = seed - detail::xxh64_prime1;
+  pending_size_ = 0;
+}
+
+ASIOEXT_NS_END
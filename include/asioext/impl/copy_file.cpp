@@ -0,0 +1,27 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/copy_file.hpp"
+
+#include "asioext/detail/throw_error.hpp"
+
+ASIOEXT_NS_BEGIN
+
+uint64_t copy_file(file_handle src, file_handle dst)
+{
+  error_code ec;
+  const uint64_t total = copy_file(src, dst, ec);
+  detail::throw_error(ec, "copy_file");
+  return total;
+}
+
+uint64_t copy_file(file_handle src, file_handle dst,
+                   error_code& ec) ASIOEXT_NOEXCEPT
+{
+  detail::null_hasher hasher;
+  return detail::copy_file_aux(src, dst, hasher, ec);
+}
+
+ASIOEXT_NS_END
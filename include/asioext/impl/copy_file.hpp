@@ -0,0 +1,84 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_IMPL_COPYFILE_HPP
+#define ASIOEXT_IMPL_COPYFILE_HPP
+
+#include "asioext/detail/error.hpp"
+#include "asioext/detail/hashing.hpp"
+#include "asioext/detail/throw_error.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/read.hpp>
+# include <boost/asio/write.hpp>
+#else
+# include <asio/read.hpp>
+# include <asio/write.hpp>
+#endif
+
+#include <memory>
+#include <new>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+template <class Hasher>
+uint64_t copy_file_aux(file_handle src, file_handle dst, Hasher& hasher,
+                       error_code& ec)
+{
+  std::unique_ptr<unsigned char[]> buffer(
+      new (std::nothrow) unsigned char[hashing_chunk_size]);
+  if (!buffer) {
+    ec = asio::error::no_memory;
+    return 0;
+  }
+
+  uint64_t total = 0;
+  while (true) {
+    const std::size_t actual = asio::read(
+        src, asio::buffer(buffer.get(), hashing_chunk_size), ec);
+    if (ec && ec != asio::error::eof)
+      return total;
+
+    const bool done = !!ec;
+    if (actual != 0) {
+      hasher.update(buffer.get(), actual);
+      asio::write(dst, asio::buffer(buffer.get(), actual), ec);
+      if (ec)
+        return total;
+      total += actual;
+    }
+
+    if (done) {
+      ec = error_code();
+      return total;
+    }
+  }
+}
+
+}
+
+template <class Hasher>
+ASIOEXT_DETAIL_COPYFILE_HASH_RET(Hasher)
+    copy_file(file_handle src, file_handle dst, Hasher& hasher)
+{
+  error_code ec;
+  const uint64_t total = copy_file(src, dst, hasher, ec);
+  detail::throw_error(ec, "copy_file");
+  return total;
+}
+
+template <class Hasher>
+ASIOEXT_DETAIL_COPYFILE_HASH_RET(Hasher)
+    copy_file(file_handle src, file_handle dst, Hasher& hasher,
+              error_code& ec)
+{
+  return detail::copy_file_aux(src, dst, hasher, ec);
+}
+
+ASIOEXT_NS_END
+
+#endif
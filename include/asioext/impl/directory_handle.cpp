@@ -0,0 +1,175 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/directory_handle.hpp"
+
+#include "asioext/detail/throw_error.hpp"
+
+ASIOEXT_NS_BEGIN
+
+directory_handle::~directory_handle()
+{
+  error_code ec;
+  close(ec);
+  // error is swallowed
+}
+
+directory_handle& directory_handle::operator=(directory_handle&& other)
+{
+  if (handle_ != -1)
+    close();
+
+  handle_ = other.handle_;
+  other.handle_ = -1;
+  return *this;
+}
+
+void directory_handle::close()
+{
+  error_code ec;
+  close(ec);
+  detail::throw_error(ec, "close");
+}
+
+void directory_handle::close(error_code& ec) ASIOEXT_NOEXCEPT
+{
+  if (handle_ != -1) {
+    detail::posix_file_ops::close(handle_, ec);
+    handle_ = -1;
+  } else {
+    ec = error_code();
+  }
+}
+
+file_info directory_handle::stat(const char* name) const
+{
+  error_code ec;
+  const file_info info = stat(name, ec);
+  detail::throw_error(ec, "stat");
+  return info;
+}
+
+file_info directory_handle::stat(const char* name,
+                                 error_code& ec) const ASIOEXT_NOEXCEPT
+{
+  file_info info;
+  detail::posix_file_ops::query_at(handle_, name, true, file_info_mask::all,
+                                   info, ec);
+  return info;
+}
+
+file_info directory_handle::symlink_stat(const char* name) const
+{
+  error_code ec;
+  const file_info info = symlink_stat(name, ec);
+  detail::throw_error(ec, "symlink_stat");
+  return info;
+}
+
+file_info directory_handle::symlink_stat(const char* name,
+                                         error_code& ec) const ASIOEXT_NOEXCEPT
+{
+  file_info info;
+  detail::posix_file_ops::query_at(handle_, name, false, file_info_mask::all,
+                                   info, ec);
+  return info;
+}
+
+void directory_handle::remove(const char* name) const
+{
+  error_code ec;
+  remove(name, ec);
+  detail::throw_error(ec, "remove");
+}
+
+void directory_handle::remove(const char* name,
+                              error_code& ec) const ASIOEXT_NOEXCEPT
+{
+  detail::posix_file_ops::unlink_at(handle_, name, false, ec);
+}
+
+void directory_handle::remove_directory(const char* name) const
+{
+  error_code ec;
+  remove_directory(name, ec);
+  detail::throw_error(ec, "remove_directory");
+}
+
+void directory_handle::remove_directory(const char* name,
+                                        error_code& ec) const ASIOEXT_NOEXCEPT
+{
+  detail::posix_file_ops::unlink_at(handle_, name, true, ec);
+}
+
+void directory_handle::rename(const char* old_name,
+                              const char* new_name) const
+{
+  error_code ec;
+  rename(old_name, *this, new_name, ec);
+  detail::throw_error(ec, "rename");
+}
+
+void directory_handle::rename(const char* old_name, const char* new_name,
+                              error_code& ec) const ASIOEXT_NOEXCEPT
+{
+  rename(old_name, *this, new_name, ec);
+}
+
+void directory_handle::rename(const char* old_name,
+                              const directory_handle& new_dir,
+                              const char* new_name) const
+{
+  error_code ec;
+  rename(old_name, new_dir, new_name, ec);
+  detail::throw_error(ec, "rename");
+}
+
+void directory_handle::rename(const char* old_name,
+                              const directory_handle& new_dir,
+                              const char* new_name,
+                              error_code& ec) const ASIOEXT_NOEXCEPT
+{
+  detail::posix_file_ops::rename_at(handle_, old_name,
+                                    new_dir.handle_, new_name, ec);
+}
+
+directory_handle open_directory(const char* path)
+{
+  error_code ec;
+  directory_handle h = open_directory(path, ec);
+  detail::throw_error(ec, "open_directory");
+  return h;
+}
+
+directory_handle open_directory(const char* path,
+                                error_code& ec) ASIOEXT_NOEXCEPT
+{
+  return directory_handle(detail::posix_file_ops::open_directory(
+      -1, path, resolve_flags::none, ec));
+}
+
+directory_handle open_directory(const directory_handle& dir, const char* path,
+                                resolve_flags resolve)
+{
+  error_code ec;
+  directory_handle h = open_directory(dir, path, resolve, ec);
+  detail::throw_error(ec, "open_directory");
+  return h;
+}
+
+directory_handle open_directory(const directory_handle& dir, const char* path,
+                                error_code& ec) ASIOEXT_NOEXCEPT
+{
+  return open_directory(dir, path, resolve_flags::none, ec);
+}
+
+directory_handle open_directory(const directory_handle& dir, const char* path,
+                                resolve_flags resolve,
+                                error_code& ec) ASIOEXT_NOEXCEPT
+{
+  return directory_handle(detail::posix_file_ops::open_directory(
+      dir.native_handle(), path, resolve, ec));
+}
+
+ASIOEXT_NS_END
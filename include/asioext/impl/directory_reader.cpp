@@ -0,0 +1,258 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/directory_reader.hpp"
+
+#include "asioext/detail/throw_error.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+#include <dirent.h>
+#include <unistd.h>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+static file_type dirent_type_to_file_type(unsigned char type) ASIOEXT_NOEXCEPT
+{
+  switch (type) {
+    case DT_REG: return file_type::regular;
+    case DT_DIR: return file_type::directory;
+    case DT_LNK: return file_type::symlink;
+    case DT_BLK: return file_type::block;
+    case DT_CHR: return file_type::character;
+    case DT_FIFO: return file_type::fifo;
+    case DT_SOCK: return file_type::socket;
+    default: return file_type::unknown;
+  }
+}
+
+static bool is_dot_or_dot_dot(const char* name) ASIOEXT_NOEXCEPT
+{
+  return name[0] == '.' &&
+      (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+#if defined(ASIOEXT_HAS_GETDENTS64)
+// Layout of the records returned by getdents64(), up to d_name.
+struct linux_dirent64_header
+{
+  uint64_t d_ino;
+  int64_t d_off;
+  unsigned short d_reclen;
+  unsigned char d_type;
+};
+
+static const std::size_t linux_dirent64_name_offset =
+    offsetof(linux_dirent64_header, d_type) + 1;
+#endif
+
+}
+
+directory_reader::directory_reader() ASIOEXT_NOEXCEPT
+  : buffer_size_(0)
+#if !defined(ASIOEXT_HAS_GETDENTS64)
+  , stream_(nullptr)
+#endif
+{
+  // ctor
+}
+
+directory_reader::directory_reader(directory_handle dir,
+                                   std::size_t buffer_size)
+  : dir_(std::move(dir))
+  , buffer_size_(buffer_size)
+#if !defined(ASIOEXT_HAS_GETDENTS64)
+  , stream_(nullptr)
+#endif
+{
+#if defined(ASIOEXT_HAS_GETDENTS64)
+  // Must at least fit a single record with a maximum-length name.
+  if (buffer_size_ < 1024)
+    buffer_size_ = 1024;
+  buffer_.reset(new unsigned char[buffer_size_]);
+#endif
+}
+
+directory_reader::~directory_reader()
+{
+#if !defined(ASIOEXT_HAS_GETDENTS64)
+  if (stream_)
+    ::closedir(static_cast<DIR*>(stream_));
+#endif
+}
+
+directory_reader::directory_reader(directory_reader&& other) ASIOEXT_NOEXCEPT
+  : dir_(std::move(other.dir_))
+  , buffer_(std::move(other.buffer_))
+  , buffer_size_(other.buffer_size_)
+#if !defined(ASIOEXT_HAS_GETDENTS64)
+  , stream_(other.stream_)
+#endif
+{
+  other.buffer_size_ = 0;
+#if !defined(ASIOEXT_HAS_GETDENTS64)
+  other.stream_ = nullptr;
+#endif
+}
+
+directory_reader& directory_reader::operator=(
+    directory_reader&& other) ASIOEXT_NOEXCEPT
+{
+  if (this != &other) {
+#if !defined(ASIOEXT_HAS_GETDENTS64)
+    if (stream_)
+      ::closedir(static_cast<DIR*>(stream_));
+    stream_ = other.stream_;
+    other.stream_ = nullptr;
+#endif
+    error_code ec;
+    dir_.close(ec);
+    dir_ = std::move(other.dir_);
+    buffer_ = std::move(other.buffer_);
+    buffer_size_ = other.buffer_size_;
+    other.buffer_size_ = 0;
+  }
+  return *this;
+}
+
+void directory_reader::assign(directory_handle dir)
+{
+  release();
+  dir_ = std::move(dir);
+#if defined(ASIOEXT_HAS_GETDENTS64)
+  if (!buffer_) {
+    buffer_size_ = buffer_size_ < 1024 ? default_buffer_size : buffer_size_;
+    buffer_.reset(new unsigned char[buffer_size_]);
+  }
+#endif
+}
+
+directory_handle directory_reader::release() ASIOEXT_NOEXCEPT
+{
+#if !defined(ASIOEXT_HAS_GETDENTS64)
+  if (stream_) {
+    ::closedir(static_cast<DIR*>(stream_));
+    stream_ = nullptr;
+  }
+#endif
+  return directory_handle(dir_.release());
+}
+
+std::size_t directory_reader::read(std::vector<directory_entry>& entries)
+{
+  error_code ec;
+  const std::size_t n = read(entries, ec);
+  detail::throw_error(ec, "read");
+  return n;
+}
+
+#if defined(ASIOEXT_HAS_GETDENTS64)
+std::size_t directory_reader::read(std::vector<directory_entry>& entries,
+                                   error_code& ec) ASIOEXT_NOEXCEPT
+{
+  const std::size_t initial_size = entries.size();
+
+  // A batch can consist of only "." and "..", so keep going until we
+  // have something to return.
+  while (entries.size() == initial_size) {
+    const std::size_t size = detail::posix_file_ops::read_directory(
+        dir_.native_handle(), buffer_.get(), buffer_size_, ec);
+    if (ec || size == 0)
+      break;
+
+    try {
+      for (std::size_t offset = 0; offset < size; ) {
+        const unsigned char* record = buffer_.get() + offset;
+        detail::linux_dirent64_header header;
+        std::memcpy(&header, record, sizeof(header));
+        offset += header.d_reclen;
+
+        const char* name = reinterpret_cast<const char*>(
+            record + detail::linux_dirent64_name_offset);
+        if (detail::is_dot_or_dot_dot(name))
+          continue;
+
+        entries.emplace_back();
+        directory_entry& entry = entries.back();
+        entry.name = name;
+        entry.type = detail::dirent_type_to_file_type(header.d_type);
+        entry.inode = header.d_ino;
+      }
+    } catch (const std::bad_alloc&) {
+      ec = asio::error::no_memory;
+      break;
+    }
+  }
+  return entries.size() - initial_size;
+}
+#else
+std::size_t directory_reader::read(std::vector<directory_entry>& entries,
+                                   error_code& ec) ASIOEXT_NOEXCEPT
+{
+  if (!stream_) {
+    // fdopendir() takes ownership of the descriptor, but we still
+    // need ours for stat().
+    const int fd = detail::posix_file_ops::duplicate(dir_.native_handle(), ec);
+    if (ec)
+      return 0;
+
+    stream_ = ::fdopendir(fd);
+    if (!stream_) {
+      detail::posix_file_ops::set_error(ec, errno);
+      ::close(fd);
+      return 0;
+    }
+  }
+
+  // Roughly match the amount of entries a getdents64() call would return.
+  const std::size_t max_entries = buffer_size_ / 32 + 1;
+  const std::size_t initial_size = entries.size();
+
+  ec = error_code();
+  try {
+    while (entries.size() - initial_size < max_entries) {
+      errno = 0;
+      const struct dirent* d = ::readdir(static_cast<DIR*>(stream_));
+      if (!d) {
+        if (errno != 0)
+          detail::posix_file_ops::set_error(ec, errno);
+        break;
+      }
+
+      if (detail::is_dot_or_dot_dot(d->d_name))
+        continue;
+
+      entries.emplace_back();
+      directory_entry& entry = entries.back();
+      entry.name = d->d_name;
+      entry.type = detail::dirent_type_to_file_type(d->d_type);
+      entry.inode = static_cast<uint64_t>(d->d_ino);
+    }
+  } catch (const std::bad_alloc&) {
+    ec = asio::error::no_memory;
+  }
+  return entries.size() - initial_size;
+}
+#endif
+
+file_info directory_reader::stat(const directory_entry& entry) const
+{
+  error_code ec;
+  const file_info info = stat(entry, ec);
+  detail::throw_error(ec, "stat");
+  return info;
+}
+
+file_info directory_reader::stat(const directory_entry& entry,
+                                 error_code& ec) const ASIOEXT_NOEXCEPT
+{
+  return dir_.symlink_stat(entry.name.c_str(), ec);
+}
+
+ASIOEXT_NS_END
@@ -0,0 +1,77 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_IMPL_DIRECTORYREADER_HPP
+#define ASIOEXT_IMPL_DIRECTORYREADER_HPP
+
+#include "asioext/bind_handler.hpp"
+#include "asioext/work.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/associated_executor.hpp>
+# include <boost/asio/post.hpp>
+#else
+# include <asio/associated_executor.hpp>
+# include <asio/post.hpp>
+#endif
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+// Runs on the file thread pool and hands the batch back to
+// the handler's executor.
+template <typename Handler, typename Executor>
+struct read_directory_task
+{
+  void operator()()
+  {
+    error_code ec;
+    const std::size_t n = reader->read(*entries, ec);
+    asio::post(ex, bind_handler(std::move(handler), std::move(work), ec, n));
+  }
+
+  Handler handler;
+  work_tuple<Executor> work;
+  Executor ex;
+  directory_reader* reader;
+  std::vector<directory_entry>* entries;
+};
+
+struct initiate_async_read_directory
+{
+  template <typename Handler>
+  void operator()(Handler&& handler,
+                  thread_pool_file_service* svc,
+                  directory_reader* reader,
+                  std::vector<directory_entry>* entries) const
+  {
+    typedef typename std::decay<Handler>::type handler_type;
+    auto ex = get_associated_executor(
+        handler, svc->get_io_context().get_executor());
+    asio::post(svc->get_thread_pool(),
+               read_directory_task<handler_type, decltype(ex)>{
+                 std::forward<Handler>(handler), make_work_tuple(ex), ex,
+                 reader, entries});
+  }
+};
+
+}
+
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code, std::size_t))
+async_read_directory(asio::io_context& context, directory_reader& reader,
+                     std::vector<directory_entry>& entries,
+                     CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code, std::size_t)>(
+      detail::initiate_async_read_directory(), token,
+      &asio::use_service<thread_pool_file_service>(context),
+      &reader, &entries);
+}
+
+ASIOEXT_NS_END
+
+#endif
@@ -126,4 +126,34 @@ void file_handle::times(const file_times& new_times)
   detail::throw_error(ec, "set_times");
 }
 
+file_info file_handle::query(file_info_mask mask)
+{
+  error_code ec;
+  file_info info = query(mask, ec);
+  detail::throw_error(ec, "query");
+  return info;
+}
+
+void file_handle::lock(const file_range& range, lock_type type)
+{
+  error_code ec;
+  lock(range, type, ec);
+  detail::throw_error(ec, "lock");
+}
+
+bool file_handle::try_lock(const file_range& range, lock_type type)
+{
+  error_code ec;
+  const bool locked = try_lock(range, type, ec);
+  detail::throw_error(ec, "try_lock");
+  return locked;
+}
+
+void file_handle::unlock(const file_range& range)
+{
+  error_code ec;
+  unlock(range, ec);
+  detail::throw_error(ec, "unlock");
+}
+
 ASIOEXT_NS_END
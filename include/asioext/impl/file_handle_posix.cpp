@@ -95,4 +95,32 @@ void file_handle::times(const file_times& new_times,
                                     new_times.mtime, ec);
 }
 
+file_info file_handle::query(file_info_mask mask,
+                             error_code& ec) ASIOEXT_NOEXCEPT
+{
+  file_info info;
+  detail::posix_file_ops::query(handle_, mask, info, ec);
+  return info;
+}
+
+void file_handle::lock(const file_range& range, lock_type type,
+                       error_code& ec) ASIOEXT_NOEXCEPT
+{
+  detail::posix_file_ops::lock(handle_, range.offset, range.length,
+                               type == lock_type::exclusive, true, ec);
+}
+
+bool file_handle::try_lock(const file_range& range, lock_type type,
+                           error_code& ec) ASIOEXT_NOEXCEPT
+{
+  return detail::posix_file_ops::lock(handle_, range.offset, range.length,
+                                      type == lock_type::exclusive, false, ec);
+}
+
+void file_handle::unlock(const file_range& range,
+                         error_code& ec) ASIOEXT_NOEXCEPT
+{
+  detail::posix_file_ops::unlock(handle_, range.offset, range.length, ec);
+}
+
 ASIOEXT_NS_END
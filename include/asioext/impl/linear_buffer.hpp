@@ -13,28 +13,35 @@
 
 ASIOEXT_NS_BEGIN
 
-template <typename Allocator>
-basic_linear_buffer<Allocator>::basic_linear_buffer(
+template <typename Allocator, typename GrowthPolicy>
+basic_linear_buffer<Allocator, GrowthPolicy>::basic_linear_buffer(
     const basic_linear_buffer& other)
-  : rep_()
+  : rep_(allocator_traits_type::select_on_container_copy_construction(
+        other.rep_))
   , capacity_(other.size_)
   , size_(other.size_)
+  , offset_(0)
   , max_size_(other.max_size_)
 {
   rep_.data_ = allocator_traits_type::allocate(rep_, other.size_);
   std::memcpy(rep_.data_, other.rep_.data_, size_);
 }
 
-template <typename Allocator>
-basic_linear_buffer<Allocator>& basic_linear_buffer<Allocator>::operator=(
+template <typename Allocator, typename GrowthPolicy>
+basic_linear_buffer<Allocator, GrowthPolicy>& basic_linear_buffer<Allocator, GrowthPolicy>::operator=(
     const basic_linear_buffer& other)
 {
+  // rewind() doesn't move the data, so we'd copy over it.
+  if (this == &other)
+    return *this;
+
   const size_type n = other.size_;
   if (n > max_size_) {
     std::length_error ex("basic_linear_buffer too long");
     detail::throw_exception(ex);
   }
 
+  rewind();
   if (n > capacity_)
     reallocate(calculate_capacity(n), [this] (uint8_t* new_buffer) {});
 
@@ -43,8 +50,8 @@ basic_linear_buffer<Allocator>& basic_linear_buffer<Allocator>::operator=(
   return *this;
 }
 
-template <typename Allocator>
-basic_linear_buffer<Allocator>& basic_linear_buffer<Allocator>::operator=(
+template <typename Allocator, typename GrowthPolicy>
+basic_linear_buffer<Allocator, GrowthPolicy>& basic_linear_buffer<Allocator, GrowthPolicy>::operator=(
     basic_linear_buffer&& other) ASIOEXT_NOEXCEPT
 {
   move_assign(other, std::integral_constant<bool,
@@ -52,26 +59,29 @@ basic_linear_buffer<Allocator>& basic_linear_buffer<Allocator>::operator=(
   return *this;
 }
 
-template <typename Allocator>
-void basic_linear_buffer<Allocator>::append(const void* data, std::size_t n)
+template <typename Allocator, typename GrowthPolicy>
+void basic_linear_buffer<Allocator, GrowthPolicy>::append(const void* data, std::size_t n)
 {
   if (size_ > max_size_ || max_size_ - size_ < n) {
     std::length_error ex("basic_linear_buffer too long");
     detail::throw_exception(ex);
   }
 
-  if (size_ + n > capacity_) {
-    reallocate(calculate_capacity(size_ + n), [this] (uint8_t* new_buffer) {
-      std::memcpy(new_buffer, rep_.data_, size_);
-    });
+  if (!make_room(n)) {
+    const std::size_t cap = calculate_capacity(size_ + n);
+    if (!try_realloc(cap)) {
+      reallocate(cap, [this] (uint8_t* new_buffer) {
+        std::memcpy(new_buffer, rep_.data_, size_);
+      });
+    }
   }
 
   std::memcpy(rep_.data_ + size_, data, n);
   size_ += n;
 }
 
-template <typename Allocator>
-void basic_linear_buffer<Allocator>::insert(std::size_t before_this,
+template <typename Allocator, typename GrowthPolicy>
+void basic_linear_buffer<Allocator, GrowthPolicy>::insert(std::size_t before_this,
                                             const void* data, std::size_t n)
 {
   if (size_ > max_size_ || max_size_ - size_ < n) {
@@ -79,7 +89,17 @@ void basic_linear_buffer<Allocator>::insert(std::size_t before_this,
     detail::throw_exception(ex);
   }
 
-  if (size_ + n > capacity_) {
+  if (before_this == 0 && n <= offset_) {
+    rep_.data_ -= n;
+    capacity_ += n;
+    offset_ -= n;
+    std::memcpy(rep_.data_, data, n);
+    size_ += n;
+    return;
+  }
+
+  // If the allocator can grow our block, we can insert in place.
+  if (!make_room(n) && !try_realloc(calculate_capacity(size_ + n))) {
     reallocate(calculate_capacity(size_ + n),
                [this, before_this, data, n] (uint8_t* new_buffer) {
       std::memcpy(new_buffer, rep_.data_, before_this);
@@ -88,8 +108,8 @@ void basic_linear_buffer<Allocator>::insert(std::size_t before_this,
                   size_ - before_this);
     });
   } else {
-    std::memmove(rep_.data_ + before_this,
-                 rep_.data_ + before_this + n,
+    std::memmove(rep_.data_ + before_this + n,
+                 rep_.data_ + before_this,
                  size_ - before_this);
     std::memcpy(rep_.data_ + before_this, data, n);
   }
@@ -97,105 +117,171 @@ void basic_linear_buffer<Allocator>::insert(std::size_t before_this,
   size_ += n;
 }
 
-template <typename Allocator>
-void basic_linear_buffer<Allocator>::erase(std::size_t pos)
+template <typename Allocator, typename GrowthPolicy>
+void basic_linear_buffer<Allocator, GrowthPolicy>::erase(std::size_t pos)
 {
   // TODO: assert pos < size
-  std::memmove(rep_.data_ + pos, rep_.data_ + pos + 1, size_ - pos - 1);
-  --size_;
+  erase(pos, pos + 1);
 }
 
-template <typename Allocator>
-void basic_linear_buffer<Allocator>::erase(std::size_t first, std::size_t last)
+template <typename Allocator, typename GrowthPolicy>
+void basic_linear_buffer<Allocator, GrowthPolicy>::erase(std::size_t first, std::size_t last)
 {
   const std::size_t n = last - first;
-  std::memmove(rep_.data_ + first, rep_.data_ + last, size_ - first - n);
-  size_ -= n;
+  if (first == 0) {
+    // Just skip the erased bytes. Moving the rest down once the skipped
+    // prefix is larger than what's left (and at least half of our storage)
+    // copies fewer bytes than were erased, which keeps erasing from
+    // the front amortized O(1) per byte.
+    rep_.data_ += n;
+    capacity_ -= n;
+    offset_ += n;
+    size_ -= n;
+    if (size_ == 0)
+      rewind();
+    else if (offset_ >= size_ && offset_ >= capacity_)
+      compact();
+  } else {
+    std::memmove(rep_.data_ + first, rep_.data_ + last, size_ - first - n);
+    size_ -= n;
+  }
+  maybe_shrink();
 }
 
-template <typename Allocator>
-void basic_linear_buffer<Allocator>::reserve(std::size_t min_cap)
+template <typename Allocator, typename GrowthPolicy>
+void basic_linear_buffer<Allocator, GrowthPolicy>::reserve(std::size_t min_cap)
 {
   if (min_cap > max_size_) {
     std::length_error ex("basic_linear_buffer too long");
     detail::throw_exception(ex);
   }
 
-  if (min_cap > capacity_) {
+  if (min_cap > capacity() && !try_realloc(min_cap)) {
     reallocate(min_cap, [this] (uint8_t* new_buffer) {
       std::memcpy(new_buffer, rep_.data_, size_);
     });
   }
 }
 
-template <typename Allocator>
-void basic_linear_buffer<Allocator>::resize(std::size_t new_size)
+template <typename Allocator, typename GrowthPolicy>
+void basic_linear_buffer<Allocator, GrowthPolicy>::resize(std::size_t new_size)
 {
   if (new_size > max_size_) {
     std::length_error ex("basic_linear_buffer too long");
     detail::throw_exception(ex);
   }
 
-  if (new_size > capacity_) {
-    reallocate(calculate_capacity(new_size), [this] (uint8_t* new_buffer) {
-      std::memcpy(new_buffer, rep_.data_, size_);
-    });
+  if (new_size > size_ && !make_room(new_size - size_)) {
+    const std::size_t cap = calculate_capacity(new_size);
+    if (!try_realloc(cap)) {
+      reallocate(cap, [this] (uint8_t* new_buffer) {
+        std::memcpy(new_buffer, rep_.data_, size_);
+      });
+    }
   }
 
+  const bool shrinking = new_size < size_;
   size_ = new_size;
+  if (shrinking)
+    maybe_shrink();
+}
+
+template <typename Allocator, typename GrowthPolicy>
+void basic_linear_buffer<Allocator, GrowthPolicy>::shrink_capacity(std::size_t cap)
+{
+  if (is_inline())
+    return;
+
+  if (cap <= rep_.inline_capacity_) {
+    // Move back into the inline storage (or drop the memory altogether if
+    // there is none and the buffer is empty).
+    if (size_ != 0)
+      std::memcpy(rep_.inline_data_, rep_.data_, size_);
+    deallocate();
+    return;
+  }
+
+  if (!try_realloc(cap)) {
+    reallocate(cap, [this] (uint8_t* new_buffer) {
+      std::memcpy(new_buffer, rep_.data_, size_);
+    });
+  }
 }
 
-template <typename Allocator>
-void basic_linear_buffer<Allocator>::move_assign(basic_linear_buffer& other,
+template <typename Allocator, typename GrowthPolicy>
+void basic_linear_buffer<Allocator, GrowthPolicy>::move_assign(basic_linear_buffer& other,
                                                  std::false_type)
-#if defined(ASIOEXT_HAS_ALLOCATOR_ALWAYS_EQUAL)
-  ASIOEXT_NOEXCEPT_IF(allocator_traits_type::is_always_equal::value)
-#endif
 {
   if (static_cast<allocator_type&>(rep_) !=
       static_cast<allocator_type&>(other.rep_)) {
-    if (rep_.data_)
-      allocator_traits_type::deallocate(rep_, rep_.data_, capacity_);
+    rewind();
+    if (other.size_ > capacity_)
+      reallocate(other.size_, [] (uint8_t* new_buffer) {});
 
-    capacity_ = other.capacity_;
     size_ = other.size_;
-    rep_.data_ = allocator_traits_type::allocate(rep_, capacity_);
     std::memcpy(rep_.data_, other.rep_.data_, size_);
   } else {
-    move_assign(other, std::false_type());
+    steal(other);
   }
 }
 
-template <typename Allocator>
-void basic_linear_buffer<Allocator>::move_assign(basic_linear_buffer& other,
+template <typename Allocator, typename GrowthPolicy>
+void basic_linear_buffer<Allocator, GrowthPolicy>::move_assign(basic_linear_buffer& other,
                                                  std::true_type)
-  ASIOEXT_NOEXCEPT_IF(std::is_nothrow_move_assignable<allocator_type>::value)
 {
+  // Our memory has to be returned to our old allocator.
+  deallocate();
+  size_ = 0;
+
   static_cast<allocator_type&>(rep_) =
       std::move(static_cast<allocator_type&>(other.rep_));
+  steal(other);
+}
+
+template <typename Allocator, typename GrowthPolicy>
+void basic_linear_buffer<Allocator, GrowthPolicy>::steal(basic_linear_buffer& other)
+{
+  max_size_ = other.max_size_;
+
+  if (other.is_inline()) {
+    // Inline storage can't change hands.
+    rewind();
+    if (other.size_ > capacity_)
+      reallocate(other.size_, [] (uint8_t* new_buffer) {});
+
+    std::memcpy(rep_.data_, other.rep_.data_, other.size_);
+    size_ = other.size_;
+    other.size_ = 0;
+    other.rewind();
+    return;
+  }
+
+  deallocate();
   rep_.data_ = other.rep_.data_;
   capacity_ = other.capacity_;
   size_ = other.size_;
-  max_size_ = other.max_size_;
+  offset_ = other.offset_;
+
   other.rep_.data_ = nullptr;
-  other.capacity_ = other.size_ = 0;
+  other.deallocate();
+  other.size_ = 0;
 }
 
-template <typename Allocator>
+template <typename Allocator, typename GrowthPolicy>
 template <typename Function>
-void basic_linear_buffer<Allocator>::reallocate(std::size_t cap, Function&& fn)
+void basic_linear_buffer<Allocator, GrowthPolicy>::reallocate(std::size_t cap, Function&& fn)
 {
   uint8_t* new_buffer = allocator_traits_type::allocate(rep_, cap);
   fn(new_buffer);
-  allocator_traits_type::deallocate(rep_, rep_.data_, capacity_);
+  deallocate();
   rep_.data_ = new_buffer;
   capacity_ = cap;
 }
 
 #if !defined(ASIOEXT_NO_DYNAMIC_BUFFER_V1)
-template <typename Allocator>
-typename dynamic_linear_buffer<Allocator>::mutable_buffers_type
-dynamic_linear_buffer<Allocator>::prepare(std::size_t n)
+template <typename Allocator, typename GrowthPolicy>
+typename dynamic_linear_buffer<Allocator, GrowthPolicy>::mutable_buffers_type
+dynamic_linear_buffer<Allocator, GrowthPolicy>::prepare(std::size_t n)
 {
   std::size_t siz = size_;
   if (siz == (std::numeric_limits<std::size_t>::max)())
@@ -212,9 +298,9 @@ dynamic_linear_buffer<Allocator>::prepare(std::size_t n)
                               data_.size() - siz);
 }
 
-template <typename Allocator>
-typename dynamic_linear_buffer<Allocator>::mutable_buffers_type
-dynamic_linear_buffer<Allocator>::prepare(std::size_t n, error_code& ec)
+template <typename Allocator, typename GrowthPolicy>
+typename dynamic_linear_buffer<Allocator, GrowthPolicy>::mutable_buffers_type
+dynamic_linear_buffer<Allocator, GrowthPolicy>::prepare(std::size_t n, error_code& ec)
 {
   std::size_t siz = size_;
   if (siz == (std::numeric_limits<std::size_t>::max)())
@@ -234,8 +320,8 @@ dynamic_linear_buffer<Allocator>::prepare(std::size_t n, error_code& ec)
 }
 #endif
 
-template <typename Allocator>
-void dynamic_linear_buffer<Allocator>::grow(std::size_t n)
+template <typename Allocator, typename GrowthPolicy>
+void dynamic_linear_buffer<Allocator, GrowthPolicy>::grow(std::size_t n)
 {
   const std::size_t siz = size();
   if (siz > max_size_ || max_size_ - siz < n) {
@@ -0,0 +1,137 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/mirrored_ring_buffer.hpp"
+
+#include "asioext/detail/throw_error.hpp"
+
+#include <cstring>
+
+ASIOEXT_NS_BEGIN
+
+mirrored_ring_buffer::mirrored_ring_buffer(std::size_t initial_capacity,
+                                           std::size_t maximum_size)
+  : data_(nullptr)
+  , capacity_(0)
+  , offset_(0)
+  , size_(0)
+  , max_size_((std::min)(maximum_size,
+                         (std::numeric_limits<std::size_t>::max)() / 2))
+{
+  if (initial_capacity != 0)
+    reserve(initial_capacity);
+}
+
+mirrored_ring_buffer& mirrored_ring_buffer::operator=(
+    mirrored_ring_buffer&& other) ASIOEXT_NOEXCEPT
+{
+  if (this != &other) {
+    if (data_)
+      detail::mirrored_mapping::unmap(data_, capacity_);
+
+    data_ = other.data_;
+    capacity_ = other.capacity_;
+    offset_ = other.offset_;
+    size_ = other.size_;
+    max_size_ = other.max_size_;
+
+    other.data_ = nullptr;
+    other.capacity_ = other.offset_ = other.size_ = 0;
+  }
+  return *this;
+}
+
+void mirrored_ring_buffer::append(const void* data, std::size_t n)
+{
+  std::memcpy(prepare(n).data(), data, n);
+  size_ += n;
+}
+
+mirrored_ring_buffer::mutable_buffers_type mirrored_ring_buffer::prepare(
+    std::size_t n)
+{
+  if (max_size_ - size_ < n) {
+    std::length_error ex("mirrored_ring_buffer too long");
+    detail::throw_exception(ex);
+  }
+
+  reserve(size_ + n);
+  return mutable_buffers_type(end(), n);
+}
+
+mirrored_ring_buffer::mutable_buffers_type mirrored_ring_buffer::prepare(
+    std::size_t n, error_code& ec) ASIOEXT_NOEXCEPT
+{
+  if (max_size_ - size_ < n) {
+    ec = asio::error::no_memory;
+    return mutable_buffers_type(nullptr, 0);
+  }
+
+  reserve(size_ + n, ec);
+  if (ec)
+    return mutable_buffers_type(nullptr, 0);
+  return mutable_buffers_type(end(), n);
+}
+
+void mirrored_ring_buffer::reserve(std::size_t min_cap)
+{
+  if (min_cap > max_size_) {
+    std::length_error ex("mirrored_ring_buffer too long");
+    detail::throw_exception(ex);
+  }
+
+  error_code ec;
+  reserve(min_cap, ec);
+  detail::throw_error(ec, "reserve");
+}
+
+void mirrored_ring_buffer::reserve(std::size_t min_cap,
+                                   error_code& ec) ASIOEXT_NOEXCEPT
+{
+  if (min_cap <= capacity_) {
+    ec = error_code();
+    return;
+  }
+
+  if (min_cap > max_size_) {
+    ec = asio::error::no_memory;
+    return;
+  }
+
+  const std::size_t cap = calculate_capacity(min_cap);
+  uint8_t* new_data = detail::mirrored_mapping::map(cap, ec);
+  if (ec)
+    return;
+
+  if (data_) {
+    // Thanks to the mirror, the old data is contiguous as well.
+    std::memcpy(new_data, data_ + offset_, size_);
+    detail::mirrored_mapping::unmap(data_, capacity_);
+  }
+
+  data_ = new_data;
+  capacity_ = cap;
+  offset_ = 0;
+}
+
+void mirrored_ring_buffer::resize(std::size_t new_size)
+{
+  if (new_size > size_)
+    prepare(new_size - size_);
+  size_ = new_size;
+}
+
+std::size_t mirrored_ring_buffer::calculate_capacity(std::size_t n)
+    const ASIOEXT_NOEXCEPT
+{
+  if (capacity_ < max_size_ / 2)
+    n = (std::max)(n, capacity_ * 2);
+
+  const std::size_t granularity = detail::mirrored_mapping::granularity();
+  const std::size_t pages = n / granularity + (n % granularity != 0);
+  return pages * granularity;
+}
+
+ASIOEXT_NS_END
@@ -11,6 +11,7 @@
 #if defined(ASIOEXT_WINDOWS)
 # include "asioext/detail/win_file_ops.hpp"
 #else
+# include "asioext/directory_handle.hpp"
 # include "asioext/detail/posix_file_ops.hpp"
 #endif
 
@@ -74,4 +75,29 @@ unique_file_handle open(const boost::filesystem::path& filename,
 }
 #endif
 
+#if !defined(ASIOEXT_WINDOWS)
+unique_file_handle open(const directory_handle& dir, const char* filename,
+                        const open_args& args, resolve_flags resolve)
+{
+  error_code ec;
+  unique_file_handle h = open(dir, filename, args, resolve, ec);
+  detail::throw_error(ec, "open");
+  return h;
+}
+
+unique_file_handle open(const directory_handle& dir, const char* filename,
+                        const open_args& args, error_code& ec) ASIOEXT_NOEXCEPT
+{
+  return open(dir, filename, args, resolve_flags::none, ec);
+}
+
+unique_file_handle open(const directory_handle& dir, const char* filename,
+                        const open_args& args, resolve_flags resolve,
+                        error_code& ec) ASIOEXT_NOEXCEPT
+{
+  return unique_file_handle(detail::posix_file_ops::openat(
+      dir.native_handle(), filename, args, resolve, ec));
+}
+#endif
+
 ASIOEXT_NS_END
@@ -0,0 +1,51 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_IMPL_PARALLELWALK_HPP
+#define ASIOEXT_IMPL_PARALLELWALK_HPP
+
+#include "asioext/detail/parallel_walk.hpp"
+#include "asioext/detail/throw_error.hpp"
+
+#include <memory>
+#include <type_traits>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+template <typename Visitor>
+walk_action invoke_walk_visitor(void* visitor, const walk_entry& entry)
+{
+  return (*static_cast<Visitor*>(visitor))(entry);
+}
+
+}
+
+template <typename Visitor>
+uint64_t parallel_walk(const char* root, Visitor&& visitor,
+                       const walk_options& options)
+{
+  error_code ec;
+  const uint64_t n = parallel_walk(root, std::forward<Visitor>(visitor),
+                                   options, ec);
+  detail::throw_error(ec, "parallel_walk");
+  return n;
+}
+
+template <typename Visitor>
+uint64_t parallel_walk(const char* root, Visitor&& visitor,
+                       const walk_options& options, error_code& ec)
+{
+  typedef typename std::remove_reference<Visitor>::type visitor_type;
+  return detail::parallel_walk(
+      root, &detail::invoke_walk_visitor<visitor_type>,
+      const_cast<void*>(static_cast<const void*>(std::addressof(visitor))),
+      options, ec);
+}
+
+ASIOEXT_NS_END
+
+#endif
@@ -0,0 +1,200 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_IMPL_PREFETCHINGFILEREADER_HPP
+#define ASIOEXT_IMPL_PREFETCHINGFILEREADER_HPP
+
+#include "asioext/bind_handler.hpp"
+#include "asioext/compose.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/associated_executor.hpp>
+# include <boost/asio/post.hpp>
+# include <boost/asio/read_at.hpp>
+#else
+# include <asio/associated_executor.hpp>
+# include <asio/post.hpp>
+# include <asio/read_at.hpp>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+ASIOEXT_NS_BEGIN
+
+template <typename RandomAccessReadDevice, typename Allocator>
+prefetching_file_reader<RandomAccessReadDevice, Allocator>::
+    prefetching_file_reader(RandomAccessReadDevice& device,
+                            const prefetch_options& options,
+                            const Allocator& allocator)
+  : prefetching_file_reader(device, 0, (std::numeric_limits<uint64_t>::max)(),
+                            options, allocator)
+{
+  // ctor
+}
+
+template <typename RandomAccessReadDevice, typename Allocator>
+prefetching_file_reader<RandomAccessReadDevice, Allocator>::
+    prefetching_file_reader(RandomAccessReadDevice& device,
+                            uint64_t offset, uint64_t length,
+                            const prefetch_options& options,
+                            const Allocator& allocator)
+  : device_(device)
+  , options_(options)
+  , next_offset_(offset)
+  , end_((std::numeric_limits<uint64_t>::max)() - offset < length
+             ? (std::numeric_limits<uint64_t>::max)() : offset + length)
+  , chunk_wait_(device.get_executor(), asio::steady_timer::time_point::max())
+{
+  options_.chunk_size = (std::max)(options_.chunk_size, std::size_t(1));
+  options_.max_depth = (std::max)(options_.max_depth, std::size_t(1));
+  options_.min_depth = (std::min)((std::max)(options_.min_depth,
+                                             std::size_t(1)),
+                                  options_.max_depth);
+  depth_ = options_.min_depth;
+
+  // Buffers are only allocated once they're needed.
+  slots_.reserve(options_.max_depth + 1);
+  for (std::size_t i = 0; i != options_.max_depth + 1; ++i)
+    slots_.emplace_back(allocator);
+}
+
+template <typename RandomAccessReadDevice, typename Allocator>
+template <typename ChunkHandler>
+ASIOEXT_INITFN_RESULT_TYPE(ChunkHandler, void (error_code, asio::const_buffer))
+prefetching_file_reader<RandomAccessReadDevice, Allocator>::async_next(
+    ChunkHandler&& handler)
+{
+  auto init = [this] (auto&& handler) {
+    if (holding_) {
+      const std::chrono::duration<double> elapsed =
+          clock::now() - handed_out_;
+      consume_time_ += (elapsed.count() - consume_time_) / 8;
+      head_ = (head_ + 1) % slots_.size();
+      --count_;
+      holding_ = false;
+      update_depth();
+    }
+
+    start_reads();
+
+    if (count_ == 0 || slots_[head_].done) {
+      error_code ec = asio::error::eof;
+      asio::const_buffer chunk;
+      if (count_ != 0)
+        chunk = take_head(ec);
+      auto ex = asio::get_associated_executor(handler, get_executor());
+      asio::post(ex, asioext::bind_handler(
+          std::forward<decltype(handler)>(handler), ec, chunk));
+      return;
+    }
+
+    auto op = [this] (auto& self, error_code) {
+      if (!slots_[head_].done) {
+        chunk_wait_.async_wait(std::move(self));
+        return;
+      }
+
+      waiting_ = false;
+      error_code ec;
+      const asio::const_buffer chunk = take_head(ec);
+      self.complete(ec, chunk);
+    };
+    waiting_ = true;
+    chunk_wait_.async_wait(asioext::make_composed_operation(
+        std::move(op), std::forward<decltype(handler)>(handler)));
+  };
+  return asioext::async_initiate<ChunkHandler,
+                                 void (error_code, asio::const_buffer)>(
+    init, handler);
+}
+
+template <typename RandomAccessReadDevice, typename Allocator>
+void prefetching_file_reader<RandomAccessReadDevice, Allocator>::start_reads()
+{
+  // The chunk the consumer holds doesn't count.
+  const std::size_t limit = depth_ + (holding_ ? 1 : 0);
+  while (!stopped_ && next_offset_ < end_ && count_ < limit) {
+    const std::size_t index = (head_ + count_) % slots_.size();
+    slot& s = slots_[index];
+    if (s.data.empty())
+      s.data.resize(options_.chunk_size);
+
+    const std::size_t n = static_cast<std::size_t>(
+        (std::min)(uint64_t(options_.chunk_size), end_ - next_offset_));
+    s.size = 0;
+    s.ec = error_code();
+    s.done = false;
+    s.started = clock::now();
+    asio::async_read_at(device_, next_offset_,
+                        asio::buffer(s.data.data(), n),
+                        [this, index] (error_code ec, std::size_t size) {
+      on_read(index, ec, size);
+    });
+
+    next_offset_ += n;
+    ++count_;
+    ++in_flight_;
+  }
+}
+
+template <typename RandomAccessReadDevice, typename Allocator>
+void prefetching_file_reader<RandomAccessReadDevice, Allocator>::on_read(
+    std::size_t index, error_code ec, std::size_t size)
+{
+  --in_flight_;
+  slot& s = slots_[index];
+  s.done = true;
+  s.ec = ec;
+  s.size = size;
+
+  const std::chrono::duration<double> elapsed = clock::now() - s.started;
+  if (read_latency_ == 0.0)
+    read_latency_ = elapsed.count();
+  else
+    read_latency_ += (elapsed.count() - read_latency_) / 8;
+
+  // Reads that are already in flight just hit the end as well.
+  if (ec)
+    stopped_ = true;
+
+  if (waiting_ && index == head_)
+    chunk_wait_.cancel();
+}
+
+template <typename RandomAccessReadDevice, typename Allocator>
+asio::const_buffer
+prefetching_file_reader<RandomAccessReadDevice, Allocator>::take_head(
+    error_code& ec)
+{
+  const slot& s = slots_[head_];
+  holding_ = true;
+  handed_out_ = clock::now();
+
+  // The eof is reported with the next call.
+  ec = s.ec;
+  if (ec == asio::error::eof && s.size != 0)
+    ec = error_code();
+  return asio::const_buffer(s.data.data(), s.size);
+}
+
+template <typename RandomAccessReadDevice, typename Allocator>
+void prefetching_file_reader<RandomAccessReadDevice, Allocator>::update_depth()
+{
+  if (read_latency_ == 0.0)
+    return;
+
+  // Little's law: enough reads to cover one read's latency at the rate
+  // the consumer takes chunks, plus the one it's processing.
+  double target = static_cast<double>(options_.max_depth);
+  if (consume_time_ > 0.0)
+    target = (std::min)(target, std::ceil(read_latency_ / consume_time_) + 1);
+
+  depth_ = (std::max)(options_.min_depth, static_cast<std::size_t>(target));
+}
+
+ASIOEXT_NS_END
+
+#endif
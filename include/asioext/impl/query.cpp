@@ -0,0 +1,71 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/query.hpp"
+
+#include "asioext/detail/throw_error.hpp"
+
+#if defined(ASIOEXT_WINDOWS)
+# include "asioext/detail/win_file_ops.hpp"
+#else
+# include "asioext/detail/posix_file_ops.hpp"
+#endif
+
+ASIOEXT_NS_BEGIN
+
+file_info query(const char* filename, file_info_mask mask)
+{
+  error_code ec;
+  file_info info = query(filename, mask, ec);
+  detail::throw_error(ec, "query");
+  return info;
+}
+
+file_info query(const char* filename, file_info_mask mask,
+                error_code& ec) ASIOEXT_NOEXCEPT
+{
+  file_info info;
+#if defined(ASIOEXT_WINDOWS)
+  detail::win_file_ops::query(filename, mask, info, ec);
+#else
+  detail::posix_file_ops::query_at(-1, filename, true, mask, info, ec);
+#endif
+  return info;
+}
+
+#if defined(ASIOEXT_WINDOWS)
+file_info query(const wchar_t* filename, file_info_mask mask)
+{
+  error_code ec;
+  file_info info = query(filename, mask, ec);
+  detail::throw_error(ec, "query");
+  return info;
+}
+
+file_info query(const wchar_t* filename, file_info_mask mask,
+                error_code& ec) ASIOEXT_NOEXCEPT
+{
+  file_info info;
+  detail::win_file_ops::query(filename, mask, info, ec);
+  return info;
+}
+#endif
+
+#if defined(ASIOEXT_HAS_BOOST_FILESYSTEM)
+file_info query(const boost::filesystem::path& filename, file_info_mask mask)
+{
+  error_code ec;
+  file_info info = query(filename, mask, ec);
+  detail::throw_error(ec, "query");
+  return info;
+}
+
+file_info query(const boost::filesystem::path& filename, file_info_mask mask,
+                error_code& ec) ASIOEXT_NOEXCEPT
+{
+  return query(filename.c_str(), mask, ec);
+}
+#endif
+
+ASIOEXT_NS_END
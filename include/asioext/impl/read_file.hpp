@@ -5,6 +5,7 @@
 #ifndef ASIOEXT_IMPL_READFILE_HPP
 #define ASIOEXT_IMPL_READFILE_HPP
 
+#include "asioext/chained_buffer.hpp"
 #include "asioext/file_handle.hpp"
 #include "asioext/unique_file_handle.hpp"
 #include "asioext/open.hpp"
@@ -12,6 +13,7 @@
 
 #include "asioext/detail/error.hpp"
 #include "asioext/detail/buffer.hpp"
+#include "asioext/detail/hashing.hpp"
 
 #if defined(ASIOEXT_USE_BOOST_ASIO)
 # include <boost/asio/read.hpp>
@@ -19,6 +21,7 @@
 # include <asio/read.hpp>
 #endif
 
+#include <algorithm>
 #include <limits>
 
 ASIOEXT_NS_BEGIN
@@ -119,6 +122,214 @@ ASIOEXT_DETAIL_RF_RAW_RET(RawByteContainer)
   }
 }
 
+// basic_chained_buffer overloads
+
+template <typename Allocator>
+void read_file(const char* filename, basic_chained_buffer<Allocator>& c)
+{
+  error_code ec;
+  read_file(filename, c, ec);
+  detail::throw_error(ec, "read_file");
+}
+
+template <typename Allocator>
+void read_file(const char* filename, basic_chained_buffer<Allocator>& c,
+               error_code& ec)
+{
+  unique_file_handle file = open(filename,
+                                 open_flags::access_read |
+                                 open_flags::open_existing, ec);
+  if (!ec)
+    read_file(file.get(), c, ec);
+}
+
+#if defined(ASIOEXT_WINDOWS)
+template <typename Allocator>
+void read_file(const wchar_t* filename, basic_chained_buffer<Allocator>& c)
+{
+  error_code ec;
+  read_file(filename, c, ec);
+  detail::throw_error(ec, "read_file");
+}
+
+template <typename Allocator>
+void read_file(const wchar_t* filename, basic_chained_buffer<Allocator>& c,
+               error_code& ec)
+{
+  unique_file_handle file = open(filename,
+                                 open_flags::access_read |
+                                 open_flags::open_existing, ec);
+  if (!ec)
+    read_file(file.get(), c, ec);
+}
+#endif
+
+#if defined(ASIOEXT_HAS_BOOST_FILESYSTEM)
+template <typename Allocator>
+void read_file(const boost::filesystem::path& filename,
+               basic_chained_buffer<Allocator>& c)
+{
+  error_code ec;
+  read_file(filename, c, ec);
+  detail::throw_error(ec, "read_file");
+}
+
+template <typename Allocator>
+void read_file(const boost::filesystem::path& filename,
+               basic_chained_buffer<Allocator>& c, error_code& ec)
+{
+  unique_file_handle file = open(filename,
+                                 open_flags::access_read |
+                                 open_flags::open_existing, ec);
+  if (!ec)
+    read_file(file.get(), c, ec);
+}
+#endif
+
+template <typename Allocator>
+void read_file(file_handle file, basic_chained_buffer<Allocator>& c)
+{
+  error_code ec;
+  read_file(file, c, ec);
+  detail::throw_error(ec, "read_file");
+}
+
+template <typename Allocator>
+void read_file(file_handle file, basic_chained_buffer<Allocator>& c,
+               error_code& ec)
+{
+  const uint64_t size = file.size(ec);
+  if (ec) return;
+
+  if (size > (std::numeric_limits<std::size_t>::max)() ||
+      size > c.max_size()) {
+    ec = asio::error::message_size;
+    return;
+  }
+
+  c.clear();
+  if (size != 0) {
+    c.resize(static_cast<std::size_t>(size));
+    asio::read(file, c.data(), ec);
+  }
+}
+
+// RawByteContainer overloads with checksum computation
+
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(const char* filename, RawByteContainer& c, Hasher& hasher)
+{
+  error_code ec;
+  read_file(filename, c, hasher, ec);
+  detail::throw_error(ec, "read_file");
+}
+
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(const char* filename, RawByteContainer& c, Hasher& hasher,
+              error_code& ec)
+{
+  unique_file_handle file = open(filename,
+                                 open_flags::access_read |
+                                 open_flags::open_existing, ec);
+  if (!ec)
+    read_file(file.get(), c, hasher, ec);
+}
+
+#if defined(ASIOEXT_WINDOWS)
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(const wchar_t* filename, RawByteContainer& c, Hasher& hasher)
+{
+  error_code ec;
+  read_file(filename, c, hasher, ec);
+  detail::throw_error(ec, "read_file");
+}
+
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(const wchar_t* filename, RawByteContainer& c, Hasher& hasher,
+              error_code& ec)
+{
+  unique_file_handle file = open(filename,
+                                 open_flags::access_read |
+                                 open_flags::open_existing, ec);
+  if (!ec)
+    read_file(file.get(), c, hasher, ec);
+}
+#endif
+
+#if defined(ASIOEXT_HAS_BOOST_FILESYSTEM)
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(const boost::filesystem::path& filename, RawByteContainer& c,
+              Hasher& hasher)
+{
+  error_code ec;
+  read_file(filename, c, hasher, ec);
+  detail::throw_error(ec, "read_file");
+}
+
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(const boost::filesystem::path& filename, RawByteContainer& c,
+              Hasher& hasher, error_code& ec)
+{
+  unique_file_handle file = open(filename,
+                                 open_flags::access_read |
+                                 open_flags::open_existing, ec);
+  if (!ec)
+    read_file(file.get(), c, hasher, ec);
+}
+#endif
+
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(file_handle file, RawByteContainer& c, Hasher& hasher)
+{
+  error_code ec;
+  read_file(file, c, hasher, ec);
+  detail::throw_error(ec, "read_file");
+}
+
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(file_handle file, RawByteContainer& c, Hasher& hasher,
+              error_code& ec)
+{
+  const uint64_t size = file.size(ec);
+  if (ec) return;
+
+  if (size > std::numeric_limits<typename RawByteContainer::size_type>::max() ||
+      size > c.max_size()) {
+    ec = asio::error::message_size;
+    return;
+  }
+
+  if (size == 0) {
+    c.clear();
+    return;
+  }
+
+  c.resize(static_cast<typename RawByteContainer::size_type>(size));
+
+  // Hash every chunk while it's still in the cache, instead of
+  // hashing the whole container after we're done.
+  unsigned char* data = reinterpret_cast<unsigned char*>(&c[0]);
+  std::size_t remaining = c.size();
+  while (remaining != 0) {
+    const std::size_t chunk = (std::min)(remaining,
+                                         detail::hashing_chunk_size);
+    asio::read(file, asio::buffer(data, chunk), ec);
+    if (ec) return;
+
+    hasher.update(data, chunk);
+    data += chunk;
+    remaining -= chunk;
+  }
+}
+
 // MutableBufferSequence overloads
 
 template <class MutableBufferSequence>
@@ -0,0 +1,231 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_IMPL_READFILES_HPP
+#define ASIOEXT_IMPL_READFILES_HPP
+
+#include "asioext/bind_handler.hpp"
+#include "asioext/work.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/associated_executor.hpp>
+# include <boost/asio/error.hpp>
+# include <boost/asio/post.hpp>
+#else
+# include <asio/associated_executor.hpp>
+# include <asio/error.hpp>
+# include <asio/post.hpp>
+#endif
+
+#include <atomic>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <string>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+inline const char* read_files_filename(const char* filename)
+{ return filename; }
+
+inline const char* read_files_filename(const std::string& filename)
+{ return filename.c_str(); }
+
+#if defined(ASIOEXT_WINDOWS)
+inline const wchar_t* read_files_filename(const wchar_t* filename)
+{ return filename; }
+
+inline const wchar_t* read_files_filename(const std::wstring& filename)
+{ return filename.c_str(); }
+#endif
+
+#if defined(ASIOEXT_HAS_BOOST_FILESYSTEM)
+inline const boost::filesystem::path& read_files_filename(
+    const boost::filesystem::path& filename)
+{ return filename; }
+#endif
+
+// Shared between all per-file tasks of one batch. The task that finishes
+// last hands the collected results to |Completion|.
+template <typename Completion>
+class read_files_state
+{
+public:
+  read_files_state(std::size_t count, Completion&& completion)
+    : errors_(count)
+    , remaining_(count)
+    , completion_(std::move(completion))
+  {
+    // ctor
+  }
+
+  void set_result(std::size_t index, const error_code& ec)
+  {
+    errors_[index] = ec;
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      completion_(std::move(errors_));
+  }
+
+private:
+  std::vector<error_code> errors_;
+  std::atomic<std::size_t> remaining_;
+  Completion completion_;
+};
+
+template <typename Filename, typename RawByteContainer, typename State>
+struct read_files_task
+{
+  void operator()()
+  {
+    error_code ec;
+    read_file(read_files_filename(*filename), *container, ec);
+    state->set_result(index, ec);
+  }
+
+  const Filename* filename;
+  RawByteContainer* container;
+  std::size_t index;
+  std::shared_ptr<State> state;
+};
+
+template <typename State>
+struct read_files_invalid_task
+{
+  void operator()()
+  {
+    state->set_result(index, asio::error::invalid_argument);
+  }
+
+  std::size_t index;
+  std::shared_ptr<State> state;
+};
+
+template <typename FilenameRange, typename RawByteContainerRange,
+          typename Completion>
+void start_read_files(thread_pool_file_service& svc,
+                      const FilenameRange& filenames,
+                      RawByteContainerRange& containers,
+                      Completion&& completion)
+{
+  typedef read_files_state<typename std::decay<Completion>::type> state_type;
+
+  using std::begin;
+  using std::end;
+
+  const std::size_t count = static_cast<std::size_t>(
+      std::distance(begin(filenames), end(filenames)));
+  if (count == 0) {
+    completion(std::vector<error_code>());
+    return;
+  }
+
+  auto state = std::make_shared<state_type>(
+      count, std::forward<Completion>(completion));
+
+  auto container = begin(containers);
+  const auto last_container = end(containers);
+
+  std::size_t index = 0;
+  for (const auto& filename : filenames) {
+    if (container != last_container) {
+      typedef typename std::remove_reference<
+        decltype(*container)>::type container_type;
+      typedef typename std::remove_cv<
+        typename std::remove_reference<decltype(filename)>::type
+      >::type filename_type;
+
+      asio::post(svc.get_thread_pool(),
+                 read_files_task<filename_type, container_type, state_type>{
+                   &filename, &*container, index, state});
+      ++container;
+    } else {
+      asio::post(svc.get_thread_pool(),
+                 read_files_invalid_task<state_type>{index, state});
+    }
+    ++index;
+  }
+}
+
+template <typename Handler, typename Executor>
+class read_files_async_completion
+{
+public:
+  read_files_async_completion(Handler&& handler, const Executor& ex)
+    : handler_(std::move(handler))
+    , work_(make_work_tuple(ex))
+    , ex_(ex)
+  {
+    // ctor
+  }
+
+  void operator()(std::vector<error_code>&& errors)
+  {
+    asio::post(ex_, bind_handler(std::move(handler_), std::move(work_),
+                                 std::move(errors)));
+  }
+
+private:
+  Handler handler_;
+  work_tuple<Executor> work_;
+  Executor ex_;
+};
+
+struct initiate_async_read_files
+{
+  template <typename Handler, typename FilenameRange,
+            typename RawByteContainerRange>
+  void operator()(Handler&& handler,
+                  thread_pool_file_service* svc,
+                  const FilenameRange* filenames,
+                  RawByteContainerRange* containers) const
+  {
+    typedef typename std::decay<Handler>::type handler_type;
+
+    auto ex = get_associated_executor(
+        handler, svc->get_io_context().get_executor());
+    start_read_files(*svc, *filenames, *containers,
+        read_files_async_completion<handler_type, decltype(ex)>(
+            handler_type(std::forward<Handler>(handler)), ex));
+  }
+};
+
+}
+
+template <class FilenameRange, class RawByteContainerRange>
+std::vector<error_code> read_files(asio::io_context& context,
+                                   const FilenameRange& filenames,
+                                   RawByteContainerRange& containers)
+{
+  std::promise<std::vector<error_code>> result;
+  std::future<std::vector<error_code>> errors = result.get_future();
+
+  detail::start_read_files(
+      asio::use_service<thread_pool_file_service>(context),
+      filenames, containers,
+      [&result] (std::vector<error_code>&& e) {
+        result.set_value(std::move(e));
+      });
+  return errors.get();
+}
+
+template <class FilenameRange, class RawByteContainerRange,
+          class CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(std::vector<error_code>))
+async_read_files(asio::io_context& context,
+                 const FilenameRange& filenames,
+                 RawByteContainerRange& containers,
+                 CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(std::vector<error_code>)>(
+      detail::initiate_async_read_files(), token,
+      &asio::use_service<thread_pool_file_service>(context),
+      &filenames, &containers);
+}
+
+ASIOEXT_NS_END
+
+#endif
@@ -0,0 +1,86 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/splice.hpp"
+
+#include "asioext/detail/throw_error.hpp"
+
+ASIOEXT_NS_BEGIN
+
+void make_pipe(unique_file_handle& read_end, unique_file_handle& write_end)
+{
+  error_code ec;
+  make_pipe(read_end, write_end, ec);
+  detail::throw_error(ec, "make_pipe");
+}
+
+void make_pipe(unique_file_handle& read_end, unique_file_handle& write_end,
+               error_code& ec) ASIOEXT_NOEXCEPT
+{
+  detail::posix_file_ops::handle_type fds[2];
+  detail::posix_file_ops::pipe(fds, ec);
+  if (ec)
+    return;
+
+  unique_file_handle new_read_end(fds[0]);
+  unique_file_handle new_write_end(fds[1]);
+
+  read_end.reset(new_read_end.release(), ec);
+  if (!ec)
+    write_end.reset(new_write_end.release(), ec);
+}
+
+std::size_t splice_some(file_handle in, file_handle out,
+                        std::size_t max_size)
+{
+  error_code ec;
+  const std::size_t n = splice_some(in, out, max_size, ec);
+  detail::throw_error(ec, "splice_some");
+  return n;
+}
+
+std::size_t splice_some(file_handle in, file_handle out,
+                        std::size_t max_size,
+                        error_code& ec) ASIOEXT_NOEXCEPT
+{
+  return detail::posix_file_ops::splice(in.native_handle(),
+                                        out.native_handle(),
+                                        max_size, false, ec);
+}
+
+std::size_t tee_some(file_handle in, file_handle out, std::size_t max_size)
+{
+  error_code ec;
+  const std::size_t n = tee_some(in, out, max_size, ec);
+  detail::throw_error(ec, "tee_some");
+  return n;
+}
+
+std::size_t tee_some(file_handle in, file_handle out, std::size_t max_size,
+                     error_code& ec) ASIOEXT_NOEXCEPT
+{
+  return detail::posix_file_ops::tee(in.native_handle(), out.native_handle(),
+                                     max_size, false, ec);
+}
+
+uint64_t splice_transfer(file_handle in, file_handle out, uint64_t max_size)
+{
+  error_code ec;
+  const uint64_t n = splice_transfer(in, out, max_size, ec);
+  detail::throw_error(ec, "splice_transfer");
+  return n;
+}
+
+uint64_t splice_transfer(file_handle in, file_handle out, uint64_t max_size,
+                         error_code& ec) ASIOEXT_NOEXCEPT
+{
+  detail::splice_transfer_state state(in.native_handle(),
+                                      out.native_handle(),
+                                      max_size, false, false);
+  detail::run_blocking(state, in.native_handle(), out.native_handle(), ec);
+  return state.total();
+}
+
+ASIOEXT_NS_END
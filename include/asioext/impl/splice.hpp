@@ -0,0 +1,183 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_IMPL_SPLICE_HPP
+#define ASIOEXT_IMPL_SPLICE_HPP
+
+#include "asioext/compose.hpp"
+
+#include "asioext/detail/splice.hpp"
+#include "asioext/detail/buffer_sequence_adapter.hpp"
+#include "asioext/detail/throw_error.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/post.hpp>
+#else
+# include <asio/post.hpp>
+#endif
+
+#include <utility>
+#include <vector>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+inline posix_file_ops::handle_type get_splice_handle(
+    const unique_file_handle& handle) ASIOEXT_NOEXCEPT
+{
+  return handle.get().native_handle();
+}
+
+template <typename Handle>
+inline auto get_splice_handle(Handle& handle)
+    -> decltype(handle.native_handle())
+{
+  return handle.native_handle();
+}
+
+template <typename HandleRange>
+std::vector<posix_file_ops::handle_type> get_splice_handles(
+    HandleRange& handles)
+{
+  std::vector<posix_file_ops::handle_type> native_handles;
+  for (auto& handle : handles)
+    native_handles.push_back(get_splice_handle(handle));
+  return native_handles;
+}
+
+// Runs |State| on the thread that runs |stream|'s io_context, waiting for
+// the stream's readiness whenever the state machine would block.
+template <typename Stream, typename State>
+class splice_op
+{
+public:
+  splice_op(Stream& stream, State&& state)
+    : stream_(stream)
+    , state_(std::move(state))
+    , started_(false)
+  {
+    // ctor
+  }
+
+  template <typename Self>
+  void operator()(Self& self, error_code ec = error_code())
+  {
+    if (!started_) {
+      // The handler must not be invoked from within the initiating function.
+      started_ = true;
+      asio::post(stream_.get_executor(), std::move(self));
+      return;
+    }
+
+    if (!ec && !stream_.native_non_blocking())
+      stream_.native_non_blocking(true, ec);
+
+    if (!ec) {
+      state_.run(ec);
+      if (ec == asio::error::would_block) {
+        stream_.async_wait(state_.waiting_for_read() ? Stream::wait_read
+                                                     : Stream::wait_write,
+                           std::move(self));
+        return;
+      }
+    }
+
+    self.complete(ec, state_.total());
+  }
+
+private:
+  Stream& stream_;
+  State state_;
+  bool started_;
+};
+
+}
+
+template <typename ConstBufferSequence>
+std::size_t vmsplice_some(file_handle pipe,
+                          const ConstBufferSequence& buffers)
+{
+  error_code ec;
+  const std::size_t n = vmsplice_some(pipe, buffers, ec);
+  detail::throw_error(ec, "vmsplice_some");
+  return n;
+}
+
+template <typename ConstBufferSequence>
+std::size_t vmsplice_some(file_handle pipe,
+                          const ConstBufferSequence& buffers,
+                          error_code& ec) ASIOEXT_NOEXCEPT
+{
+  detail::buffer_sequence_adapter<asio::const_buffer, ConstBufferSequence>
+      bufs(buffers);
+  return detail::posix_file_ops::vmsplice(pipe.native_handle(),
+                                          bufs.buffers(), bufs.count(),
+                                          false, ec);
+}
+
+template <typename HandleRange>
+uint64_t splice_fanout(file_handle source, HandleRange&& destinations)
+{
+  error_code ec;
+  const uint64_t n = splice_fanout(source, destinations, ec);
+  detail::throw_error(ec, "splice_fanout");
+  return n;
+}
+
+template <typename HandleRange>
+uint64_t splice_fanout(file_handle source, HandleRange&& destinations,
+                       error_code& ec)
+{
+  detail::splice_fanout_state state(source.native_handle(),
+                                    detail::get_splice_handles(destinations),
+                                    false);
+  detail::run_blocking(state, source.native_handle(),
+                       source.native_handle(), ec);
+  return state.total();
+}
+
+template <typename Stream, typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code, uint64_t))
+async_splice_read(Stream& stream, file_handle out, uint64_t max_size,
+                  CompletionToken&& handler)
+{
+  return async_compose<CompletionToken, void(error_code, uint64_t)>(
+      detail::splice_op<Stream, detail::splice_transfer_state>(
+          stream, detail::splice_transfer_state(
+              stream.native_handle(), out.native_handle(), max_size,
+              true, false)),
+      handler, stream);
+}
+
+template <typename Stream, typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code, uint64_t))
+async_splice_write(Stream& stream, file_handle in, uint64_t max_size,
+                   CompletionToken&& handler)
+{
+  return async_compose<CompletionToken, void(error_code, uint64_t)>(
+      detail::splice_op<Stream, detail::splice_transfer_state>(
+          stream, detail::splice_transfer_state(
+              in.native_handle(), stream.native_handle(), max_size,
+              false, true)),
+      handler, stream);
+}
+
+template <typename Stream, typename HandleRange, typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code, uint64_t))
+async_splice_fanout(Stream& source, HandleRange&& destinations,
+                    CompletionToken&& handler)
+{
+  return async_compose<CompletionToken, void(error_code, uint64_t)>(
+      detail::splice_op<Stream, detail::splice_fanout_state>(
+          source, detail::splice_fanout_state(
+              source.native_handle(),
+              detail::get_splice_handles(destinations), true)),
+      handler, source);
+}
+
+ASIOEXT_NS_END
+
+#endif
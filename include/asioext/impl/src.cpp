@@ -8,19 +8,25 @@
 
 #include "asioext/detail/config.hpp"
 
+#include "asioext/impl/buffer_pool.cpp"
 #include "asioext/impl/cancellation_token.cpp"
+#include "asioext/impl/checksum.cpp"
 #include "asioext/impl/chrono.cpp"
 #include "asioext/impl/connect.cpp"
+#include "asioext/impl/copy_file.cpp"
 #include "asioext/impl/duplicate.cpp"
 #include "asioext/impl/error.cpp"
 #include "asioext/impl/file_handle.cpp"
 #include "asioext/impl/open.cpp"
 #include "asioext/impl/open_flags.cpp"
+#include "asioext/impl/query.cpp"
+#include "asioext/impl/standard_stream.cpp"
 #include "asioext/impl/standard_streams.cpp"
 #include "asioext/impl/thread_pool_file_service.cpp"
 #include "asioext/impl/unique_handler.cpp"
 #include "asioext/impl/unique_file_handle.cpp"
 #include "asioext/impl/url_view.cpp"
+#include "asioext/detail/impl/find_delimiter.cpp"
 #include "asioext/detail/impl/throw_error.cpp"
 #include "asioext/detail/impl/url_parser.cpp"
 #include "asioext/socks/impl/socks_error.cpp"
@@ -31,6 +37,22 @@
 # include "asioext/detail/impl/win_path.cpp"
 # include "asioext/detail/impl/win_file_ops.cpp"
 #else
+# include "asioext/impl/directory_handle.cpp"
+# include "asioext/impl/directory_reader.cpp"
 # include "asioext/impl/file_handle_posix.cpp"
+# include "asioext/detail/impl/parallel_walk.cpp"
 # include "asioext/detail/impl/posix_file_ops.cpp"
+# if defined(ASIOEXT_HAS_SPLICE)
+#  include "asioext/impl/splice.cpp"
+#  include "asioext/detail/impl/splice.cpp"
+# endif
+# include "asioext/detail/mirrored_mapping.hpp"
+# if defined(ASIOEXT_HAS_MIRRORED_MAPPING)
+#  include "asioext/impl/mirrored_ring_buffer.cpp"
+#  include "asioext/detail/impl/mirrored_mapping.cpp"
+# endif
+# include "asioext/detail/mapped_memory.hpp"
+# if defined(ASIOEXT_HAS_MREMAP)
+#  include "asioext/detail/impl/mapped_memory.cpp"
+# endif
 #endif
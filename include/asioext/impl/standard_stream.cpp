@@ -0,0 +1,46 @@
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#include "asioext/standard_stream.hpp"
+#include "asioext/file_info.hpp"
+
+#if !defined(ASIOEXT_WINDOWS)
+# include "asioext/detail/posix_file_ops.hpp"
+#endif
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+bool is_reactor_compatible(file_handle handle,
+                           error_code& ec) ASIOEXT_NOEXCEPT
+{
+#if defined(ASIOEXT_WINDOWS)
+  // Anonymous pipes (which is what standard handles usually are)
+  // don't support overlapped I/O.
+  (void)handle;
+  ec = error_code();
+  return false;
+#else
+  file_info info;
+  posix_file_ops::query(handle.native_handle(), file_info_mask::type, info,
+                        ec);
+  if (ec)
+    return false;
+
+  switch (info.type) {
+    case file_type::fifo:
+    case file_type::character:
+    case file_type::socket:
+      return true;
+    default:
+      return false;
+  }
+#endif
+}
+
+}
+
+ASIOEXT_NS_END
@@ -65,6 +65,7 @@ void thread_pool_file_service::move_assign(
     implementation_type& other_impl)
 {
   close_for_destruction(impl);
+  impl.cancel_token_.reset();
 
   if (this != &other_service) {
     // Remove implementation from linked list of all implementations.
@@ -166,6 +167,8 @@ void thread_pool_file_service::assign(implementation_type& impl,
 void thread_pool_file_service::close(implementation_type& impl,
                                      error_code& ec) ASIOEXT_NOEXCEPT
 {
+  // A pending async_open() must not install its handle afterwards.
+  ++impl.close_count_;
   impl.handle_.close(ec);
 }
 
@@ -249,6 +252,35 @@ void thread_pool_file_service::times(implementation_type& impl,
   impl.handle_.times(new_times, ec);
 }
 
+file_info thread_pool_file_service::query(implementation_type& impl,
+                                          file_info_mask mask,
+                                          error_code& ec) ASIOEXT_NOEXCEPT
+{
+  return impl.handle_.query(mask, ec);
+}
+
+void thread_pool_file_service::lock(implementation_type& impl,
+                                    const file_range& range, lock_type type,
+                                    error_code& ec) ASIOEXT_NOEXCEPT
+{
+  impl.handle_.lock(range, type, ec);
+}
+
+bool thread_pool_file_service::try_lock(implementation_type& impl,
+                                        const file_range& range,
+                                        lock_type type,
+                                        error_code& ec) ASIOEXT_NOEXCEPT
+{
+  return impl.handle_.try_lock(range, type, ec);
+}
+
+void thread_pool_file_service::unlock(implementation_type& impl,
+                                      const file_range& range,
+                                      error_code& ec) ASIOEXT_NOEXCEPT
+{
+  impl.handle_.unlock(range, ec);
+}
+
 void thread_pool_file_service::cancel(implementation_type& impl,
                                       error_code& ec) ASIOEXT_NOEXCEPT
 {
@@ -263,9 +295,11 @@ void thread_pool_file_service::cancel(implementation_type& impl,
 
 void thread_pool_file_service::close_for_destruction(implementation_type& impl)
 {
+  // Even if we're not open, there might be a pending async_open()
+  // that needs to know.
+  impl.cancel_token_.destroy();
   if (impl.handle_.is_open()) {
     // TODO(tim): log handler operation
-    impl.cancel_token_.destroy();
     impl.handle_.close();
   }
 }
@@ -7,11 +7,16 @@
 #define ASIOEXT_IMPL_THREADPOOLFILESERVICE_HPP
 
 #include "asioext/file_handle.hpp"
+#include "asioext/open.hpp"
 #include "asioext/compose.hpp"
 #include "asioext/error_code.hpp"
 
 #include "asioext/detail/error.hpp"
 
+#include <string>
+#include <type_traits>
+#include <utility>
+
 #if defined(ASIOEXT_USE_BOOST_ASIO)
 # include <boost/asio/bind_executor.hpp>
 # include <boost/asio/post.hpp>
@@ -24,10 +29,15 @@ ASIOEXT_NS_BEGIN
 
 namespace detail {
 
+// |OperationImpl| is invoked with an error_code& on the pool. Its result
+// (if any) is passed to the handler after the error_code.
 template <typename OperationImpl>
 class thread_pool_fs_op
 {
 public:
+  typedef decltype(std::declval<OperationImpl&>()(
+      std::declval<error_code&>())) result_type;
+
   thread_pool_fs_op(const cancellation_token_source& source,
                     OperationImpl& impl,
                     thread_pool_file_service* svc)
@@ -40,19 +50,38 @@ public:
 
   template <typename Self>
   void operator()(Self& self)
+  {
+    run(self, std::is_void<result_type>());
+  }
+
+private:
+  template <typename Self>
+  void run(Self& self, std::false_type)
   {
     error_code ec;
-    std::size_t bytes_transferred = 0;
+    result_type result = result_type();
     if (cancel_token_.cancelled()) {
       ec = asio::error::operation_aborted;
     } else {
-      bytes_transferred = impl_(ec);
+      result = impl_(ec);
     }
     auto ex = get_associated_executor(self, svc_->get_io_context().get_executor());
-    asio::post(ex, self.complete_to_bound_handler(ec, bytes_transferred));
+    asio::post(ex, self.complete_to_bound_handler(ec, std::move(result)));
+  }
+
+  template <typename Self>
+  void run(Self& self, std::true_type)
+  {
+    error_code ec;
+    if (cancel_token_.cancelled()) {
+      ec = asio::error::operation_aborted;
+    } else {
+      impl_(ec);
+    }
+    auto ex = get_associated_executor(self, svc_->get_io_context().get_executor());
+    asio::post(ex, self.complete_to_bound_handler(ec));
   }
 
-private:
   cancellation_token cancel_token_;
   OperationImpl impl_;
   thread_pool_file_service* svc_;
@@ -69,7 +98,121 @@ struct thread_pool_fs_init
     auto ex = get_associated_executor(handler, svc->get_io_context().get_executor());
     auto op = make_composed_operation(
         thread_pool_fs_op<Implementation>(source, impl, svc),
-        std::move(handler), ex);
+        std::forward<Handler>(handler), ex);
+
+    asio::post(asio::bind_executor(svc->get_thread_pool(), std::move(op)));
+  }
+};
+
+// Opens the file on the pool, then hands the new handle to the
+// implementation on the handler's executor (where it's safe to touch).
+template <typename Filename>
+class thread_pool_fs_open_op
+{
+public:
+  thread_pool_fs_open_op(const cancellation_token_source& source,
+                         file_handle* target, const std::size_t* close_count,
+                         Filename&& filename, const open_args& args,
+                         bool already_open, thread_pool_file_service* svc)
+    : cancel_token_(source)
+    , target_(target)
+    , close_count_(close_count)
+    , expected_close_count_(*close_count)
+    , filename_(std::move(filename))
+    , args_(args)
+    , already_open_(already_open)
+    , opened_(false)
+    , svc_(svc)
+  {
+    // ctor
+  }
+
+  template <typename Self>
+  void operator()(Self& self)
+  {
+    if (!opened_) {
+      opened_ = true;
+      if (already_open_)
+        ec_ = asio::error::already_open;
+      else if (cancel_token_.cancelled())
+        ec_ = asio::error::operation_aborted;
+      else
+        handle_ = asioext::open(filename_.c_str(), args_, ec_).release();
+
+      auto ex = get_associated_executor(self, svc_->get_io_context().get_executor());
+      asio::post(ex, std::move(self));
+      return;
+    }
+
+    if (!ec_) {
+      // The file was closed or destroyed in the meantime. We'd rather block
+      // here in this (rare) case than leak the handle.
+      if (cancel_token_.cancelled() ||
+          *close_count_ != expected_close_count_) {
+        error_code ignored_ec;
+        handle_.close(ignored_ec);
+        ec_ = asio::error::operation_aborted;
+      } else if (target_->is_open()) {
+        error_code ignored_ec;
+        handle_.close(ignored_ec);
+        ec_ = asio::error::already_open;
+      } else {
+        *target_ = handle_;
+      }
+    }
+    self.complete(ec_);
+  }
+
+private:
+  cancellation_token cancel_token_;
+  file_handle* target_;
+  // Only valid if |cancel_token_| isn't cancelled.
+  const std::size_t* close_count_;
+  std::size_t expected_close_count_;
+  Filename filename_;
+  open_args args_;
+  bool already_open_;
+  bool opened_;
+  file_handle handle_;
+  error_code ec_;
+  thread_pool_file_service* svc_;
+};
+
+// Unlike the other operations, this one can't be cancelled, as that
+// would leak the handle.
+class thread_pool_fs_close_op
+{
+public:
+  thread_pool_fs_close_op(file_handle handle, thread_pool_file_service* svc)
+    : handle_(handle)
+    , svc_(svc)
+  {
+    // ctor
+  }
+
+  template <typename Self>
+  void operator()(Self& self)
+  {
+    error_code ec;
+    handle_.close(ec);
+    auto ex = get_associated_executor(self, svc_->get_io_context().get_executor());
+    asio::post(ex, self.complete_to_bound_handler(ec));
+  }
+
+private:
+  file_handle handle_;
+  thread_pool_file_service* svc_;
+};
+
+struct thread_pool_fs_op_init
+{
+  template <typename Handler, typename Operation>
+  void operator()(Handler&& handler, Operation&& operation,
+                  thread_pool_file_service* svc)
+  {
+    auto ex = get_associated_executor(handler, svc->get_io_context().get_executor());
+    auto op = make_composed_operation(std::move(operation),
+                                      std::forward<Handler>(handler), ex);
 
     asio::post(asio::bind_executor(svc->get_thread_pool(), std::move(op)));
   }
@@ -125,6 +268,115 @@ struct thread_pool_fs_write_at
   ConstBufferSequence buffers;
 };
 
+struct thread_pool_fs_size
+{
+  uint64_t operator()(error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    return handle.size(ec);
+  }
+
+  file_handle handle;
+};
+
+struct thread_pool_fs_truncate
+{
+  void operator()(error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    handle.truncate(new_size, ec);
+  }
+
+  file_handle handle;
+  uint64_t new_size;
+};
+
+struct thread_pool_fs_get_permissions
+{
+  file_perms operator()(error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    return handle.permissions(ec);
+  }
+
+  file_handle handle;
+};
+
+struct thread_pool_fs_set_permissions
+{
+  void operator()(error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    handle.permissions(perms, opts, ec);
+  }
+
+  file_handle handle;
+  file_perms perms;
+  file_perm_options opts;
+};
+
+struct thread_pool_fs_get_attributes
+{
+  file_attrs operator()(error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    return handle.attributes(ec);
+  }
+
+  file_handle handle;
+};
+
+struct thread_pool_fs_set_attributes
+{
+  void operator()(error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    handle.attributes(attrs, opts, ec);
+  }
+
+  file_handle handle;
+  file_attrs attrs;
+  file_attr_options opts;
+};
+
+struct thread_pool_fs_get_times
+{
+  file_times operator()(error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    return handle.times(ec);
+  }
+
+  file_handle handle;
+};
+
+struct thread_pool_fs_set_times
+{
+  void operator()(error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    handle.times(new_times, ec);
+  }
+
+  file_handle handle;
+  file_times new_times;
+};
+
+struct thread_pool_fs_query
+{
+  file_info operator()(error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    return handle.query(mask, ec);
+  }
+
+  file_handle handle;
+  file_info_mask mask;
+};
+
+struct thread_pool_fs_lock
+{
+  void operator()(error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    handle.lock(range, type, ec);
+  }
+
+  file_handle handle;
+  file_range range;
+  lock_type type;
+};
+
 }
 
 template <typename MutableBufferSequence>
@@ -208,6 +460,190 @@ thread_pool_file_service::async_write_some_at(
       impl.cancel_token_, this);
 }
 
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code))
+thread_pool_file_service::async_open(implementation_type& impl,
+                                     const char* filename,
+                                     const open_args& args,
+                                     CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code)>(
+      detail::thread_pool_fs_op_init(), token,
+      detail::thread_pool_fs_open_op<std::string>(
+          impl.cancel_token_, &impl.handle_, &impl.close_count_,
+          std::string(filename), args, impl.handle_.is_open(), this),
+      this);
+}
+
+#if defined(ASIOEXT_WINDOWS)
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code))
+thread_pool_file_service::async_open(implementation_type& impl,
+                                     const wchar_t* filename,
+                                     const open_args& args,
+                                     CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code)>(
+      detail::thread_pool_fs_op_init(), token,
+      detail::thread_pool_fs_open_op<std::wstring>(
+          impl.cancel_token_, &impl.handle_, &impl.close_count_,
+          std::wstring(filename), args, impl.handle_.is_open(), this),
+      this);
+}
+#endif
+
+#if defined(ASIOEXT_HAS_BOOST_FILESYSTEM)
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code))
+thread_pool_file_service::async_open(implementation_type& impl,
+                                     const boost::filesystem::path& filename,
+                                     const open_args& args,
+                                     CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code)>(
+      detail::thread_pool_fs_op_init(), token,
+      detail::thread_pool_fs_open_op<boost::filesystem::path>(
+          impl.cancel_token_, &impl.handle_, &impl.close_count_,
+          boost::filesystem::path(filename), args, impl.handle_.is_open(),
+          this),
+      this);
+}
+#endif
+
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code))
+thread_pool_file_service::async_close(implementation_type& impl,
+                                      CompletionToken&& token)
+{
+  // Detach the handle right away, so it can't be used (or closed) again.
+  // A pending async_open() is aborted, just like with close().
+  const file_handle handle = impl.handle_;
+  impl.handle_.clear();
+  ++impl.close_count_;
+
+  return async_initiate<CompletionToken, void(error_code)>(
+      detail::thread_pool_fs_op_init(), token,
+      detail::thread_pool_fs_close_op(handle, this), this);
+}
+
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code, uint64_t))
+thread_pool_file_service::async_size(implementation_type& impl,
+                                     CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code, uint64_t)>(
+      detail::thread_pool_fs_init(), token,
+      detail::thread_pool_fs_size{impl.handle_},
+      impl.cancel_token_, this);
+}
+
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code))
+thread_pool_file_service::async_truncate(implementation_type& impl,
+                                         uint64_t new_size,
+                                         CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code)>(
+      detail::thread_pool_fs_init(), token,
+      detail::thread_pool_fs_truncate{impl.handle_, new_size},
+      impl.cancel_token_, this);
+}
+
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code, file_perms))
+thread_pool_file_service::async_permissions(implementation_type& impl,
+                                            CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code, file_perms)>(
+      detail::thread_pool_fs_init(), token,
+      detail::thread_pool_fs_get_permissions{impl.handle_},
+      impl.cancel_token_, this);
+}
+
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code))
+thread_pool_file_service::async_permissions(implementation_type& impl,
+                                            file_perms perms,
+                                            file_perm_options opts,
+                                            CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code)>(
+      detail::thread_pool_fs_init(), token,
+      detail::thread_pool_fs_set_permissions{impl.handle_, perms, opts},
+      impl.cancel_token_, this);
+}
+
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code, file_attrs))
+thread_pool_file_service::async_attributes(implementation_type& impl,
+                                           CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code, file_attrs)>(
+      detail::thread_pool_fs_init(), token,
+      detail::thread_pool_fs_get_attributes{impl.handle_},
+      impl.cancel_token_, this);
+}
+
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code))
+thread_pool_file_service::async_attributes(implementation_type& impl,
+                                           file_attrs attrs,
+                                           file_attr_options opts,
+                                           CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code)>(
+      detail::thread_pool_fs_init(), token,
+      detail::thread_pool_fs_set_attributes{impl.handle_, attrs, opts},
+      impl.cancel_token_, this);
+}
+
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code, file_times))
+thread_pool_file_service::async_times(implementation_type& impl,
+                                      CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code, file_times)>(
+      detail::thread_pool_fs_init(), token,
+      detail::thread_pool_fs_get_times{impl.handle_},
+      impl.cancel_token_, this);
+}
+
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code))
+thread_pool_file_service::async_times(implementation_type& impl,
+                                      const file_times& new_times,
+                                      CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code)>(
+      detail::thread_pool_fs_init(), token,
+      detail::thread_pool_fs_set_times{impl.handle_, new_times},
+      impl.cancel_token_, this);
+}
+
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code, file_info))
+thread_pool_file_service::async_query(implementation_type& impl,
+                                      file_info_mask mask,
+                                      CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code, file_info)>(
+      detail::thread_pool_fs_init(), token,
+      detail::thread_pool_fs_query{impl.handle_, mask},
+      impl.cancel_token_, this);
+}
+
+template <typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code))
+thread_pool_file_service::async_lock(implementation_type& impl,
+                                     const file_range& range, lock_type type,
+                                     CompletionToken&& token)
+{
+  return async_initiate<CompletionToken, void(error_code)>(
+      detail::thread_pool_fs_init(), token,
+      detail::thread_pool_fs_lock{impl.handle_, range, type},
+      impl.cancel_token_, this);
+}
+
 ASIOEXT_NS_END
 
 #endif
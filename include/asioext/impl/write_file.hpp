@@ -13,6 +13,7 @@
 
 #include "asioext/detail/error.hpp"
 #include "asioext/detail/buffer.hpp"
+#include "asioext/detail/hashing.hpp"
 
 #if defined(ASIOEXT_USE_BOOST_ASIO)
 # include <boost/asio/write.hpp>
@@ -20,10 +21,38 @@
 # include <asio/write.hpp>
 #endif
 
+#include <algorithm>
 #include <limits>
 
 ASIOEXT_NS_BEGIN
 
+namespace detail {
+
+template <class ConstBufferSequence, class Hasher>
+void hash_and_write(file_handle file, const ConstBufferSequence& buffers,
+                    Hasher& hasher, error_code& ec)
+{
+  const auto last = asio::buffer_sequence_end(buffers);
+  for (auto first = asio::buffer_sequence_begin(buffers); first != last;
+       ++first) {
+    const asio::const_buffer buffer(*first);
+    const unsigned char* data =
+        static_cast<const unsigned char*>(buffer.data());
+    std::size_t remaining = buffer.size();
+    while (remaining != 0) {
+      const std::size_t chunk = (std::min)(remaining, hashing_chunk_size);
+      hasher.update(data, chunk);
+      asio::write(file, asio::buffer(data, chunk), ec);
+      if (ec) return;
+
+      data += chunk;
+      remaining -= chunk;
+    }
+  }
+}
+
+}
+
 template <class ConstBufferSequence>
 ASIOEXT_DETAIL_WRITEFILE_BUF_RET(ConstBufferSequence)
     write_file(const char* filename, const ConstBufferSequence& buffers)
@@ -93,6 +122,79 @@ ASIOEXT_DETAIL_WRITEFILE_BUF_RET(ConstBufferSequence)
 }
 #endif
 
+// Overloads with checksum computation
+
+template <class ConstBufferSequence, class Hasher>
+ASIOEXT_DETAIL_WRITEFILE_HASH_RET(ConstBufferSequence, Hasher)
+    write_file(const char* filename, const ConstBufferSequence& buffers,
+               Hasher& hasher)
+{
+  error_code ec;
+  write_file(filename, buffers, hasher, ec);
+  detail::throw_error(ec, "write_file");
+}
+
+template <class ConstBufferSequence, class Hasher>
+ASIOEXT_DETAIL_WRITEFILE_HASH_RET(ConstBufferSequence, Hasher)
+    write_file(const char* filename, const ConstBufferSequence& buffers,
+               Hasher& hasher, error_code& ec)
+{
+  unique_file_handle file = open(filename,
+                                 open_flags::access_write |
+                                 open_flags::create_always, ec);
+  if (!ec)
+    detail::hash_and_write(file.get(), buffers, hasher, ec);
+}
+
+#if defined(ASIOEXT_WINDOWS)
+template <class ConstBufferSequence, class Hasher>
+ASIOEXT_DETAIL_WRITEFILE_HASH_RET(ConstBufferSequence, Hasher)
+    write_file(const wchar_t* filename, const ConstBufferSequence& buffers,
+               Hasher& hasher)
+{
+  error_code ec;
+  write_file(filename, buffers, hasher, ec);
+  detail::throw_error(ec, "write_file");
+}
+
+template <class ConstBufferSequence, class Hasher>
+ASIOEXT_DETAIL_WRITEFILE_HASH_RET(ConstBufferSequence, Hasher)
+    write_file(const wchar_t* filename, const ConstBufferSequence& buffers,
+               Hasher& hasher, error_code& ec)
+{
+  unique_file_handle file = open(filename,
+                                 open_flags::access_write |
+                                 open_flags::create_always, ec);
+  if (!ec)
+    detail::hash_and_write(file.get(), buffers, hasher, ec);
+}
+#endif
+
+#if defined(ASIOEXT_HAS_BOOST_FILESYSTEM)
+template <class ConstBufferSequence, class Hasher>
+ASIOEXT_DETAIL_WRITEFILE_HASH_RET(ConstBufferSequence, Hasher)
+    write_file(const boost::filesystem::path& filename,
+               const ConstBufferSequence& buffers, Hasher& hasher)
+{
+  error_code ec;
+  write_file(filename, buffers, hasher, ec);
+  detail::throw_error(ec, "write_file");
+}
+
+template <class ConstBufferSequence, class Hasher>
+ASIOEXT_DETAIL_WRITEFILE_HASH_RET(ConstBufferSequence, Hasher)
+    write_file(const boost::filesystem::path& filename,
+               const ConstBufferSequence& buffers, Hasher& hasher,
+               error_code& ec)
+{
+  unique_file_handle file = open(filename,
+                                 open_flags::access_write |
+                                 open_flags::create_always, ec);
+  if (!ec)
+    detail::hash_and_write(file.get(), buffers, hasher, ec);
+}
+#endif
+
 ASIOEXT_NS_END
 
 #endif
@@ -0,0 +1,80 @@
+/// @file
+/// Defines the asioext::is_hasher trait.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_ISHASHER_HPP
+#define ASIOEXT_ISHASHER_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include <type_traits>
+#include <cstddef>
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup concepts
+/// @defgroup concept-Hasher Hasher
+/// A `Hasher` incrementally computes a checksum or hash over a stream of
+/// bytes.
+///
+/// Functions accepting a `Hasher` feed it the data they transfer chunk by
+/// chunk, while the data is still in the CPU cache. This avoids a second
+/// pass over the data just to compute its checksum.
+///
+/// ## Requirements
+///
+/// Given:
+///
+/// * @c h, lvalue of type X
+/// * @c p, a value of type <code>const void*</code>
+/// * @c n, a value of type @c std::size_t
+///
+/// The following expressions must be valid and have their specified effects:
+///
+/// | expression | return type | effects | precondition | postcondition |
+/// | ---------- | ----------- | ------- | ------------ | ------------- |
+/// | `h.update(p, n)` | | Appends the @c n bytes at @c p to the hashed data | `[p, p + n)` is a valid range | |
+///
+/// How the final value is obtained is up to the individual type.
+/// @ref crc32c_hasher and @ref xxhash64_hasher are models of this concept.
+///
+/// @{
+
+#if defined(ASIOEXT_IS_DOCUMENTATION)
+/// @brief Determines whether T satisfies the @ref concept-Hasher
+/// requirements.
+template <typename T>
+struct is_hasher
+{
+  /// @c true if T satisfies the @ref concept-Hasher requirements,
+  /// @c false otherwise.
+  static const bool value;
+};
+#else
+
+template <typename T, typename = void>
+struct is_hasher : std::false_type
+{};
+
+template <typename T>
+struct is_hasher<T, void_t<
+  decltype(std::declval<T&>().update(std::declval<const void*>(),
+                                     std::size_t()))
+>> : std::true_type
+{};
+
+#endif
+
+/// @}
+
+ASIOEXT_NS_END
+
+#endif
@@ -15,27 +15,57 @@
 #endif
 
 #include "asioext/error_code.hpp"
+#include "asioext/growth_policy.hpp"
+#include "asioext/detail/allocator_realloc.hpp"
 #include "asioext/detail/buffer.hpp"
 #include "asioext/detail/cstdint.hpp"
 
+#include <cstring>
 #include <memory>
 #include <limits>
 #include <type_traits>
 
 ASIOEXT_NS_BEGIN
 
+template <std::size_t N, typename Allocator, typename GrowthPolicy>
+class basic_small_linear_buffer;
+
 /// @ingroup core
 /// @brief Basic container-like wrapper around a dynamic size byte array.
 ///
 /// This class templates manages a contiguously-stored array of bytes,
 /// allocating memory using the given allocator as needed. Individual bytes
 /// are accessible as `uint8_t` values.
-template <typename Allocator = std::allocator<uint8_t>>
+///
+/// How much memory is allocated when the buffer runs out of space (and
+/// whether memory is given back when it shrinks) is determined by the
+/// @c GrowthPolicy. See @ref growth_policy.
+///
+/// Resizing the storage normally means allocating a new block, copying
+/// the contents over and freeing the old block. Allocators that can do better
+/// may provide one of the following member functions, which are then
+/// tried first:
+///
+/// @code
+/// // Resizes the block |p| of |n| bytes to |new_n| bytes, preserving its
+/// // contents. Returns the (possibly moved) block, or nullptr (leaving |p|
+/// // untouched) if that isn't possible.
+/// uint8_t* try_realloc(uint8_t* p, std::size_t n, std::size_t new_n);
+///
+/// // Resizes the block |p| of |n| bytes to |new_n| bytes in place.
+/// // Returns false if that isn't possible.
+/// bool expand(uint8_t* p, std::size_t n, std::size_t new_n);
+/// @endcode
+///
+/// See @ref mremap_allocator for an allocator that implements this.
+template <typename Allocator = std::allocator<uint8_t>,
+          typename GrowthPolicy = geometric_growth<>>
 class basic_linear_buffer
 {
 public:
   typedef Allocator allocator_type;
   typedef std::allocator_traits<allocator_type> allocator_traits_type;
+  typedef GrowthPolicy growth_policy_type;
 
   typedef uint8_t value_type;
   typedef std::size_t size_type;
@@ -71,6 +101,7 @@ public:
     : rep_()
     , capacity_(0)
     , size_(0)
+    , offset_(0)
     , max_size_(allocator_traits_type::max_size(rep_))
   {
   }
@@ -85,6 +116,7 @@ public:
     : rep_(a)
     , capacity_(0)
     , size_(0)
+    , offset_(0)
     , max_size_(allocator_traits_type::max_size(rep_))
   {
   }
@@ -99,6 +131,7 @@ public:
     : rep_()
     , capacity_(initial_size)
     , size_(initial_size)
+    , offset_(0)
     , max_size_((std::min)(allocator_traits_type::max_size(rep_),
                            maximum_size))
   {
@@ -116,6 +149,7 @@ public:
     : rep_(a)
     , capacity_(initial_size)
     , size_(initial_size)
+    , offset_(0)
     , max_size_((std::min)(allocator_traits_type::max_size(rep_),
                            maximum_size))
   {
@@ -129,13 +163,35 @@ public:
   ///
   /// After the move, @c other is an empty buffer with no allocated memory
   /// (as-if just default-constructed).
+  ///
+  /// @note @c other must not keep its data in inline storage, which would
+  /// need to be copied. Moving from a @ref basic_small_linear_buffer selects
+  /// the overload below.
   basic_linear_buffer(basic_linear_buffer&& other) ASIOEXT_NOEXCEPT
-    : rep_(std::move(other.rep_))
-    , capacity_(other.capacity_)
-    , size_(other.size_)
+    : rep_(std::move(static_cast<allocator_type&>(other.rep_)))
+    , capacity_(0)
+    , size_(0)
+    , offset_(0)
     , max_size_(other.max_size_)
   {
-    other.capacity_ = other.size_ = 0;
+    steal(other);
+  }
+
+  /// @brief Move-construct a linear buffer from a small linear buffer.
+  ///
+  /// Heap memory is taken over, while data in @c other's inline storage is
+  /// copied, which can allocate. After the move, @c other is empty.
+  template <std::size_t N>
+  basic_linear_buffer(
+      basic_small_linear_buffer<N, Allocator, GrowthPolicy>&& other)
+    : rep_(std::move(static_cast<allocator_type&>(
+          static_cast<basic_linear_buffer&>(other).rep_)))
+    , capacity_(0)
+    , size_(0)
+    , offset_(0)
+    , max_size_(other.max_size())
+  {
+    steal(other);
   }
 
   /// @brief Destroy the basic_linear_buffer.
@@ -143,8 +199,7 @@ public:
   /// Deallocates all owned data.
   ~basic_linear_buffer()
   {
-    if (rep_.data_)
-      allocator_traits_type::deallocate(rep_, rep_.data_, capacity_);
+    deallocate();
   }
 
   /// @brief Copy-assign a linear buffer.
@@ -154,8 +209,31 @@ public:
   ///
   /// After the move, @c other is an empty buffer with no allocated memory
   /// (as-if just default-constructed).
+  ///
+  /// @note @c other must not keep its data in inline storage that doesn't
+  /// fit into ours. Moving from a @ref basic_small_linear_buffer selects
+  /// the overload below.
   basic_linear_buffer& operator=(basic_linear_buffer&& other) ASIOEXT_NOEXCEPT;
 
+  /// @brief Move-assign a small linear buffer.
+  ///
+  /// Heap memory is taken over, while data in @c other's inline storage is
+  /// copied, which can allocate. After the move, @c other is empty.
+  template <std::size_t N>
+  basic_linear_buffer& operator=(
+      basic_small_linear_buffer<N, Allocator, GrowthPolicy>&& other)
+  {
+    move_assign(other, std::integral_constant<bool,
+        allocator_traits_type::propagate_on_container_move_assignment::value>());
+    return *this;
+  }
+
+  /// Get a copy of the allocator.
+  allocator_type get_allocator() const ASIOEXT_NOEXCEPT
+  {
+    return rep_;
+  }
+
   /// @brief Get the size of the input sequence.
   std::size_t size() const ASIOEXT_NOEXCEPT
   {
@@ -177,7 +255,7 @@ public:
   /// sequence and output sequence.
   std::size_t capacity() const ASIOEXT_NOEXCEPT
   {
-    return capacity_;
+    return offset_ + capacity_;
   }
 
   /// @brief Determine if this linear buffer is empty.
@@ -329,6 +407,8 @@ public:
   /// This function erases the single byte at the given position.
   ///
   /// All iterators and references after the erased byte are invalidated.
+  /// If the @c GrowthPolicy decides to shrink the buffer, all iterators
+  /// and references are invalidated.
   ///
   /// @param pos Position of the byte to remove. Must be in `[0, size())`.
   void erase(std::size_t pos);
@@ -338,6 +418,14 @@ public:
   /// This function erases the bytes in the range `[first, last)`.
   ///
   /// All iterators and references after the first erased byte are invalidated.
+  /// If the @c GrowthPolicy decides to shrink the buffer, all iterators
+  /// and references are invalidated.
+  ///
+  /// Erasing bytes from the front of the buffer doesn't move the remaining
+  /// bytes. They are only moved back to the start of the storage once
+  /// the buffer would otherwise have to grow, or the erased prefix
+  /// outweighs the remaining data. Consuming a buffer piece by piece is
+  /// therefore linear in its size, not quadratic.
   ///
   /// @param first Position of the first byte to remove.
   /// @param last Position of one past the last byte to remove.
@@ -359,10 +447,27 @@ public:
   /// (unlike e.g. <tt>std::vector<uint8_t></tt> which does initialize all
   /// elements).
   ///
+  /// When shrinking the buffer, the @c GrowthPolicy may decide to give
+  /// back unused memory.
+  ///
   /// If the buffer is resized, all iterators and references
   /// (including the `end()` iterator) are invalidated.
   void resize(std::size_t new_size);
 
+  /// @brief Reduce the capacity to the buffer's size.
+  ///
+  /// This function gives back all unused memory, regardless of
+  /// the @c GrowthPolicy. A basic_small_linear_buffer whose contents fit
+  /// into its inline storage returns to using it.
+  ///
+  /// If the buffer is reallocated, all iterators and references
+  /// (including the `end()` iterator) are invalidated.
+  void shrink_to_fit()
+  {
+    if (size_ < capacity())
+      shrink_capacity(size_);
+  }
+
   /// @brief Clear the buffer.
   ///
   /// Resets the buffer to a size of zero without deallocating
@@ -370,6 +475,25 @@ public:
   void clear() ASIOEXT_NOEXCEPT
   {
     size_ = 0;
+    rewind();
+  }
+
+protected:
+  /// @brief Construct a linear buffer that uses the given inline storage.
+  ///
+  /// The buffer starts out using @c inline_data (which must outlive it)
+  /// and only allocates once @c inline_capacity bytes are exceeded.
+  basic_linear_buffer(const Allocator& a, uint8_t* inline_data,
+                      std::size_t inline_capacity,
+                      std::size_t maximum_size) ASIOEXT_NOEXCEPT
+    : rep_(a, inline_data, inline_capacity)
+    , capacity_(inline_capacity)
+    , size_(0)
+    , offset_(0)
+    , max_size_((std::min)(allocator_traits_type::max_size(rep_),
+                           maximum_size))
+  {
+    rep_.data_ = inline_data;
   }
 
 private:
@@ -378,56 +502,150 @@ private:
     representation_type() ASIOEXT_NOEXCEPT
       : Allocator()
       , data_(nullptr)
+      , inline_data_(nullptr)
+      , inline_capacity_(0)
     {}
 
     explicit representation_type(const Allocator& a) ASIOEXT_NOEXCEPT
       : Allocator(a)
       , data_(nullptr)
+      , inline_data_(nullptr)
+      , inline_capacity_(0)
     {}
 
-    representation_type(representation_type&& other) ASIOEXT_NOEXCEPT
-      : Allocator(std::move(static_cast<allocator_type&>(other)))
-      , data_(other.data_)
-    {
-      other.data_ = nullptr;
-    }
+    explicit representation_type(Allocator&& a) ASIOEXT_NOEXCEPT
+      : Allocator(std::move(a))
+      , data_(nullptr)
+      , inline_data_(nullptr)
+      , inline_capacity_(0)
+    {}
+
+    representation_type(const Allocator& a, uint8_t* inline_data,
+                        std::size_t inline_capacity) ASIOEXT_NOEXCEPT
+      : Allocator(a)
+      , data_(nullptr)
+      , inline_data_(inline_data)
+      , inline_capacity_(inline_capacity)
+    {}
 
     uint8_t* data_;
+    // Storage owned by a derived basic_small_linear_buffer (if any).
+    uint8_t* inline_data_;
+    std::size_t inline_capacity_;
   };
 
-  void move_assign(basic_linear_buffer& other, std::false_type)
-#if defined(ASIOEXT_HAS_ALLOCATOR_ALWAYS_EQUAL)
-    ASIOEXT_NOEXCEPT_IF(allocator_traits_type::is_always_equal::value)
-#endif
-    ;
+  bool is_inline() const ASIOEXT_NOEXCEPT
+  {
+    return rep_.inline_data_ && rep_.data_ - offset_ == rep_.inline_data_;
+  }
+
+  // Frees heap memory (if any) and falls back to the inline storage.
+  void deallocate() ASIOEXT_NOEXCEPT
+  {
+    if (rep_.data_ && !is_inline()) {
+      allocator_traits_type::deallocate(rep_, rep_.data_ - offset_,
+                                        offset_ + capacity_);
+    }
+    rep_.data_ = rep_.inline_data_;
+    capacity_ = rep_.inline_capacity_;
+    offset_ = 0;
+  }
+
+  // Moves the data back to the start of our storage.
+  void compact() ASIOEXT_NOEXCEPT
+  {
+    if (size_ != 0)
+      std::memmove(rep_.data_ - offset_, rep_.data_, size_);
+    rewind();
+  }
+
+  // Same as compact(), but the data is discarded.
+  void rewind() ASIOEXT_NOEXCEPT
+  {
+    rep_.data_ -= offset_;
+    capacity_ += offset_;
+    offset_ = 0;
+  }
+
+  // Makes room for |n| bytes after the data, without reallocating.
+  // Returns false if the storage is too small.
+  bool make_room(std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    if (n <= capacity_ - size_)
+      return true;
+    if (n > offset_ + capacity_ - size_)
+      return false;
+    compact();
+    return true;
+  }
 
-  void move_assign(basic_linear_buffer& other, std::true_type)
-    ASIOEXT_NOEXCEPT_IF(std::is_nothrow_move_assignable<allocator_type>::value);
+  // Takes over |other|'s memory (or copies its inline data),
+  // leaving |other| empty. Allocators must compare equal.
+  // Only allocates if |other|'s inline data doesn't fit into our storage.
+  void steal(basic_linear_buffer& other);
+
+  void move_assign(basic_linear_buffer& other, std::false_type);
+  void move_assign(basic_linear_buffer& other, std::true_type);
 
   template <typename Function>
   void reallocate(std::size_t cap, Function&& cb);
 
-  ASIOEXT_CONSTEXPR std::size_t calculate_capacity(std::size_t n)
-      const ASIOEXT_NOEXCEPT
+  // Resizes heap storage through the allocator's realloc hook (if any),
+  // sparing us the copy. Returns false if we have to reallocate().
+  bool try_realloc(std::size_t cap)
+  {
+    if (!rep_.data_ || is_inline() ||
+        !(detail::has_try_realloc<allocator_type>::value ||
+          detail::has_expand<allocator_type>::value))
+      return false;
+
+    compact();
+    uint8_t* data = detail::try_realloc(static_cast<allocator_type&>(rep_),
+                                        rep_.data_, capacity_, cap);
+    if (!data)
+      return false;
+
+    rep_.data_ = data;
+    capacity_ = cap;
+    return true;
+  }
+
+  std::size_t calculate_capacity(std::size_t n) const ASIOEXT_NOEXCEPT
+  {
+    return GrowthPolicy::grow(capacity(), n, max_size_);
+  }
+
+  // Lets the GrowthPolicy decide whether to give back memory.
+  void maybe_shrink()
   {
-    return (capacity_ * 2) < max_size_ ? (std::max)(n, capacity_ * 2) : max_size_;
+    const std::size_t cap = GrowthPolicy::shrink(capacity(), size_);
+    if (cap < capacity() && cap >= size_)
+      shrink_capacity(cap);
   }
 
+  void shrink_capacity(std::size_t cap);
+
+  // |rep_.data_| points at the first byte of data, |offset_| bytes into
+  // our storage (due to erasing from the front). |capacity_| is counted
+  // from |rep_.data_|.
   representation_type rep_;
   std::size_t capacity_;
   std::size_t size_;
+  std::size_t offset_;
   std::size_t max_size_;
 };
 
-template <typename Allocator>
-inline ASIOEXT_CONST_BUFFER buffer(const basic_linear_buffer<Allocator>& b)
+template <typename Allocator, typename GrowthPolicy>
+inline ASIOEXT_CONST_BUFFER buffer(
+    const basic_linear_buffer<Allocator, GrowthPolicy>& b)
     ASIOEXT_NOEXCEPT
 {
   return asio::buffer(b.data(), b.size());
 }
 
-template <typename Allocator>
-inline ASIOEXT_MUTABLE_BUFFER buffer(basic_linear_buffer<Allocator>& b)
+template <typename Allocator, typename GrowthPolicy>
+inline ASIOEXT_MUTABLE_BUFFER buffer(
+    basic_linear_buffer<Allocator, GrowthPolicy>& b)
     ASIOEXT_NOEXCEPT
 {
   return asio::buffer(b.data(), b.size());
@@ -436,9 +654,139 @@ inline ASIOEXT_MUTABLE_BUFFER buffer(basic_linear_buffer<Allocator>& b)
 /// @brief A linear buffer using the default allocator.
 typedef basic_linear_buffer<> linear_buffer;
 
+namespace detail {
+
+template <std::size_t N>
+struct small_linear_buffer_storage
+{
+  uint8_t inline_data_[N];
+};
+
+}
+
+/// @ingroup core
+/// @brief A basic_linear_buffer with inline storage for small contents.
+///
+/// This class template behaves exactly like @c basic_linear_buffer, but
+/// contains @c N bytes of storage itself. Memory is only allocated using the
+/// given allocator once the buffer needs to grow beyond @c N bytes, so small
+/// buffers (e.g. for protocol headers or handshakes) don't need any
+/// allocations at all.
+///
+/// @note Since the inline storage is part of the object, moving a buffer
+/// whose contents fit into it copies them, and invalidates all iterators
+/// and references.
+template <std::size_t N, typename Allocator = std::allocator<uint8_t>,
+          typename GrowthPolicy = geometric_growth<>>
+class basic_small_linear_buffer
+  : private detail::small_linear_buffer_storage<N>
+  , public basic_linear_buffer<Allocator, GrowthPolicy>
+{
+  static_assert(N != 0, "N must not be 0");
+
+  typedef detail::small_linear_buffer_storage<N> storage_type;
+  typedef basic_linear_buffer<Allocator, GrowthPolicy> base_type;
+
+public:
+  /// The number of bytes that can be stored without allocating memory.
+  static const std::size_t inline_capacity = N;
+
+  /// @brief Default-construct a basic_small_linear_buffer.
+  ///
+  /// The constructed basic_small_linear_buffer is empty and uses its
+  /// inline storage.
+  basic_small_linear_buffer() ASIOEXT_NOEXCEPT
+    : base_type(Allocator(), this->inline_data_, N,
+                (std::numeric_limits<std::size_t>::max)())
+  {
+  }
+
+  /// @brief Construct a small linear buffer from an allocator.
+  ///
+  /// The constructed basic_small_linear_buffer is empty and uses its
+  /// inline storage.
+  ///
+  /// @param a The allocator that shall be used to allocate the buffer's
+  /// storage once the inline storage is exhausted.
+  explicit basic_small_linear_buffer(const Allocator& a) ASIOEXT_NOEXCEPT
+    : base_type(a, this->inline_data_, N,
+                (std::numeric_limits<std::size_t>::max)())
+  {
+  }
+
+  /// @brief Construct a small linear buffer.
+  ///
+  /// @param initial_size The initial size that the buffer starts with.
+  /// @param maximum_size Specifies a maximum size for the buffer, in bytes.
+  basic_small_linear_buffer(std::size_t initial_size,
+                            std::size_t maximum_size =
+                                (std::numeric_limits<std::size_t>::max)())
+    : base_type(Allocator(), this->inline_data_, N, maximum_size)
+  {
+    this->resize(initial_size);
+  }
+
+  /// @brief Construct a small linear buffer from an allocator.
+  ///
+  /// @param a The allocator that shall be used to allocate the buffer's
+  /// storage once the inline storage is exhausted.
+  /// @param initial_size The initial size that the buffer starts with.
+  /// @param maximum_size Specifies a maximum size for the buffer, in bytes.
+  basic_small_linear_buffer(const Allocator& a, std::size_t initial_size,
+                            std::size_t maximum_size =
+                                (std::numeric_limits<std::size_t>::max)())
+    : base_type(a, this->inline_data_, N, maximum_size)
+  {
+    this->resize(initial_size);
+  }
+
+  /// @brief Copy-construct a small linear buffer.
+  basic_small_linear_buffer(const basic_small_linear_buffer& other)
+    : base_type(std::allocator_traits<Allocator>::
+                    select_on_container_copy_construction(
+                        other.get_allocator()),
+                this->inline_data_, N, other.max_size())
+  {
+    base_type::operator=(other);
+  }
+
+  /// @brief Move-construct a small linear buffer.
+  ///
+  /// After the move, @c other is empty.
+  basic_small_linear_buffer(basic_small_linear_buffer&& other)
+      ASIOEXT_NOEXCEPT
+    : base_type(other.get_allocator(), this->inline_data_, N,
+                other.max_size())
+  {
+    // Our inline storage is as large as |other|'s, so this doesn't allocate.
+    base_type::operator=(static_cast<base_type&&>(other));
+  }
+
+  /// @brief Copy-assign a small linear buffer.
+  basic_small_linear_buffer& operator=(const basic_small_linear_buffer& other)
+  {
+    base_type::operator=(other);
+    return *this;
+  }
+
+  /// @brief Move-assign a small linear buffer.
+  ///
+  /// After the move, @c other is empty.
+  basic_small_linear_buffer& operator=(
+      basic_small_linear_buffer&& other) ASIOEXT_NOEXCEPT
+  {
+    base_type::operator=(static_cast<base_type&&>(other));
+    return *this;
+  }
+};
+
+/// @brief A small linear buffer using the default allocator.
+template <std::size_t N>
+using small_linear_buffer = basic_small_linear_buffer<N>;
+
 /// @ingroup core
 /// @brief Adapt a @c basic_linear_buffer to the DynamicBuffer requirements.
-template <typename Allocator>
+template <typename Allocator, typename GrowthPolicy = geometric_growth<>>
 class dynamic_linear_buffer
 {
 public:
@@ -459,7 +807,7 @@ public:
   ///
   /// @param maximum_size Specifies a maximum size for the buffer, in bytes.
   ///
-  explicit dynamic_linear_buffer(basic_linear_buffer<Allocator>& b,
+  explicit dynamic_linear_buffer(basic_linear_buffer<Allocator, GrowthPolicy>& b,
       std::size_t maximum_size =
         (std::numeric_limits<std::size_t>::max)()) ASIOEXT_NOEXCEPT
     : data_(b)
@@ -683,7 +1031,7 @@ public:
   }
 
 private:
-  basic_linear_buffer<Allocator>& data_;
+  basic_linear_buffer<Allocator, GrowthPolicy>& data_;
 #if !defined(ASIOEXT_NO_DYNAMIC_BUFFER_V1)
   std::size_t size_;
 #endif
@@ -694,12 +1042,12 @@ private:
 /// @brief Create a new dynamic buffer that represents the
 /// given @c basic_linear_buffer.
 ///
-/// @returns <tt>dynamic_linear_buffer<Allocator>(data)</tt>.
-template <typename Allocator>
-inline dynamic_linear_buffer<Allocator> dynamic_buffer(
-    basic_linear_buffer<Allocator>& data) ASIOEXT_NOEXCEPT
+/// @returns <tt>dynamic_linear_buffer<Allocator, GrowthPolicy>(data)</tt>.
+template <typename Allocator, typename GrowthPolicy>
+inline dynamic_linear_buffer<Allocator, GrowthPolicy> dynamic_buffer(
+    basic_linear_buffer<Allocator, GrowthPolicy>& data) ASIOEXT_NOEXCEPT
 {
-  return dynamic_linear_buffer<Allocator>(data);
+  return dynamic_linear_buffer<Allocator, GrowthPolicy>(data);
 }
 
 ASIOEXT_NS_END
@@ -0,0 +1,571 @@
+/// @file
+/// Defines the mirrored_ring_buffer class.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_MIRROREDRINGBUFFER_HPP
+#define ASIOEXT_MIRROREDRINGBUFFER_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/error_code.hpp"
+#include "asioext/detail/mirrored_mapping.hpp"
+#include "asioext/detail/error.hpp"
+#include "asioext/detail/buffer.hpp"
+#include "asioext/detail/cstdint.hpp"
+#include "asioext/detail/throw_exception.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+#if defined(ASIOEXT_HAS_MIRRORED_MAPPING) || defined(ASIOEXT_IS_DOCUMENTATION)
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup core
+/// @brief Ring buffer whose contents are always contiguous.
+///
+/// This class manages a ring buffer of bytes whose storage is mapped twice,
+/// back-to-back, into the address space. Both the stored data (input
+/// sequence) and the free space behind it (output sequence) are therefore
+/// always accessible as a single contiguous block of memory, even if they
+/// wrap around the end of the ring.
+///
+/// Unlike @c basic_linear_buffer, removing data from the front
+/// (@ref consume) never moves any bytes. Memory is only copied when the
+/// buffer needs to grow.
+///
+/// The capacity is always a multiple of the system's page size.
+///
+/// @note Only available on Linux.
+class mirrored_ring_buffer
+{
+public:
+  typedef uint8_t value_type;
+  typedef std::size_t size_type;
+
+  /// The type used to represent an iterator for the buffer's data.
+  typedef uint8_t* iterator;
+
+  /// The type used to represent an iterator for a constant
+  /// view of the buffer's data.
+  typedef const uint8_t* const_iterator;
+
+  /// The type used to represent a reference to a single byte inside the buffer.
+  typedef uint8_t& reference;
+
+  /// The type used to represent a const. reference to a single byte inside
+  /// the buffer.
+  typedef const uint8_t& const_reference;
+
+  /// The type used to represent a const object as a list of buffers.
+  typedef ASIOEXT_CONST_BUFFER const_buffers_type;
+
+  /// The type used to represent a non-const object as a list of buffers.
+  typedef ASIOEXT_MUTABLE_BUFFER mutable_buffers_type;
+
+  /// @brief Default-construct a mirrored_ring_buffer.
+  ///
+  /// The constructed mirrored_ring_buffer is empty and doesn't have
+  /// any allocated memory.
+  mirrored_ring_buffer() ASIOEXT_NOEXCEPT
+    : data_(nullptr)
+    , capacity_(0)
+    , offset_(0)
+    , size_(0)
+    , max_size_((std::numeric_limits<std::size_t>::max)() / 2)
+  {
+  }
+
+  /// @brief Construct a mirrored_ring_buffer.
+  ///
+  /// The constructed mirrored_ring_buffer is empty.
+  ///
+  /// @param initial_capacity The minimum capacity that the buffer starts with.
+  /// @param maximum_size Specifies a maximum size for the buffer, in bytes.
+  ///
+  /// @throws asio::system_error Thrown if the memory couldn't be mapped.
+  ASIOEXT_DECL explicit mirrored_ring_buffer(
+      std::size_t initial_capacity,
+      std::size_t maximum_size = (std::numeric_limits<std::size_t>::max)());
+
+  /// @brief Move-construct a mirrored_ring_buffer.
+  ///
+  /// After the move, @c other is an empty buffer with no allocated memory
+  /// (as-if just default-constructed).
+  mirrored_ring_buffer(mirrored_ring_buffer&& other) ASIOEXT_NOEXCEPT
+    : data_(other.data_)
+    , capacity_(other.capacity_)
+    , offset_(other.offset_)
+    , size_(other.size_)
+    , max_size_(other.max_size_)
+  {
+    other.data_ = nullptr;
+    other.capacity_ = other.offset_ = other.size_ = 0;
+  }
+
+  /// @brief Destroy the mirrored_ring_buffer.
+  ///
+  /// Unmaps all owned memory.
+  ~mirrored_ring_buffer()
+  {
+    if (data_)
+      detail::mirrored_mapping::unmap(data_, capacity_);
+  }
+
+  /// @brief Move-assign a mirrored_ring_buffer.
+  ///
+  /// After the move, @c other is an empty buffer with no allocated memory
+  /// (as-if just default-constructed).
+  ASIOEXT_DECL mirrored_ring_buffer& operator=(
+      mirrored_ring_buffer&& other) ASIOEXT_NOEXCEPT;
+
+  /// @brief Get the size of the input sequence.
+  std::size_t size() const ASIOEXT_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// @brief Get the maximum size of the ring buffer.
+  std::size_t max_size() const ASIOEXT_NOEXCEPT
+  {
+    return max_size_;
+  }
+
+  /// @brief Get the current capacity of the ring buffer.
+  ///
+  /// @returns The current total capacity of the buffer, i.e. for both the input
+  /// sequence and output sequence.
+  std::size_t capacity() const ASIOEXT_NOEXCEPT
+  {
+    return capacity_;
+  }
+
+  /// @brief Determine if this ring buffer is empty.
+  bool empty() const ASIOEXT_NOEXCEPT
+  {
+    return 0 == size_;
+  }
+
+  /// @brief Get an iterator pointing at the buffer data beginning.
+  iterator begin() ASIOEXT_NOEXCEPT { return data_ + offset_; }
+
+  /// @brief Get an iterator pointing at the buffer data end.
+  iterator end() ASIOEXT_NOEXCEPT { return data_ + offset_ + size_; }
+
+  /// @brief Get an iterator pointing at the buffer data beginning.
+  const_iterator begin() const ASIOEXT_NOEXCEPT { return data_ + offset_; }
+
+  /// @brief Get an iterator pointing at the buffer data end.
+  const_iterator end() const ASIOEXT_NOEXCEPT
+  {
+    return data_ + offset_ + size_;
+  }
+
+  /// @brief Get a pointer to the buffer data beginning.
+  uint8_t* data() ASIOEXT_NOEXCEPT { return data_ + offset_; }
+
+  /// @brief Get a pointer to the buffer data beginning.
+  const uint8_t* data() const ASIOEXT_NOEXCEPT { return data_ + offset_; }
+
+  /// Get a list of buffers that represents the input sequence.
+  ///
+  /// @note The returned object is invalidated by any @c mirrored_ring_buffer
+  /// member function that causes a reallocation.
+  mutable_buffers_type as_buffers() ASIOEXT_NOEXCEPT
+  {
+    return mutable_buffers_type(data(), size_);
+  }
+
+  /// Get a list of buffers that represents the input sequence.
+  ///
+  /// @note The returned object is invalidated by any @c mirrored_ring_buffer
+  /// member function that causes a reallocation.
+  const_buffers_type as_buffers() const ASIOEXT_NOEXCEPT
+  {
+    return const_buffers_type(data(), size_);
+  }
+
+  /// @brief Get a reference to a specific byte inside the buffer.
+  ///
+  /// @param i Offset of the wanted byte.
+  reference operator[](std::size_t i) ASIOEXT_NOEXCEPT
+  {
+    return data_[offset_ + i];
+  }
+
+  /// @brief Get a reference to a specific byte inside the buffer.
+  ///
+  /// @param i Offset of the wanted byte.
+  const_reference operator[](std::size_t i) const ASIOEXT_NOEXCEPT
+  {
+    return data_[offset_ + i];
+  }
+
+  /// @brief Append the given data to the buffer.
+  ///
+  /// This function appends the given raw data to the buffer,
+  /// growing it as necessary.
+  ///
+  /// @param data The raw bytes to append.
+  /// @param n Number of raw bytes to append.
+  ///
+  /// @throws std::length_error If <tt>size() + n > max_size()</tt>.
+  ASIOEXT_DECL void append(const void* data, std::size_t n);
+
+  /// @brief Get a list of buffers that represents the output sequence, with
+  /// the given size.
+  ///
+  /// Ensures that the output sequence can accommodate @c n bytes, growing the
+  /// buffer as necessary.
+  ///
+  /// @param n Total number of bytes the output sequence has to accomodate.
+  ///
+  /// @returns An object of type @c mutable_buffers_type representing memory
+  /// directly behind the input sequence, of size @c n.
+  ///
+  /// @throws std::length_error If <tt>size() + n > max_size()</tt>.
+  ASIOEXT_DECL mutable_buffers_type prepare(std::size_t n);
+
+  /// @brief Get a list of buffers that represents the output sequence, with
+  /// the given size.
+  ///
+  /// Ensures that the output sequence can accommodate @c n bytes, growing the
+  /// buffer as necessary.
+  ///
+  /// @param n Total number of bytes the output sequence has to accomodate.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ///
+  /// @returns An object of type @c mutable_buffers_type representing memory
+  /// directly behind the input sequence, of size @c n.
+  ASIOEXT_DECL mutable_buffers_type prepare(std::size_t n,
+                                            error_code& ec) ASIOEXT_NOEXCEPT;
+
+  /// @brief Move bytes from the output sequence to the input sequence.
+  ///
+  /// @param n The number of bytes to append from the start of the output
+  /// sequence to the end of the input sequence.
+  ///
+  /// @note If @c n is greater than the size of the output sequence, the entire
+  /// output sequence is moved to the input sequence and no error is issued.
+  void commit(std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    size_ += (std::min)(n, capacity_ - size_);
+  }
+
+  /// @brief Remove bytes from the input sequence.
+  ///
+  /// Removes @c n bytes from the beginning of the input sequence.
+  /// This doesn't move any data.
+  ///
+  /// @note If @c n is greater than the size of the input sequence, the entire
+  /// input sequence is consumed and no error is issued.
+  void consume(std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    if (n >= size_) {
+      clear();
+      return;
+    }
+
+    offset_ += n;
+    if (offset_ >= capacity_)
+      offset_ -= capacity_;
+    size_ -= n;
+  }
+
+  /// @brief Ensure the buffer has at least the given capacity.
+  ///
+  /// If the buffer is reallocated, all iterators and references
+  /// (including the `end()` iterator) are invalidated.
+  ///
+  /// @throws std::length_error If <tt>min_cap > max_size()</tt>.
+  /// @throws asio::system_error Thrown if the memory couldn't be mapped.
+  ASIOEXT_DECL void reserve(std::size_t min_cap);
+
+  /// @brief Ensure the buffer has at least the given capacity.
+  ///
+  /// If the buffer is reallocated, all iterators and references
+  /// (including the `end()` iterator) are invalidated.
+  ///
+  /// @param min_cap The minimum capacity.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ASIOEXT_DECL void reserve(std::size_t min_cap,
+                            error_code& ec) ASIOEXT_NOEXCEPT;
+
+  /// @brief Resize the input sequence.
+  ///
+  /// When growing the buffer, new bytes are not zero-initialized.
+  ///
+  /// @throws std::length_error If <tt>new_size > max_size()</tt>.
+  ASIOEXT_DECL void resize(std::size_t new_size);
+
+  /// @brief Clear the buffer.
+  ///
+  /// Resets the buffer to a size of zero without unmapping the memory.
+  void clear() ASIOEXT_NOEXCEPT
+  {
+    offset_ = 0;
+    size_ = 0;
+  }
+
+private:
+  mirrored_ring_buffer(const mirrored_ring_buffer&) ASIOEXT_DELETED;
+  mirrored_ring_buffer& operator=(const mirrored_ring_buffer&) ASIOEXT_DELETED;
+
+  ASIOEXT_DECL std::size_t calculate_capacity(std::size_t n)
+      const ASIOEXT_NOEXCEPT;
+
+  // Both mappings, i.e. |2 * capacity_| bytes.
+  uint8_t* data_;
+  std::size_t capacity_;
+  // Start of the input sequence, always < capacity_.
+  std::size_t offset_;
+  std::size_t size_;
+  std::size_t max_size_;
+};
+
+inline ASIOEXT_CONST_BUFFER buffer(const mirrored_ring_buffer& b)
+    ASIOEXT_NOEXCEPT
+{
+  return asio::buffer(b.data(), b.size());
+}
+
+inline ASIOEXT_MUTABLE_BUFFER buffer(mirrored_ring_buffer& b)
+    ASIOEXT_NOEXCEPT
+{
+  return asio::buffer(b.data(), b.size());
+}
+
+/// @ingroup core
+/// @brief Adapt a @c mirrored_ring_buffer to the DynamicBuffer requirements.
+///
+/// The interface is identical to @c dynamic_linear_buffer, but all buffer
+/// sequences returned by this class always consist of a single buffer
+/// and consuming data from the front is free.
+class dynamic_mirrored_ring_buffer
+{
+public:
+  /// The type used to represent the input sequence as a list of buffers.
+  typedef ASIOEXT_CONST_BUFFER const_buffers_type;
+
+  /// The type used to represent the output sequence as a list of buffers.
+  typedef ASIOEXT_MUTABLE_BUFFER mutable_buffers_type;
+
+  /// @brief Construct a dynamic buffer from a @c mirrored_ring_buffer.
+  ///
+  /// @param b The mirrored_ring_buffer to be used as backing storage for
+  /// the dynamic buffer.
+  /// Any existing data in the buffer is treated as the dynamic buffer's input
+  /// sequence. The object stores a reference to the buffer and the user is
+  /// responsible for ensuring that the buffer object remains valid until the
+  /// dynamic_mirrored_ring_buffer object is destroyed.
+  ///
+  /// @param maximum_size Specifies a maximum size for the buffer, in bytes.
+  explicit dynamic_mirrored_ring_buffer(mirrored_ring_buffer& b,
+      std::size_t maximum_size =
+        (std::numeric_limits<std::size_t>::max)()) ASIOEXT_NOEXCEPT
+    : data_(b)
+    , max_size_((std::min)(b.max_size(), maximum_size))
+  {
+  }
+
+  /// @brief Move-construct a dynamic buffer.
+  dynamic_mirrored_ring_buffer(
+      dynamic_mirrored_ring_buffer&& other) ASIOEXT_NOEXCEPT
+    : data_(other.data_)
+    , max_size_(other.max_size_)
+  {
+  }
+
+  /// @brief Get the size of the input sequence.
+  std::size_t size() const ASIOEXT_NOEXCEPT
+  {
+    return (std::min)(data_.size(), max_size_);
+  }
+
+  /// @brief Get the maximum size of the dynamic buffer.
+  std::size_t max_size() const ASIOEXT_NOEXCEPT
+  {
+    return max_size_;
+  }
+
+  /// @brief Get the current capacity of the dynamic buffer.
+  std::size_t capacity() const ASIOEXT_NOEXCEPT
+  {
+    return (std::min)(data_.capacity(), max_size_);
+  }
+
+#if !defined(ASIOEXT_NO_DYNAMIC_BUFFER_V1)
+  /// Get a list of buffers that represents the input sequence.
+  mutable_buffers_type data() ASIOEXT_NOEXCEPT
+  {
+    return mutable_buffers_type(data_.data(), size());
+  }
+
+  /// Get a list of buffers that represents the input sequence.
+  const_buffers_type data() const ASIOEXT_NOEXCEPT
+  {
+    return const_buffers_type(data_.data(), size());
+  }
+#endif
+
+  /// @brief Get a sequence of buffers that represents the underlying memory.
+  ///
+  /// @param pos Position of the first byte to represent in the buffer sequence
+  ///
+  /// @param n The number of bytes to return in the buffer sequence. If the
+  /// underlying memory is shorter, the buffer sequence represents as many bytes
+  /// as are available.
+  mutable_buffers_type data(std::size_t pos, std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    const std::size_t siz = data_.size();
+    if (pos > siz)
+      pos = siz;
+    if (n > siz - pos)
+      n = siz - pos;
+    return mutable_buffers_type(data_.data() + pos, n);
+  }
+
+  /// @brief Get a sequence of buffers that represents the underlying memory.
+  ///
+  /// @param pos Position of the first byte to represent in the buffer sequence
+  ///
+  /// @param n The number of bytes to return in the buffer sequence. If the
+  /// underlying memory is shorter, the buffer sequence represents as many bytes
+  /// as are available.
+  const_buffers_type data(std::size_t pos,
+                          std::size_t n) const ASIOEXT_NOEXCEPT
+  {
+    const std::size_t siz = data_.size();
+    if (pos > siz)
+      pos = siz;
+    if (n > siz - pos)
+      n = siz - pos;
+    return const_buffers_type(data_.data() + pos, n);
+  }
+
+#if !defined(ASIOEXT_NO_DYNAMIC_BUFFER_V1)
+  /// @brief Get a list of buffers that represents the output sequence, with
+  /// the given size.
+  ///
+  /// @throws std::length_error If <tt>size() + n > max_size()</tt>.
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    check_grow(n);
+    return data_.prepare(n);
+  }
+
+  /// @brief Get a list of buffers that represents the output sequence, with
+  /// the given size.
+  ///
+  /// @param n Total number of bytes the output sequence has to accomodate.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  ///
+  /// @note This function is not part of the DynamicBuffer requirements.
+  mutable_buffers_type prepare(std::size_t n, error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    const std::size_t siz = data_.size();
+    if (siz > max_size_ || max_size_ - siz < n) {
+      ec = asio::error::no_memory;
+      return mutable_buffers_type(nullptr, 0);
+    }
+    return data_.prepare(n, ec);
+  }
+
+  /// Move bytes from the output sequence to the input sequence.
+  void commit(std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    data_.commit(n);
+  }
+#endif
+
+  /// @brief Grow the underlying memory by the specified number of bytes.
+  ///
+  /// @throws std::length_error If <tt>size() + n > max_size()</tt>.
+  void grow(std::size_t n)
+  {
+    check_grow(n);
+    data_.resize(data_.size() + n);
+  }
+
+  /// @brief Shrink the underlying memory by the specified number of bytes.
+  ///
+  /// Erases @c n bytes from the end of the input sequence. If @c n is greater
+  /// than the current size, the buffer is emptied.
+  void shrink(std::size_t n)
+  {
+    const std::size_t siz = data_.size();
+    data_.resize(siz - (std::min)(siz, n));
+  }
+
+  /// @brief Remove characters from the input sequence.
+  ///
+  /// Removes @c n characters from the beginning of the input sequence.
+  /// This doesn't move any data.
+  void consume(std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    data_.consume(n);
+  }
+
+private:
+  void check_grow(std::size_t n) const
+  {
+    const std::size_t siz = data_.size();
+    if (siz > max_size_ || max_size_ - siz < n) {
+      std::length_error ex("dynamic_mirrored_ring_buffer too long");
+      detail::throw_exception(ex);
+    }
+  }
+
+  mirrored_ring_buffer& data_;
+  std::size_t max_size_;
+};
+
+/// @ingroup core
+/// @brief Create a new dynamic buffer that represents the
+/// given @c mirrored_ring_buffer.
+///
+/// @returns <tt>dynamic_mirrored_ring_buffer(data)</tt>.
+inline dynamic_mirrored_ring_buffer dynamic_buffer(
+    mirrored_ring_buffer& data) ASIOEXT_NOEXCEPT
+{
+  return dynamic_mirrored_ring_buffer(data);
+}
+
+ASIOEXT_NS_END
+
+#if !defined(ASIOEXT_IS_DOCUMENTATION)
+# if defined(ASIOEXT_USE_BOOST_ASIO)
+namespace boost {
+# endif
+namespace asio {
+
+using asioext::buffer;
+using asioext::dynamic_buffer;
+
+}
+# if defined(ASIOEXT_USE_BOOST_ASIO)
+}
+# endif
+#endif
+
+# if defined(ASIOEXT_HEADER_ONLY)
+#  include "asioext/impl/mirrored_ring_buffer.cpp"
+# endif
+
+#endif
+
+#endif
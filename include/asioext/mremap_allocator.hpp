@@ -0,0 +1,119 @@
+/// @file
+/// Defines the mremap_allocator class template.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_MREMAPALLOCATOR_HPP
+#define ASIOEXT_MREMAPALLOCATOR_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/detail/mapped_memory.hpp"
+#include "asioext/detail/throw_exception.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if defined(ASIOEXT_HAS_MREMAP) || defined(ASIOEXT_IS_DOCUMENTATION)
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup core
+/// @brief Allocator that maps whole pages and grows them with @c mremap().
+///
+/// Every allocation is an anonymous memory mapping of its own, rounded up
+/// to the system's page size. That makes this allocator unsuitable for
+/// small objects, but growing a large block (see @ref try_realloc) doesn't
+/// copy anything: the kernel merely updates the page tables. Growing
+/// a gigabyte-sized @c basic_linear_buffer is therefore about as cheap as
+/// growing a kilobyte-sized one.
+///
+/// @code
+/// asioext::basic_linear_buffer<asioext::mremap_allocator<uint8_t>> buf;
+/// @endcode
+///
+/// @note Only available on Linux.
+template <typename T>
+class mremap_allocator
+{
+public:
+  typedef T value_type;
+  typedef std::true_type is_always_equal;
+  typedef std::true_type propagate_on_container_move_assignment;
+
+  template <typename U>
+  struct rebind { typedef mremap_allocator<U> other; };
+
+  mremap_allocator() ASIOEXT_NOEXCEPT
+  {}
+
+  template <typename U>
+  mremap_allocator(const mremap_allocator<U>&) ASIOEXT_NOEXCEPT
+  {}
+
+  /// @brief Map memory for @c n objects of type @c T.
+  ///
+  /// @throws std::bad_alloc Thrown if the memory couldn't be mapped.
+  T* allocate(std::size_t n)
+  {
+    void* data = nullptr;
+    if (n <= (std::numeric_limits<std::size_t>::max)() / sizeof(T))
+      data = detail::mapped_memory::map(n * sizeof(T));
+
+    if (!data) {
+      std::bad_alloc ex;
+      detail::throw_exception(ex);
+    }
+    return static_cast<T*>(data);
+  }
+
+  /// @brief Unmap memory obtained from @ref allocate or @ref try_realloc.
+  void deallocate(T* p, std::size_t n) ASIOEXT_NOEXCEPT
+  {
+    detail::mapped_memory::unmap(p, n * sizeof(T));
+  }
+
+  /// @brief Resize a block without copying its contents.
+  ///
+  /// This function resizes the block @c p of @c n objects so that it holds
+  /// @c new_n objects. The block may be moved to a different address.
+  ///
+  /// @returns The resized block, or @c nullptr if it couldn't be resized.
+  /// In that case @c p is still valid.
+  T* try_realloc(T* p, std::size_t n, std::size_t new_n) ASIOEXT_NOEXCEPT
+  {
+    if (new_n > (std::numeric_limits<std::size_t>::max)() / sizeof(T))
+      return nullptr;
+    return static_cast<T*>(detail::mapped_memory::remap(
+        p, n * sizeof(T), new_n * sizeof(T)));
+  }
+};
+
+template <typename T, typename U>
+inline bool operator==(const mremap_allocator<T>&,
+                       const mremap_allocator<U>&) ASIOEXT_NOEXCEPT
+{
+  return true;
+}
+
+template <typename T, typename U>
+inline bool operator!=(const mremap_allocator<T>&,
+                       const mremap_allocator<U>&) ASIOEXT_NOEXCEPT
+{
+  return false;
+}
+
+ASIOEXT_NS_END
+
+#endif
+
+#endif
@@ -18,12 +18,20 @@
 #include "asioext/open_args.hpp"
 #include "asioext/error_code.hpp"
 
+#if !defined(ASIOEXT_WINDOWS) || defined(ASIOEXT_IS_DOCUMENTATION)
+# include "asioext/resolve_flags.hpp"
+#endif
+
 #if defined(ASIOEXT_HAS_BOOST_FILESYSTEM) || defined(ASIOEXT_IS_DOCUMENTATION)
 # include <boost/filesystem/path.hpp>
 #endif
 
 ASIOEXT_NS_BEGIN
 
+#if !defined(ASIOEXT_WINDOWS) || defined(ASIOEXT_IS_DOCUMENTATION)
+class directory_handle;
+#endif
+
 /// @ingroup files
 /// @defgroup filenames Filenames
 /// Various platforms have different ways of representing filenames.
@@ -120,6 +128,75 @@ ASIOEXT_DECL unique_file_handle open(
     error_code& ec) ASIOEXT_NOEXCEPT;
 #endif
 
+#if !defined(ASIOEXT_WINDOWS) || defined(ASIOEXT_IS_DOCUMENTATION)
+/// @brief Open a file relative to a directory and return its handle.
+///
+/// This function opens the file @c filename inside the directory @c dir.
+/// Only @c filename needs to be resolved, which makes this considerably
+/// cheaper than open(const char*,const open_args&) when many files inside
+/// the same directory are opened.
+///
+/// @param dir The directory @c filename is relative to.
+///
+/// @param filename The path of the file to open, relative to @c dir.
+///
+/// @param args Additional options used to open the file.
+///
+/// @param resolve Restrictions for resolving @c filename.
+/// See @ref resolve_flags.
+///
+/// @return A handle to the opened file. Ownership is transferred to the
+/// caller. Handles are not inherited by child processes.
+///
+/// @throws asio::system_error Thrown on failure.
+///
+/// @note Only available on POSIX systems.
+ASIOEXT_DECL unique_file_handle open(
+    const directory_handle& dir, const char* filename, const open_args& args,
+    resolve_flags resolve = resolve_flags::none);
+
+/// @brief Open a file relative to a directory and return its handle.
+///
+/// @param dir The directory @c filename is relative to.
+///
+/// @param filename The path of the file to open, relative to @c dir.
+///
+/// @param args Additional options used to open the file.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+///
+/// @return A handle to the opened file (or an empty handle in case
+/// of failure).
+///
+/// @note Only available on POSIX systems.
+ASIOEXT_DECL unique_file_handle open(
+    const directory_handle& dir, const char* filename, const open_args& args,
+    error_code& ec) ASIOEXT_NOEXCEPT;
+
+/// @brief Open a file relative to a directory and return its handle.
+///
+/// @param dir The directory @c filename is relative to.
+///
+/// @param filename The path of the file to open, relative to @c dir.
+///
+/// @param args Additional options used to open the file.
+///
+/// @param resolve Restrictions for resolving @c filename.
+/// See @ref resolve_flags.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+///
+/// @return A handle to the opened file (or an empty handle in case
+/// of failure).
+///
+/// @note Only available on POSIX systems.
+ASIOEXT_DECL unique_file_handle open(
+    const directory_handle& dir, const char* filename, const open_args& args,
+    resolve_flags resolve, error_code& ec) ASIOEXT_NOEXCEPT;
+#endif
+
 /// @}
 
 ASIOEXT_NS_END
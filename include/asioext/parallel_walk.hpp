@@ -0,0 +1,170 @@
+/// @file
+/// Defines the parallel_walk() function and its helper types.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_PARALLELWALK_HPP
+#define ASIOEXT_PARALLELWALK_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#if !defined(ASIOEXT_WINDOWS) || defined(ASIOEXT_IS_DOCUMENTATION)
+
+#include "asioext/directory_reader.hpp"
+#include "asioext/directory_handle.hpp"
+#include "asioext/file_info.hpp"
+#include "asioext/error_code.hpp"
+
+#include "asioext/detail/cstdint.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <string>
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup files
+/// @brief Tells parallel_walk() how to proceed after visiting an entry.
+enum class walk_action
+{
+  /// Continue normally. Directories are descended into.
+  proceed,
+
+  /// Don't descend into this directory. Same as @c proceed for
+  /// non-directories.
+  prune,
+
+  /// Stop the walk as soon as possible.
+  stop,
+};
+
+/// @ingroup files
+/// @brief Options for parallel_walk().
+struct walk_options
+{
+  /// @brief The number of threads to use (including the calling thread).
+  ///
+  /// If 0, @c std::thread::hardware_concurrency() threads are used.
+  std::size_t threads = 0;
+
+  /// @brief The maximum depth of visited entries.
+  ///
+  /// The entries of the root directory have a depth of 1.
+  std::size_t max_depth = (std::numeric_limits<std::size_t>::max)();
+
+  /// @brief Whether to fetch the metadata of every visited entry.
+  ///
+  /// If set, walk_entry::info is valid for all visited entries.
+  bool stat_entries = false;
+
+  /// @brief Whether to silently skip entries and directories that
+  /// can't be accessed.
+  ///
+  /// If unset, the first error stops the walk and is reported.
+  bool skip_errors = false;
+
+  /// @brief The size of each thread's directory read buffer.
+  std::size_t buffer_size = directory_reader::default_buffer_size;
+};
+
+/// @ingroup files
+/// @brief Describes an entry visited by parallel_walk().
+struct walk_entry
+{
+  /// @brief The directory containing the entry.
+  ///
+  /// Can be used to open or query the entry without resolving its path.
+  const directory_handle& directory;
+
+  /// @brief The path of the directory containing the entry, relative to
+  /// the walk's root (empty for the root's entries).
+  const std::string& parent_path;
+
+  /// @brief The entry itself.
+  ///
+  /// Unlike with directory_reader, @c entry.type is never
+  /// file_type::unknown.
+  const directory_entry& entry;
+
+  /// @brief The entry's depth (1 for the root's entries).
+  std::size_t depth;
+
+  /// @brief The entry's metadata if walk_options::stat_entries is set,
+  /// @c nullptr otherwise.
+  const file_info* info;
+};
+
+/// @ingroup files
+/// @defgroup parallel_walk asioext::parallel_walk()
+/// @brief Recursively visit all entries of a directory tree in parallel.
+///
+/// Subdirectories are distributed across worker threads. Every worker
+/// processes its own subdirectories depth-first and steals the oldest
+/// (i.e. shallowest and usually largest) pending directory of another
+/// worker once it runs out of work.
+///
+/// Subdirectories are opened relative to their already open parent
+/// directory (see directory_handle), so their paths are never resolved
+/// from the root again. Entries are listed using directory_reader and
+/// only queried individually if walk_options::stat_entries is set (or
+/// the file system doesn't report entry types).
+///
+/// Symbolic links are reported, but never followed.
+///
+/// The visitor must be callable as
+/// <code>walk_action(const walk_entry&)</code>. It is invoked concurrently
+/// from all worker threads. Exceptions thrown by the visitor stop the
+/// walk and are rethrown by parallel_walk().
+///
+/// @note Only available on POSIX systems.
+///
+/// @{
+
+/// @brief Recursively visit all entries of a directory tree in parallel.
+///
+/// @param root The path of the tree's root directory. The root itself
+/// isn't visited.
+///
+/// @param visitor The visitor, see above.
+///
+/// @param options Options for the walk.
+///
+/// @return The number of visited entries.
+///
+/// @throws asio::system_error Thrown on failure.
+template <typename Visitor>
+uint64_t parallel_walk(const char* root, Visitor&& visitor,
+                       const walk_options& options = walk_options());
+
+/// @brief Recursively visit all entries of a directory tree in parallel.
+///
+/// @param root The path of the tree's root directory. The root itself
+/// isn't visited.
+///
+/// @param visitor The visitor, see above.
+///
+/// @param options Options for the walk.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+///
+/// @return The number of visited entries.
+template <typename Visitor>
+uint64_t parallel_walk(const char* root, Visitor&& visitor,
+                       const walk_options& options, error_code& ec);
+
+/// @}
+
+ASIOEXT_NS_END
+
+#include "asioext/impl/parallel_walk.hpp"
+
+#endif
+
+#endif
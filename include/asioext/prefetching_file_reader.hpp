@@ -0,0 +1,231 @@
+/// @file
+/// Defines the prefetching_file_reader class template.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_PREFETCHINGFILEREADER_HPP
+#define ASIOEXT_PREFETCHINGFILEREADER_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/async_result.hpp"
+#include "asioext/error_code.hpp"
+#include "asioext/detail/cstdint.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/buffer.hpp>
+# include <boost/asio/steady_timer.hpp>
+#else
+# include <asio/buffer.hpp>
+# include <asio/steady_timer.hpp>
+#endif
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup files
+/// @brief Options of a @c prefetching_file_reader.
+struct prefetch_options
+{
+  /// The size of the chunks the file is read in.
+  std::size_t chunk_size = 256 * 1024;
+
+  /// The number of reads kept in flight at first, and at least.
+  std::size_t min_depth = 2;
+
+  /// The maximum number of reads kept in flight. At most one more chunk
+  /// buffer is allocated, for the chunk that's being processed.
+  std::size_t max_depth = 16;
+};
+
+/// @ingroup files
+/// @brief Reads a file sequentially, keeping reads in flight ahead of
+/// the consumer.
+///
+/// Reading a file chunk by chunk with @c async_read_some leaves the device
+/// idle while each chunk is processed, and only ever gives it a single
+/// request to work on. This class keeps up to @c max_depth chunk reads
+/// in flight, using a ring of chunk buffers, and hands out the chunks in
+/// file order:
+///
+/// @code
+/// asioext::prefetching_file_reader<asioext::file> reader(file);
+/// reader.async_next([&] (asioext::error_code ec, asio::const_buffer chunk) {
+///   // Process chunk, then call async_next() for the next one.
+/// });
+/// @endcode
+///
+/// The number of reads in flight (the depth) is adapted as the file is
+/// read. Following Little's law, the reader needs as many chunks in flight
+/// as complete during one read's latency, so the depth is the observed read
+/// latency divided by the time the consumer spends per chunk (both smoothed),
+/// plus one for the chunk that's being processed. A slow consumer thus keeps
+/// few buffers busy, while a fast one gets the device's queue filled.
+///
+/// Reads should be done with a @c thread_pool_file_service that has
+/// multiple threads, or another service that can run multiple reads
+/// concurrently. Otherwise the reads in flight are just queued.
+///
+/// @tparam RandomAccessReadDevice A type satisfying the
+/// @c AsyncRandomAccessReadDevice requirements, such as @ref basic_file.
+///
+/// @tparam Allocator The allocator used for the chunk buffers.
+///
+/// @note The reader must outlive its reads. Cancel or close the device and
+/// run its executor until @ref in_flight is 0 before destroying it.
+///
+/// @par Thread Safety:
+/// @e Distinct @e objects: Safe.@n
+/// @e Shared @e objects: Unsafe. The device's completion handlers must not
+/// run concurrently (e.g. by using a single-threaded io_context).
+template <typename RandomAccessReadDevice,
+          typename Allocator = std::allocator<uint8_t>>
+class prefetching_file_reader
+{
+public:
+  /// The type of the executor associated with the object.
+  typedef typename RandomAccessReadDevice::executor_type executor_type;
+
+  /// @brief Construct a reader for the whole file.
+  ///
+  /// No reads are started until @ref async_next is called.
+  explicit prefetching_file_reader(RandomAccessReadDevice& device,
+                                   const prefetch_options& options =
+                                       prefetch_options(),
+                                   const Allocator& allocator = Allocator());
+
+  /// @brief Construct a reader for a range of the file.
+  ///
+  /// @param device The file to read.
+  ///
+  /// @param offset The offset of the first byte to read.
+  ///
+  /// @param length The number of bytes to read. Reading stops earlier if
+  /// the end of the file is reached.
+  ///
+  /// @param options The chunk size and depth limits.
+  ///
+  /// @param allocator The allocator for the chunk buffers.
+  prefetching_file_reader(RandomAccessReadDevice& device,
+                          uint64_t offset, uint64_t length,
+                          const prefetch_options& options =
+                              prefetch_options(),
+                          const Allocator& allocator = Allocator());
+
+  prefetching_file_reader(const prefetching_file_reader&) = delete;
+  prefetching_file_reader& operator=(const prefetching_file_reader&) = delete;
+
+  /// Get the executor associated with the object.
+  executor_type get_executor() ASIOEXT_NOEXCEPT
+  {
+    return device_.get_executor();
+  }
+
+  /// @brief Get the number of reads currently in flight.
+  std::size_t in_flight() const ASIOEXT_NOEXCEPT
+  {
+    return in_flight_;
+  }
+
+  /// @brief Get the number of reads the reader currently aims to keep
+  /// in flight.
+  std::size_t depth() const ASIOEXT_NOEXCEPT
+  {
+    return depth_;
+  }
+
+  /// @brief Asynchronously get the next chunk of the file.
+  ///
+  /// This function releases the chunk returned by the previous call, and
+  /// starts as many reads as the current depth allows.
+  ///
+  /// @param handler The handler to be called when the next chunk is
+  /// available. The function signature of the handler must be:
+  /// @code void handler(
+  ///   const error_code& error, // Result of operation.
+  ///   asio::const_buffer chunk // The data following the last chunk.
+  /// ); @endcode
+  /// The chunk remains valid until the next call to this function.
+  /// Only the last chunk can be shorter than @c chunk_size. Once all data has
+  /// been read, the handler receives @c asio::error::eof and an empty chunk.
+  /// Regardless of whether the asynchronous operation completes immediately or
+  /// not, the handler will not be invoked from within this function. Invocation
+  /// of the handler will be performed in a manner equivalent to using
+  /// asio::io_context::post().
+  ///
+  /// @warning Starting multiple @c async_next operations is not allowed.
+  template <typename ChunkHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(ChunkHandler,
+                             void (error_code, asio::const_buffer))
+  async_next(ChunkHandler&& handler);
+
+private:
+  typedef std::chrono::steady_clock clock;
+
+  struct slot
+  {
+    explicit slot(const Allocator& allocator)
+      : data(allocator)
+    {}
+
+    std::vector<uint8_t, Allocator> data;
+    std::size_t size = 0;
+    error_code ec;
+    bool done = false;
+    clock::time_point started;
+  };
+
+  // Starts reads until |depth_| are in flight (or unconsumed).
+  void start_reads();
+  void on_read(std::size_t index, error_code ec, std::size_t size);
+
+  // Hands the chunk at |head_| to the consumer.
+  asio::const_buffer take_head(error_code& ec);
+
+  void update_depth();
+
+  RandomAccessReadDevice& device_;
+  prefetch_options options_;
+
+  std::vector<slot> slots_;
+  // The ring of slots in use starts at |head_|. It contains |count_| slots,
+  // including one that's being processed by the consumer if |holding_|.
+  std::size_t head_ = 0;
+  std::size_t count_ = 0;
+  bool holding_ = false;
+  std::size_t in_flight_ = 0;
+
+  uint64_t next_offset_;
+  uint64_t end_;
+  // Set once a read hit the end of the file or failed.
+  bool stopped_ = false;
+
+  std::size_t depth_;
+  // Smoothed read latency and time the consumer spent per chunk.
+  double read_latency_ = 0.0;
+  double consume_time_ = 0.0;
+  clock::time_point handed_out_;
+
+  // Never expires. async_next() waits on this for the next chunk, reads
+  // completing the head slot cancel it.
+  asio::steady_timer chunk_wait_;
+  bool waiting_ = false;
+};
+
+ASIOEXT_NS_END
+
+#include "asioext/impl/prefetching_file_reader.hpp"
+
+#endif
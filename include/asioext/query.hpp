@@ -0,0 +1,112 @@
+/// @file
+/// Declares the path-based query() functions.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_QUERY_HPP
+#define ASIOEXT_QUERY_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include "asioext/file_info.hpp"
+#include "asioext/error_code.hpp"
+
+#if defined(ASIOEXT_HAS_BOOST_FILESYSTEM) || defined(ASIOEXT_IS_DOCUMENTATION)
+# include <boost/filesystem/path.hpp>
+#endif
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup files_meta
+/// @defgroup query asioext::query()
+/// @brief Get a snapshot of a file's metadata without opening it.
+///
+/// These functions are the path-based equivalent of
+/// file_handle::query(). Symbolic links are followed.
+///
+/// @{
+
+/// @brief Get a snapshot of a file's metadata.
+///
+/// This function retrieves the metadata selected by @c mask. On Linux this
+/// is a single `statx()` call, so unlike open() followed by
+/// file_handle::query() no file descriptor is created.
+///
+/// @param filename The path of the file.
+/// See @ref filenames for details.
+///
+/// @param mask The members of @c file_info to retrieve.
+/// Defaults to @ref file_info_mask::all.
+///
+/// @return The file's metadata. Members that weren't requested or aren't
+/// available for this file keep their default values.
+///
+/// @throws asio::system_error Thrown on failure.
+ASIOEXT_DECL file_info query(const char* filename,
+                             file_info_mask mask = file_info_mask::all);
+
+/// @brief Get a snapshot of a file's metadata.
+///
+/// This function retrieves the metadata selected by @c mask. On Linux this
+/// is a single `statx()` call, so unlike open() followed by
+/// file_handle::query() no file descriptor is created.
+///
+/// @param filename The path of the file.
+/// See @ref filenames for details.
+///
+/// @param mask The members of @c file_info to retrieve.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+///
+/// @return The file's metadata. Members that weren't requested or aren't
+/// available for this file keep their default values.
+ASIOEXT_DECL file_info query(const char* filename, file_info_mask mask,
+                             error_code& ec) ASIOEXT_NOEXCEPT;
+
+#if defined(ASIOEXT_WINDOWS) || defined(ASIOEXT_IS_DOCUMENTATION)
+/// @copydoc query(const char*,file_info_mask)
+///
+/// @note Only available on Windows.
+ASIOEXT_DECL file_info query(const wchar_t* filename,
+                             file_info_mask mask = file_info_mask::all);
+
+/// @copydoc query(const char*,file_info_mask,error_code&)
+///
+/// @note Only available on Windows.
+ASIOEXT_DECL file_info query(const wchar_t* filename, file_info_mask mask,
+                             error_code& ec) ASIOEXT_NOEXCEPT;
+#endif
+
+#if defined(ASIOEXT_HAS_BOOST_FILESYSTEM) || defined(ASIOEXT_IS_DOCUMENTATION)
+/// @copydoc query(const char*,file_info_mask)
+///
+/// @note Only available if using Boost.Filesystem
+/// (i.e. if @c ASIOEXT_HAS_BOOST_FILESYSTEM is defined)
+ASIOEXT_DECL file_info query(const boost::filesystem::path& filename,
+                             file_info_mask mask = file_info_mask::all);
+
+/// @copydoc query(const char*,file_info_mask,error_code&)
+///
+/// @note Only available if using Boost.Filesystem
+/// (i.e. if @c ASIOEXT_HAS_BOOST_FILESYSTEM is defined)
+ASIOEXT_DECL file_info query(const boost::filesystem::path& filename,
+                             file_info_mask mask,
+                             error_code& ec) ASIOEXT_NOEXCEPT;
+#endif
+
+/// @}
+
+ASIOEXT_NS_END
+
+#if defined(ASIOEXT_HEADER_ONLY)
+# include "asioext/impl/query.cpp"
+#endif
+
+#endif
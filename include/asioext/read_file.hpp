@@ -16,6 +16,7 @@
 #endif
 
 #include "asioext/is_raw_byte_container.hpp"
+#include "asioext/is_hasher.hpp"
 #include "asioext/error_code.hpp"
 
 #include "asioext/detail/asio_version.hpp"
@@ -156,6 +157,149 @@ ASIOEXT_DETAIL_RF_RAW_RET(RawByteContainer)
 
 /// @}
 
+/// @name RawByteContainer overloads with checksum computation
+/// These overloads additionally feed the file's contents to a
+/// @ref concept-Hasher (e.g. @ref crc32c_hasher) while reading.
+/// The file is read in chunks and each chunk is hashed right after it
+/// arrived, while it is still in the CPU cache. This saves a second pass
+/// over the data.
+/// @{
+
+#if !defined(ASIOEXT_IS_DOCUMENTATION)
+# define ASIOEXT_DETAIL_RF_HASH_RET(T, H) \
+    typename std::enable_if<is_raw_byte_container<T>::value && \
+                            is_hasher<H>::value>::type
+#else
+# define ASIOEXT_DETAIL_RF_HASH_RET(T, H) void
+#endif
+
+/// Read a file into a container and compute its checksum.
+///
+/// This function loads the contents of @c filename into @c c and
+/// passes them to @c hasher.
+///
+/// @param filename The path of the file to load.
+///
+/// @param c The container object which shall contain the file's
+/// content. The container is resized to the file's size and any previous
+/// data is overwritten. The container type must satisfy the
+///  @ref concept-RawByteContainer requirements.
+///
+/// @param hasher The hasher that is updated with the file's content.
+/// The type must satisfy the @ref concept-Hasher requirements.
+///
+/// @throws asio::system_error Thrown on failure.
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(const char* filename, RawByteContainer& c, Hasher& hasher);
+
+/// Read a file into a container and compute its checksum.
+///
+/// This function loads the contents of @c filename into @c c and
+/// passes them to @c hasher.
+///
+/// @param filename The path of the file to load.
+///
+/// @param c The container object which shall contain the file's
+/// content. The container is resized to the file's size and any previous
+/// data is overwritten. The container type must satisfy the
+///  @ref concept-RawByteContainer requirements.
+///
+/// @param hasher The hasher that is updated with the file's content.
+/// The type must satisfy the @ref concept-Hasher requirements.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(const char* filename, RawByteContainer& c, Hasher& hasher,
+              error_code& ec);
+
+#if defined(ASIOEXT_WINDOWS)  || defined(ASIOEXT_IS_DOCUMENTATION)
+/// @copydoc read_file(const char*,RawByteContainer&,Hasher&)
+///
+/// @note Only available on Windows.
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(const wchar_t* filename, RawByteContainer& c, Hasher& hasher);
+
+/// @copydoc read_file(const char*,RawByteContainer&,Hasher&,error_code&)
+///
+/// @note Only available on Windows.
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(const wchar_t* filename, RawByteContainer& c, Hasher& hasher,
+              error_code& ec);
+#endif
+
+#if defined(ASIOEXT_HAS_BOOST_FILESYSTEM) || defined(ASIOEXT_IS_DOCUMENTATION)
+/// @copydoc read_file(const char*,RawByteContainer&,Hasher&)
+///
+/// @note Only available if using Boost.Filesystem
+/// (i.e. if @c ASIOEXT_HAS_BOOST_FILESYSTEM is defined)
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(const boost::filesystem::path& filename, RawByteContainer& c,
+              Hasher& hasher);
+
+/// @copydoc read_file(const char*,RawByteContainer&,Hasher&,error_code&)
+///
+/// @note Only available if using Boost.Filesystem
+/// (i.e. if @c ASIOEXT_HAS_BOOST_FILESYSTEM is defined)
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(const boost::filesystem::path& filename, RawByteContainer& c,
+              Hasher& hasher, error_code& ec);
+#endif
+
+/// Read a file into a container and compute its checksum.
+///
+/// This function loads the contents of @c file into @c c and
+/// passes them to @c hasher.
+///
+/// @param file The file_handle object to read from.
+/// The file_handle's file pointer is expected to point at the beginning
+/// of the file. Upon completion, the file pointer points at the end.
+///
+/// @param c The container object which shall contain the file's
+/// content. The container is resized to the file's size and any previous
+/// data is overwritten. The container type must satisfy the
+///  @ref concept-RawByteContainer requirements.
+///
+/// @param hasher The hasher that is updated with the file's content.
+/// The type must satisfy the @ref concept-Hasher requirements.
+///
+/// @throws asio::system_error Thrown on failure.
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(file_handle file, RawByteContainer& c, Hasher& hasher);
+
+/// Read a file into a container and compute its checksum.
+///
+/// This function loads the contents of @c file into @c c and
+/// passes them to @c hasher.
+///
+/// @param file The file_handle object to read from.
+/// The file_handle's file pointer is expected to point at the beginning
+/// of the file. Upon completion, the file pointer points at the end.
+///
+/// @param c The container object which shall contain the file's
+/// content. The container is resized to the file's size and any previous
+/// data is overwritten. The container type must satisfy the
+///  @ref concept-RawByteContainer requirements.
+///
+/// @param hasher The hasher that is updated with the file's content.
+/// The type must satisfy the @ref concept-Hasher requirements.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+template <class RawByteContainer, class Hasher>
+ASIOEXT_DETAIL_RF_HASH_RET(RawByteContainer, Hasher)
+    read_file(file_handle file, RawByteContainer& c, Hasher& hasher,
+              error_code& ec);
+
+/// @}
+
 /// @name MutableBufferSequence overloads
 /// @{
 
@@ -283,6 +427,110 @@ ASIOEXT_DETAIL_RF_BUF_RET(MutableBufferSequence)
 
 /// @}
 
+/// @name basic_chained_buffer overloads
+/// These overloads read the file straight into the segments of a
+/// @ref basic_chained_buffer, using scatter I/O where available. Large files
+/// therefore don't need a single contiguous block of memory.
+/// @{
+
+template <typename Allocator>
+class basic_chained_buffer;
+
+/// Read a file into a chained buffer.
+///
+/// This function loads the contents of @c filename into @c c.
+///
+/// @param filename The path of the file to load.
+///
+/// @param c The buffer which shall contain the file's content. The buffer is
+/// resized to the file's size and any previous data is overwritten.
+///
+/// @throws asio::system_error Thrown on failure.
+template <typename Allocator>
+void read_file(const char* filename, basic_chained_buffer<Allocator>& c);
+
+/// Read a file into a chained buffer.
+///
+/// This function loads the contents of @c filename into @c c.
+///
+/// @param filename The path of the file to load.
+///
+/// @param c The buffer which shall contain the file's content. The buffer is
+/// resized to the file's size and any previous data is overwritten.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+template <typename Allocator>
+void read_file(const char* filename, basic_chained_buffer<Allocator>& c,
+               error_code& ec);
+
+#if defined(ASIOEXT_WINDOWS)  || defined(ASIOEXT_IS_DOCUMENTATION)
+/// @copydoc read_file(const char*,basic_chained_buffer<Allocator>&)
+///
+/// @note Only available on Windows.
+template <typename Allocator>
+void read_file(const wchar_t* filename, basic_chained_buffer<Allocator>& c);
+
+/// @copydoc read_file(const char*,basic_chained_buffer<Allocator>&,error_code&)
+///
+/// @note Only available on Windows.
+template <typename Allocator>
+void read_file(const wchar_t* filename, basic_chained_buffer<Allocator>& c,
+               error_code& ec);
+#endif
+
+#if defined(ASIOEXT_HAS_BOOST_FILESYSTEM) || defined(ASIOEXT_IS_DOCUMENTATION)
+/// @copydoc read_file(const char*,basic_chained_buffer<Allocator>&)
+///
+/// @note Only available if using Boost.Filesystem
+/// (i.e. if @c ASIOEXT_HAS_BOOST_FILESYSTEM is defined)
+template <typename Allocator>
+void read_file(const boost::filesystem::path& filename,
+               basic_chained_buffer<Allocator>& c);
+
+/// @copydoc read_file(const char*,basic_chained_buffer<Allocator>&,error_code&)
+///
+/// @note Only available if using Boost.Filesystem
+/// (i.e. if @c ASIOEXT_HAS_BOOST_FILESYSTEM is defined)
+template <typename Allocator>
+void read_file(const boost::filesystem::path& filename,
+               basic_chained_buffer<Allocator>& c, error_code& ec);
+#endif
+
+/// Read a file into a chained buffer.
+///
+/// This function loads the contents of @c file into @c c.
+///
+/// @param file The file_handle object to read from.
+/// The file_handle's file pointer is expected to point at the beginning
+/// of the file. Upon completion, the file pointer points at the end.
+///
+/// @param c The buffer which shall contain the file's content. The buffer is
+/// resized to the file's size and any previous data is overwritten.
+///
+/// @throws asio::system_error Thrown on failure.
+template <typename Allocator>
+void read_file(file_handle file, basic_chained_buffer<Allocator>& c);
+
+/// Read a file into a chained buffer.
+///
+/// This function loads the contents of @c file into @c c.
+///
+/// @param file The file_handle object to read from.
+/// The file_handle's file pointer is expected to point at the beginning
+/// of the file. Upon completion, the file pointer points at the end.
+///
+/// @param c The buffer which shall contain the file's content. The buffer is
+/// resized to the file's size and any previous data is overwritten.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+template <typename Allocator>
+void read_file(file_handle file, basic_chained_buffer<Allocator>& c,
+               error_code& ec);
+
+/// @}
+
 // TODO(tim): Add support for asio's dynamic buffers,
 // once they are released.
 
@@ -0,0 +1,126 @@
+/// @file
+/// Declares the asioext::read_files and asioext::async_read_files functions.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_READFILES_HPP
+#define ASIOEXT_READFILES_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/read_file.hpp"
+#include "asioext/thread_pool_file_service.hpp"
+#include "asioext/async_result.hpp"
+#include "asioext/error_code.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/io_context.hpp>
+#else
+# include <asio/io_context.hpp>
+#endif
+
+#include <vector>
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup files
+/// @defgroup read_files asioext::read_files()
+/// Reads the entire contents of multiple files into memory.
+///
+/// Opening, querying the size of, reading and closing a file are all
+/// blocking operations, so loading many small files one after another
+/// spends most of its time waiting for the kernel. These functions hand
+/// every file to the thread-pool of the io_context's
+/// @ref thread_pool_file_service, which performs the complete
+/// open/stat/read/close sequence of different files concurrently.
+///
+/// The amount of overlap is bounded by the number of threads in the
+/// service's pool. A service with a single thread (the default) gains
+/// nothing over a simple loop calling @ref read_file.
+///
+/// Elements of @c filenames can be of any type accepted by
+/// @ref read_file, or @c std::string.
+/// Elements of @c containers must satisfy the
+/// @ref concept-RawByteContainer requirements.
+///
+///@{
+
+/// Read multiple files into containers.
+///
+/// This function loads the contents of each file named in @c filenames
+/// into the corresponding element of @c containers and blocks until all
+/// files have been processed.
+///
+/// @param context The io_context whose @ref thread_pool_file_service
+/// shall perform the reads. The io_context doesn't need to be running.
+///
+/// @param filenames A range of file paths to load.
+///
+/// @param containers A range of containers, one for each file.
+/// The containers are resized to their file's size and any previous data is
+/// overwritten. If there are fewer containers than files, the excess files
+/// fail with @c asio::error::invalid_argument.
+///
+/// @returns One error code for each element of @c filenames, in the same
+/// order.
+///
+/// @note This function must not be called from one of the service's
+/// thread-pool threads.
+template <class FilenameRange, class RawByteContainerRange>
+std::vector<error_code> read_files(asio::io_context& context,
+                                   const FilenameRange& filenames,
+                                   RawByteContainerRange& containers);
+
+/// Start an asynchronous operation to read multiple files into containers.
+///
+/// This function loads the contents of each file named in @c filenames
+/// into the corresponding element of @c containers. It always returns
+/// immediately.
+///
+/// @param context The io_context whose @ref thread_pool_file_service
+/// shall perform the reads.
+///
+/// @param filenames A range of file paths to load. The range and its
+/// elements must remain valid until the handler is called.
+///
+/// @param containers A range of containers, one for each file.
+/// The containers are resized to their file's size and any previous data is
+/// overwritten. If there are fewer containers than files, the excess files
+/// fail with @c asio::error::invalid_argument. The range and its elements
+/// must remain valid until the handler is called.
+///
+/// @param token The completion token that will be used to produce a
+/// completion handler, which will be called when the read completes.
+/// The function signature of the completion handler must be:
+/// @code
+/// void handler(
+///   std::vector<error_code> errors // One error code for each element of
+///                                  // filenames, in the same order.
+/// );
+/// @endcode
+/// Regardless of whether the asynchronous operation completes immediately
+/// or not, the handler will not be invoked from within this function.
+/// Invocation of the handler will be performed in a manner equivalent to
+/// using @c asio::post().
+template <class FilenameRange, class RawByteContainerRange,
+          class CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(std::vector<error_code>))
+async_read_files(asio::io_context& context,
+                 const FilenameRange& filenames,
+                 RawByteContainerRange& containers,
+                 CompletionToken&& token);
+
+///@}
+
+ASIOEXT_NS_END
+
+#include "asioext/impl/read_files.hpp"
+
+#endif
@@ -0,0 +1,55 @@
+/// @file
+/// Defines the resolve_flags enum.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_RESOLVEFLAGS_HPP
+#define ASIOEXT_RESOLVEFLAGS_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#include "asioext/detail/enum.hpp"
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup files_handle
+/// @brief Restrict how a path relative to a directory_handle is resolved.
+///
+/// These flags correspond to the Linux `openat2()` @c RESOLVE_* flags.
+/// If any of them is requested on a system without `openat2()`,
+/// the operation fails with @c asio::error::operation_not_supported
+/// instead of silently resolving the path without the restriction.
+enum class resolve_flags
+{
+  /// Resolve the path the usual way.
+  none = 0,
+
+  /// Fail if the path (including symlinks and <code>..</code> components)
+  /// would escape the directory it is relative to.
+  beneath = 1 << 0,
+
+  /// Treat the directory as the root directory while resolving the path.
+  /// Absolute symlinks and <code>..</code> components can't escape it.
+  in_root = 1 << 1,
+
+  /// Fail if the path contains any symlinks.
+  no_symlinks = 1 << 2,
+
+  /// Fail if the path contains any "magic links" (e.g. <code>/proc/self/fd/N</code>).
+  no_magic_links = 1 << 3,
+
+  /// Fail if the path crosses a mount point.
+  no_cross_device = 1 << 4,
+};
+
+ASIOEXT_ENUM_CLASS_BITMASK_OPS(resolve_flags)
+
+ASIOEXT_NS_END
+
+#endif
@@ -0,0 +1,366 @@
+/// @file
+/// Declares zero-copy transfer functions based on Linux' @c splice(),
+/// @c tee() and @c vmsplice() system calls.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_SPLICE_HPP
+#define ASIOEXT_SPLICE_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/file_handle.hpp"
+#include "asioext/unique_file_handle.hpp"
+#include "asioext/async_result.hpp"
+#include "asioext/error_code.hpp"
+
+#include "asioext/detail/cstdint.hpp"
+
+#include <limits>
+
+#if defined(ASIOEXT_HAS_SPLICE) || defined(ASIOEXT_IS_DOCUMENTATION)
+
+ASIOEXT_NS_BEGIN
+
+/// @ingroup files
+/// @defgroup splice Zero-copy transfers
+/// Move data between files, pipes and sockets without copying it
+/// to user space.
+///
+/// The kernel's @c splice() requires one side of a transfer to be a pipe.
+/// The primitive functions (splice_some(), tee_some(), vmsplice_some())
+/// expose this directly, while the higher-level functions
+/// (splice_transfer(), splice_fanout() and their asynchronous versions)
+/// create intermediate pipes as necessary, so they work with arbitrary
+/// files, pipes and sockets.
+///
+/// To use an Asio socket with the synchronous functions, pass
+/// <code>file_handle(socket.native_handle())</code>.
+/// Descriptors in non-blocking mode are waited on using @c poll().
+///
+/// @note Only available on Linux.
+///
+/// @{
+
+/// @brief Create an anonymous pipe.
+///
+/// @param read_end Receives the pipe's read end.
+///
+/// @param write_end Receives the pipe's write end.
+///
+/// @throws asio::system_error Thrown on failure.
+ASIOEXT_DECL void make_pipe(unique_file_handle& read_end,
+                            unique_file_handle& write_end);
+
+/// @brief Create an anonymous pipe.
+///
+/// @param read_end Receives the pipe's read end.
+///
+/// @param write_end Receives the pipe's write end.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+ASIOEXT_DECL void make_pipe(unique_file_handle& read_end,
+                            unique_file_handle& write_end,
+                            error_code& ec) ASIOEXT_NOEXCEPT;
+
+/// @brief Move some data from @c in to @c out.
+///
+/// This function performs a single @c splice() call.
+/// At least one of @c in and @c out needs to be a pipe.
+///
+/// @param in The handle to read from. If it isn't a pipe, reading starts at
+/// the current file pointer.
+///
+/// @param out The handle to write to. If it isn't a pipe, writing starts at
+/// the current file pointer.
+///
+/// @param max_size The maximum number of bytes to move.
+///
+/// @return The number of bytes moved.
+///
+/// @throws asio::system_error Thrown on failure. An error code of
+/// asio::error::eof indicates that @c in has no more data.
+ASIOEXT_DECL std::size_t splice_some(file_handle in, file_handle out,
+                                     std::size_t max_size);
+
+/// @brief Move some data from @c in to @c out.
+///
+/// This function performs a single @c splice() call.
+/// At least one of @c in and @c out needs to be a pipe.
+///
+/// @param in The handle to read from. If it isn't a pipe, reading starts at
+/// the current file pointer.
+///
+/// @param out The handle to write to. If it isn't a pipe, writing starts at
+/// the current file pointer.
+///
+/// @param max_size The maximum number of bytes to move.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset. asio::error::eof indicates that @c in has no
+/// more data.
+///
+/// @return The number of bytes moved.
+ASIOEXT_DECL std::size_t splice_some(file_handle in, file_handle out,
+                                     std::size_t max_size,
+                                     error_code& ec) ASIOEXT_NOEXCEPT;
+
+/// @brief Duplicate some data from one pipe to another.
+///
+/// This function performs a single @c tee() call. The data remains
+/// in @c in and can be read (or spliced) again.
+///
+/// @param in The pipe to duplicate data from.
+///
+/// @param out The pipe to duplicate data to.
+///
+/// @param max_size The maximum number of bytes to duplicate.
+///
+/// @return The number of bytes duplicated.
+///
+/// @throws asio::system_error Thrown on failure. An error code of
+/// asio::error::eof indicates that @c in has no more data.
+ASIOEXT_DECL std::size_t tee_some(file_handle in, file_handle out,
+                                  std::size_t max_size);
+
+/// @brief Duplicate some data from one pipe to another.
+///
+/// This function performs a single @c tee() call. The data remains
+/// in @c in and can be read (or spliced) again.
+///
+/// @param in The pipe to duplicate data from.
+///
+/// @param out The pipe to duplicate data to.
+///
+/// @param max_size The maximum number of bytes to duplicate.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset. asio::error::eof indicates that @c in has no
+/// more data.
+///
+/// @return The number of bytes duplicated.
+ASIOEXT_DECL std::size_t tee_some(file_handle in, file_handle out,
+                                  std::size_t max_size,
+                                  error_code& ec) ASIOEXT_NOEXCEPT;
+
+/// @brief Map user memory into a pipe.
+///
+/// This function performs a single @c vmsplice() call, which makes the
+/// pipe reference the given buffers' pages instead of copying them.
+///
+/// @warning The buffers must not be modified until all of their data has
+/// been consumed from the pipe.
+///
+/// @param pipe The pipe's write end.
+///
+/// @param buffers The data to add to the pipe.
+///
+/// @return The number of bytes added to the pipe.
+///
+/// @throws asio::system_error Thrown on failure.
+template <typename ConstBufferSequence>
+std::size_t vmsplice_some(file_handle pipe,
+                          const ConstBufferSequence& buffers);
+
+/// @brief Map user memory into a pipe.
+///
+/// This function performs a single @c vmsplice() call, which makes the
+/// pipe reference the given buffers' pages instead of copying them.
+///
+/// @warning The buffers must not be modified until all of their data has
+/// been consumed from the pipe.
+///
+/// @param pipe The pipe's write end.
+///
+/// @param buffers The data to add to the pipe.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+///
+/// @return The number of bytes added to the pipe.
+template <typename ConstBufferSequence>
+std::size_t vmsplice_some(file_handle pipe,
+                          const ConstBufferSequence& buffers,
+                          error_code& ec) ASIOEXT_NOEXCEPT;
+
+/// @brief Move data from @c in to @c out until @c in reports EOF.
+///
+/// Neither handle has to be a pipe, an intermediate pipe is used if
+/// necessary.
+///
+/// @param in The handle to read from.
+///
+/// @param out The handle to write to.
+///
+/// @param max_size The maximum number of bytes to move.
+///
+/// @return The number of bytes moved.
+///
+/// @throws asio::system_error Thrown on failure.
+ASIOEXT_DECL uint64_t splice_transfer(
+    file_handle in, file_handle out,
+    uint64_t max_size = (std::numeric_limits<uint64_t>::max)());
+
+/// @brief Move data from @c in to @c out until @c in reports EOF.
+///
+/// Neither handle has to be a pipe, an intermediate pipe is used if
+/// necessary.
+///
+/// @param in The handle to read from.
+///
+/// @param out The handle to write to.
+///
+/// @param max_size The maximum number of bytes to move.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+///
+/// @return The number of bytes moved.
+ASIOEXT_DECL uint64_t splice_transfer(file_handle in, file_handle out,
+                                      uint64_t max_size,
+                                      error_code& ec) ASIOEXT_NOEXCEPT;
+
+/// @brief Copy everything from @c source to multiple destinations.
+///
+/// Data is read from @c source until it reports EOF. If @c source is a
+/// pipe, its data is duplicated using @c tee(), otherwise it is moved
+/// into a pipe first. No data is copied to user space.
+///
+/// @param source The handle to read from.
+///
+/// @param destinations A range of handles to write to. Its elements can be
+/// @ref file_handle or @ref unique_file_handle objects or anything else
+/// that provides a @c native_handle() member function.
+/// Destinations are written to in blocking mode.
+///
+/// @return The number of bytes read from @c source.
+///
+/// @throws asio::system_error Thrown on failure.
+template <typename HandleRange>
+uint64_t splice_fanout(file_handle source, HandleRange&& destinations);
+
+/// @brief Copy everything from @c source to multiple destinations.
+///
+/// Data is read from @c source until it reports EOF. If @c source is a
+/// pipe, its data is duplicated using @c tee(), otherwise it is moved
+/// into a pipe first. No data is copied to user space.
+///
+/// @param source The handle to read from.
+///
+/// @param destinations A range of handles to write to. Its elements can be
+/// @ref file_handle or @ref unique_file_handle objects or anything else
+/// that provides a @c native_handle() member function.
+/// Destinations are written to in blocking mode.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+///
+/// @return The number of bytes read from @c source. On failure, this
+/// includes data that didn't reach all destinations, so if it's 0, nothing
+/// has been consumed from @c source.
+template <typename HandleRange>
+uint64_t splice_fanout(file_handle source, HandleRange&& destinations,
+                       error_code& ec);
+
+/// @brief Start an asynchronous transfer from a stream to a file.
+///
+/// This function moves data from @c stream to @c out until @c max_size
+/// bytes have been moved or @c stream reports EOF. @c stream is put into
+/// non-blocking mode and waited on using its @c async_wait() function.
+///
+/// Writing to @c out blocks the thread running the io_context. This is
+/// fine for local files and pipes that are drained quickly.
+///
+/// @param stream The stream to read from, e.g. an @c asio::ip::tcp::socket
+/// or an @c asio::posix::stream_descriptor.
+///
+/// @param out The handle to write to.
+///
+/// @param max_size The maximum number of bytes to move.
+///
+/// @param handler The handler to be called when the operation completes.
+/// Copies will be made of the handler as required. The function signature of
+/// the handler must be:
+/// @code void handler(
+///   const error_code& error, // Result of operation.
+///   uint64_t bytes_transferred // Number of bytes moved.
+/// ); @endcode
+template <typename Stream, typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code, uint64_t))
+async_splice_read(Stream& stream, file_handle out, uint64_t max_size,
+                  CompletionToken&& handler);
+
+/// @brief Start an asynchronous transfer from a file to a stream.
+///
+/// This function moves data from @c in to @c stream until @c max_size
+/// bytes have been moved or @c in reports EOF. @c stream is put into
+/// non-blocking mode and waited on using its @c async_wait() function.
+///
+/// Reading from @c in blocks the thread running the io_context. This is
+/// fine for local files and pipes that are filled quickly.
+///
+/// @param stream The stream to write to, e.g. an @c asio::ip::tcp::socket
+/// or an @c asio::posix::stream_descriptor.
+///
+/// @param in The handle to read from.
+///
+/// @param max_size The maximum number of bytes to move.
+///
+/// @param handler The handler to be called when the operation completes.
+/// Copies will be made of the handler as required. The function signature of
+/// the handler must be:
+/// @code void handler(
+///   const error_code& error, // Result of operation.
+///   uint64_t bytes_transferred // Number of bytes moved.
+/// ); @endcode
+template <typename Stream, typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code, uint64_t))
+async_splice_write(Stream& stream, file_handle in, uint64_t max_size,
+                   CompletionToken&& handler);
+
+/// @brief Start an asynchronous operation to copy everything from
+/// @c source to multiple destinations.
+///
+/// This is the asynchronous version of splice_fanout(). @c source is put
+/// into non-blocking mode and waited on using its @c async_wait() function,
+/// while the destinations are written to in blocking mode.
+///
+/// @param source The stream to read from, e.g. an
+/// @c asio::posix::stream_descriptor wrapping a pipe.
+///
+/// @param destinations A range of handles to write to.
+/// See splice_fanout() for details.
+///
+/// @param handler The handler to be called when the operation completes.
+/// Copies will be made of the handler as required. The function signature of
+/// the handler must be:
+/// @code void handler(
+///   const error_code& error, // Result of operation.
+///   uint64_t bytes_transferred // Number of bytes read from source.
+/// ); @endcode
+template <typename Stream, typename HandleRange, typename CompletionToken>
+ASIOEXT_INITFN_RESULT_TYPE(CompletionToken, void(error_code, uint64_t))
+async_splice_fanout(Stream& source, HandleRange&& destinations,
+                    CompletionToken&& handler);
+
+/// @}
+
+ASIOEXT_NS_END
+
+#include "asioext/impl/splice.hpp"
+
+#if defined(ASIOEXT_HEADER_ONLY)
+# include "asioext/impl/splice.cpp"
+#endif
+
+#endif
+
+#endif
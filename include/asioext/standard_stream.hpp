@@ -0,0 +1,471 @@
+/// @file
+/// Defines the basic_standard_stream class.
+///
+/// @copyright Copyright (c) 2024 Tim Niederhausen (tim@rnc-ag.de)
+/// Distributed under the Boost Software License, Version 1.0.
+/// (See accompanying file LICENSE_1_0.txt or copy at
+/// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef ASIOEXT_STANDARDSTREAM_HPP
+#define ASIOEXT_STANDARDSTREAM_HPP
+
+#include "asioext/detail/config.hpp"
+
+#if ASIOEXT_HAS_PRAGMA_ONCE
+# pragma once
+#endif
+
+#include "asioext/basic_file.hpp"
+#include "asioext/thread_pool_file_service.hpp"
+#include "asioext/standard_streams.hpp"
+#include "asioext/unique_file_handle.hpp"
+#include "asioext/duplicate.hpp"
+#include "asioext/execution_context.hpp"
+#include "asioext/async_result.hpp"
+#include "asioext/error_code.hpp"
+
+#include "asioext/detail/throw_error.hpp"
+
+#if !defined(ASIOEXT_WINDOWS)
+# if defined(ASIOEXT_USE_BOOST_ASIO)
+#  include <boost/asio/posix/stream_descriptor.hpp>
+# else
+#  include <asio/posix/stream_descriptor.hpp>
+# endif
+#endif
+
+#include <utility>
+
+ASIOEXT_NS_BEGIN
+
+namespace detail {
+
+// Returns true if |handle| can be monitored by the platform's reactor
+// (pipes, terminals and sockets), false for regular files and
+// anything else that would need a thread.
+ASIOEXT_DECL bool is_reactor_compatible(file_handle handle,
+                                        error_code& ec) ASIOEXT_NOEXCEPT;
+
+}
+
+/// @ingroup stdhandles
+/// @brief Asynchronous stream on top of a standard handle.
+///
+/// This class provides asynchronous I/O on @c stdin, @c stdout or
+/// @c stderr (or any other stream-like handle), picking the cheapest
+/// mechanism available for the kind of file behind it:
+///
+/// * Pipes, terminals and sockets are handled by an
+///   @c asio::posix::stream_descriptor, so operations are driven by the
+///   io_context's reactor without involving any additional threads.
+/// * Everything else (e.g. a regular file the shell redirected to
+///   @c stdin) uses a @ref basic_file with the given FileService.
+///
+/// Which one was chosen can be checked with @ref is_reactive().
+///
+/// The handle passed to the constructor is duplicated, so closing the
+/// stream doesn't close the standard handle itself.
+///
+/// basic_standard_stream models the following asio concepts:
+/// * SyncReadStream
+/// * SyncWriteStream
+/// * AsyncReadStream
+/// * AsyncWriteStream
+///
+/// @par Example:
+/// @code
+/// asio::io_context io_context;
+/// asioext::standard_stream input(io_context, asioext::get_stdin());
+/// input.async_read_some(asio::buffer(data), handler);
+/// @endcode
+///
+/// @warning In reactive mode, the descriptor is switched to non-blocking
+/// mode. This flag is shared with all other handles to the same open file
+/// description (including the original standard handle and possibly
+/// other processes), so plain blocking I/O on it might fail with
+/// @c EAGAIN until the stream is closed.
+///
+/// @note On Windows, the FileService is always used.
+///
+/// @par Thread Safety:
+/// @e Distinct @e objects: Safe.@n
+/// @e Shared @e objects: Unsafe.
+template <typename FileService = thread_pool_file_service,
+          typename Executor = asio::any_io_executor>
+class basic_standard_stream
+{
+public:
+  /// The type of the executor associated with the object.
+  typedef Executor executor_type;
+
+  /// The type of the file used for handles that the reactor can't handle.
+  typedef basic_file<FileService, Executor> file_type;
+
+#if !defined(ASIOEXT_WINDOWS) || defined(ASIOEXT_IS_DOCUMENTATION)
+  /// The type of the descriptor used for pipes, terminals and sockets.
+  typedef asio::posix::basic_stream_descriptor<Executor> descriptor_type;
+#endif
+
+  /// @brief Construct an unopened stream.
+  ///
+  /// @param ex The I/O executor that the stream will use, by default, to
+  /// dispatch handlers for any asynchronous operations performed on it.
+  explicit basic_standard_stream(const executor_type& ex)
+    : file_(ex)
+#if !defined(ASIOEXT_WINDOWS)
+    , descriptor_(ex)
+#endif
+    , reactive_(false)
+  {
+    // ctor
+  }
+
+  /// @brief Construct an unopened stream.
+  ///
+  /// @param context An execution context which provides the I/O executor
+  /// that the stream will use, by default, to dispatch handlers for any
+  /// asynchronous operations performed on it.
+  template <execution_context ExecutionContext>
+  explicit basic_standard_stream(ExecutionContext& context)
+    : file_(context)
+#if !defined(ASIOEXT_WINDOWS)
+    , descriptor_(context)
+#endif
+    , reactive_(false)
+  {
+    // ctor
+  }
+
+  /// @brief Construct a stream for a standard handle.
+  ///
+  /// This constructor duplicates the given handle and picks the
+  /// implementation that suits its type.
+  ///
+  /// @param ex The I/O executor that the stream will use, by default, to
+  /// dispatch handlers for any asynchronous operations performed on it.
+  ///
+  /// @param standard_handle The handle to use, e.g. the result of
+  /// get_stdin(). Ownership is *not* transferred.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  basic_standard_stream(const executor_type& ex, file_handle standard_handle)
+    : file_(ex)
+#if !defined(ASIOEXT_WINDOWS)
+    , descriptor_(ex)
+#endif
+    , reactive_(false)
+  {
+    error_code ec;
+    assign(standard_handle, ec);
+    detail::throw_error(ec, "basic_standard_stream construct");
+  }
+
+  /// @brief Construct a stream for a standard handle.
+  ///
+  /// This constructor duplicates the given handle and picks the
+  /// implementation that suits its type.
+  ///
+  /// @param context An execution context which provides the I/O executor
+  /// that the stream will use, by default, to dispatch handlers for any
+  /// asynchronous operations performed on it.
+  ///
+  /// @param standard_handle The handle to use, e.g. the result of
+  /// get_stdin(). Ownership is *not* transferred.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  template <execution_context ExecutionContext>
+  basic_standard_stream(ExecutionContext& context,
+                        file_handle standard_handle)
+    : file_(context)
+#if !defined(ASIOEXT_WINDOWS)
+    , descriptor_(context)
+#endif
+    , reactive_(false)
+  {
+    error_code ec;
+    assign(standard_handle, ec);
+    detail::throw_error(ec, "basic_standard_stream construct");
+  }
+
+  /// Get the executor associated with the object.
+  const executor_type& get_executor() ASIOEXT_NOEXCEPT
+  {
+    return file_.get_executor();
+  }
+
+  /// @brief Assign a standard handle to this stream.
+  ///
+  /// This function duplicates the given handle and picks the
+  /// implementation that suits its type. An already open handle is
+  /// closed first.
+  ///
+  /// @param standard_handle The handle to use. Ownership is *not*
+  /// transferred.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  void assign(file_handle standard_handle, error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    close(ec);
+    if (ec)
+      return;
+
+    const bool reactive = detail::is_reactor_compatible(standard_handle, ec);
+    if (ec)
+      return;
+
+    unique_file_handle handle = duplicate(standard_handle, ec);
+    if (ec)
+      return;
+
+#if !defined(ASIOEXT_WINDOWS)
+    if (reactive) {
+      descriptor_.assign(handle.get().native_handle(), ec);
+      if (!ec) {
+        handle.release();
+        reactive_ = true;
+      }
+      return;
+    }
+#else
+    (void)reactive;
+#endif
+
+    file_.assign(handle.get(), ec);
+    if (!ec)
+      handle.release();
+  }
+
+  /// @brief Determine whether the reactor is used.
+  ///
+  /// @return @c true if the stream is driven by the io_context's reactor,
+  /// @c false if operations are performed by the FileService.
+  bool is_reactive() const ASIOEXT_NOEXCEPT
+  {
+    return reactive_;
+  }
+
+  /// @brief Determine whether the stream is open.
+  bool is_open() const ASIOEXT_NOEXCEPT
+  {
+#if !defined(ASIOEXT_WINDOWS)
+    if (reactive_)
+      return descriptor_.is_open();
+#endif
+    return file_.is_open();
+  }
+
+  /// @brief Close the stream.
+  ///
+  /// The standard handle this stream was created from stays open.
+  ///
+  /// @throws asio::system_error Thrown on failure.
+  void close()
+  {
+    error_code ec;
+    close(ec);
+    detail::throw_error(ec, "close");
+  }
+
+  /// @brief Close the stream.
+  ///
+  /// The standard handle this stream was created from stays open.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  void close(error_code& ec) ASIOEXT_NOEXCEPT
+  {
+#if !defined(ASIOEXT_WINDOWS)
+    if (reactive_) {
+      reactive_ = false;
+      descriptor_.close(ec);
+      return;
+    }
+#endif
+    if (file_.is_open())
+      file_.close(ec);
+    else
+      ec = error_code();
+  }
+
+  /// @brief Cancel all asynchronous operations associated with the stream.
+  ///
+  /// @param ec Set to indicate what error occurred. If no error occurred,
+  /// the object is reset.
+  void cancel(error_code& ec) ASIOEXT_NOEXCEPT
+  {
+#if !defined(ASIOEXT_WINDOWS)
+    if (reactive_) {
+      descriptor_.cancel(ec);
+      return;
+    }
+#endif
+    file_.cancel(ec);
+  }
+
+  /// @name SyncReadStream functions
+  /// @{
+
+  /// @brief Read some data from the stream.
+  ///
+  /// @see basic_file::read_some
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers)
+  {
+    error_code ec;
+    const std::size_t s = read_some(buffers, ec);
+    detail::throw_error(ec, "read_some");
+    return s;
+  }
+
+  /// @brief Read some data from the stream.
+  ///
+  /// @see basic_file::read_some
+  template <typename MutableBufferSequence>
+  std::size_t read_some(const MutableBufferSequence& buffers,
+                        error_code& ec) ASIOEXT_NOEXCEPT
+  {
+#if !defined(ASIOEXT_WINDOWS)
+    if (reactive_)
+      return descriptor_.read_some(buffers, ec);
+#endif
+    return file_.read_some(buffers, ec);
+  }
+
+  /// @}
+
+  /// @name SyncWriteStream functions
+  /// @{
+
+  /// @brief Write some data to the stream.
+  ///
+  /// @see basic_file::write_some
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers)
+  {
+    error_code ec;
+    const std::size_t s = write_some(buffers, ec);
+    detail::throw_error(ec, "write_some");
+    return s;
+  }
+
+  /// @brief Write some data to the stream.
+  ///
+  /// @see basic_file::write_some
+  template <typename ConstBufferSequence>
+  std::size_t write_some(const ConstBufferSequence& buffers,
+                         error_code& ec) ASIOEXT_NOEXCEPT
+  {
+#if !defined(ASIOEXT_WINDOWS)
+    if (reactive_)
+      return descriptor_.write_some(buffers, ec);
+#endif
+    return file_.write_some(buffers, ec);
+  }
+
+  /// @}
+
+  /// @name AsyncReadStream functions
+  /// @{
+
+  /// @brief Start an asynchronous read.
+  ///
+  /// The function signature of the handler must be:
+  /// @code
+  /// void handler(
+  ///   const asio::error_code& error, // Result of operation.
+  ///   std::size_t bytes_transferred // Number of bytes read.
+  /// );
+  /// @endcode
+  ///
+  /// @see basic_file::async_read_some
+  template <typename MutableBufferSequence, typename ReadHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(ReadHandler, void(error_code, std::size_t))
+  async_read_some(const MutableBufferSequence& buffers,
+                  ReadHandler&& handler)
+  {
+    return async_initiate<ReadHandler, void(error_code, std::size_t)>(
+        initiate_async_read_some(), handler, this, buffers);
+  }
+
+  /// @}
+
+  /// @name AsyncWriteStream functions
+  /// @{
+
+  /// @brief Start an asynchronous write.
+  ///
+  /// The function signature of the handler must be:
+  /// @code
+  /// void handler(
+  ///   const asio::error_code& error, // Result of operation.
+  ///   std::size_t bytes_transferred // Number of bytes written.
+  /// );
+  /// @endcode
+  ///
+  /// @see basic_file::async_write_some
+  template <typename ConstBufferSequence, typename WriteHandler>
+  ASIOEXT_INITFN_RESULT_TYPE(WriteHandler, void(error_code, std::size_t))
+  async_write_some(const ConstBufferSequence& buffers,
+                   WriteHandler&& handler)
+  {
+    return async_initiate<WriteHandler, void(error_code, std::size_t)>(
+        initiate_async_write_some(), handler, this, buffers);
+  }
+
+  /// @}
+
+private:
+  struct initiate_async_read_some
+  {
+    template <typename Handler, typename MutableBufferSequence>
+    void operator()(Handler&& handler, basic_standard_stream* self,
+                    const MutableBufferSequence& buffers) const
+    {
+#if !defined(ASIOEXT_WINDOWS)
+      if (self->reactive_) {
+        self->descriptor_.async_read_some(buffers,
+                                          std::forward<Handler>(handler));
+        return;
+      }
+#endif
+      self->file_.async_read_some(buffers, std::forward<Handler>(handler));
+    }
+  };
+
+  struct initiate_async_write_some
+  {
+    template <typename Handler, typename ConstBufferSequence>
+    void operator()(Handler&& handler, basic_standard_stream* self,
+                    const ConstBufferSequence& buffers) const
+    {
+#if !defined(ASIOEXT_WINDOWS)
+      if (self->reactive_) {
+        self->descriptor_.async_write_some(buffers,
+                                           std::forward<Handler>(handler));
+        return;
+      }
+#endif
+      self->file_.async_write_some(buffers, std::forward<Handler>(handler));
+    }
+  };
+
+  file_type file_;
+#if !defined(ASIOEXT_WINDOWS)
+  descriptor_type descriptor_;
+#endif
+  bool reactive_;
+};
+
+/// @ingroup stdhandles
+/// Typedef for a basic_standard_stream using the default
+/// FileService (thread_pool_file_service)
+typedef basic_standard_stream<> standard_stream;
+
+ASIOEXT_NS_END
+
+#if defined(ASIOEXT_HEADER_ONLY)
+# include "asioext/impl/standard_stream.cpp"
+#endif
+
+#endif
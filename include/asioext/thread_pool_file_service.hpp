@@ -73,7 +73,8 @@ public:
   {
   public:
     implementation_type()
-      : next_(0)
+      : close_count_(0)
+      , next_(0)
       , prev_(0)
     {
       // ctor
@@ -85,6 +86,8 @@ public:
 
     file_handle handle_;
     cancellation_token_source cancel_token_;
+    // Incremented by close(), so a pending async_open() knows it's aborted.
+    std::size_t close_count_;
 
     // Pointers to adjacent handle implementations in linked list.
     implementation_type* next_;
@@ -144,6 +147,29 @@ public:
                          error_code& ec) ASIOEXT_NOEXCEPT;
 #endif
 
+  /// Start an asynchronous open of the given file.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code))
+  async_open(implementation_type& impl, const char* filename,
+             const open_args& args, Handler&& handler);
+
+#if defined(ASIOEXT_WINDOWS) || defined(ASIOEXT_IS_DOCUMENTATION)
+  /// Start an asynchronous open of the given file.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code))
+  async_open(implementation_type& impl, const wchar_t* filename,
+             const open_args& args, Handler&& handler);
+#endif
+
+#if defined(ASIOEXT_HAS_BOOST_FILESYSTEM) || defined(ASIOEXT_IS_DOCUMENTATION)
+  /// Start an asynchronous open of the given file.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code))
+  async_open(implementation_type& impl,
+             const boost::filesystem::path& filename,
+             const open_args& args, Handler&& handler);
+#endif
+
   /// Assign a native handle to a file implementation.
   ASIOEXT_DECL void assign(implementation_type& impl,
                            const native_handle_type& handle,
@@ -159,6 +185,11 @@ public:
   ASIOEXT_DECL void close(implementation_type& impl, error_code& ec)
     ASIOEXT_NOEXCEPT;
 
+  /// Start an asynchronous close of the file handle.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code))
+  async_close(implementation_type& impl, Handler&& handler);
+
   /// Get the native file handle representation.
   native_handle_type native_handle(implementation_type& impl) ASIOEXT_NOEXCEPT
   {
@@ -220,6 +251,24 @@ public:
                           const file_times& new_times,
                           error_code& ec) ASIOEXT_NOEXCEPT;
 
+  /// Get a snapshot of the file's metadata.
+  ASIOEXT_DECL file_info query(implementation_type& impl,
+                               file_info_mask mask,
+                               error_code& ec) ASIOEXT_NOEXCEPT;
+
+  /// Lock a range of the file.
+  ASIOEXT_DECL void lock(implementation_type& impl, const file_range& range,
+                         lock_type type, error_code& ec) ASIOEXT_NOEXCEPT;
+
+  /// Try to lock a range of the file.
+  ASIOEXT_DECL bool try_lock(implementation_type& impl,
+                             const file_range& range, lock_type type,
+                             error_code& ec) ASIOEXT_NOEXCEPT;
+
+  /// Unlock a range of the file.
+  ASIOEXT_DECL void unlock(implementation_type& impl, const file_range& range,
+                           error_code& ec) ASIOEXT_NOEXCEPT;
+
   /// Cancel all operations associated with the handle.
   ASIOEXT_DECL void cancel(implementation_type& impl,
                            error_code& ec) ASIOEXT_NOEXCEPT;
@@ -282,8 +331,64 @@ public:
                       const ConstBufferSequence& buffers,
                       Handler&& handler);
 
+  /// Start an asynchronous size query.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code, uint64_t))
+  async_size(implementation_type& impl, Handler&& handler);
+
+  /// Start an asynchronous truncation.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code))
+  async_truncate(implementation_type& impl, uint64_t new_size,
+                 Handler&& handler);
+
+  /// Start an asynchronous permissions query.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code, file_perms))
+  async_permissions(implementation_type& impl, Handler&& handler);
+
+  /// Start an asynchronous permissions change.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code))
+  async_permissions(implementation_type& impl, file_perms perms,
+                    file_perm_options opts, Handler&& handler);
+
+  /// Start an asynchronous attributes query.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code, file_attrs))
+  async_attributes(implementation_type& impl, Handler&& handler);
+
+  /// Start an asynchronous attributes change.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code))
+  async_attributes(implementation_type& impl, file_attrs attrs,
+                   file_attr_options opts, Handler&& handler);
+
+  /// Start an asynchronous file times query.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code, file_times))
+  async_times(implementation_type& impl, Handler&& handler);
+
+  /// Start an asynchronous file times change.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code))
+  async_times(implementation_type& impl, const file_times& new_times,
+              Handler&& handler);
+
+  /// Start an asynchronous metadata query.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code, file_info))
+  async_query(implementation_type& impl, file_info_mask mask,
+              Handler&& handler);
+
+  /// Start an asynchronous lock acquisition.
+  template <typename Handler>
+  ASIOEXT_INITFN_RESULT_TYPE(Handler, void(error_code))
+  async_lock(implementation_type& impl, const file_range& range,
+             lock_type type, Handler&& handler);
+
   /// @private
-  // This is needed for tests.
+  // This is needed for tests and batch operations (e.g. read_files()).
   asio::thread_pool& get_thread_pool()
   {
     return pool_;
@@ -151,7 +151,7 @@ public:
   ///
   /// @return A copy of the contained file_handle object.
   /// Ownership is not transferred to the caller.
-  file_handle get() ASIOEXT_NOEXCEPT
+  file_handle get() const ASIOEXT_NOEXCEPT
   {
     return handle_;
   }
@@ -366,6 +366,61 @@ public:
     handle_.times(new_times, ec);
   }
 
+  /// @copydoc file_handle::query(file_info_mask)
+  file_info query(file_info_mask mask = file_info_mask::all)
+  {
+    return handle_.query(mask);
+  }
+
+  /// @copydoc file_handle::query(file_info_mask,error_code&)
+  file_info query(file_info_mask mask, error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    return handle_.query(mask, ec);
+  }
+
+  /// @}
+
+  /// @name Locking functions
+  /// @{
+
+  /// @copydoc file_handle::lock(const file_range&,lock_type)
+  void lock(const file_range& range, lock_type type)
+  {
+    handle_.lock(range, type);
+  }
+
+  /// @copydoc file_handle::lock(const file_range&,lock_type,error_code&)
+  void lock(const file_range& range, lock_type type,
+            error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    handle_.lock(range, type, ec);
+  }
+
+  /// @copydoc file_handle::try_lock(const file_range&,lock_type)
+  bool try_lock(const file_range& range, lock_type type)
+  {
+    return handle_.try_lock(range, type);
+  }
+
+  /// @copydoc file_handle::try_lock(const file_range&,lock_type,error_code&)
+  bool try_lock(const file_range& range, lock_type type,
+                error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    return handle_.try_lock(range, type, ec);
+  }
+
+  /// @copydoc file_handle::unlock(const file_range&)
+  void unlock(const file_range& range)
+  {
+    handle_.unlock(range);
+  }
+
+  /// @copydoc file_handle::unlock(const file_range&,error_code&)
+  void unlock(const file_range& range, error_code& ec) ASIOEXT_NOEXCEPT
+  {
+    handle_.unlock(range, ec);
+  }
+
   /// @}
 
   /// @name SyncReadStream functions
@@ -15,6 +15,7 @@
 # pragma once
 #endif
 
+#include "asioext/is_hasher.hpp"
 #include "asioext/error_code.hpp"
 
 #include "asioext/detail/asio_version.hpp"
@@ -130,6 +131,110 @@ ASIOEXT_DETAIL_WRITEFILE_BUF_RET(ConstBufferSequence)
               error_code& ec) ASIOEXT_NOEXCEPT;
 #endif
 
+/// @name Overloads with checksum computation
+/// These overloads additionally feed the written data to a
+/// @ref concept-Hasher (e.g. @ref crc32c_hasher). The buffers are processed
+/// in chunks and each chunk is written right after it was hashed, while it
+/// is still in the CPU cache. This saves a second pass over the data.
+/// @{
+
+#if !defined(ASIOEXT_IS_DOCUMENTATION)
+# if ASIOEXT_ASIO_VERSION < 101100
+#  define ASIOEXT_DETAIL_WRITEFILE_HASH_RET(T, H) \
+    typename std::enable_if<is_hasher<H>::value>::type
+# else
+#  define ASIOEXT_DETAIL_WRITEFILE_HASH_RET(T, H) \
+    typename std::enable_if<asio::is_const_buffer_sequence<T>::value && \
+                            is_hasher<H>::value>::type
+# endif
+#else
+# define ASIOEXT_DETAIL_WRITEFILE_HASH_RET(T, H) void
+#endif
+
+/// Write a sequence of buffers to a file and compute their checksum.
+///
+/// This function writes @c buffers into @c filename and passes them to
+/// @c hasher. If the file already exists, it is overwritten.
+/// After a successful call to this function, the file shall only contain
+/// the contents of the given buffers.
+///
+/// @param filename The path of the file into which the buffer content shall
+/// be written.
+///
+/// @param buffers The sequence of buffers to write to the file.
+///
+/// @param hasher The hasher that is updated with the written data.
+/// The type must satisfy the @ref concept-Hasher requirements.
+///
+/// @throws asio::system_error Thrown on failure.
+template <class ConstBufferSequence, class Hasher>
+ASIOEXT_DETAIL_WRITEFILE_HASH_RET(ConstBufferSequence, Hasher)
+    write_file(const char* filename, const ConstBufferSequence& buffers,
+               Hasher& hasher);
+
+/// Write a sequence of buffers to a file and compute their checksum.
+///
+/// This function writes @c buffers into @c filename and passes them to
+/// @c hasher. If the file already exists, it is overwritten.
+/// After a successful call to this function, the file shall only contain
+/// the contents of the given buffers.
+///
+/// @param filename The path of the file into which the buffer content shall
+/// be written.
+///
+/// @param buffers The sequence of buffers to write to the file.
+///
+/// @param hasher The hasher that is updated with the written data.
+/// The type must satisfy the @ref concept-Hasher requirements.
+///
+/// @param ec Set to indicate what error occurred. If no error occurred,
+/// the object is reset.
+template <class ConstBufferSequence, class Hasher>
+ASIOEXT_DETAIL_WRITEFILE_HASH_RET(ConstBufferSequence, Hasher)
+    write_file(const char* filename, const ConstBufferSequence& buffers,
+               Hasher& hasher, error_code& ec);
+
+#if defined(ASIOEXT_WINDOWS)  || defined(ASIOEXT_IS_DOCUMENTATION)
+/// @copydoc write_file(const char*,const ConstBufferSequence&,Hasher&)
+///
+/// @note Only available on Windows.
+template <class ConstBufferSequence, class Hasher>
+ASIOEXT_DETAIL_WRITEFILE_HASH_RET(ConstBufferSequence, Hasher)
+    write_file(const wchar_t* filename, const ConstBufferSequence& buffers,
+               Hasher& hasher);
+
+/// @copydoc write_file(const char*,const ConstBufferSequence&,Hasher&,error_code&)
+///
+/// @note Only available on Windows.
+template <class ConstBufferSequence, class Hasher>
+ASIOEXT_DETAIL_WRITEFILE_HASH_RET(ConstBufferSequence, Hasher)
+    write_file(const wchar_t* filename, const ConstBufferSequence& buffers,
+               Hasher& hasher, error_code& ec);
+#endif
+
+#if defined(ASIOEXT_HAS_BOOST_FILESYSTEM) || defined(ASIOEXT_IS_DOCUMENTATION)
+/// @copydoc write_file(const char*,const ConstBufferSequence&,Hasher&)
+///
+/// @note Only available if using Boost.Filesystem
+/// (i.e. if @c ASIOEXT_HAS_BOOST_FILESYSTEM is defined)
+template <class ConstBufferSequence, class Hasher>
+ASIOEXT_DETAIL_WRITEFILE_HASH_RET(ConstBufferSequence, Hasher)
+    write_file(const boost::filesystem::path& filename,
+               const ConstBufferSequence& buffers, Hasher& hasher);
+
+/// @copydoc write_file(const char*,const ConstBufferSequence&,Hasher&,error_code&)
+///
+/// @note Only available if using Boost.Filesystem
+/// (i.e. if @c ASIOEXT_HAS_BOOST_FILESYSTEM is defined)
+template <class ConstBufferSequence, class Hasher>
+ASIOEXT_DETAIL_WRITEFILE_HASH_RET(ConstBufferSequence, Hasher)
+    write_file(const boost::filesystem::path& filename,
+               const ConstBufferSequence& buffers, Hasher& hasher,
+               error_code& ec);
+#endif
+
+/// @}
+
 // TODO(tim): Add support for asio's dynamic buffers,
 // once they are released.
 
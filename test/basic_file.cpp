@@ -3,6 +3,7 @@
 #include "asioext/open_flags.hpp"
 #include "asioext/basic_file.hpp"
 #include "asioext/thread_pool_file_service.hpp"
+#include "asioext/open.hpp"
 
 #if defined(ASIOEXT_USE_BOOST_ASIO)
 # include <boost/asio/write.hpp>
@@ -21,6 +22,10 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/mpl/list.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 ASIOEXT_NS_BEGIN
 
 BOOST_AUTO_TEST_SUITE(asioext_basic_file)
@@ -341,6 +346,229 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(async_read_write_at, FileService, service_types)
   io_context.reset();
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(async_open_close, FileService, service_types)
+{
+  test_file_rm_guard rguard1(test_filename);
+
+  asio::io_context io_context;
+  asioext::basic_file<FileService> file(io_context);
+
+  int completed = 0;
+  file.async_open(test_filename,
+                  open_flags::access_write | open_flags::create_always,
+                  [&] (const error_code& ec) {
+    BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK(file.is_open());
+    ++completed;
+  });
+  BOOST_CHECK(!file.is_open());
+
+  io_context.run();
+  io_context.restart();
+  BOOST_REQUIRE_EQUAL(1, completed);
+
+  BOOST_REQUIRE_EQUAL(test_data_size,
+                      asio::write(file, asio::buffer(test_data,
+                                                     test_data_size)));
+
+  // Opening twice fails.
+  file.async_open(test_filename, open_flags::access_read |
+                                 open_flags::open_existing,
+                  [&] (const error_code& ec) {
+    BOOST_CHECK_EQUAL(asio::error::already_open, ec);
+    ++completed;
+  });
+
+  file.async_close([&] (const error_code& ec) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    ++completed;
+  });
+  BOOST_CHECK(!file.is_open());
+
+  io_context.run();
+  io_context.restart();
+  BOOST_REQUIRE_EQUAL(3, completed);
+
+  file.async_open(test_filename, open_flags::access_read |
+                                 open_flags::open_existing,
+                  [&] (const error_code& ec) {
+    BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+    ++completed;
+  });
+
+  io_context.run();
+  io_context.restart();
+  BOOST_REQUIRE_EQUAL(4, completed);
+  BOOST_CHECK_EQUAL(test_data_size, file.size());
+
+  // Destroying the file aborts a pending open.
+  {
+    asioext::basic_file<FileService> file2(io_context);
+    file2.async_open(test_filename, open_flags::access_read |
+                                    open_flags::open_existing,
+                     [&] (const error_code& ec) {
+      BOOST_CHECK_EQUAL(asio::error::operation_aborted, ec);
+      ++completed;
+    });
+  }
+
+  io_context.run();
+  io_context.restart();
+  BOOST_CHECK_EQUAL(5, completed);
+
+  // So does closing it, synchronously or not.
+  file.close();
+  file.async_open(test_filename, open_flags::access_read |
+                                 open_flags::open_existing,
+                  [&] (const error_code& ec) {
+    BOOST_CHECK_EQUAL(asio::error::operation_aborted, ec);
+    BOOST_CHECK(!file.is_open());
+    ++completed;
+  });
+  file.close();
+
+  io_context.run();
+  io_context.restart();
+  BOOST_CHECK_EQUAL(6, completed);
+  BOOST_CHECK(!file.is_open());
+
+  file.async_open(test_filename, open_flags::access_read |
+                                 open_flags::open_existing,
+                  [&] (const error_code& ec) {
+    BOOST_CHECK_EQUAL(asio::error::operation_aborted, ec);
+    ++completed;
+  });
+  file.async_close([&] (const error_code&) {
+    ++completed;
+  });
+
+  io_context.run();
+  io_context.restart();
+  BOOST_CHECK_EQUAL(8, completed);
+  BOOST_CHECK(!file.is_open());
+
+  // The file can still be opened afterwards.
+  file.async_open(test_filename, open_flags::access_read |
+                                 open_flags::open_existing,
+                  [&] (const error_code& ec) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    ++completed;
+  });
+
+  io_context.run();
+  BOOST_CHECK_EQUAL(9, completed);
+  BOOST_CHECK(file.is_open());
+}
+
+// Classic POSIX record locks don't conflict within a process.
+#if defined(ASIOEXT_HAS_OFD_LOCKS) || defined(ASIOEXT_WINDOWS)
+BOOST_AUTO_TEST_CASE_TEMPLATE(async_lock, FileService, service_types)
+{
+  test_file_rm_guard rguard1(test_filename);
+
+  asioext::error_code ec;
+  asioext::unique_file_handle holder = asioext::open(test_filename,
+      open_flags::access_read_write | open_flags::create_always, ec);
+  BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+
+  asio::io_context io_context;
+  asioext::basic_file<FileService> file(io_context);
+  file.open(test_filename,
+            open_flags::access_read_write | open_flags::open_existing, ec);
+  BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+
+  const file_range range{0, 0};
+  holder.lock(range, lock_type::exclusive);
+
+  std::atomic<bool> released(false);
+  std::thread releaser([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    released = true;
+    holder.unlock(range);
+  });
+
+  int completed = 0;
+  file.async_lock(range, lock_type::exclusive, [&] (const error_code& ec) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK(released);
+    ++completed;
+  });
+
+  io_context.run();
+  releaser.join();
+  BOOST_REQUIRE_EQUAL(1, completed);
+
+  // The lock is ours now.
+  BOOST_CHECK(!holder.try_lock(range, lock_type::shared));
+  {
+    file_lock_guard<asioext::basic_file<FileService>> guard(
+        file, range, std::adopt_lock);
+  }
+  BOOST_CHECK(holder.try_lock(range, lock_type::shared));
+}
+#endif
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(async_metadata, FileService, service_types)
+{
+  test_file_rm_guard rguard1(test_filename);
+
+  asio::io_context io_context;
+  asioext::basic_file<FileService> file(io_context);
+
+  asioext::error_code ec;
+  file.open(test_filename,
+            open_flags::access_write | open_flags::create_always, ec);
+  BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+
+  int completed = 0;
+  file.async_truncate(128, [&] (const error_code& ec) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    ++completed;
+  });
+
+  io_context.run();
+  io_context.restart();
+
+  file.async_size([&] (const error_code& ec, uint64_t size) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK_EQUAL(128, size);
+    ++completed;
+  });
+
+  file_times new_times;
+  new_times.mtime = file_clock::from_time_t(1405706349);
+  file.async_times(new_times, [&] (const error_code& ec) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    ++completed;
+  });
+
+  io_context.run();
+  io_context.restart();
+
+  file.async_times([&] (const error_code& ec, file_times times) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK(new_times.mtime == times.mtime);
+    ++completed;
+  });
+
+  file.async_permissions([&] (const error_code& ec, file_perms perms) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK(file.permissions() == perms);
+    ++completed;
+  });
+
+  file.async_query(file_info_mask::size | file_info_mask::type,
+                   [&] (const error_code& ec, file_info info) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK_EQUAL(128, info.size);
+    BOOST_CHECK(file_type::regular == info.type);
+    ++completed;
+  });
+
+  io_context.run();
+  BOOST_CHECK_EQUAL(6, completed);
+}
+
 template <typename FileService>
 struct write_cancel_handler
 {
@@ -0,0 +1,127 @@
+#include "asioext/buffer_pool.hpp"
+
+#include "asioext/linear_buffer.hpp"
+#include "asioext/chained_buffer.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+ASIOEXT_NS_BEGIN
+
+BOOST_AUTO_TEST_SUITE(asioext_buffer_pool)
+
+BOOST_AUTO_TEST_CASE(reuse)
+{
+  buffer_pool pool;
+
+  void* a = pool.allocate(100);
+  pool.deallocate(a, 100);
+  BOOST_CHECK_EQUAL(1, pool.statistics().cached_blocks);
+  BOOST_CHECK_EQUAL(128, pool.statistics().cached_bytes);
+
+  // Same size class.
+  void* b = pool.allocate(128);
+  BOOST_CHECK(a == b);
+  BOOST_CHECK_EQUAL(2, pool.statistics().allocations);
+  BOOST_CHECK_EQUAL(1, pool.statistics().hits);
+  BOOST_CHECK_EQUAL(0, pool.statistics().cached_blocks);
+
+  // Different size class.
+  void* c = pool.allocate(129);
+  BOOST_CHECK_EQUAL(1, pool.statistics().hits);
+
+  pool.deallocate(b, 128);
+  pool.deallocate(c, 129);
+  BOOST_CHECK_EQUAL(2, pool.statistics().cached_blocks);
+  BOOST_CHECK_EQUAL(128 + 256, pool.statistics().cached_bytes);
+
+  pool.trim();
+  BOOST_CHECK_EQUAL(0, pool.statistics().cached_blocks);
+  BOOST_CHECK_EQUAL(0, pool.statistics().cached_bytes);
+}
+
+BOOST_AUTO_TEST_CASE(bounded_retention)
+{
+  buffer_pool pool(1024);
+
+  void* a = pool.allocate(1024);
+  void* b = pool.allocate(1024);
+  pool.deallocate(a, 1024);
+  pool.deallocate(b, 1024);
+  BOOST_CHECK_EQUAL(1, pool.statistics().cached_blocks);
+  BOOST_CHECK_EQUAL(1, pool.statistics().releases);
+
+  // Too large to be pooled.
+  void* c = pool.allocate(2 * 1024 * 1024);
+  pool.deallocate(c, 2 * 1024 * 1024);
+  BOOST_CHECK_EQUAL(1, pool.statistics().cached_blocks);
+  BOOST_CHECK_EQUAL(2, pool.statistics().releases);
+}
+
+BOOST_AUTO_TEST_CASE(thread_local_pool)
+{
+  buffer_pool* other = nullptr;
+  std::thread t([&] {
+    other = &buffer_pool::thread_local_pool();
+  });
+  t.join();
+
+  BOOST_CHECK(&buffer_pool::thread_local_pool() ==
+              &buffer_pool::thread_local_pool());
+  BOOST_CHECK(&buffer_pool::thread_local_pool() != other);
+}
+
+BOOST_AUTO_TEST_CASE(allocator)
+{
+  buffer_pool pool;
+  {
+    basic_linear_buffer<buffer_pool_allocator<uint8_t>> b(
+        buffer_pool_allocator<uint8_t>(pool), 0);
+    b.append("HELLO", 5);
+    b.resize(1000);
+  }
+  buffer_pool_statistics stats = pool.statistics();
+  BOOST_CHECK_EQUAL(0, stats.releases);
+  BOOST_CHECK_EQUAL(stats.allocations - stats.hits, stats.cached_blocks);
+
+  // The 1000 byte block from above is reused for the first segment.
+  const uint64_t hits = stats.hits;
+  {
+    basic_chained_buffer<buffer_pool_allocator<uint8_t>> b(
+        buffer_pool_allocator<uint8_t>(pool), 0, 10000, 1000);
+    b.resize(2000);
+  }
+  stats = pool.statistics();
+  BOOST_CHECK_LT(hits, stats.hits);
+  BOOST_CHECK_EQUAL(stats.allocations - stats.hits, stats.cached_blocks);
+
+  // Default-constructed allocators use the thread's pool.
+  const buffer_pool_statistics before =
+      buffer_pool::thread_local_pool().statistics();
+  {
+    basic_linear_buffer<buffer_pool_allocator<uint8_t>> b;
+    b.append("HELLO", 5);
+  }
+  BOOST_CHECK_EQUAL(before.allocations + 1,
+                    buffer_pool::thread_local_pool().statistics().allocations);
+}
+
+BOOST_AUTO_TEST_CASE(io_context)
+{
+  asio::io_context io_context;
+  buffer_pool_allocator<uint8_t> a(io_context);
+  buffer_pool_allocator<uint8_t> b(io_context);
+  BOOST_CHECK(a == b);
+  BOOST_CHECK(a != buffer_pool_allocator<uint8_t>());
+  BOOST_CHECK(a.pool() ==
+              &asio::use_service<buffer_pool_service>(io_context).pool());
+
+  uint8_t* p = a.allocate(10);
+  b.deallocate(p, 10);
+  BOOST_CHECK_EQUAL(1, a.pool()->statistics().cached_blocks);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
@@ -0,0 +1,567 @@
+#include "asioext/buffered_stream.hpp"
+#include "asioext/detail/find_delimiter.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/io_context.hpp>
+# include <boost/asio/ip/tcp.hpp>
+#else
+# include <asio/io_context.hpp>
+# include <asio/ip/tcp.hpp>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+ASIOEXT_NS_BEGIN
+
+typedef buffered_stream<asio::ip::tcp::socket> tcp_buffered_stream;
+
+struct socket_pair
+{
+  explicit socket_pair(std::size_t max_write_size =
+                           (std::numeric_limits<std::size_t>::max)(),
+                       std::size_t max_read_size =
+                           (std::numeric_limits<std::size_t>::max)())
+    : acceptor(io_context,
+               asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0))
+    , client(io_context, max_write_size, max_read_size)
+    , server(io_context)
+  {
+    client.next_layer().connect(acceptor.local_endpoint());
+    acceptor.accept(server);
+  }
+
+  std::string receive(std::size_t n)
+  {
+    std::string data(n, '\0');
+    asio::read(server, asio::buffer(&data[0], n));
+    return data;
+  }
+
+  asio::io_context io_context;
+  asio::ip::tcp::acceptor acceptor;
+  tcp_buffered_stream client;
+  asio::ip::tcp::socket server;
+};
+
+static void append(tcp_buffered_stream::buffer_type& b, const std::string& s)
+{
+  b.append(s.data(), s.size());
+}
+
+static std::string to_string(const tcp_buffered_stream::buffer_type& b,
+                             std::size_t n)
+{
+  return std::string(reinterpret_cast<const char*>(b.data()), n);
+}
+
+static std::size_t find(const std::string& haystack, const std::string& needle)
+{
+  const uint8_t* first = reinterpret_cast<const uint8_t*>(haystack.data());
+  const uint8_t* last = first + haystack.size();
+  return detail::find_bytes(first, last,
+                            reinterpret_cast<const uint8_t*>(needle.data()),
+                            needle.size()) - first;
+}
+
+BOOST_AUTO_TEST_SUITE(asioext_buffered_stream)
+
+BOOST_AUTO_TEST_CASE(flush)
+{
+  socket_pair p;
+  append(p.client.write_buffer(), "HELLO");
+  BOOST_CHECK(p.client.can_flush());
+  BOOST_CHECK_EQUAL(5, p.client.flush());
+  BOOST_CHECK(!p.client.can_flush());
+  BOOST_CHECK_EQUAL("HELLO", p.receive(5));
+}
+
+BOOST_AUTO_TEST_CASE(enqueue)
+{
+  socket_pair p;
+  p.client.set_coalesce_limit(16);
+
+  const std::string big(1000, 'x');
+  const auto blob = std::make_shared<const std::string>(100, 'y');
+
+  append(p.client.write_buffer(), "HEAD");
+  p.client.enqueue(std::string(big));
+  append(p.client.write_buffer(), "MID");
+  p.client.enqueue(asio::buffer(*blob), blob);
+  // Small enough to be copied.
+  p.client.enqueue(std::vector<char>(3, 'z'));
+  BOOST_CHECK_EQUAL(7 + 3, p.client.write_buffer().size());
+
+  const std::string expected = "HEAD" + big + "MID" + *blob + "zzz";
+  BOOST_CHECK(p.client.can_flush());
+  BOOST_CHECK_EQUAL(expected.size(), p.client.flush());
+  BOOST_CHECK(!p.client.can_flush());
+  BOOST_CHECK(blob.use_count() == 1);
+  BOOST_CHECK_EQUAL(expected, p.receive(expected.size()));
+}
+
+BOOST_AUTO_TEST_CASE(async_enqueue)
+{
+  socket_pair p;
+  p.client.set_coalesce_limit(0);
+
+  const std::string first(2000, 'a');
+  const std::string second(3000, 'b');
+  p.client.enqueue(std::string(first));
+
+  int completed = 0;
+  p.client.async_flush([&] (const error_code& ec, std::size_t n) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK_EQUAL(first.size(), n);
+    ++completed;
+  });
+
+  // Data added while the flush is pending goes out with the next one.
+  append(p.client.write_buffer(), "AFTER");
+  p.client.enqueue(std::string(second));
+  BOOST_CHECK(!p.client.can_flush());
+
+  p.io_context.run();
+  BOOST_CHECK_EQUAL(1, completed);
+  BOOST_CHECK(p.client.can_flush());
+  BOOST_CHECK_EQUAL(second.size() + 5, p.client.flush());
+
+  BOOST_CHECK_EQUAL(first + "AFTER" + second,
+                    p.receive(first.size() + second.size() + 5));
+}
+
+BOOST_AUTO_TEST_CASE(high_water_mark)
+{
+  socket_pair p;
+  auto_flush_options options;
+  options.high_water_mark = 10;
+  p.client.set_auto_flush(options);
+
+  p.client.write(asio::buffer("HELLO", 5));
+  BOOST_CHECK(!p.client.flush_pending());
+  BOOST_CHECK_EQUAL(5, p.client.pending_write_size());
+
+  p.client.write(asio::buffer(" WORLD", 6));
+  BOOST_CHECK(p.client.flush_pending());
+  BOOST_CHECK_EQUAL(0, p.client.pending_write_size());
+
+  // Written while the flush is running, and again above the mark.
+  p.client.enqueue(std::string(20, 'x'));
+  p.io_context.run();
+  BOOST_CHECK(!p.client.flush_pending());
+  BOOST_CHECK_EQUAL(0, p.client.pending_write_size());
+  BOOST_CHECK_EQUAL("HELLO WORLD" + std::string(20, 'x'), p.receive(31));
+}
+
+BOOST_AUTO_TEST_CASE(max_delay)
+{
+  socket_pair p;
+  auto_flush_options options;
+  options.max_delay = std::chrono::milliseconds(10);
+  p.client.set_auto_flush(options);
+
+  p.client.write(asio::buffer("AB", 2));
+  p.client.write(asio::buffer("CD", 2));
+  BOOST_CHECK(!p.client.flush_pending());
+
+  const auto start = std::chrono::steady_clock::now();
+  p.io_context.run();
+  BOOST_CHECK(std::chrono::steady_clock::now() - start >=
+              std::chrono::milliseconds(10));
+  BOOST_CHECK_EQUAL(0, p.client.pending_write_size());
+  BOOST_CHECK_EQUAL("ABCD", p.receive(4));
+}
+
+BOOST_AUTO_TEST_CASE(cork)
+{
+  socket_pair p;
+  auto_flush_options options;
+  options.high_water_mark = 1;
+  p.client.set_auto_flush(options);
+
+  p.client.cork();
+  BOOST_CHECK(p.client.corked());
+  p.client.write(asio::buffer("AB", 2));
+  p.client.write(asio::buffer("CD", 2));
+  BOOST_CHECK(!p.client.flush_pending());
+
+  p.client.uncork();
+  BOOST_CHECK(!p.client.corked());
+  BOOST_CHECK(p.client.flush_pending());
+  p.io_context.run();
+  BOOST_CHECK_EQUAL("ABCD", p.receive(4));
+}
+
+BOOST_AUTO_TEST_CASE(buffer_full)
+{
+  socket_pair p(8);
+  BOOST_CHECK_EQUAL(5, p.client.write(asio::buffer("HELLO", 5)));
+
+  error_code ec;
+  BOOST_CHECK_EQUAL(0, p.client.write(asio::buffer("WORLD", 5), ec));
+  BOOST_CHECK_EQUAL(asio::error::no_buffer_space, ec);
+  BOOST_CHECK_THROW(p.client.write(asio::buffer("WORLD", 5)),
+                    std::exception);
+  BOOST_CHECK_EQUAL(5, p.client.pending_write_size());
+
+  p.client.flush();
+  BOOST_CHECK_EQUAL(5, p.client.write(asio::buffer("WORLD", 5), ec));
+  BOOST_CHECK(!ec);
+
+  // Enqueued data counts as well, copied or not.
+  p.client.set_coalesce_limit(4);
+  p.client.enqueue(std::string("!!"), ec);
+  BOOST_CHECK(!ec);
+  std::string big(8, 'x');
+  p.client.enqueue(std::move(big), ec);
+  BOOST_CHECK_EQUAL(asio::error::no_buffer_space, ec);
+  BOOST_CHECK_EQUAL(8, big.size());
+  const auto blob = std::make_shared<const std::string>(2, 'y');
+  p.client.enqueue(asio::buffer(*blob), blob, ec);
+  BOOST_CHECK_EQUAL(asio::error::no_buffer_space, ec);
+  BOOST_CHECK_THROW(p.client.enqueue(std::string("???")), std::exception);
+  BOOST_CHECK_EQUAL(7, p.client.pending_write_size());
+  BOOST_CHECK(blob.use_count() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(find_delimiter)
+{
+  // Exercise all positions relative to the SIMD blocks.
+  for (std::size_t size = 0; size != 100; ++size) {
+    std::string haystack(size, 'a');
+    BOOST_CHECK_EQUAL(size, find(haystack, "\n"));
+    BOOST_CHECK_EQUAL(size, find(haystack, "\r\n"));
+
+    for (std::size_t i = 0; i != size; ++i) {
+      haystack[i] = '\n';
+      BOOST_CHECK_EQUAL(i, find(haystack, "\n"));
+      haystack[i] = 'a';
+    }
+
+    for (std::size_t i = 0; i + 4 <= size; ++i) {
+      // Partial matches in front must not confuse us.
+      if (i >= 3)
+        haystack.replace(i - 3, 3, "\r\n\r");
+      haystack.replace(i, 4, "\r\n\r\n");
+      BOOST_CHECK_EQUAL(i, find(haystack, "\r\n\r\n"));
+      haystack.assign(size, 'a');
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(read_until)
+{
+  socket_pair p;
+  asio::write(p.server, asio::buffer("first\nsecond\r\n", 14));
+
+  std::size_t n = p.client.read_until('\n');
+  BOOST_REQUIRE_EQUAL(6, n);
+  BOOST_CHECK_EQUAL("first\n", to_string(p.client.read_buffer(), n));
+  p.client.read_buffer().erase(std::size_t(0), n);
+
+  n = p.client.read_until("\r\n");
+  BOOST_REQUIRE_EQUAL(8, n);
+  BOOST_CHECK_EQUAL("second\r\n", to_string(p.client.read_buffer(), n));
+  p.client.read_buffer().erase(std::size_t(0), n);
+
+  // The delimiter is split across two reads.
+  asio::write(p.server, asio::buffer("third\r", 6));
+  std::thread writer([&p] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    asio::write(p.server, asio::buffer("\nrest", 5));
+  });
+  n = p.client.read_until("\r\n");
+  writer.join();
+  BOOST_REQUIRE_EQUAL(7, n);
+  BOOST_CHECK_EQUAL("third\r\n", to_string(p.client.read_buffer(), n));
+
+  error_code ec;
+  BOOST_CHECK_EQUAL(0, p.client.read_until("", ec));
+  BOOST_CHECK_EQUAL(asio::error::invalid_argument, ec);
+}
+
+BOOST_AUTO_TEST_CASE(read_until_not_found)
+{
+  socket_pair p(std::numeric_limits<std::size_t>::max(), 8);
+  asio::write(p.server, asio::buffer("0123456789", 10));
+
+  error_code ec;
+  BOOST_CHECK_EQUAL(0, p.client.read_until('\n', ec));
+  BOOST_CHECK_EQUAL(asio::error::not_found, ec);
+
+  p.server.shutdown(asio::ip::tcp::socket::shutdown_send);
+  p.client.read_buffer().clear();
+  BOOST_CHECK_EQUAL(0, p.client.read_until('\n', ec));
+  BOOST_CHECK_EQUAL(asio::error::eof, ec);
+}
+
+BOOST_AUTO_TEST_CASE(async_read_until)
+{
+  socket_pair p;
+  asio::write(p.server, asio::buffer("HEAD\r\n\r", 7));
+
+  int completed = 0;
+  p.client.async_read_until("\r\n\r\n",
+                            [&] (const error_code& ec, std::size_t n) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK_EQUAL(8, n);
+    ++completed;
+
+    // Already buffered.
+    p.client.async_read_until('H', [&] (const error_code& ec,
+                                        std::size_t n) {
+      BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+      BOOST_CHECK_EQUAL(1, n);
+      ++completed;
+    });
+  });
+
+  p.io_context.poll();
+  BOOST_CHECK_EQUAL(0, completed);
+
+  asio::write(p.server, asio::buffer("\nBODY", 5));
+  p.io_context.run();
+  BOOST_CHECK_EQUAL(2, completed);
+  BOOST_CHECK_EQUAL("HEAD\r\n\r\nBODY",
+                    to_string(p.client.read_buffer(), 12));
+}
+
+BOOST_AUTO_TEST_CASE(read_some)
+{
+  socket_pair p;
+  p.client.set_read_bypass_limit(16);
+  asio::write(p.server, asio::buffer("0123456789", 10));
+
+  // Small reads go through the read buffer.
+  char data[32];
+  BOOST_REQUIRE_EQUAL(4, p.client.read_some(asio::buffer(data, 4)));
+  BOOST_CHECK_EQUAL("0123", std::string(data, 4));
+  BOOST_CHECK_EQUAL(6, p.client.read_buffer().size());
+
+  // Buffered data is returned first, without reading more.
+  BOOST_REQUIRE_EQUAL(6, p.client.read_some(asio::buffer(data)));
+  BOOST_CHECK_EQUAL("456789", std::string(data, 6));
+  BOOST_CHECK_EQUAL(0, p.client.read_buffer().size());
+
+  // Large reads bypass the read buffer.
+  const std::size_t capacity = p.client.read_buffer().capacity();
+  asio::write(p.server, asio::buffer("abcdefghijklmnopqrstuvwxyz", 26));
+  BOOST_REQUIRE_EQUAL(26, asio::read(p.client, asio::buffer(data, 26)));
+  BOOST_CHECK_EQUAL("abcdefghijklmnopqrstuvwxyz", std::string(data, 26));
+  BOOST_CHECK_EQUAL(0, p.client.read_buffer().size());
+  BOOST_CHECK_EQUAL(capacity, p.client.read_buffer().capacity());
+
+  p.server.shutdown(asio::ip::tcp::socket::shutdown_send);
+  error_code ec;
+  BOOST_CHECK_EQUAL(0, p.client.read_some(asio::buffer(data), ec));
+  BOOST_CHECK_EQUAL(asio::error::eof, ec);
+}
+
+BOOST_AUTO_TEST_CASE(async_read_some)
+{
+  socket_pair p;
+  p.client.set_read_bypass_limit(16);
+  asio::write(p.server, asio::buffer("0123456789", 10));
+
+  char data[32];
+  int completed = 0;
+  p.client.async_read_some(asio::buffer(data, 4),
+                           [&] (const error_code& ec, std::size_t n) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_REQUIRE_EQUAL(4, n);
+    BOOST_CHECK_EQUAL("0123", std::string(data, 4));
+    ++completed;
+
+    p.client.async_read_some(asio::buffer(data),
+                             [&] (const error_code& ec, std::size_t n) {
+      BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+      BOOST_REQUIRE_EQUAL(6, n);
+      BOOST_CHECK_EQUAL("456789", std::string(data, 6));
+      ++completed;
+    });
+  });
+  p.io_context.run();
+  BOOST_CHECK_EQUAL(2, completed);
+  BOOST_CHECK_EQUAL(0, p.client.read_buffer().size());
+
+  // A composed read, bypassing the read buffer.
+  asio::write(p.server, asio::buffer("abcdefghijklmnopqrstuvwxyz", 26));
+  asio::async_read(p.client, asio::buffer(data, 26),
+                   [&] (const error_code& ec, std::size_t n) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK_EQUAL(26, n);
+    ++completed;
+  });
+  p.io_context.restart();
+  p.io_context.run();
+  BOOST_CHECK_EQUAL(3, completed);
+  BOOST_CHECK_EQUAL("abcdefghijklmnopqrstuvwxyz", std::string(data, 26));
+  BOOST_CHECK_EQUAL(0, p.client.read_buffer().size());
+}
+
+BOOST_AUTO_TEST_CASE(request_response)
+{
+  socket_pair p;
+
+  // The server only answers once it has received a whole request.
+  std::string requests[2];
+  std::thread server([&p, &requests] {
+    for (std::string& request : requests) {
+      request = p.receive(5);
+      asio::write(p.server, asio::buffer("PONG\n", 5));
+    }
+  });
+
+  // With the default options, reading has to flush the request.
+  asio::write(p.client, asio::buffer("PING\n", 5));
+  const std::size_t n = p.client.read_until('\n');
+  BOOST_CHECK_EQUAL("PONG\n", to_string(p.client.read_buffer(), n));
+  p.client.read_buffer().erase(std::size_t(0), n);
+
+  char data[5];
+  int completed = 0;
+  asio::async_write(p.client, asio::buffer("PING\n", 5),
+                    [&] (const error_code& ec, std::size_t) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    ++completed;
+
+    asio::async_read(p.client, asio::buffer(data),
+                     [&] (const error_code& ec, std::size_t n) {
+      BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+      BOOST_CHECK_EQUAL(5, n);
+      ++completed;
+    });
+  });
+  p.io_context.run();
+  server.join();
+
+  BOOST_CHECK_EQUAL(2, completed);
+  BOOST_CHECK_EQUAL("PONG\n", std::string(data, 5));
+  BOOST_CHECK_EQUAL("PING\n", requests[0]);
+  BOOST_CHECK_EQUAL("PING\n", requests[1]);
+}
+
+BOOST_AUTO_TEST_CASE(write_some)
+{
+  socket_pair p;
+  auto_flush_options options;
+  options.high_water_mark = 8;
+  p.client.set_auto_flush(options);
+
+  BOOST_CHECK_EQUAL(5, p.client.write_some(asio::buffer("HELLO", 5)));
+  BOOST_CHECK_EQUAL(5, p.client.write_some(asio::buffer("WORLD", 5)));
+  BOOST_CHECK_EQUAL(10, p.client.pending_write_size());
+
+  // Reaching the high water mark flushes before copying more.
+  BOOST_CHECK_EQUAL(1, p.client.write_some(asio::buffer("!", 1)));
+  BOOST_CHECK_EQUAL(1, p.client.pending_write_size());
+  BOOST_CHECK_EQUAL("HELLOWORLD", p.receive(10));
+
+  p.client.flush();
+  BOOST_CHECK_EQUAL("!", p.receive(1));
+}
+
+BOOST_AUTO_TEST_CASE(write_some_buffer_full)
+{
+  socket_pair p(4);
+
+  // Only what fits is written, the rest goes out in later calls.
+  BOOST_CHECK_EQUAL(4, p.client.write_some(asio::buffer("0123456789", 10)));
+  BOOST_CHECK_EQUAL(10, asio::write(p.client, asio::buffer("0123456789", 10)));
+  p.client.flush();
+  BOOST_CHECK_EQUAL("01230123456789", p.receive(14));
+}
+
+BOOST_AUTO_TEST_CASE(write_some_auto_flush)
+{
+  socket_pair p(24);
+  auto_flush_options options;
+  options.high_water_mark = 8;
+  p.client.set_auto_flush(options);
+
+  // Starts an automatic flush, and fills the buffer again while it runs.
+  p.client.write(asio::buffer("0123456789", 10));
+  BOOST_CHECK(p.client.flush_pending());
+  p.client.write(asio::buffer("abcdefghij", 10));
+
+  // We can't wait for that flush, so only what fits is copied.
+  error_code ec;
+  BOOST_CHECK_EQUAL(14, p.client.write_some(asio::buffer("ABCDEFGHIJKLMNOP",
+                                                         16), ec));
+  BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+  BOOST_CHECK_EQUAL(0, p.client.write_some(asio::buffer("!", 1), ec));
+  BOOST_CHECK_EQUAL(asio::error::would_block, ec);
+
+  p.io_context.run();
+  BOOST_CHECK_EQUAL(0, p.client.pending_write_size());
+  BOOST_CHECK_EQUAL("0123456789abcdefghijABCDEFGHIJKLMN", p.receive(34));
+}
+
+BOOST_AUTO_TEST_CASE(async_write_some_close)
+{
+  socket_pair p;
+  auto_flush_options options;
+  options.high_water_mark = 8;
+  p.client.set_auto_flush(options);
+
+  p.client.write(asio::buffer("0123456789", 10));
+  p.client.write(asio::buffer("abcdefghij", 10));
+
+  // Has to wait for the automatic flush, which is then cancelled.
+  int completed = 0;
+  p.client.async_write_some(asio::buffer("ABC", 3),
+                            [&] (const error_code& ec, std::size_t n) {
+    BOOST_CHECK_EQUAL(asio::error::operation_aborted, ec);
+    BOOST_CHECK_EQUAL(0, n);
+    ++completed;
+  });
+  p.client.close();
+
+  p.io_context.run();
+  BOOST_CHECK_EQUAL(1, completed);
+  BOOST_CHECK_EQUAL(0, p.client.pending_write_size());
+}
+
+BOOST_AUTO_TEST_CASE(async_write_some)
+{
+  socket_pair p(16);
+  auto_flush_options options;
+  options.high_water_mark = 8;
+  p.client.set_auto_flush(options);
+
+  // A layer on top of us, writing in small pieces.
+  const std::string data = "The quick brown fox jumps over the lazy dog";
+  int completed = 0;
+  asio::async_write(p.client, asio::buffer(data), asio::transfer_at_least(1),
+                    [&] (const error_code& ec, std::size_t n) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK_EQUAL(16, n);
+    ++completed;
+  });
+  p.io_context.run();
+  BOOST_CHECK_EQUAL(1, completed);
+  // The high water mark was reached, so everything has been flushed.
+  BOOST_CHECK_EQUAL(0, p.client.pending_write_size());
+  BOOST_CHECK_EQUAL(data.substr(0, 16), p.receive(16));
+
+  p.io_context.restart();
+  asio::async_write(p.client, asio::buffer(data),
+                    [&] (const error_code& ec, std::size_t n) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK_EQUAL(data.size(), n);
+    ++completed;
+  });
+  p.io_context.run();
+  BOOST_CHECK_EQUAL(2, completed);
+  BOOST_CHECK_EQUAL(data, p.receive(data.size()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
@@ -0,0 +1,213 @@
+#include "asioext/chained_buffer.hpp"
+
+#include "test_file_rm_guard.hpp"
+#include "test_file_writer.hpp"
+
+#include "asioext/open.hpp"
+#include "asioext/read_file.hpp"
+#include "asioext/detail/asio_version.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/read_until.hpp>
+#else
+# include <asio/read_until.hpp>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <string>
+
+ASIOEXT_NS_BEGIN
+
+#if (ASIOEXT_ASIO_VERSION >= 101400)
+# if !defined(ASIOEXT_NO_DYNAMIC_BUFFER_V1)
+static_assert(asio::is_dynamic_buffer_v1<
+                  asioext::dynamic_chained_buffer<std::allocator<uint8_t>>
+              >::value, "concept check");
+# endif
+static_assert(asio::is_dynamic_buffer_v2<
+                  asioext::dynamic_chained_buffer<std::allocator<uint8_t>>
+              >::value, "concept check");
+#else
+static_assert(asio::is_dynamic_buffer<
+                  asioext::dynamic_chained_buffer<std::allocator<uint8_t>>
+              >::value, "concept check");
+#endif
+
+static_assert(asio::is_const_buffer_sequence<
+                  chained_buffer::const_buffers_type>::value,
+              "concept check");
+static_assert(asio::is_mutable_buffer_sequence<
+                  chained_buffer::mutable_buffers_type>::value,
+              "concept check");
+
+template <typename BufferSequence>
+static std::string to_string(const BufferSequence& buffers)
+{
+  std::string s(asio::buffer_size(buffers), '\0');
+  asio::buffer_copy(asio::buffer(&s[0], s.size()), buffers);
+  return s;
+}
+
+BOOST_AUTO_TEST_SUITE(asioext_chained_buffer)
+
+BOOST_AUTO_TEST_CASE(basic_construction)
+{
+  chained_buffer x1;
+  BOOST_CHECK_EQUAL(0, x1.size());
+  BOOST_CHECK_EQUAL(0, x1.capacity());
+  BOOST_CHECK_EQUAL(chained_buffer::default_segment_size, x1.segment_size());
+
+  chained_buffer x2(10, 100, 4);
+  BOOST_CHECK_EQUAL(0, x2.size());
+  BOOST_CHECK_EQUAL(12, x2.capacity());
+  BOOST_CHECK_EQUAL(100, x2.max_size());
+  BOOST_CHECK_EQUAL(4, x2.segment_size());
+
+  BOOST_CHECK_THROW(chained_buffer(0, 100, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(segments)
+{
+  chained_buffer b(0, 100, 4);
+  b.append("0123456789", 10);
+  BOOST_CHECK_EQUAL(10, b.size());
+  BOOST_CHECK_EQUAL(12, b.capacity());
+  BOOST_CHECK(!b.is_contiguous());
+
+  const chained_buffer::const_buffers_type data = b.data();
+  BOOST_CHECK_EQUAL(3, std::distance(data.begin(), data.end()));
+  BOOST_CHECK_EQUAL("0123456789", to_string(data));
+  BOOST_CHECK_EQUAL("2345", to_string(b.data(2, 4)));
+  BOOST_CHECK_EQUAL("89", to_string(b.data(8, 10)));
+  BOOST_CHECK_EQUAL(0, asio::buffer_size(b.data(20, 10)));
+
+  char out[4];
+  BOOST_CHECK_EQUAL(4, b.copy(out, 4, 3));
+  BOOST_CHECK_EQUAL("3456", std::string(out, 4));
+
+  const linear_buffer linear = b.linearize();
+  BOOST_CHECK_EQUAL("0123456789",
+                    std::string(reinterpret_cast<const char*>(linear.data()),
+                                linear.size()));
+}
+
+BOOST_AUTO_TEST_CASE(consume)
+{
+  chained_buffer b(0, 100, 4);
+  b.append("0123456789", 10);
+
+  const uint8_t* first_segment = asio::buffer_cast<const uint8_t*>(
+      *b.data().begin());
+
+  // The first segment is recycled and moves to the back.
+  b.consume(5);
+  BOOST_CHECK_EQUAL("56789", to_string(b.data()));
+  BOOST_CHECK_EQUAL(12 - 1, b.capacity());
+
+  b.append("abcdef", 6);
+  BOOST_CHECK_EQUAL("56789abcdef", to_string(b.data()));
+  BOOST_CHECK_EQUAL(12 - 1, b.capacity());
+
+  const chained_buffer::const_buffers_type data = b.data();
+  auto last = data.end();
+  --last;
+  BOOST_CHECK(first_segment == asio::buffer_cast<const uint8_t*>(*last));
+
+  b.consume(100);
+  BOOST_CHECK(b.empty());
+  BOOST_CHECK_EQUAL(12, b.capacity());
+
+  b.shrink_to_fit();
+  BOOST_CHECK_EQUAL(0, b.capacity());
+}
+
+BOOST_AUTO_TEST_CASE(prepare_commit)
+{
+  chained_buffer b(0, 10, 4);
+
+  chained_buffer::mutable_buffers_type out = b.prepare(6);
+  BOOST_CHECK_EQUAL(6, asio::buffer_size(out));
+  asio::buffer_copy(out, asio::buffer("HELLO!", 6));
+  b.commit(6);
+  BOOST_CHECK_EQUAL("HELLO!", to_string(b.data()));
+
+  BOOST_CHECK_THROW(b.prepare(5), std::length_error);
+  BOOST_CHECK_NO_THROW(b.prepare(4));
+}
+
+BOOST_AUTO_TEST_CASE(move)
+{
+  chained_buffer a(0, 100, 4);
+  a.append("HELLO WORLD", 11);
+
+  chained_buffer b(std::move(a));
+  BOOST_CHECK_EQUAL(0, a.capacity());
+  BOOST_CHECK_EQUAL("HELLO WORLD", to_string(b.data()));
+
+  a = std::move(b);
+  BOOST_CHECK_EQUAL(0, b.capacity());
+  BOOST_CHECK_EQUAL("HELLO WORLD", to_string(a.data()));
+}
+
+BOOST_AUTO_TEST_CASE(read_file)
+{
+  static const char* test_filename = "asioext_chained_buffer_read_file";
+  std::string test_data;
+  for (int i = 0; i != 1000; ++i)
+    test_data += std::to_string(i) + ",";
+  test_file_writer writer(test_filename, test_data.data(), test_data.size());
+
+  chained_buffer b(0, (std::numeric_limits<std::size_t>::max)(), 64);
+  b.append("stale", 5);
+  asioext::read_file(test_filename, b);
+  BOOST_CHECK_EQUAL(test_data, to_string(b.data()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(asioext_dynamic_chained_buffer)
+
+BOOST_AUTO_TEST_CASE(grow_shrink)
+{
+  chained_buffer b(0, 100, 4);
+  auto db = dynamic_buffer(b);
+
+  db.grow(6);
+  asio::buffer_copy(db.data(0, 6), asio::buffer("HELLO!", 6));
+  BOOST_CHECK_EQUAL(6, db.size());
+  BOOST_CHECK_EQUAL("LLO!", to_string(db.data(2, 10)));
+
+  db.shrink(1);
+  db.consume(1);
+  BOOST_CHECK_EQUAL("ELLO", to_string(b.data()));
+
+  db.shrink(10);
+  BOOST_CHECK_EQUAL(0, db.size());
+}
+
+BOOST_AUTO_TEST_CASE(read_until)
+{
+  static const char* test_filename = "asioext_chained_buffer_test";
+  static const char test_data[] = "first line\nsecond line\n";
+  test_file_writer writer(test_filename, test_data, sizeof(test_data) - 1);
+
+  unique_file_handle fh = open(test_filename,
+                               open_flags::access_read |
+                               open_flags::open_existing);
+
+  chained_buffer b(0, 1024, 4);
+  std::size_t n = asio::read_until(fh, dynamic_buffer(b), '\n');
+  BOOST_REQUIRE_EQUAL(11, n);
+  BOOST_CHECK_EQUAL("first line\n", to_string(b.data(0, n)));
+  b.consume(n);
+
+  n = asio::read_until(fh, dynamic_buffer(b), '\n');
+  BOOST_REQUIRE_EQUAL(12, n);
+  BOOST_CHECK_EQUAL("second line\n", to_string(b.data()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
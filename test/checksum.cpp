@@ -0,0 +1,108 @@
+#include "asioext/checksum.hpp"
+#include "asioext/is_hasher.hpp"
+#include "asioext/error_code.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <vector>
+
+ASIOEXT_NS_BEGIN
+
+BOOST_AUTO_TEST_SUITE(asioext_checksum)
+
+// BOOST_AUTO_TEST_SUITE() gives us a unique NS, so we don't need to
+// prefix our variables.
+
+static_assert(is_hasher<crc32c_hasher>::value,
+              "crc32c_hasher must satisfy Hasher");
+static_assert(is_hasher<xxhash64_hasher>::value,
+              "xxhash64_hasher must satisfy Hasher");
+static_assert(!is_hasher<error_code>::value,
+              "error_code mustn't satisfy Hasher");
+
+template <class Hasher>
+static typename Hasher::value_type hash_all(const void* data,
+                                            std::size_t size)
+{
+  Hasher h;
+  h.update(data, size);
+  return h.value();
+}
+
+template <class Hasher>
+static typename Hasher::value_type hash_chunked(const unsigned char* data,
+                                                std::size_t size,
+                                                std::size_t chunk)
+{
+  Hasher h;
+  for (std::size_t i = 0; i < size; i += chunk)
+    h.update(data + i, (std::min)(chunk, size - i));
+  return h.value();
+}
+
+BOOST_AUTO_TEST_CASE(crc32c)
+{
+  BOOST_CHECK_EQUAL(0u, hash_all<crc32c_hasher>("", 0));
+  BOOST_CHECK_EQUAL(0xe3069283u, hash_all<crc32c_hasher>("123456789", 9));
+
+  // RFC 3720, B.4. CRC Examples
+  unsigned char data[32];
+  std::memset(data, 0, sizeof(data));
+  BOOST_CHECK_EQUAL(0x8a9136aau, hash_all<crc32c_hasher>(data, 32));
+  std::memset(data, 0xff, sizeof(data));
+  BOOST_CHECK_EQUAL(0x62a8ab43u, hash_all<crc32c_hasher>(data, 32));
+  for (int i = 0; i != 32; ++i)
+    data[i] = static_cast<unsigned char>(i);
+  BOOST_CHECK_EQUAL(0x46dd794eu, hash_all<crc32c_hasher>(data, 32));
+
+  crc32c_hasher h;
+  h.update("garbage", 7);
+  h.reset();
+  h.update("123456789", 9);
+  BOOST_CHECK_EQUAL(0xe3069283u, h.value());
+}
+
+BOOST_AUTO_TEST_CASE(xxhash64)
+{
+  BOOST_CHECK_EQUAL(0xef46db3751d8e999ull, hash_all<xxhash64_hasher>("", 0));
+  BOOST_CHECK_EQUAL(0x44bc2cf5ad770999ull,
+                    hash_all<xxhash64_hasher>("abc", 3));
+
+  const char long_data[] = "Nobody inspects the spammish repetition";
+  BOOST_CHECK_EQUAL(0xfbcea83c8a378bf1ull,
+                    hash_all<xxhash64_hasher>(long_data,
+                                              sizeof(long_data) - 1));
+
+  xxhash64_hasher h;
+  h.update("garbage", 7);
+  h.reset();
+  h.update("abc", 3);
+  BOOST_CHECK_EQUAL(0x44bc2cf5ad770999ull, h.value());
+}
+
+BOOST_AUTO_TEST_CASE(chunked_updates)
+{
+  std::vector<unsigned char> data(100000);
+  for (std::size_t i = 0; i != data.size(); ++i)
+    data[i] = static_cast<unsigned char>(i * 31 + (i >> 8));
+
+  const uint32_t crc = hash_all<crc32c_hasher>(data.data(), data.size());
+  const uint64_t xxh = hash_all<xxhash64_hasher>(data.data(), data.size());
+
+  const std::size_t chunks[] = {1, 3, 7, 8, 31, 32, 33, 4096, 65537};
+  for (std::size_t chunk : chunks) {
+    BOOST_CHECK_EQUAL(crc, hash_chunked<crc32c_hasher>(
+        data.data(), data.size(), chunk));
+    BOOST_CHECK_EQUAL(xxh, hash_chunked<xxhash64_hasher>(
+        data.data(), data.size(), chunk));
+  }
+
+  // Unaligned start
+  BOOST_CHECK_EQUAL(hash_all<crc32c_hasher>(data.data() + 3, 1000),
+                    hash_chunked<crc32c_hasher>(data.data() + 3, 1000, 5));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
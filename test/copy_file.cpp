@@ -0,0 +1,87 @@
+#include "test_file_rm_guard.hpp"
+#include "test_file_writer.hpp"
+
+#include "asioext/copy_file.hpp"
+#include "asioext/checksum.hpp"
+#include "asioext/read_file.hpp"
+#include "asioext/unique_file_handle.hpp"
+#include "asioext/open.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+ASIOEXT_NS_BEGIN
+
+BOOST_AUTO_TEST_SUITE(asioext_copy_file)
+
+// BOOST_AUTO_TEST_SUITE() gives us a unique NS, so we don't need to
+// prefix our variables.
+
+static const char* src_filename = "asioext_copyfile_src";
+static const char* dst_filename = "asioext_copyfile_dst";
+
+static std::string make_test_data()
+{
+  // Large enough to require multiple chunks.
+  std::string data(200 * 1024 + 17, '\0');
+  for (std::size_t i = 0; i != data.size(); ++i)
+    data[i] = static_cast<char>('a' + i % 26);
+  return data;
+}
+
+BOOST_AUTO_TEST_CASE(copy)
+{
+  const std::string test_data = make_test_data();
+  test_file_writer src_file(src_filename, test_data.data(), test_data.size());
+  test_file_rm_guard rguard(dst_filename);
+
+  {
+    unique_file_handle src = open(src_filename,
+                                  open_flags::access_read |
+                                  open_flags::open_existing);
+    unique_file_handle dst = open(dst_filename,
+                                  open_flags::access_write |
+                                  open_flags::create_always);
+
+    BOOST_CHECK_EQUAL(test_data.size(), copy_file(src.get(), dst.get()));
+  }
+
+  std::string copied;
+  read_file(dst_filename, copied);
+  BOOST_CHECK(test_data == copied);
+}
+
+BOOST_AUTO_TEST_CASE(copy_with_checksum)
+{
+  const std::string test_data = make_test_data();
+  test_file_writer src_file(src_filename, test_data.data(), test_data.size());
+  test_file_rm_guard rguard(dst_filename);
+
+  crc32c_hasher hasher;
+  {
+    unique_file_handle src = open(src_filename,
+                                  open_flags::access_read |
+                                  open_flags::open_existing);
+    unique_file_handle dst = open(dst_filename,
+                                  open_flags::access_write |
+                                  open_flags::create_always);
+
+    error_code ec;
+    BOOST_CHECK_EQUAL(test_data.size(),
+                      copy_file(src.get(), dst.get(), hasher, ec));
+    BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+  }
+
+  crc32c_hasher expected;
+  expected.update(test_data.data(), test_data.size());
+  BOOST_CHECK_EQUAL(expected.value(), hasher.value());
+
+  std::string copied;
+  read_file(dst_filename, copied);
+  BOOST_CHECK(test_data == copied);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
@@ -0,0 +1,186 @@
+#include "test_file_rm_guard.hpp"
+
+#include "asioext/directory_handle.hpp"
+#include "asioext/open.hpp"
+#include "asioext/error.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/write.hpp>
+# include <boost/asio/read.hpp>
+# include <boost/asio/buffer.hpp>
+#else
+# include <asio/write.hpp>
+# include <asio/read.hpp>
+# include <asio/buffer.hpp>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include <cerrno>
+#include <cstring>
+
+ASIOEXT_NS_BEGIN
+
+BOOST_AUTO_TEST_SUITE(asioext_directory_handle)
+
+// BOOST_AUTO_TEST_SUITE() gives us a unique NS, so we don't need to
+// prefix our variables.
+
+static const char* dir_name = "asioext_dirhandle_test";
+static const char* test_data = "hello world";
+
+struct test_directory
+{
+  test_directory()
+    : rguard(dir_name)
+  {
+    boost::filesystem::create_directory(dir_name);
+  }
+
+  // Removed last, after the guards of its contents.
+  test_file_rm_guard rguard;
+};
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+  directory_handle dh;
+  BOOST_CHECK(!dh.is_open());
+  BOOST_CHECK_EQUAL(-1, dh.native_handle());
+
+  error_code ec;
+  dh.close(ec);
+  BOOST_CHECK(!ec);
+}
+
+BOOST_AUTO_TEST_CASE(open_relative)
+{
+  test_directory td;
+  test_file_rm_guard rguard("asioext_dirhandle_test/a");
+
+  directory_handle dh = open_directory(dir_name);
+  BOOST_REQUIRE(dh.is_open());
+
+  {
+    unique_file_handle fh = open(dh, "a",
+                                 open_flags::access_write |
+                                 open_flags::create_always);
+    asio::write(fh, asio::buffer(test_data, std::strlen(test_data)));
+  }
+
+  unique_file_handle fh = open("asioext_dirhandle_test/a",
+                               open_flags::access_read |
+                               open_flags::open_existing);
+  char buffer[32] = {};
+  error_code ec;
+  const std::size_t size = asio::read(fh, asio::buffer(buffer), ec);
+  BOOST_CHECK(ec == asio::error::eof);
+  BOOST_CHECK_EQUAL(std::strlen(test_data), size);
+  BOOST_CHECK_EQUAL(0, std::memcmp(buffer, test_data, size));
+
+  // open_existing shouldn't create anything.
+  fh = open(dh, "b", open_flags::access_read | open_flags::open_existing, ec);
+  BOOST_CHECK(!fh.is_open());
+  BOOST_CHECK_EQUAL(ENOENT, ec.value());
+}
+
+BOOST_AUTO_TEST_CASE(stat_entries)
+{
+  test_directory td;
+  test_file_rm_guard rguard1("asioext_dirhandle_test/sub");
+  test_file_rm_guard rguard2("asioext_dirhandle_test/a");
+
+  directory_handle dh = open_directory(dir_name);
+  open(dh, "a", open_flags::access_write | open_flags::create_always)
+      .write_some(asio::buffer(test_data, std::strlen(test_data)));
+  boost::filesystem::create_directory("asioext_dirhandle_test/sub");
+
+  file_info info = dh.stat("a");
+  BOOST_CHECK(info.type == file_type::regular);
+  BOOST_CHECK_EQUAL(std::strlen(test_data), info.size);
+  BOOST_CHECK_EQUAL(1, info.hard_links);
+
+  info = dh.symlink_stat("sub");
+  BOOST_CHECK(info.type == file_type::directory);
+
+  error_code ec;
+  dh.stat("missing", ec);
+  BOOST_CHECK_EQUAL(ENOENT, ec.value());
+
+  directory_handle sub = open_directory(dh, "sub");
+  BOOST_CHECK(sub.is_open());
+  BOOST_CHECK(sub.stat(".").inode == info.inode);
+
+  open_directory(dh, "a", ec);
+  BOOST_CHECK_EQUAL(ENOTDIR, ec.value());
+}
+
+BOOST_AUTO_TEST_CASE(rename_remove)
+{
+  test_directory td;
+  test_file_rm_guard rguard1("asioext_dirhandle_test/sub");
+  test_file_rm_guard rguard2("asioext_dirhandle_test/sub/c");
+  test_file_rm_guard rguard3("asioext_dirhandle_test/a");
+  test_file_rm_guard rguard4("asioext_dirhandle_test/b");
+
+  directory_handle dh = open_directory(dir_name);
+  open(dh, "a", open_flags::access_write | open_flags::create_always);
+  boost::filesystem::create_directory("asioext_dirhandle_test/sub");
+  directory_handle sub = open_directory(dh, "sub");
+
+  dh.rename("a", "b");
+  BOOST_CHECK(!boost::filesystem::exists("asioext_dirhandle_test/a"));
+  BOOST_CHECK(boost::filesystem::exists("asioext_dirhandle_test/b"));
+
+  dh.rename("b", sub, "c");
+  BOOST_CHECK(!boost::filesystem::exists("asioext_dirhandle_test/b"));
+  BOOST_CHECK(boost::filesystem::exists("asioext_dirhandle_test/sub/c"));
+
+  error_code ec;
+  dh.remove_directory("sub", ec);
+  BOOST_CHECK(ec.value() == ENOTEMPTY || ec.value() == EEXIST);
+
+  sub.remove("c");
+  BOOST_CHECK(!boost::filesystem::exists("asioext_dirhandle_test/sub/c"));
+
+  dh.remove_directory("sub");
+  BOOST_CHECK(!boost::filesystem::exists("asioext_dirhandle_test/sub"));
+
+  dh.remove("sub", ec);
+  BOOST_CHECK_EQUAL(ENOENT, ec.value());
+}
+
+BOOST_AUTO_TEST_CASE(resolve_beneath)
+{
+  test_directory td;
+  test_file_rm_guard rguard1("asioext_dirhandle_test/sub");
+  test_file_rm_guard rguard2("asioext_dirhandle_test/a");
+
+  directory_handle dh = open_directory(dir_name);
+  open(dh, "a", open_flags::access_write | open_flags::create_always);
+  boost::filesystem::create_directory("asioext_dirhandle_test/sub");
+  directory_handle sub = open_directory(dh, "sub");
+
+  error_code ec;
+  unique_file_handle fh = open(sub, "../a",
+                               open_flags::access_read |
+                               open_flags::open_existing,
+                               resolve_flags::beneath, ec);
+  if (ec == asio::error::operation_not_supported)
+    return; // No openat2()
+
+  BOOST_CHECK(!fh.is_open());
+  BOOST_CHECK_EQUAL(EXDEV, ec.value());
+
+  // Escaping isn't restricted without resolve_flags.
+  fh = open(sub, "../a", open_flags::access_read | open_flags::open_existing);
+  BOOST_CHECK(fh.is_open());
+
+  // Staying below |dh| is fine.
+  directory_handle sub2 = open_directory(dh, "sub/../sub",
+                                         resolve_flags::beneath);
+  BOOST_CHECK(sub2.is_open());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
@@ -0,0 +1,148 @@
+#include "asioext/directory_reader.hpp"
+#include "asioext/open.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+ASIOEXT_NS_BEGIN
+
+BOOST_AUTO_TEST_SUITE(asioext_directory_reader)
+
+// BOOST_AUTO_TEST_SUITE() gives us a unique NS, so we don't need to
+// prefix our variables.
+
+static const char* dir_name = "asioext_dirreader_test";
+static const std::size_t num_files = 300;
+
+struct test_tree
+{
+  test_tree()
+  {
+    boost::filesystem::create_directory(dir_name);
+    directory_handle dir = open_directory(dir_name);
+    for (std::size_t i = 0; i != num_files; ++i) {
+      open(dir, ("file" + std::to_string(i)).c_str(),
+           open_flags::access_write | open_flags::create_always);
+    }
+    boost::filesystem::create_directory("asioext_dirreader_test/sub");
+    boost::filesystem::create_symlink("file0",
+                                      "asioext_dirreader_test/link");
+  }
+
+  ~test_tree()
+  {
+    boost::filesystem::remove_all(dir_name);
+  }
+};
+
+static bool by_name(const directory_entry& a, const directory_entry& b)
+{
+  return a.name < b.name;
+}
+
+static const directory_entry* find(const std::vector<directory_entry>& v,
+                                   const std::string& name)
+{
+  for (const directory_entry& e : v) {
+    if (e.name == name)
+      return &e;
+  }
+  return nullptr;
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+  directory_reader reader;
+  BOOST_CHECK(!reader.is_open());
+
+  std::vector<directory_entry> entries;
+  error_code ec;
+  BOOST_CHECK_EQUAL(0, reader.read(entries, ec));
+  BOOST_CHECK(ec);
+}
+
+BOOST_AUTO_TEST_CASE(read_sync)
+{
+  test_tree tree;
+
+  // Small buffer, so we need multiple batches.
+  directory_reader reader(open_directory(dir_name), 1024);
+  BOOST_REQUIRE(reader.is_open());
+
+  std::vector<directory_entry> entries;
+  std::size_t batches = 0;
+  while (reader.read(entries) != 0)
+    ++batches;
+
+  BOOST_CHECK_GT(batches, 1);
+  BOOST_REQUIRE_EQUAL(num_files + 2, entries.size());
+  BOOST_CHECK(!find(entries, "."));
+  BOOST_CHECK(!find(entries, ".."));
+
+  std::sort(entries.begin(), entries.end(), by_name);
+  BOOST_CHECK(std::adjacent_find(entries.begin(), entries.end(),
+      [] (const directory_entry& a, const directory_entry& b) {
+        return a.name == b.name;
+      }) == entries.end());
+
+  const directory_entry* file = find(entries, "file42");
+  const directory_entry* sub = find(entries, "sub");
+  const directory_entry* link = find(entries, "link");
+  BOOST_REQUIRE(file && sub && link);
+
+  // Some file systems don't report types.
+  if (file->type != file_type::unknown) {
+    BOOST_CHECK(file->type == file_type::regular);
+    BOOST_CHECK(sub->type == file_type::directory);
+    BOOST_CHECK(link->type == file_type::symlink);
+  }
+
+  const file_info file_info = reader.stat(*file);
+  BOOST_CHECK(file_info.type == file_type::regular);
+  BOOST_CHECK_EQUAL(file->inode, file_info.inode);
+  BOOST_CHECK(reader.stat(*sub).type == file_type::directory);
+  BOOST_CHECK(reader.stat(*link).type == file_type::symlink);
+
+  // Exhausted readers stay that way.
+  BOOST_CHECK_EQUAL(0, reader.read(entries));
+}
+
+BOOST_AUTO_TEST_CASE(read_async)
+{
+  test_tree tree;
+
+  asio::io_context io_context;
+  asio::add_service(io_context, new thread_pool_file_service(io_context, 2));
+
+  directory_reader reader(open_directory(dir_name), 1024);
+  std::vector<directory_entry> entries;
+  std::size_t batches = 0;
+  bool done = false;
+
+  std::function<void (error_code, std::size_t)> on_read;
+  on_read = [&] (error_code ec, std::size_t n) {
+    BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+    if (n == 0) {
+      done = true;
+      return;
+    }
+    ++batches;
+    async_read_directory(io_context, reader, entries, on_read);
+  };
+
+  async_read_directory(io_context, reader, entries, on_read);
+  io_context.run();
+
+  BOOST_CHECK(done);
+  BOOST_CHECK_GT(batches, 1);
+  BOOST_CHECK_EQUAL(num_files + 2, entries.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
@@ -2,6 +2,7 @@
 
 #include "asioext/unique_file_handle.hpp"
 #include "asioext/open.hpp"
+#include "asioext/query.hpp"
 
 #if defined(ASIOEXT_USE_BOOST_ASIO)
 # include <boost/asio/write.hpp>
@@ -287,6 +288,100 @@ BOOST_AUTO_TEST_CASE(set_times_manual)
 #endif
 }
 
+BOOST_AUTO_TEST_CASE(query)
+{
+  test_file_rm_guard rguard1(test_filename);
+
+  asioext::error_code ec;
+  asioext::unique_file_handle fh = asioext::open(test_filename,
+    asioext::open_flags::access_write |
+    asioext::open_flags::create_always, ec);
+  BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+
+  BOOST_REQUIRE_EQUAL(test_data_size,
+                      asio::write(fh, asio::buffer(test_data,
+                                                   test_data_size)));
+
+  const file_info info = fh.query(file_info_mask::all, ec);
+  BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+  BOOST_CHECK(file_type::regular == info.type);
+  BOOST_CHECK_EQUAL(test_data_size, info.size);
+  BOOST_CHECK_EQUAL(1, info.hard_links);
+  BOOST_CHECK(fh.permissions() == info.perms);
+  BOOST_CHECK(fh.attributes() == info.attrs);
+  BOOST_CHECK(fh.times() == info.times);
+
+  // Members that weren't requested are left alone.
+  const file_info partial = fh.query(file_info_mask::size);
+  BOOST_CHECK_EQUAL(test_data_size, partial.size);
+  BOOST_CHECK(file_type::unknown == partial.type);
+  BOOST_CHECK_EQUAL(0, partial.inode);
+  BOOST_CHECK_EQUAL(0, partial.times.mtime.time_since_epoch().count());
+
+  // The path-based variant refers to the same file.
+  const file_info by_path = asioext::query(test_filename);
+  BOOST_CHECK_EQUAL(info.inode, by_path.inode);
+  BOOST_CHECK_EQUAL(info.device, by_path.device);
+  BOOST_CHECK_EQUAL(info.size, by_path.size);
+
+  asioext::query("asioext_scopedfilehandle_nonexistent",
+                 file_info_mask::all, ec);
+  BOOST_CHECK(ec);
+  BOOST_CHECK_THROW(asioext::query("asioext_scopedfilehandle_nonexistent"),
+                    std::exception);
+}
+
+// Classic POSIX record locks don't conflict within a process.
+#if defined(ASIOEXT_HAS_OFD_LOCKS) || defined(ASIOEXT_WINDOWS)
+BOOST_AUTO_TEST_CASE(lock)
+{
+  test_file_rm_guard rguard1(test_filename);
+
+  asioext::error_code ec;
+  asioext::unique_file_handle a = asioext::open(test_filename,
+    asioext::open_flags::access_read_write |
+    asioext::open_flags::create_always, ec);
+  BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+
+  asioext::unique_file_handle b = asioext::open(test_filename,
+    asioext::open_flags::access_read_write |
+    asioext::open_flags::open_existing, ec);
+  BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+
+  const file_range first{0, 100};
+  const file_range second{100, 100};
+
+  a.lock(first, lock_type::exclusive, ec);
+  BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+
+  // Conflicting locks fail, independent ranges don't.
+  BOOST_CHECK(!b.try_lock(first, lock_type::shared, ec));
+  BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+  BOOST_CHECK(b.try_lock(second, lock_type::exclusive, ec));
+  BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+  BOOST_CHECK(!a.try_lock(second, lock_type::shared));
+
+  a.unlock(first);
+  b.unlock(second);
+
+  // Shared locks may overlap.
+  BOOST_CHECK(a.try_lock(first, lock_type::shared));
+  BOOST_CHECK(b.try_lock(first, lock_type::shared));
+  BOOST_CHECK(!b.try_lock(first, lock_type::exclusive));
+  a.unlock(first);
+  b.unlock(first);
+
+  {
+    file_lock_guard<asioext::unique_file_handle> guard(
+        a, first, lock_type::exclusive);
+    BOOST_CHECK(guard.owns_lock());
+    BOOST_CHECK(!b.try_lock(first, lock_type::exclusive));
+  }
+  BOOST_CHECK(b.try_lock(first, lock_type::exclusive));
+  b.unlock(first);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ASIOEXT_NS_END
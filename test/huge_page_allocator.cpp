@@ -0,0 +1,78 @@
+#include "asioext/huge_page_allocator.hpp"
+
+#if defined(ASIOEXT_HAS_HUGE_PAGES)
+
+#include "asioext/linear_buffer.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <string>
+
+ASIOEXT_NS_BEGIN
+
+BOOST_AUTO_TEST_SUITE(asioext_huge_page_allocator)
+
+BOOST_AUTO_TEST_CASE(allocate)
+{
+  const std::size_t page_size = detail::mapped_memory::huge_page_size();
+  huge_page_allocator<uint8_t> a;
+  BOOST_CHECK_EQUAL(page_size, a.threshold());
+  BOOST_CHECK(!a.prefault());
+
+  // Small blocks come from the heap.
+  uint8_t* p = a.allocate(100);
+  std::memset(p, 'x', 100);
+  a.deallocate(p, 100);
+
+  // Large ones are huge page aligned mappings.
+  p = a.allocate(page_size + 1);
+  BOOST_CHECK_EQUAL(0, reinterpret_cast<std::size_t>(p) % page_size);
+  p[0] = 'a';
+  p[page_size] = 'b';
+  a.deallocate(p, page_size + 1);
+}
+
+BOOST_AUTO_TEST_CASE(prefault)
+{
+  huge_page_allocator<uint8_t> a(1024, true);
+  BOOST_CHECK(a.prefault());
+
+  uint8_t* p = a.allocate(4096);
+  BOOST_CHECK_EQUAL(0, p[0]);
+  BOOST_CHECK_EQUAL(0, p[4095]);
+  a.deallocate(p, 4096);
+}
+
+BOOST_AUTO_TEST_CASE(rebind)
+{
+  huge_page_allocator<uint8_t> a(1024, true);
+  huge_page_allocator<uint32_t> b(a);
+  BOOST_CHECK_EQUAL(1024, b.threshold());
+  BOOST_CHECK(b.prefault());
+  BOOST_CHECK(a == b);
+  BOOST_CHECK(a != huge_page_allocator<uint8_t>());
+}
+
+BOOST_AUTO_TEST_CASE(linear_buffer)
+{
+  typedef huge_page_allocator<uint8_t> allocator_type;
+  basic_linear_buffer<allocator_type> b(allocator_type(64 * 1024));
+
+  std::string expected;
+  for (int i = 0; i != 10000; ++i) {
+    const std::string line = std::to_string(i) + " some data\n";
+    b.append(line.data(), line.size());
+    expected += line;
+  }
+
+  BOOST_CHECK_EQUAL(expected,
+                    std::string(reinterpret_cast<const char*>(b.data()),
+                                b.size()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
+
+#endif
@@ -153,6 +153,376 @@ BOOST_AUTO_TEST_CASE(append)
                       "AAABBB");
 }
 
+BOOST_AUTO_TEST_CASE(erase_front)
+{
+  linear_buffer b;
+  b.reserve(16);
+  const std::size_t cap = b.capacity();
+  b.append("0123456789", 10);
+
+  // Erasing from the front doesn't move anything.
+  const uint8_t* data = b.data();
+  b.erase(std::size_t(0), 3);
+  BOOST_CHECK(data + 3 == b.data());
+  BOOST_CHECK_EQUAL(cap, b.capacity());
+  BOOST_CHECK_EQUAL("3456789",
+                    std::string_view(reinterpret_cast<const char*>(b.data()),
+                                     b.size()));
+
+  // Running out of space at the end moves the data back to the start
+  // instead of growing the buffer.
+  b.append("abcdefghi", 9);
+  BOOST_CHECK(data == b.data());
+  BOOST_CHECK_EQUAL(cap, b.capacity());
+  BOOST_CHECK_EQUAL("3456789abcdefghi",
+                    std::string_view(reinterpret_cast<const char*>(b.data()),
+                                     b.size()));
+
+  b.erase(b.begin());
+  b.erase(std::size_t(0), 6);
+  BOOST_CHECK(data + 7 == b.data());
+  BOOST_CHECK_EQUAL("abcdefghi",
+                    std::string_view(reinterpret_cast<const char*>(b.data()),
+                                     b.size()));
+
+  // Once the erased prefix outweighs the rest, it's compacted right away.
+  b.erase(std::size_t(0), 2);
+  BOOST_CHECK(data == b.data());
+  BOOST_CHECK_EQUAL("cdefghi",
+                    std::string_view(reinterpret_cast<const char*>(b.data()),
+                                     b.size()));
+
+  b.erase(std::size_t(0), 7);
+  BOOST_CHECK(b.empty());
+  BOOST_CHECK(data == b.data());
+
+  // Copies and moves only see the data.
+  b.append("0123456789", 10);
+  b.erase(std::size_t(0), 2);
+  linear_buffer c(b);
+  BOOST_CHECK_EQUAL(8, c.size());
+  // Self-assignment doesn't copy over the data.
+  const linear_buffer& self = b;
+  b = self;
+  BOOST_CHECK_EQUAL("23456789",
+                    std::string_view(reinterpret_cast<const char*>(b.data()),
+                                     b.size()));
+  linear_buffer d(std::move(b));
+  BOOST_CHECK_EQUAL(cap, d.capacity());
+  // Inserting at the front reuses the erased prefix.
+  d.insert(std::size_t(0), "AB", 2);
+  BOOST_CHECK(data == d.data());
+  BOOST_CHECK_EQUAL("AB23456789",
+                    std::string_view(reinterpret_cast<const char*>(d.data()),
+                                     d.size()));
+  d.shrink_to_fit();
+  BOOST_CHECK_EQUAL(10, d.capacity());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(asioext_small_linear_buffer)
+
+// Counts allocations, so we can verify the inline storage is used.
+struct counting_allocator : std::allocator<uint8_t>
+{
+  typedef uint8_t value_type;
+
+  template <typename U>
+  struct rebind { typedef counting_allocator other; };
+
+  counting_allocator() = default;
+
+  explicit counting_allocator(std::size_t* count)
+    : count(count)
+  {}
+
+  uint8_t* allocate(std::size_t n)
+  {
+    if (count)
+      ++*count;
+    return std::allocator<uint8_t>::allocate(n);
+  }
+
+  std::size_t* count = nullptr;
+};
+
+typedef basic_small_linear_buffer<16, counting_allocator> small_buffer_type;
+
+BOOST_AUTO_TEST_CASE(inline_storage)
+{
+  std::size_t allocations = 0;
+  small_buffer_type b((counting_allocator(&allocations)));
+  BOOST_CHECK_EQUAL(0, b.size());
+  BOOST_CHECK_EQUAL(16, b.capacity());
+
+  b.append("AAAA", 4);
+  b.insert(std::size_t(0), "BBBB", 4);
+  b.insert(4, "CCCC", 4);
+  BOOST_CHECK_EQUAL(std::string_view(reinterpret_cast<const char*>(b.data()),
+                                     b.size()),
+                    "BBBBCCCCAAAA");
+  b.resize(16);
+  BOOST_CHECK_EQUAL(16, b.capacity());
+  BOOST_CHECK_EQUAL(0, allocations);
+
+  // Spill to the heap.
+  b.append("D", 1);
+  BOOST_CHECK_EQUAL(1, allocations);
+  BOOST_CHECK_EQUAL(17, b.size());
+  BOOST_CHECK_EQUAL(std::string_view(reinterpret_cast<const char*>(b.data()),
+                                     12),
+                    "BBBBCCCCAAAA");
+  BOOST_CHECK_EQUAL('D', b[16]);
+}
+
+BOOST_AUTO_TEST_CASE(copy_move)
+{
+  small_linear_buffer<16> a;
+  a.append("HELLO", 5);
+
+  small_linear_buffer<16> b(a);
+  BOOST_CHECK_EQUAL(std::string_view(reinterpret_cast<const char*>(b.data()),
+                                     b.size()),
+                    "HELLO");
+  BOOST_CHECK(a.data() != b.data());
+
+  small_linear_buffer<16> c(std::move(a));
+  BOOST_CHECK_EQUAL(0, a.size());
+  BOOST_CHECK_EQUAL(16, a.capacity());
+  BOOST_CHECK_EQUAL(std::string_view(reinterpret_cast<const char*>(c.data()),
+                                     c.size()),
+                    "HELLO");
+
+  // Heap memory is taken over.
+  c.resize(32);
+  const uint8_t* heap_data = c.data();
+  a = std::move(c);
+  BOOST_CHECK(a.data() == heap_data);
+  BOOST_CHECK_EQUAL(32, a.size());
+  BOOST_CHECK_EQUAL(0, c.size());
+  BOOST_CHECK_EQUAL(16, c.capacity());
+
+  // Inline contents can be moved into a plain linear_buffer. That needs
+  // an allocation, so unlike moving a linear_buffer, it can throw.
+  static_assert(std::is_nothrow_move_constructible<linear_buffer>::value,
+                "moving a linear_buffer must not throw");
+  static_assert(std::is_nothrow_move_constructible<
+                    small_linear_buffer<16>>::value,
+                "moving a small_linear_buffer must not throw");
+  static_assert(!std::is_nothrow_constructible<
+                    linear_buffer, small_linear_buffer<16>&&>::value,
+                "moving inline data into a linear_buffer allocates");
+  linear_buffer d(std::move(b));
+  BOOST_CHECK_EQUAL(std::string_view(reinterpret_cast<const char*>(d.data()),
+                                     d.size()),
+                    "HELLO");
+  BOOST_CHECK_EQUAL(0, b.size());
+
+  b.append("WORLD", 5);
+  d = std::move(b);
+  BOOST_CHECK_EQUAL(std::string_view(reinterpret_cast<const char*>(d.data()),
+                                     d.size()),
+                    "WORLD");
+  BOOST_CHECK_EQUAL(0, b.size());
+}
+
+BOOST_AUTO_TEST_CASE(copy_move_allocator)
+{
+  std::size_t allocations = 0;
+  small_buffer_type a((counting_allocator(&allocations)));
+  a.append("HELLO", 5);
+
+  // Copies and moves keep using the same (stateful) allocator.
+  small_buffer_type b(a);
+  BOOST_CHECK(b.get_allocator().count == &allocations);
+  b.resize(32);
+  BOOST_CHECK_EQUAL(1, allocations);
+
+  small_buffer_type c(std::move(b));
+  BOOST_CHECK(c.get_allocator().count == &allocations);
+  c.resize(64);
+  BOOST_CHECK_EQUAL(2, allocations);
+
+  small_buffer_type d(std::move(a));
+  BOOST_CHECK(d.get_allocator().count == &allocations);
+  d.resize(32);
+  BOOST_CHECK_EQUAL(3, allocations);
+}
+
+BOOST_AUTO_TEST_CASE(dynamic_buffer)
+{
+  small_linear_buffer<16> b;
+  auto db = asio::dynamic_buffer(b);
+  db.grow(5);
+  std::memcpy(db.data(0, 5).data(), "HELLO", 5);
+  db.consume(1);
+  BOOST_CHECK_EQUAL(std::string_view(reinterpret_cast<const char*>(b.data()),
+                                     b.size()),
+                    "ELLO");
+}
+
+BOOST_AUTO_TEST_CASE(shrink_to_fit)
+{
+  std::size_t allocations = 0;
+  small_buffer_type b((counting_allocator(&allocations)));
+  b.resize(64);
+  BOOST_CHECK_EQUAL(1, allocations);
+
+  b.resize(8);
+  b.shrink_to_fit();
+  BOOST_CHECK_EQUAL(16, b.capacity());
+  BOOST_CHECK_EQUAL(8, b.size());
+
+  // Already inline, nothing to do.
+  b.shrink_to_fit();
+  BOOST_CHECK_EQUAL(16, b.capacity());
+  BOOST_CHECK_EQUAL(1, allocations);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(asioext_growth_policy)
+
+BOOST_AUTO_TEST_CASE(geometric)
+{
+  BOOST_CHECK_EQUAL(20, geometric_growth<>::grow(10, 11, 100));
+  BOOST_CHECK_EQUAL(50, geometric_growth<>::grow(10, 50, 100));
+  BOOST_CHECK_EQUAL(100, geometric_growth<>::grow(60, 61, 100));
+
+  typedef geometric_growth<3, 2> one_and_a_half;
+  BOOST_CHECK_EQUAL(15, one_and_a_half::grow(10, 11, 100));
+  BOOST_CHECK_EQUAL(16, one_and_a_half::grow(11, 12, 100));
+  BOOST_CHECK_EQUAL(100, one_and_a_half::grow(90, 91, 100));
+
+  basic_linear_buffer<std::allocator<uint8_t>, one_and_a_half> b(16);
+  b.resize(17);
+  BOOST_CHECK_EQUAL(24, b.capacity());
+}
+
+BOOST_AUTO_TEST_CASE(fixed_step)
+{
+  typedef fixed_step_growth<64> policy;
+  BOOST_CHECK_EQUAL(64, policy::grow(0, 1, 1000));
+  BOOST_CHECK_EQUAL(128, policy::grow(64, 128, 1000));
+  BOOST_CHECK_EQUAL(192, policy::grow(128, 129, 1000));
+  BOOST_CHECK_EQUAL(1000, policy::grow(960, 961, 1000));
+}
+
+BOOST_AUTO_TEST_CASE(page_rounded)
+{
+  typedef page_rounded_growth<> policy;
+  BOOST_CHECK_EQUAL(4096, policy::grow(0, 1, 1 << 20));
+  BOOST_CHECK_EQUAL(8192, policy::grow(4096, 4097, 1 << 20));
+  BOOST_CHECK_EQUAL(12288, policy::grow(5000, 5001, 1 << 20));
+  BOOST_CHECK_EQUAL(4096, policy::grow(10, 11, 5000));
+  BOOST_CHECK_EQUAL(5000, policy::grow(2048, 2049, 5000));
+}
+
+BOOST_AUTO_TEST_CASE(size_class)
+{
+  BOOST_CHECK_EQUAL(16, size_class_growth::grow(0, 1, 1000));
+  BOOST_CHECK_EQUAL(20, size_class_growth::grow(16, 17, 1000));
+  BOOST_CHECK_EQUAL(32, size_class_growth::grow(28, 29, 1000));
+  BOOST_CHECK_EQUAL(40, size_class_growth::grow(32, 33, 1000));
+  BOOST_CHECK_EQUAL(640, size_class_growth::grow(512, 600, 1000));
+  BOOST_CHECK_EQUAL(1000, size_class_growth::grow(900, 980, 1000));
+}
+
+BOOST_AUTO_TEST_CASE(hysteresis)
+{
+  typedef hysteresis_shrink<geometric_growth<>, 4, 64> policy;
+  BOOST_CHECK_EQUAL(1024, policy::shrink(1024, 257));
+  BOOST_CHECK_EQUAL(512, policy::shrink(1024, 256));
+  BOOST_CHECK_EQUAL(64, policy::shrink(1024, 0));
+  BOOST_CHECK_EQUAL(64, policy::shrink(64, 0));
+
+  basic_linear_buffer<std::allocator<uint8_t>, policy> b;
+  b.resize(1024);
+  BOOST_CHECK_EQUAL(1024, b.capacity());
+
+  b.erase(0, 500);
+  BOOST_CHECK_EQUAL(1024, b.capacity());
+
+  b.resize(100);
+  BOOST_CHECK_EQUAL(200, b.capacity());
+
+  b.clear();
+  BOOST_CHECK_EQUAL(200, b.capacity());
+
+  // Consuming through a dynamic buffer shrinks as well.
+  b.resize(200);
+  std::memset(b.data(), 'x', b.size());
+  b[150] = 'y';
+  auto db = asio::dynamic_buffer(b);
+  db.consume(150);
+  BOOST_CHECK_EQUAL(100, b.capacity());
+  BOOST_CHECK_EQUAL(50, b.size());
+  BOOST_CHECK_EQUAL('y', b[0]);
+}
+
+BOOST_AUTO_TEST_CASE(shrink_to_fit)
+{
+  linear_buffer b;
+  b.resize(100);
+  b.resize(10);
+  BOOST_CHECK_EQUAL(100, b.capacity());
+
+  b.shrink_to_fit();
+  BOOST_CHECK_EQUAL(10, b.capacity());
+  BOOST_CHECK_EQUAL(10, b.size());
+
+  b.clear();
+  b.shrink_to_fit();
+  BOOST_CHECK_EQUAL(0, b.capacity());
+  BOOST_CHECK(b.data() == nullptr);
+}
+
+// Grows blocks in place as long as they fit into its arena.
+struct expanding_allocator : std::allocator<uint8_t>
+{
+  typedef uint8_t value_type;
+
+  template <typename U>
+  struct rebind { typedef expanding_allocator other; };
+
+  uint8_t* allocate(std::size_t n)
+  {
+    BOOST_REQUIRE_LE(n, sizeof(arena));
+    ++allocations;
+    return arena;
+  }
+
+  void deallocate(uint8_t*, std::size_t)
+  {}
+
+  bool expand(uint8_t* p, std::size_t /*n*/, std::size_t new_n)
+  {
+    BOOST_CHECK(p == arena);
+    return new_n <= sizeof(arena);
+  }
+
+  static uint8_t arena[256];
+  static std::size_t allocations;
+};
+
+uint8_t expanding_allocator::arena[256];
+std::size_t expanding_allocator::allocations = 0;
+
+BOOST_AUTO_TEST_CASE(expand)
+{
+  basic_linear_buffer<expanding_allocator> b;
+  b.append("HELLO", 5);
+  BOOST_CHECK_EQUAL(1, expanding_allocator::allocations);
+
+  b.resize(100);
+  b.insert(std::size_t(1), "..", 2);
+  b.reserve(256);
+  BOOST_CHECK_EQUAL(256, b.capacity());
+  BOOST_CHECK_EQUAL(1, expanding_allocator::allocations);
+  BOOST_CHECK(0 == std::memcmp(b.data(), "H..ELLO", 7));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(asioext_dynamic_linear_buffer)
@@ -0,0 +1,206 @@
+#include "asioext/mirrored_ring_buffer.hpp"
+
+#if defined(ASIOEXT_HAS_MIRRORED_MAPPING)
+
+#include "test_file_rm_guard.hpp"
+#include "test_file_writer.hpp"
+
+#include "asioext/open.hpp"
+#include "asioext/detail/asio_version.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/read_until.hpp>
+#else
+# include <asio/read_until.hpp>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <string>
+
+ASIOEXT_NS_BEGIN
+
+#if (ASIOEXT_ASIO_VERSION >= 101400)
+# if !defined(ASIOEXT_NO_DYNAMIC_BUFFER_V1)
+static_assert(asio::is_dynamic_buffer_v1<
+                  asioext::dynamic_mirrored_ring_buffer>::value,
+              "concept check");
+# endif
+static_assert(asio::is_dynamic_buffer_v2<
+                  asioext::dynamic_mirrored_ring_buffer>::value,
+              "concept check");
+#else
+static_assert(asio::is_dynamic_buffer<
+                  asioext::dynamic_mirrored_ring_buffer>::value,
+              "concept check");
+#endif
+
+static std::string to_string(const mirrored_ring_buffer& b)
+{
+  return std::string(reinterpret_cast<const char*>(b.data()), b.size());
+}
+
+BOOST_AUTO_TEST_SUITE(asioext_mirrored_ring_buffer)
+
+BOOST_AUTO_TEST_CASE(basic_construction)
+{
+  mirrored_ring_buffer x1;
+  BOOST_CHECK_EQUAL(0, x1.size());
+  BOOST_CHECK_EQUAL(0, x1.capacity());
+
+  mirrored_ring_buffer x2(16, 1024 * 1024);
+  BOOST_CHECK_EQUAL(0, x2.size());
+  BOOST_CHECK_LE(16, x2.capacity());
+  BOOST_CHECK_EQUAL(1024 * 1024, x2.max_size());
+}
+
+BOOST_AUTO_TEST_CASE(mirror)
+{
+  mirrored_ring_buffer b(1);
+  const std::size_t cap = b.capacity();
+
+  // Both halves refer to the same memory.
+  b.resize(1);
+  b[0] = 'a';
+  BOOST_CHECK_EQUAL('a', b.data()[cap]);
+  b.data()[cap] = 'b';
+  BOOST_CHECK_EQUAL('b', b[0]);
+}
+
+BOOST_AUTO_TEST_CASE(wrap_around)
+{
+  mirrored_ring_buffer b(1);
+  const std::size_t cap = b.capacity();
+
+  std::string expected(cap - 10, 'x');
+  b.append(expected.data(), expected.size());
+  b.consume(cap - 20);
+  expected.erase(0, cap - 20);
+  BOOST_CHECK_EQUAL(expected, to_string(b));
+
+  // Crosses the end of the ring, but stays contiguous.
+  const std::string tail = "0123456789abcdefghijklmnopqrstuvwxyz";
+  b.append(tail.data(), tail.size());
+  expected += tail;
+  BOOST_CHECK_EQUAL(cap, b.capacity());
+  BOOST_CHECK_EQUAL(expected, to_string(b));
+
+  b.consume(expected.size());
+  BOOST_CHECK(b.empty());
+  BOOST_CHECK_EQUAL(cap, b.capacity());
+}
+
+BOOST_AUTO_TEST_CASE(grow)
+{
+  mirrored_ring_buffer b(1);
+  const std::size_t cap = b.capacity();
+
+  std::string expected(cap - 3, 'y');
+  b.append(expected.data(), expected.size());
+  b.consume(5);
+  expected.erase(0, 5);
+
+  // Data that wrapped around is moved to the start of the new ring.
+  const std::string more(cap, 'z');
+  b.append(more.data(), more.size());
+  expected += more;
+  BOOST_CHECK_LE(expected.size(), b.capacity());
+  BOOST_CHECK_EQUAL(expected, to_string(b));
+}
+
+BOOST_AUTO_TEST_CASE(max_size)
+{
+  mirrored_ring_buffer b(1, 16);
+  b.resize(16);
+  BOOST_CHECK_THROW(b.prepare(1), std::length_error);
+
+  error_code ec;
+  b.prepare(1, ec);
+  BOOST_CHECK_EQUAL(asio::error::no_memory, ec);
+
+  b.consume(1);
+  BOOST_CHECK_EQUAL(1, b.prepare(1, ec).size());
+  BOOST_CHECK(!ec);
+}
+
+BOOST_AUTO_TEST_CASE(move)
+{
+  mirrored_ring_buffer a(1);
+  a.append("HELLO", 5);
+
+  mirrored_ring_buffer b(std::move(a));
+  BOOST_CHECK_EQUAL(0, a.capacity());
+  BOOST_CHECK_EQUAL("HELLO", to_string(b));
+
+  a = std::move(b);
+  BOOST_CHECK_EQUAL(0, b.capacity());
+  BOOST_CHECK_EQUAL("HELLO", to_string(a));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(asioext_dynamic_mirrored_ring_buffer)
+
+#if !defined(ASIOEXT_NO_DYNAMIC_BUFFER_V1)
+BOOST_AUTO_TEST_CASE(prepare_commit)
+{
+  mirrored_ring_buffer b;
+  dynamic_mirrored_ring_buffer db(b, 8);
+
+  BOOST_CHECK_EQUAL(5, db.prepare(5).size());
+  std::memcpy(b.end(), "HELLO", 5);
+  db.commit(5);
+  BOOST_CHECK_EQUAL(5, db.size());
+  BOOST_CHECK_THROW(db.prepare(4), std::length_error);
+
+  db.consume(2);
+  BOOST_CHECK_EQUAL("LLO", std::string(static_cast<const char*>(
+      db.data().data()), db.data().size()));
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(grow_shrink)
+{
+  mirrored_ring_buffer b;
+  dynamic_mirrored_ring_buffer db(b);
+
+  db.grow(5);
+  std::memcpy(db.data(0, 5).data(), "HELLO", 5);
+  BOOST_CHECK_EQUAL(5, db.size());
+  BOOST_CHECK_EQUAL(3, db.data(2, 10).size());
+
+  db.shrink(2);
+  db.consume(1);
+  BOOST_CHECK_EQUAL("EL", to_string(b));
+
+  db.shrink(10);
+  BOOST_CHECK_EQUAL(0, db.size());
+}
+
+BOOST_AUTO_TEST_CASE(read_until)
+{
+  static const char* test_filename = "asioext_mirrored_ring_buffer_test";
+  static const char test_data[] = "first line\nsecond line\n";
+  test_file_writer writer(test_filename, test_data, sizeof(test_data) - 1);
+
+  unique_file_handle fh = open(test_filename,
+                               open_flags::access_read |
+                               open_flags::open_existing);
+
+  mirrored_ring_buffer b;
+  std::size_t n = asio::read_until(fh, dynamic_buffer(b), '\n');
+  BOOST_REQUIRE_EQUAL(11, n);
+  BOOST_CHECK_EQUAL("first line\n", to_string(b).substr(0, n));
+  b.consume(n);
+
+  n = asio::read_until(fh, dynamic_buffer(b), '\n');
+  BOOST_REQUIRE_EQUAL(12, n);
+  BOOST_CHECK_EQUAL("second line\n", to_string(b));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
+
+#endif
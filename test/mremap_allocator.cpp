@@ -0,0 +1,68 @@
+#include "asioext/mremap_allocator.hpp"
+
+#if defined(ASIOEXT_HAS_MREMAP)
+
+#include "asioext/linear_buffer.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <string>
+
+ASIOEXT_NS_BEGIN
+
+BOOST_AUTO_TEST_SUITE(asioext_mremap_allocator)
+
+BOOST_AUTO_TEST_CASE(try_realloc)
+{
+  mremap_allocator<uint8_t> a;
+
+  uint8_t* p = a.allocate(100);
+  std::memset(p, 'x', 100);
+
+  // Stays within the first page.
+  BOOST_CHECK(p == a.try_realloc(p, 100, 200));
+
+  const std::size_t big = 16 * 1024 * 1024;
+  p = a.try_realloc(p, 200, big);
+  BOOST_REQUIRE(p != nullptr);
+  BOOST_CHECK_EQUAL(std::string(100, 'x'),
+                    std::string(reinterpret_cast<char*>(p), 100));
+  p[big - 1] = 'y';
+
+  p = a.try_realloc(p, big, 100);
+  BOOST_REQUIRE(p != nullptr);
+  BOOST_CHECK_EQUAL(std::string(100, 'x'),
+                    std::string(reinterpret_cast<char*>(p), 100));
+  a.deallocate(p, 100);
+}
+
+BOOST_AUTO_TEST_CASE(linear_buffer)
+{
+  basic_linear_buffer<mremap_allocator<uint8_t>> b;
+
+  std::string expected;
+  for (int i = 0; i != 1000; ++i) {
+    const std::string line = std::to_string(i) + " some data\n";
+    b.append(line.data(), line.size());
+    expected += line;
+  }
+
+  b.reserve(64 * 1024 * 1024);
+  BOOST_CHECK_EQUAL(expected,
+                    std::string(reinterpret_cast<const char*>(b.data()),
+                                b.size()));
+
+  b.insert(std::size_t(0), "HEAD", 4);
+  b.resize(b.size() + 1024 * 1024 * 128);
+  b.resize(4);
+  b.shrink_to_fit();
+  BOOST_CHECK_EQUAL("HEAD", std::string(reinterpret_cast<const char*>(
+                                        b.data()), b.size()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
+
+#endif
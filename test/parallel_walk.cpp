@@ -0,0 +1,198 @@
+#include "asioext/parallel_walk.hpp"
+#include "asioext/open.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+ASIOEXT_NS_BEGIN
+
+BOOST_AUTO_TEST_SUITE(asioext_parallel_walk)
+
+// BOOST_AUTO_TEST_SUITE() gives us a unique NS, so we don't need to
+// prefix our variables.
+
+static const char* root_name = "asioext_parallelwalk_test";
+
+// root/
+//   f0 ... f9
+//   d0/ ... d4/
+//     f0 ... f9
+//     sub/
+//       f0 ... f9
+//   link -> d0
+struct test_tree
+{
+  test_tree()
+  {
+    namespace fs = boost::filesystem;
+    const fs::path root = root_name;
+    fs::create_directory(root);
+    create_files(root);
+    for (int i = 0; i != 5; ++i) {
+      const fs::path d = root / ("d" + std::to_string(i));
+      fs::create_directory(d);
+      create_files(d);
+      fs::create_directory(d / "sub");
+      create_files(d / "sub");
+    }
+    fs::create_directory_symlink("d0", root / "link");
+  }
+
+  ~test_tree()
+  {
+    boost::filesystem::remove_all(root_name);
+  }
+
+  static void create_files(const boost::filesystem::path& dir)
+  {
+    for (int i = 0; i != 10; ++i) {
+      const boost::filesystem::path p = dir / ("f" + std::to_string(i));
+      open(p.string().c_str(),
+           open_flags::access_write | open_flags::create_always)
+          .write_some(asio::buffer(p.string()));
+    }
+  }
+};
+
+// 10 + 5 + 1 in the root, 10 + 1 + 10 in each d*.
+static const uint64_t num_entries = 16 + 5 * 21;
+
+struct collector
+{
+  walk_action operator()(const walk_entry& e)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string path = e.parent_path.empty() ?
+        e.entry.name : e.parent_path + '/' + e.entry.name;
+    paths.push_back(path);
+    max_depth = (std::max)(max_depth, e.depth);
+    return walk_action::proceed;
+  }
+
+  bool contains(const std::string& path) const
+  {
+    return std::find(paths.begin(), paths.end(), path) != paths.end();
+  }
+
+  std::mutex mutex;
+  std::vector<std::string> paths;
+  std::size_t max_depth = 0;
+};
+
+BOOST_AUTO_TEST_CASE(walk)
+{
+  test_tree tree;
+
+  for (std::size_t threads : {1, 4}) {
+    collector c;
+    walk_options options;
+    options.threads = threads;
+    options.buffer_size = 1024;
+
+    BOOST_CHECK_EQUAL(num_entries, parallel_walk(root_name, c, options));
+    BOOST_CHECK_EQUAL(num_entries, c.paths.size());
+    BOOST_CHECK_EQUAL(3, c.max_depth);
+    BOOST_CHECK(c.contains("f3"));
+    BOOST_CHECK(c.contains("d2/f9"));
+    BOOST_CHECK(c.contains("d4/sub/f0"));
+
+    // Symbolic links aren't followed.
+    BOOST_CHECK(c.contains("link"));
+    BOOST_CHECK(!c.contains("link/f0"));
+
+    std::sort(c.paths.begin(), c.paths.end());
+    BOOST_CHECK(std::unique(c.paths.begin(), c.paths.end()) ==
+                c.paths.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(prune_and_depth)
+{
+  test_tree tree;
+
+  collector c;
+  walk_options options;
+  options.threads = 3;
+  options.max_depth = 2;
+  const uint64_t n = parallel_walk(root_name, [&c] (const walk_entry& e) {
+    c(e);
+    return e.entry.name == "d1" ? walk_action::prune : walk_action::proceed;
+  }, options);
+
+  // Everything but d*/sub/* and d1/*.
+  BOOST_CHECK_EQUAL(16 + 4 * 11, n);
+  BOOST_CHECK_EQUAL(2, c.max_depth);
+  BOOST_CHECK(c.contains("d1"));
+  BOOST_CHECK(!c.contains("d1/f0"));
+  BOOST_CHECK(c.contains("d0/sub"));
+  BOOST_CHECK(!c.contains("d0/sub/f0"));
+}
+
+BOOST_AUTO_TEST_CASE(stat_entries)
+{
+  test_tree tree;
+
+  walk_options options;
+  options.stat_entries = true;
+
+  std::mutex mutex;
+  std::vector<std::string> bad;
+  parallel_walk(root_name, [&] (const walk_entry& e) {
+    bool ok = e.info != nullptr && e.info->type == e.entry.type;
+    if (ok && e.entry.type == file_type::regular) {
+      // Every file contains its own path.
+      const std::string path = std::string(root_name) + '/' +
+          (e.parent_path.empty() ? "" : e.parent_path + '/') + e.entry.name;
+      ok = e.info->size == path.size() &&
+          e.directory.stat(e.entry.name.c_str()).inode == e.info->inode;
+    }
+    if (!ok) {
+      std::lock_guard<std::mutex> lock(mutex);
+      bad.push_back(e.entry.name);
+    }
+    return walk_action::proceed;
+  }, options);
+
+  BOOST_CHECK(bad.empty());
+}
+
+BOOST_AUTO_TEST_CASE(stop)
+{
+  test_tree tree;
+
+  walk_options options;
+  options.threads = 1;
+  const uint64_t n = parallel_walk(root_name, [] (const walk_entry&) {
+    return walk_action::stop;
+  }, options);
+  BOOST_CHECK_EQUAL(1, n);
+}
+
+BOOST_AUTO_TEST_CASE(errors)
+{
+  error_code ec;
+  parallel_walk("asioext_parallelwalk_nonexistent", [] (const walk_entry&) {
+    return walk_action::proceed;
+  }, walk_options(), ec);
+  BOOST_CHECK(ec);
+
+  test_tree tree;
+
+  walk_options options;
+  options.threads = 4;
+  BOOST_CHECK_THROW(parallel_walk(root_name, [] (const walk_entry& e) {
+    if (e.entry.name == "sub")
+      throw std::runtime_error("test");
+    return walk_action::proceed;
+  }, options), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
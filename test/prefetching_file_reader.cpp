@@ -0,0 +1,236 @@
+#include "test_file_writer.hpp"
+
+#include "asioext/prefetching_file_reader.hpp"
+#include "asioext/file.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/io_context.hpp>
+# include <boost/asio/steady_timer.hpp>
+#else
+# include <asio/io_context.hpp>
+# include <asio/steady_timer.hpp>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+ASIOEXT_NS_BEGIN
+
+BOOST_AUTO_TEST_SUITE(asioext_prefetching_file_reader)
+
+// BOOST_AUTO_TEST_SUITE() gives us a unique NS, so we don't need to
+// prefix our variables.
+
+static const char* test_filename = "asioext_prefetchingfilereader_test";
+static const char* empty_filename = "asioext_prefetchingfilereader_empty";
+
+static std::string make_test_data(std::size_t size)
+{
+  std::string data(size, '\0');
+  for (std::size_t i = 0; i != size; ++i)
+    data[i] = static_cast<char>(i * 7 + i / 251);
+  return data;
+}
+
+// Serves a string, completing each read after a fixed delay.
+class delayed_device
+{
+public:
+  typedef asio::io_context::executor_type executor_type;
+
+  delayed_device(asio::io_context& io_context, const std::string& data,
+                 std::chrono::milliseconds delay)
+    : io_context_(io_context)
+    , data_(data)
+    , delay_(delay)
+  {}
+
+  executor_type get_executor()
+  {
+    return io_context_.get_executor();
+  }
+
+  template <typename MutableBufferSequence, typename ReadHandler>
+  void async_read_some_at(uint64_t offset,
+                          const MutableBufferSequence& buffers,
+                          ReadHandler&& handler)
+  {
+    auto timer = std::make_shared<asio::steady_timer>(io_context_, delay_);
+    timer->async_wait([this, timer, offset, buffers,
+                       handler = std::forward<ReadHandler>(handler)] (
+        error_code) mutable {
+      if (offset >= data_.size()) {
+        handler(error_code(asio::error::eof), std::size_t(0));
+        return;
+      }
+      const std::size_t n = asio::buffer_copy(
+          buffers, asio::buffer(data_) + static_cast<std::size_t>(offset));
+      handler(error_code(), n);
+    });
+  }
+
+private:
+  asio::io_context& io_context_;
+  const std::string& data_;
+  std::chrono::milliseconds delay_;
+};
+
+// Reads all chunks, checking that only the last one is short.
+static std::string read_all(asio::io_context& io_context,
+                            prefetching_file_reader<file>& reader,
+                            std::size_t chunk_size, error_code& ec)
+{
+  std::string result;
+  bool short_chunk = false;
+  std::function<void (error_code, asio::const_buffer)> on_chunk =
+      [&] (error_code e, asio::const_buffer chunk) {
+    if (e) {
+      ec = e;
+      return;
+    }
+
+    BOOST_CHECK(!short_chunk);
+    BOOST_CHECK_LE(chunk.size(), chunk_size);
+    BOOST_CHECK_LE(reader.in_flight(), 4);
+    short_chunk = chunk.size() != chunk_size;
+    result.append(static_cast<const char*>(chunk.data()), chunk.size());
+    reader.async_next(on_chunk);
+  };
+  reader.async_next(on_chunk);
+
+  io_context.restart();
+  io_context.run();
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(read)
+{
+  const std::string data = make_test_data(100000);
+  test_file_writer writer(test_filename, data.data(), data.size());
+
+  asio::io_context io_context;
+  asio::add_service(io_context, new thread_pool_file_service(io_context, 4));
+  file f(io_context, test_filename,
+         open_flags::access_read | open_flags::open_existing);
+
+  prefetch_options options;
+  options.chunk_size = 4096;
+  options.max_depth = 4;
+  prefetching_file_reader<file> reader(f, options);
+
+  error_code ec;
+  const std::string result = read_all(io_context, reader,
+                                      options.chunk_size, ec);
+  BOOST_CHECK_EQUAL(asio::error::eof, ec);
+  BOOST_CHECK(data == result);
+  BOOST_CHECK_EQUAL(0, reader.in_flight());
+  BOOST_CHECK_GE(reader.depth(), options.min_depth);
+  BOOST_CHECK_LE(reader.depth(), options.max_depth);
+}
+
+BOOST_AUTO_TEST_CASE(read_range)
+{
+  const std::string data = make_test_data(50000);
+  test_file_writer writer(test_filename, data.data(), data.size());
+
+  asio::io_context io_context;
+  asio::add_service(io_context, new thread_pool_file_service(io_context, 2));
+  file f(io_context, test_filename,
+         open_flags::access_read | open_flags::open_existing);
+
+  prefetch_options options;
+  options.chunk_size = 1000;
+  options.max_depth = 3;
+
+  prefetching_file_reader<file> reader(f, 123, 20000, options);
+  error_code ec;
+  std::string result = read_all(io_context, reader, options.chunk_size, ec);
+  BOOST_CHECK_EQUAL(asio::error::eof, ec);
+  BOOST_CHECK(data.substr(123, 20000) == result);
+
+  // The range ends past the end of the file.
+  prefetching_file_reader<file> tail(f, 45000, 10000, options);
+  result = read_all(io_context, tail, options.chunk_size, ec);
+  BOOST_CHECK_EQUAL(asio::error::eof, ec);
+  BOOST_CHECK(data.substr(45000) == result);
+}
+
+BOOST_AUTO_TEST_CASE(adapt_depth)
+{
+  const std::string data = make_test_data(100 * 1000);
+
+  asio::io_context io_context;
+  delayed_device device(io_context, data, std::chrono::milliseconds(5));
+
+  prefetch_options options;
+  options.chunk_size = 1000;
+  options.min_depth = 2;
+  options.max_depth = 8;
+  prefetching_file_reader<delayed_device> reader(device, options);
+
+  // The consumer first takes chunks right away, then spends 20 ms on each
+  // (without blocking the io_context, so read completions aren't delayed).
+  const std::size_t fast_chunks = 20;
+  const std::size_t slow_chunks = 10;
+  std::size_t chunks = 0;
+  std::size_t fast_depth = 0;
+  std::string result;
+  asio::steady_timer work(io_context);
+  std::function<void (error_code, asio::const_buffer)> on_chunk =
+      [&] (error_code ec, asio::const_buffer chunk) {
+    BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+    result.append(static_cast<const char*>(chunk.data()), chunk.size());
+    if (++chunks == fast_chunks)
+      fast_depth = reader.depth();
+    if (chunks == fast_chunks + slow_chunks)
+      return;
+
+    if (chunks < fast_chunks) {
+      reader.async_next(on_chunk);
+      return;
+    }
+
+    work.expires_after(std::chrono::milliseconds(20));
+    work.async_wait([&] (error_code) {
+      reader.async_next(on_chunk);
+    });
+  };
+  reader.async_next(on_chunk);
+  io_context.run();
+
+  BOOST_CHECK(data.substr(0, result.size()) == result);
+  BOOST_CHECK_EQUAL(fast_chunks + slow_chunks, chunks);
+
+  // Waiting for reads means more of them should be in flight, while
+  // a consumer that's slower than the reads needs few.
+  BOOST_CHECK_EQUAL(options.max_depth, fast_depth);
+  BOOST_CHECK_EQUAL(options.min_depth, reader.depth());
+}
+
+BOOST_AUTO_TEST_CASE(empty)
+{
+  test_file_writer writer(empty_filename, 0, 0);
+
+  asio::io_context io_context;
+  file f(io_context, empty_filename,
+         open_flags::access_read | open_flags::open_existing);
+  prefetching_file_reader<file> reader(f);
+
+  int completed = 0;
+  reader.async_next([&] (error_code ec, asio::const_buffer chunk) {
+    BOOST_CHECK_EQUAL(asio::error::eof, ec);
+    BOOST_CHECK_EQUAL(0, chunk.size());
+    ++completed;
+  });
+  BOOST_CHECK_EQUAL(0, completed);
+  io_context.run();
+  BOOST_CHECK_EQUAL(1, completed);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
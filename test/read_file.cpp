@@ -1,6 +1,7 @@
 #include "test_file_writer.hpp"
 
 #include "asioext/read_file.hpp"
+#include "asioext/checksum.hpp"
 #include "asioext/open.hpp"
 
 #include <boost/test/unit_test.hpp>
@@ -161,6 +162,32 @@ BOOST_AUTO_TEST_CASE(read_file_buffer)
   BOOST_CHECK_EQUAL(test_data, buffer);
 }
 
+BOOST_AUTO_TEST_CASE(read_file_checksum)
+{
+  write_test_file();
+
+  std::string str;
+  crc32c_hasher hasher;
+  asioext::error_code ec;
+
+  asioext::read_file(test_filename, str, hasher, ec);
+
+  BOOST_REQUIRE(!ec);
+  BOOST_CHECK_EQUAL(test_data, str);
+
+  crc32c_hasher expected;
+  expected.update(test_data, test_data_size);
+  BOOST_CHECK_EQUAL(expected.value(), hasher.value());
+
+  xxhash64_hasher hasher2;
+  BOOST_REQUIRE_NO_THROW(asioext::read_file(test_filename, str, hasher2));
+  BOOST_CHECK_EQUAL(test_data, str);
+
+  xxhash64_hasher expected2;
+  expected2.update(test_data, test_data_size);
+  BOOST_CHECK_EQUAL(expected2.value(), hasher2.value());
+}
+
 #if defined(ASIOEXT_WINDOWS)
 BOOST_AUTO_TEST_CASE(read_file_wide_filename)
 {
@@ -0,0 +1,123 @@
+#include "test_file_writer.hpp"
+
+#include "asioext/read_files.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+ASIOEXT_NS_BEGIN
+
+BOOST_AUTO_TEST_SUITE(asioext_read_files)
+
+// BOOST_AUTO_TEST_SUITE() gives us a unique NS, so we don't need to
+// prefix our variables.
+
+static const char* test_filename1 = "asioext_readfiles_test1";
+static const char* test_filename2 = "asioext_readfiles_test2";
+static const char* empty_filename = "asioext_readfiles_empty";
+static const char test_data1[] = "hello world!";
+static const char test_data2[] = "hello again!!";
+
+BOOST_AUTO_TEST_CASE(read_files_sync)
+{
+  test_file_writer file1(test_filename1, test_data1, sizeof(test_data1) - 1);
+  test_file_writer file2(test_filename2, test_data2, sizeof(test_data2) - 1);
+  test_file_writer file3(empty_filename, 0, 0);
+
+  asio::io_context io_context;
+  asio::add_service(io_context, new thread_pool_file_service(io_context, 2));
+
+  const std::vector<std::string> filenames = {
+    test_filename1, "nosuchfile", test_filename2, empty_filename
+  };
+  std::vector<std::string> contents(filenames.size(), "garbage");
+
+  std::vector<error_code> errors;
+  BOOST_REQUIRE_NO_THROW(
+      errors = read_files(io_context, filenames, contents));
+
+  BOOST_REQUIRE_EQUAL(filenames.size(), errors.size());
+  BOOST_CHECK_MESSAGE(!errors[0], "ec: " << errors[0]);
+  BOOST_CHECK(errors[1]);
+  BOOST_CHECK_MESSAGE(!errors[2], "ec: " << errors[2]);
+  BOOST_CHECK_MESSAGE(!errors[3], "ec: " << errors[3]);
+
+  BOOST_CHECK_EQUAL(test_data1, contents[0]);
+  BOOST_CHECK_EQUAL(test_data2, contents[2]);
+  BOOST_CHECK(contents[3].empty());
+}
+
+BOOST_AUTO_TEST_CASE(read_files_missing_containers)
+{
+  test_file_writer file1(test_filename1, test_data1, sizeof(test_data1) - 1);
+
+  asio::io_context io_context;
+
+  const char* filenames[] = {test_filename1, test_filename1};
+  std::vector<std::string> contents(1);
+
+  std::vector<error_code> errors = read_files(io_context, filenames,
+                                              contents);
+
+  BOOST_REQUIRE_EQUAL(2, errors.size());
+  BOOST_CHECK_MESSAGE(!errors[0], "ec: " << errors[0]);
+  BOOST_CHECK_EQUAL(errors[1], asio::error::invalid_argument);
+  BOOST_CHECK_EQUAL(test_data1, contents[0]);
+}
+
+BOOST_AUTO_TEST_CASE(read_files_async)
+{
+  test_file_writer file1(test_filename1, test_data1, sizeof(test_data1) - 1);
+  test_file_writer file2(test_filename2, test_data2, sizeof(test_data2) - 1);
+
+  asio::io_context io_context;
+  asio::add_service(io_context, new thread_pool_file_service(io_context, 2));
+
+  const std::vector<std::string> filenames = {
+    test_filename1, test_filename2, "nosuchfile"
+  };
+  std::vector<std::vector<char>> contents(filenames.size());
+
+  bool called = false;
+  async_read_files(io_context, filenames, contents,
+                   [&] (std::vector<error_code> errors) {
+    called = true;
+    BOOST_REQUIRE_EQUAL(3, errors.size());
+    BOOST_CHECK_MESSAGE(!errors[0], "ec: " << errors[0]);
+    BOOST_CHECK_MESSAGE(!errors[1], "ec: " << errors[1]);
+    BOOST_CHECK(errors[2]);
+  });
+
+  io_context.run();
+
+  BOOST_REQUIRE(called);
+  BOOST_CHECK_EQUAL(std::string(test_data1),
+                    std::string(contents[0].begin(), contents[0].end()));
+  BOOST_CHECK_EQUAL(std::string(test_data2),
+                    std::string(contents[1].begin(), contents[1].end()));
+}
+
+BOOST_AUTO_TEST_CASE(read_files_async_empty)
+{
+  asio::io_context io_context;
+
+  const std::vector<std::string> filenames;
+  std::vector<std::string> contents;
+
+  bool called = false;
+  async_read_files(io_context, filenames, contents,
+                   [&] (std::vector<error_code> errors) {
+    called = true;
+    BOOST_CHECK(errors.empty());
+  });
+
+  BOOST_CHECK(!called);
+  io_context.run();
+  BOOST_CHECK(called);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
@@ -0,0 +1,280 @@
+#include "test_file_rm_guard.hpp"
+#include "test_file_writer.hpp"
+
+#include "asioext/splice.hpp"
+#include "asioext/read_file.hpp"
+#include "asioext/open.hpp"
+
+#if defined(ASIOEXT_HAS_SPLICE)
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/io_context.hpp>
+# include <boost/asio/ip/tcp.hpp>
+# include <boost/asio/posix/stream_descriptor.hpp>
+# include <boost/asio/write.hpp>
+#else
+# include <asio/io_context.hpp>
+# include <asio/ip/tcp.hpp>
+# include <asio/posix/stream_descriptor.hpp>
+# include <asio/write.hpp>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+ASIOEXT_NS_BEGIN
+
+BOOST_AUTO_TEST_SUITE(asioext_splice)
+
+// BOOST_AUTO_TEST_SUITE() gives us a unique NS, so we don't need to
+// prefix our variables.
+
+static const char* src_filename = "asioext_splice_src";
+static const char* dst_filenames[] = {
+  "asioext_splice_dst0",
+  "asioext_splice_dst1",
+  "asioext_splice_dst2",
+};
+
+static std::string make_test_data()
+{
+  // Larger than a default pipe buffer.
+  std::string data(300 * 1024 + 17, '\0');
+  for (std::size_t i = 0; i != data.size(); ++i)
+    data[i] = static_cast<char>('a' + i % 26);
+  return data;
+}
+
+static std::string read_all(const char* filename)
+{
+  std::string data;
+  read_file(filename, data);
+  return data;
+}
+
+static unique_file_handle create(const char* filename)
+{
+  return open(filename,
+              open_flags::access_write | open_flags::create_always);
+}
+
+static unique_file_handle open_existing(const char* filename)
+{
+  return open(filename, open_flags::access_read | open_flags::open_existing);
+}
+
+// Writes |data| to |pipe| and closes it.
+static std::thread write_to_pipe(unique_file_handle& pipe,
+                                 const std::string& data)
+{
+  return std::thread([&pipe, &data] {
+    asio::write(pipe, asio::buffer(data));
+    pipe.close();
+  });
+}
+
+BOOST_AUTO_TEST_CASE(primitives)
+{
+  test_file_rm_guard rguard(dst_filenames[0]);
+
+  unique_file_handle r1, w1, r2, w2;
+  make_pipe(r1, w1);
+  make_pipe(r2, w2);
+
+  const std::string data = "hello world!";
+  BOOST_CHECK_EQUAL(data.size(), vmsplice_some(w1.get(),
+                                               asio::buffer(data)));
+  w1.close();
+
+  // tee() leaves the data in the first pipe.
+  BOOST_CHECK_EQUAL(data.size(), tee_some(r1.get(), w2.get(), 1024));
+  w2.close();
+
+  {
+    unique_file_handle dst = create(dst_filenames[0]);
+    BOOST_CHECK_EQUAL(data.size(), splice_some(r1.get(), dst.get(), 1024));
+
+    error_code ec;
+    BOOST_CHECK_EQUAL(0, splice_some(r1.get(), dst.get(), 1024, ec));
+    BOOST_CHECK_EQUAL(asio::error::eof, ec);
+  }
+  BOOST_CHECK_EQUAL(data, read_all(dst_filenames[0]));
+
+  char buffer[64];
+  BOOST_CHECK_EQUAL(data.size(), r2.read_some(asio::buffer(buffer)));
+  BOOST_CHECK_EQUAL(data, std::string(buffer, data.size()));
+
+  // Neither side is a pipe.
+  error_code ec;
+  unique_file_handle dst = create(dst_filenames[0]);
+  splice_some(dst.get(), dst.get(), 1024, ec);
+  BOOST_CHECK(ec);
+}
+
+BOOST_AUTO_TEST_CASE(transfer)
+{
+  const std::string data = make_test_data();
+  test_file_writer src_file(src_filename, data.data(), data.size());
+  test_file_rm_guard rguard(dst_filenames[0]);
+
+  // File to file, through an intermediate pipe.
+  {
+    unique_file_handle src = open_existing(src_filename);
+    unique_file_handle dst = create(dst_filenames[0]);
+    BOOST_CHECK_EQUAL(data.size(), splice_transfer(src.get(), dst.get()));
+  }
+  BOOST_CHECK(data == read_all(dst_filenames[0]));
+
+  {
+    unique_file_handle src = open_existing(src_filename);
+    unique_file_handle dst = create(dst_filenames[0]);
+    error_code ec;
+    BOOST_CHECK_EQUAL(1000, splice_transfer(src.get(), dst.get(), 1000, ec));
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+  }
+  BOOST_CHECK(data.substr(0, 1000) == read_all(dst_filenames[0]));
+
+  // Pipe to file, directly.
+  {
+    unique_file_handle r, w;
+    make_pipe(r, w);
+    std::thread writer = write_to_pipe(w, data);
+
+    unique_file_handle dst = create(dst_filenames[0]);
+    BOOST_CHECK_EQUAL(data.size(), splice_transfer(r.get(), dst.get()));
+    writer.join();
+  }
+  BOOST_CHECK(data == read_all(dst_filenames[0]));
+}
+
+BOOST_AUTO_TEST_CASE(fanout)
+{
+  const std::string data = make_test_data();
+  test_file_writer src_file(src_filename, data.data(), data.size());
+  test_file_rm_guard rguard0(dst_filenames[0]);
+  test_file_rm_guard rguard1(dst_filenames[1]);
+  test_file_rm_guard rguard2(dst_filenames[2]);
+
+  for (int source_is_pipe = 0; source_is_pipe != 2; ++source_is_pipe) {
+    std::vector<unique_file_handle> destinations;
+    for (const char* filename : dst_filenames)
+      destinations.push_back(create(filename));
+
+    unique_file_handle r, w;
+    std::thread writer;
+    if (source_is_pipe) {
+      make_pipe(r, w);
+      writer = write_to_pipe(w, data);
+    } else {
+      r = open_existing(src_filename);
+    }
+
+    BOOST_CHECK_EQUAL(data.size(), splice_fanout(r.get(), destinations));
+    if (writer.joinable())
+      writer.join();
+
+    destinations.clear();
+    for (const char* filename : dst_filenames)
+      BOOST_CHECK(data == read_all(filename));
+  }
+
+  error_code ec;
+  splice_fanout(open_existing(src_filename).get(),
+                std::vector<file_handle>(), ec);
+  BOOST_CHECK_EQUAL(asio::error::invalid_argument, ec);
+
+  // A destination that fails after the source has been read from. The
+  // result includes the data that didn't make it.
+  std::vector<unique_file_handle> destinations;
+  destinations.push_back(create(dst_filenames[0]));
+  destinations.push_back(open_existing(src_filename));
+  const uint64_t consumed = splice_fanout(open_existing(src_filename).get(),
+                                          destinations, ec);
+  BOOST_CHECK(ec);
+  BOOST_CHECK_NE(0, consumed);
+}
+
+BOOST_AUTO_TEST_CASE(async_socket_transfer)
+{
+  const std::string data = make_test_data();
+  test_file_writer src_file(src_filename, data.data(), data.size());
+  test_file_rm_guard rguard(dst_filenames[0]);
+
+  asio::io_context io_context;
+  asio::ip::tcp::acceptor acceptor(io_context,
+      asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  asio::ip::tcp::socket client(io_context), server(io_context);
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+
+  unique_file_handle src = open_existing(src_filename);
+  unique_file_handle dst = create(dst_filenames[0]);
+
+  int completed = 0;
+  async_splice_write(client, src.get(), data.size(),
+                     [&] (const error_code& ec, uint64_t n) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK_EQUAL(data.size(), n);
+    client.shutdown(asio::ip::tcp::socket::shutdown_send);
+    ++completed;
+  });
+
+  async_splice_read(server, dst.get(), (std::numeric_limits<uint64_t>::max)(),
+                    [&] (const error_code& ec, uint64_t n) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK_EQUAL(data.size(), n);
+    ++completed;
+  });
+
+  io_context.run();
+  BOOST_CHECK_EQUAL(2, completed);
+
+  dst.close();
+  BOOST_CHECK(data == read_all(dst_filenames[0]));
+}
+
+BOOST_AUTO_TEST_CASE(async_fanout)
+{
+  const std::string data = make_test_data();
+  test_file_rm_guard rguard0(dst_filenames[0]);
+  test_file_rm_guard rguard1(dst_filenames[1]);
+  test_file_rm_guard rguard2(dst_filenames[2]);
+
+  std::vector<unique_file_handle> destinations;
+  for (const char* filename : dst_filenames)
+    destinations.push_back(create(filename));
+
+  unique_file_handle r, w;
+  make_pipe(r, w);
+
+  asio::io_context io_context;
+  asio::posix::stream_descriptor source(io_context,
+                                        r.release().native_handle());
+  std::thread writer = write_to_pipe(w, data);
+
+  int completed = 0;
+  async_splice_fanout(source, destinations,
+                      [&] (const error_code& ec, uint64_t n) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK_EQUAL(data.size(), n);
+    ++completed;
+  });
+
+  io_context.run();
+  writer.join();
+  BOOST_CHECK_EQUAL(1, completed);
+
+  destinations.clear();
+  for (const char* filename : dst_filenames)
+    BOOST_CHECK(data == read_all(filename));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
+
+#endif
@@ -0,0 +1,119 @@
+#include "asioext/standard_stream.hpp"
+
+#include "test_file_rm_guard.hpp"
+#include "test_file_writer.hpp"
+
+#include "asioext/open.hpp"
+
+#if defined(ASIOEXT_USE_BOOST_ASIO)
+# include <boost/asio/io_context.hpp>
+# include <boost/asio/read.hpp>
+# include <boost/asio/write.hpp>
+#else
+# include <asio/io_context.hpp>
+# include <asio/read.hpp>
+# include <asio/write.hpp>
+#endif
+
+#if !defined(ASIOEXT_WINDOWS)
+# include <unistd.h>
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+ASIOEXT_NS_BEGIN
+
+BOOST_AUTO_TEST_SUITE(asioext_standard_stream)
+
+// BOOST_AUTO_TEST_SUITE() gives us a unique NS, so we don't need to
+// prefix our variables.
+
+static const char* test_filename = "asioext_standard_stream_test";
+static const char test_data[] = "hello world!";
+static const std::size_t test_data_size = sizeof(test_data) - 1;
+
+BOOST_AUTO_TEST_CASE(regular_file)
+{
+  test_file_writer writer(test_filename, test_data, test_data_size);
+
+  unique_file_handle fh = open(test_filename,
+                               open_flags::access_read |
+                               open_flags::open_existing);
+
+  asio::io_context io_context;
+  standard_stream stream(io_context, fh.get());
+  BOOST_REQUIRE(stream.is_open());
+  BOOST_CHECK(!stream.is_reactive());
+
+  char buffer[sizeof(test_data)];
+  std::size_t bytes_read = 0;
+  asio::async_read(stream, asio::buffer(buffer, test_data_size),
+                   [&] (const error_code& ec, std::size_t n) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    bytes_read = n;
+  });
+  io_context.run();
+
+  BOOST_CHECK_EQUAL(test_data_size, bytes_read);
+  BOOST_CHECK_EQUAL(std::string(test_data),
+                    std::string(buffer, test_data_size));
+
+  // The stream only closes its own duplicate.
+  stream.close();
+  BOOST_CHECK(!stream.is_open());
+  BOOST_CHECK(fh.is_open());
+}
+
+#if !defined(ASIOEXT_WINDOWS)
+BOOST_AUTO_TEST_CASE(pipe)
+{
+  int fds[2];
+  BOOST_REQUIRE_EQUAL(0, ::pipe(fds));
+  unique_file_handle read_end{file_handle(fds[0])};
+  unique_file_handle write_end{file_handle(fds[1])};
+
+  asio::io_context io_context;
+  standard_stream input(io_context, read_end.get());
+  standard_stream output(io_context, write_end.get());
+  BOOST_CHECK(input.is_reactive());
+  BOOST_CHECK(output.is_reactive());
+
+  // Only the duplicates are left.
+  read_end.close();
+  write_end.close();
+
+  char buffer[sizeof(test_data)];
+  std::size_t bytes_read = 0;
+  asio::async_read(input, asio::buffer(buffer, test_data_size),
+                   [&] (const error_code& ec, std::size_t n) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    bytes_read = n;
+  });
+
+  // Nothing has been written yet, so the read has to wait for the reactor.
+  io_context.poll();
+  BOOST_CHECK_EQUAL(0, bytes_read);
+
+  asio::async_write(output, asio::buffer(test_data, test_data_size),
+                    [&] (const error_code& ec, std::size_t n) {
+    BOOST_CHECK_MESSAGE(!ec, "ec: " << ec);
+    BOOST_CHECK_EQUAL(test_data_size, n);
+  });
+  io_context.run();
+
+  BOOST_CHECK_EQUAL(test_data_size, bytes_read);
+  BOOST_CHECK_EQUAL(std::string(test_data),
+                    std::string(buffer, test_data_size));
+
+  output.close();
+  error_code ec;
+  BOOST_CHECK_EQUAL(0, input.read_some(asio::buffer(buffer), ec));
+  BOOST_CHECK_EQUAL(asio::error::eof, ec);
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
+
+ASIOEXT_NS_END
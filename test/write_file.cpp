@@ -2,6 +2,7 @@
 
 #include "asioext/read_file.hpp"
 #include "asioext/write_file.hpp"
+#include "asioext/checksum.hpp"
 
 #include <boost/test/unit_test.hpp>
 #include <boost/mpl/list.hpp>
@@ -85,6 +86,27 @@ BOOST_AUTO_TEST_CASE(two_buffers)
   BOOST_CHECK(compare_written(test_filename, buffers));
 }
 
+BOOST_AUTO_TEST_CASE(two_buffers_checksum)
+{
+  test_file_rm_guard rguard1(test_filename);
+
+  const boost::array<asio::const_buffer, 2> buffers = {
+    asio::const_buffer(test_data, test_data_size),
+    asio::const_buffer(test_data, test_data_size),
+  };
+
+  crc32c_hasher hasher;
+  asioext::error_code ec;
+  asioext::write_file(test_filename, buffers, hasher, ec);
+  BOOST_REQUIRE_MESSAGE(!ec, "ec: " << ec);
+  BOOST_CHECK(compare_written(test_filename, buffers));
+
+  crc32c_hasher expected;
+  expected.update(test_data, test_data_size);
+  expected.update(test_data, test_data_size);
+  BOOST_CHECK_EQUAL(expected.value(), hasher.value());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ASIOEXT_NS_END